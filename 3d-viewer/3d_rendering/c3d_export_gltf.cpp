@@ -0,0 +1,743 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  c3d_export_gltf.cpp
+ * @brief export the board and its 3D models to a binary glTF 2.0 file (.glb)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unordered_map>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include "c3d_export_gltf.h"
+#include "3d_render_ogl_legacy/clayer_triangles.h"
+#include "3d_render_raytracing/accelerators/ccontainer2d.h"
+#include "3d_render_raytracing/shapes2D/ctriangle2d.h"
+#include <class_board.h>
+#include <class_module.h>
+#include <base_units.h>
+#include <common.h>
+#include <build_version.h>
+#include <reporter.h>
+
+
+#define UNITS3D_TO_UNITSPCB (IU_PER_MM)
+
+// glTF constants
+#define GLB_MAGIC               0x46546C67  // "glTF"
+#define GLB_CHUNK_JSON          0x4E4F534A  // "JSON"
+#define GLB_CHUNK_BIN           0x004E4942  // "BIN\0"
+
+#define GLTF_FLOAT              5126
+#define GLTF_UNSIGNED_INT       5125
+#define GLTF_ARRAY_BUFFER       34962
+#define GLTF_ELEMENT_ARRAY_BUFFER 34963
+
+
+// A vertex is shared by the triangles having the same position and the same normal
+struct WELDED_VERTEX
+{
+    SFVEC3F m_position;
+    SFVEC3F m_normal;
+
+    bool operator==( const WELDED_VERTEX &aOther ) const
+    {
+        return m_position == aOther.m_position && m_normal == aOther.m_normal;
+    }
+};
+
+
+struct WELDED_VERTEX_HASH
+{
+    size_t operator()( const WELDED_VERTEX &aVertex ) const
+    {
+        const float *f = &aVertex.m_position.x;
+        const float *n = &aVertex.m_normal.x;
+        size_t seed = 0;
+
+        for( int i = 0; i < 3; ++i )
+        {
+            seed ^= std::hash<float>()( f[i] ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+            seed ^= std::hash<float>()( n[i] ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+        }
+
+        return seed;
+    }
+};
+
+
+struct WELDED_MESH
+{
+    std::vector<SFVEC3F>        m_positions;
+    std::vector<SFVEC3F>        m_normals;
+    std::vector<unsigned int>   m_indices;
+
+    std::unordered_map<WELDED_VERTEX, unsigned int, WELDED_VERTEX_HASH> m_vertices;
+
+    /**
+     * Adds the triangles of a container, with their own normals or, if aNormal is
+     * not NULL, all with the same normal.
+     */
+    void Add( const CLAYER_TRIANGLE_CONTAINER *aTriangles, const SFVEC3F *aNormal )
+    {
+        unsigned int count = aTriangles->GetVertexSize();
+
+        if( count == 0 )
+            return;
+
+        const SFVEC3F *positions = (const SFVEC3F *)aTriangles->GetVertexPointer();
+        const SFVEC3F *normals = NULL;
+
+        if( !aNormal )
+        {
+            if( aTriangles->GetNormalsSize() != count )
+                return;
+
+            normals = (const SFVEC3F *)aTriangles->GetNormalsPointer();
+        }
+
+        for( unsigned int i = 0; i < count; ++i )
+        {
+            WELDED_VERTEX vertex;
+
+            vertex.m_position = positions[i];
+            vertex.m_normal = aNormal ? *aNormal : normals[i];
+
+            auto it = m_vertices.insert( std::make_pair( vertex, m_positions.size() ) );
+
+            if( it.second )
+            {
+                m_positions.push_back( vertex.m_position );
+                m_normals.push_back( vertex.m_normal );
+            }
+
+            m_indices.push_back( it.first->second );
+        }
+    }
+};
+
+
+static std::string formatFloat( double aValue )
+{
+    char buf[32];
+
+    snprintf( buf, sizeof( buf ), "%.9g", aValue );
+
+    return buf;
+}
+
+
+static std::string formatVector( const SFVEC3F &aVector )
+{
+    return "[" + formatFloat( aVector.x ) + "," + formatFloat( aVector.y ) + "," +
+           formatFloat( aVector.z ) + "]";
+}
+
+
+static std::string quoted( const wxString &aText )
+{
+    std::string utf8 = (const char *)aText.utf8_str();
+    std::string result = "\"";
+
+    for( char c : utf8 )
+    {
+        if( c == '"' || c == '\\' )
+            result += '\\';
+
+        if( (unsigned char) c >= 0x20 )
+            result += c;
+    }
+
+    return result + "\"";
+}
+
+
+static std::string joined( const std::vector<std::string> &aItems )
+{
+    std::string result = "[";
+
+    for( unsigned int i = 0; i < aItems.size(); ++i )
+    {
+        if( i )
+            result += ",";
+
+        result += aItems[i];
+    }
+
+    return result + "]";
+}
+
+
+C3D_EXPORT_GLTF::C3D_EXPORT_GLTF( const CINFO3D_VISU &aSettings ) :
+    m_settings( aSettings )
+{
+}
+
+
+bool C3D_EXPORT_GLTF::Export( const wxString &aFileName, REPORTER *aStatusTextReporter )
+{
+    if( !m_settings.GetBoard() )
+    {
+        m_errorMessage = _( "No board to export" );
+        return false;
+    }
+
+    // Numbers are written in the JSON chunk with a '.' as decimal separator
+    LOCALE_IO toggle;
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Export glTF: board" ) );
+
+    if( m_settings.GetFlag( FL_SHOW_BOARD_BODY ) )
+        addBoardBody();
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Export glTF: layers" ) );
+
+    addLayers();
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Export glTF: 3D models" ) );
+
+    addModels();
+
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Export glTF: writing file" ) );
+
+    return write( aFileName );
+}
+
+
+void C3D_EXPORT_GLTF::addBoardBody()
+{
+    SHAPE_POLY_SET body = m_settings.GetBoardPoly();
+    SHAPE_POLY_SET holes = m_settings.GetThroughHole_Outer_poly();
+
+    holes.BooleanAdd( m_settings.GetThroughHole_Outer_poly_NPTH(), SHAPE_POLY_SET::PM_FAST );
+    body.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+
+    const SFVEC3F color = SFVEC3F( m_settings.m_BoardBodyColor );
+
+    addPolygonMesh( "Board", body,
+                    -m_settings.GetEpoxyThickness3DU() / 2.0f,
+                     m_settings.GetEpoxyThickness3DU() / 2.0f,
+                    addMaterial( color, 0.0f, 0.1f ) );
+}
+
+
+void C3D_EXPORT_GLTF::addLayers()
+{
+    const MAP_POLY &layers = m_settings.GetPolyMap();
+    const MAP_POLY &outerHoles = m_settings.GetPolyMapHoles_Outer();
+    const BOARD *board = m_settings.GetBoard();
+    bool  missingCopper = false;
+
+    for( LSEQ seq = board->GetEnabledLayers().Seq(); seq; ++seq )
+    {
+        LAYER_ID layer = *seq;
+
+        if( !m_settings.Is3DLayerEnabled( layer ) )
+            continue;
+
+        MAP_POLY::const_iterator it = layers.find( layer );
+        SHAPE_POLY_SET poly;
+
+        if( layer == B_Mask || layer == F_Mask )
+        {
+            // The layer holds the openings of the mask, which covers the rest of the board
+            poly = m_settings.GetBoardPoly();
+
+            if( it != layers.end() )
+                poly.BooleanSubtract( *it->second, SHAPE_POLY_SET::PM_FAST );
+        }
+        else if( it != layers.end() )
+        {
+            poly = *it->second;
+
+            MAP_POLY::const_iterator holes = outerHoles.find( layer );
+
+            if( holes != outerHoles.end() )
+                poly.BooleanSubtract( *holes->second, SHAPE_POLY_SET::PM_FAST );
+        }
+        else
+        {
+            // The copper polygons are only built for the OpenGL renderer, when the
+            // copper thickness is shown
+            if( IsCopperLayer( layer ) )
+                missingCopper = true;
+
+            continue;
+        }
+
+        float zbot = m_settings.GetLayerBottomZpos3DU( layer );
+        float ztop = m_settings.GetLayerTopZpos3DU( layer );
+
+        if( ztop < zbot )
+            std::swap( zbot, ztop );
+
+        addPolygonMesh( (const char *) board->GetLayerName( layer ).utf8_str(), poly,
+                        zbot, ztop,
+                        addMaterial( m_settings.GetLayerColor( layer ), 0.0f,
+                                     IsCopperLayer( layer ) ? 0.4f : 0.1f ) );
+    }
+
+    if( missingCopper )
+        m_warnings += _( "The copper layers are exported only with the OpenGL renderer and "
+                         "the copper thickness option enabled.\n" );
+}
+
+
+void C3D_EXPORT_GLTF::addPolygonMesh( const std::string &aName, const SHAPE_POLY_SET &aPoly,
+                                      float aZbot, float aZtop, int aMaterial )
+{
+    if( aPoly.OutlineCount() == 0 )
+        return;
+
+    CCONTAINER2D container;
+
+    Convert_shape_line_polygon_to_triangles( aPoly, container, m_settings.BiuTo3Dunits(),
+                                             (const BOARD_ITEM &)*m_settings.GetBoard() );
+
+    const LIST_OBJECT2D &triangles = container.GetList();
+
+    if( triangles.empty() )
+        return;
+
+    CLAYER_TRIANGLES layerTriangles( triangles.size() );
+
+    for( LIST_OBJECT2D::const_iterator ii = triangles.begin(); ii != triangles.end(); ++ii )
+    {
+        wxASSERT( (*ii)->GetObjectType() == OBJ2D_TRIANGLE );
+
+        const CTRIANGLE2D *tri = static_cast<const CTRIANGLE2D *>( *ii );
+
+        const SFVEC2F &v0 = tri->GetP1();
+        const SFVEC2F &v1 = tri->GetP2();
+        const SFVEC2F &v2 = tri->GetP3();
+
+        // Same orientation of the faces as C3D_RENDER_OGL_LEGACY::add_triangle_top_bot()
+        layerTriangles.m_layer_bot_triangles->AddTriangle( SFVEC3F( v0.x, v0.y, aZbot ),
+                                                           SFVEC3F( v1.x, v1.y, aZbot ),
+                                                           SFVEC3F( v2.x, v2.y, aZbot ) );
+
+        layerTriangles.m_layer_top_triangles->AddTriangle( SFVEC3F( v2.x, v2.y, aZtop ),
+                                                           SFVEC3F( v1.x, v1.y, aZtop ),
+                                                           SFVEC3F( v0.x, v0.y, aZtop ) );
+    }
+
+    layerTriangles.AddToMiddleContourns( aPoly, aZbot, aZtop, m_settings.BiuTo3Dunits(),
+                                         false );
+
+    // The faces of the whole layer are shared by the triangles: index them
+    const SFVEC3F up( 0.0f, 0.0f, 1.0f );
+    const SFVEC3F down( 0.0f, 0.0f, -1.0f );
+    WELDED_MESH   mesh;
+
+    mesh.Add( layerTriangles.m_layer_top_triangles, &up );
+    mesh.Add( layerTriangles.m_layer_bot_triangles, &down );
+    mesh.Add( layerTriangles.m_layer_middle_contourns_quads, NULL );
+
+    std::string primitive = addPrimitive( mesh.m_positions.data(), mesh.m_normals.data(), NULL,
+                                          mesh.m_positions.size(), mesh.m_indices.data(),
+                                          mesh.m_indices.size(), aMaterial );
+
+    if( primitive.empty() )
+        return;
+
+    m_meshes.push_back( "{\"name\":" + quoted( aName ) + ",\"primitives\":[" + primitive + "]}" );
+    addNode( aName, m_meshes.size() - 1 );
+}
+
+
+void C3D_EXPORT_GLTF::addModels()
+{
+    const double modelunit_to_3d_units_factor = m_settings.BiuTo3Dunits() *
+                                                UNITS3D_TO_UNITSPCB;
+
+    for( const MODULE* module = m_settings.GetBoard()->m_Modules;
+         module;
+         module = module->Next() )
+    {
+        if( module->Models().empty() ||
+            !m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+            continue;
+
+        // Same placement as C3D_RENDER_RAYTRACING::load_3D_models()
+        double zpos = m_settings.GetModulesZcoord3DIU( module->IsFlipped() );
+
+        wxPoint pos = module->GetPosition();
+
+        glm::mat4 moduleMatrix = glm::mat4();
+
+        moduleMatrix = glm::translate( moduleMatrix,
+                                       SFVEC3F( pos.x * m_settings.BiuTo3Dunits(),
+                                               -pos.y * m_settings.BiuTo3Dunits(),
+                                                zpos ) );
+
+        if( module->GetOrientation() )
+        {
+            moduleMatrix = glm::rotate( moduleMatrix,
+                                        ( (float)(module->GetOrientation() / 10.0f) / 180.0f ) *
+                                        glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 0.0f, 1.0f ) );
+        }
+
+        if( module->IsFlipped() )
+        {
+            moduleMatrix = glm::rotate( moduleMatrix,
+                                        glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 1.0f, 0.0f ) );
+
+            moduleMatrix = glm::rotate( moduleMatrix,
+                                        glm::pi<float>(),
+                                        SFVEC3F( 0.0f, 0.0f, 1.0f ) );
+        }
+
+        moduleMatrix = glm::scale( moduleMatrix,
+                                   SFVEC3F( modelunit_to_3d_units_factor,
+                                            modelunit_to_3d_units_factor,
+                                            modelunit_to_3d_units_factor ) );
+
+        for( std::list<S3D_INFO>::const_iterator sM = module->Models().begin();
+             sM != module->Models().end();
+             ++sM )
+        {
+            const S3DMODEL *modelPtr =
+                    m_settings.Get3DCacheManager()->GetModel( sM->m_Filename );
+
+            if( !modelPtr )
+                continue;
+
+            int mesh = getModelMesh( sM->m_Filename, modelPtr );
+
+            if( mesh < 0 )
+                continue;
+
+            glm::mat4 modelMatrix = moduleMatrix;
+
+            modelMatrix = glm::translate( modelMatrix,
+                                          SFVEC3F( sM->m_Offset.x * 25.4f,
+                                                   sM->m_Offset.y * 25.4f,
+                                                   sM->m_Offset.z * 25.4f ) );
+
+            modelMatrix = glm::rotate( modelMatrix,
+                                       (float)-( sM->m_Rotation.z / 180.0f ) *
+                                       glm::pi<float>(),
+                                       SFVEC3F( 0.0f, 0.0f, 1.0f ) );
+
+            modelMatrix = glm::rotate( modelMatrix,
+                                       (float)-( sM->m_Rotation.y / 180.0f ) *
+                                       glm::pi<float>(),
+                                       SFVEC3F( 0.0f, 1.0f, 0.0f ) );
+
+            modelMatrix = glm::rotate( modelMatrix,
+                                       (float)-( sM->m_Rotation.x / 180.0f ) *
+                                       glm::pi<float>(),
+                                       SFVEC3F( 1.0f, 0.0f, 0.0f ) );
+
+            modelMatrix = glm::scale( modelMatrix,
+                                      SFVEC3F( sM->m_Scale.x,
+                                               sM->m_Scale.y,
+                                               sM->m_Scale.z ) );
+
+            addNode( (const char *) module->GetReference().utf8_str(), mesh, &modelMatrix );
+        }
+    }
+}
+
+
+int C3D_EXPORT_GLTF::getModelMesh( const wxString &aFileName, const S3DMODEL *aModel )
+{
+    std::map< wxString, int >::const_iterator it = m_modelMeshes.find( aFileName );
+
+    if( it != m_modelMeshes.end() )
+        return it->second;
+
+    // The materials of the model, created when used by a mesh
+    std::vector<int>            materials( aModel->m_MaterialsSize, -1 );
+    std::vector<std::string>    primitives;
+
+    for( unsigned int i = 0; i < aModel->m_MeshesSize; ++i )
+    {
+        const SMESH &mesh = aModel->m_Meshes[i];
+
+        if( mesh.m_MaterialIdx >= aModel->m_MaterialsSize || !mesh.m_Positions ||
+            !mesh.m_FaceIdx || ( mesh.m_FaceIdxSize % 3 ) != 0 )
+            continue;
+
+        int &material = materials[mesh.m_MaterialIdx];
+
+        if( material < 0 )
+        {
+            const SMATERIAL &smaterial = aModel->m_Materials[mesh.m_MaterialIdx];
+
+            material = addMaterial( mesh.m_Color ? SFVEC3F( 1.0f ) : smaterial.m_Diffuse,
+                                    smaterial.m_Transparency, smaterial.m_Shininess );
+        }
+
+        std::string primitive = addPrimitive( mesh.m_Positions, mesh.m_Normals, mesh.m_Color,
+                                              mesh.m_VertexSize, mesh.m_FaceIdx,
+                                              mesh.m_FaceIdxSize, material );
+
+        if( !primitive.empty() )
+            primitives.push_back( primitive );
+    }
+
+    int meshIndex = -1;
+
+    if( !primitives.empty() )
+    {
+        wxFileName fn( aFileName );
+
+        m_meshes.push_back( "{\"name\":" + quoted( fn.GetName() ) + ",\"primitives\":" +
+                            joined( primitives ) + "}" );
+        meshIndex = m_meshes.size() - 1;
+    }
+
+    m_modelMeshes[aFileName] = meshIndex;
+
+    return meshIndex;
+}
+
+
+int C3D_EXPORT_GLTF::addMaterial( const SFVEC3F &aColor, float aTransparency, float aShininess )
+{
+    float alpha = 1.0f - glm::clamp( aTransparency, 0.0f, 1.0f );
+
+    // SMATERIAL shininess is between 0 and 1, a shiny material is a smooth one
+    float roughness = 1.0f - glm::clamp( aShininess, 0.0f, 1.0f );
+
+    std::string material = "{\"pbrMetallicRoughness\":{\"baseColorFactor\":[" +
+                           formatFloat( aColor.r ) + "," + formatFloat( aColor.g ) + "," +
+                           formatFloat( aColor.b ) + "," + formatFloat( alpha ) + "]," +
+                           "\"metallicFactor\":0,\"roughnessFactor\":" +
+                           formatFloat( roughness ) + "}";
+
+    if( alpha < 1.0f )
+        material += ",\"alphaMode\":\"BLEND\"";
+
+    material += ",\"doubleSided\":true}";
+
+    // Layers and models often share the same colors
+    for( unsigned int i = 0; i < m_materials.size(); ++i )
+    {
+        if( m_materials[i] == material )
+            return i;
+    }
+
+    m_materials.push_back( material );
+
+    return m_materials.size() - 1;
+}
+
+
+int C3D_EXPORT_GLTF::addAccessor( const void *aData, unsigned int aCount, int aComponentType,
+                                  const char *aType, int aTarget, const SFVEC3F *aMin,
+                                  const SFVEC3F *aMax )
+{
+    unsigned int components = strcmp( aType, "VEC3" ) == 0 ? 3 : 1;
+    unsigned int byteLength = aCount * components * 4;   // floats and 32 bits indices
+    unsigned int offset = m_buffer.size();
+
+    m_buffer.insert( m_buffer.end(), (const char *) aData, (const char *) aData + byteLength );
+
+    // Every array starts on a 4 bytes boundary
+    m_buffer.resize( ( m_buffer.size() + 3 ) & ~3u, 0 );
+
+    m_bufferViews.push_back( "{\"buffer\":0,\"byteOffset\":" + std::to_string( offset ) +
+                             ",\"byteLength\":" + std::to_string( byteLength ) +
+                             ",\"target\":" + std::to_string( aTarget ) + "}" );
+
+    std::string accessor = "{\"bufferView\":" + std::to_string( m_bufferViews.size() - 1 ) +
+                           ",\"componentType\":" + std::to_string( aComponentType ) +
+                           ",\"count\":" + std::to_string( aCount ) +
+                           ",\"type\":\"" + aType + "\"";
+
+    if( aMin && aMax )
+        accessor += ",\"min\":" + formatVector( *aMin ) + ",\"max\":" + formatVector( *aMax );
+
+    m_accessors.push_back( accessor + "}" );
+
+    return m_accessors.size() - 1;
+}
+
+
+int C3D_EXPORT_GLTF::addPositions( const SFVEC3F *aPositions, unsigned int aCount )
+{
+    // The bounds of the positions are required by glTF
+    SFVEC3F min = aPositions[0];
+    SFVEC3F max = aPositions[0];
+
+    for( unsigned int i = 1; i < aCount; ++i )
+    {
+        min = glm::min( min, aPositions[i] );
+        max = glm::max( max, aPositions[i] );
+    }
+
+    return addAccessor( aPositions, aCount, GLTF_FLOAT, "VEC3", GLTF_ARRAY_BUFFER,
+                        &min, &max );
+}
+
+
+std::string C3D_EXPORT_GLTF::addPrimitive( const SFVEC3F *aPositions, const SFVEC3F *aNormals,
+                                           const SFVEC3F *aColors, unsigned int aVertexCount,
+                                           const unsigned int *aIndices,
+                                           unsigned int aIndexCount, int aMaterial )
+{
+    if( aVertexCount == 0 || aIndexCount == 0 )
+        return std::string();
+
+    std::string attributes = "\"POSITION\":" +
+                             std::to_string( addPositions( aPositions, aVertexCount ) );
+
+    if( aNormals )
+        attributes += ",\"NORMAL\":" +
+                      std::to_string( addAccessor( aNormals, aVertexCount, GLTF_FLOAT, "VEC3",
+                                                   GLTF_ARRAY_BUFFER ) );
+
+    if( aColors )
+        attributes += ",\"COLOR_0\":" +
+                      std::to_string( addAccessor( aColors, aVertexCount, GLTF_FLOAT, "VEC3",
+                                                   GLTF_ARRAY_BUFFER ) );
+
+    int indices = addAccessor( aIndices, aIndexCount, GLTF_UNSIGNED_INT, "SCALAR",
+                               GLTF_ELEMENT_ARRAY_BUFFER );
+
+    return "{\"attributes\":{" + attributes + "},\"indices\":" + std::to_string( indices ) +
+           ",\"material\":" + std::to_string( aMaterial ) + "}";
+}
+
+
+void C3D_EXPORT_GLTF::addNode( const std::string &aName, int aMesh, const glm::mat4 *aMatrix )
+{
+    std::string node = "{\"name\":" + quoted( wxString::FromUTF8( aName.c_str() ) ) +
+                       ",\"mesh\":" + std::to_string( aMesh );
+
+    if( aMatrix )
+    {
+        // glm matrices are column major, as glTF ones
+        const float *m = glm::value_ptr( *aMatrix );
+
+        node += ",\"matrix\":[";
+
+        for( int i = 0; i < 16; ++i )
+            node += ( i ? "," : "" ) + formatFloat( m[i] );
+
+        node += "]";
+    }
+
+    m_nodes.push_back( node + "}" );
+}
+
+
+static void writeUint32( wxFFile &aFile, unsigned int aValue )
+{
+    unsigned char bytes[4] = { (unsigned char)( aValue ),       (unsigned char)( aValue >> 8 ),
+                               (unsigned char)( aValue >> 16 ), (unsigned char)( aValue >> 24 ) };
+
+    aFile.Write( bytes, 4 );
+}
+
+
+bool C3D_EXPORT_GLTF::write( const wxString &aFileName )
+{
+    // The root node converts the 3D units to meters, and the Z up of the board to the
+    // Y up of glTF
+    const float s = 1.0f / ( m_settings.BiuTo3Dunits() * UNITS3D_TO_UNITSPCB * 1000.0 );
+
+    std::vector<std::string> children;
+
+    for( unsigned int i = 0; i < m_nodes.size(); ++i )
+        children.push_back( std::to_string( i + 1 ) );
+
+    std::string root = "{\"name\":" + quoted( wxFileName( aFileName ).GetName() ) +
+                       ",\"matrix\":[" + formatFloat( s ) + ",0,0,0,0,0," +
+                       formatFloat( -s ) + ",0,0," + formatFloat( s ) + ",0,0,0,0,0,1]";
+
+    if( !children.empty() )
+        root += ",\"children\":" + joined( children );
+
+    std::vector<std::string> nodes;
+
+    nodes.push_back( root + "}" );
+    nodes.insert( nodes.end(), m_nodes.begin(), m_nodes.end() );
+
+    std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":" +
+                       quoted( wxT( "KiCad " ) + GetBuildVersion() ) + "}," +
+                       "\"scene\":0,\"scenes\":[{\"nodes\":[0]}]," +
+                       "\"nodes\":" + joined( nodes );
+
+    if( !m_meshes.empty() )
+    {
+        json += ",\"meshes\":" + joined( m_meshes ) +
+                ",\"materials\":" + joined( m_materials ) +
+                ",\"accessors\":" + joined( m_accessors ) +
+                ",\"bufferViews\":" + joined( m_bufferViews ) +
+                ",\"buffers\":[{\"byteLength\":" + std::to_string( m_buffer.size() ) + "}]";
+    }
+
+    json += "}";
+
+    // The JSON chunk is padded with spaces, the BIN chunk with zeros
+    json.resize( ( json.size() + 3 ) & ~3u, ' ' );
+
+    unsigned int length = 12 + 8 + json.size();
+
+    if( !m_buffer.empty() )
+        length += 8 + m_buffer.size();
+
+    wxFFile file( aFileName, "wb" );
+
+    if( !file.IsOpened() )
+    {
+        m_errorMessage.Printf( _( "Cannot create file '%s'" ), GetChars( aFileName ) );
+        return false;
+    }
+
+    writeUint32( file, GLB_MAGIC );
+    writeUint32( file, 2 );
+    writeUint32( file, length );
+
+    writeUint32( file, json.size() );
+    writeUint32( file, GLB_CHUNK_JSON );
+    file.Write( json.data(), json.size() );
+
+    if( !m_buffer.empty() )
+    {
+        writeUint32( file, m_buffer.size() );
+        writeUint32( file, GLB_CHUNK_BIN );
+        file.Write( m_buffer.data(), m_buffer.size() );
+    }
+
+    if( file.Error() || !file.Close() )
+    {
+        m_errorMessage.Printf( _( "Error writing file '%s'" ), GetChars( aFileName ) );
+        return false;
+    }
+
+    return true;
+}
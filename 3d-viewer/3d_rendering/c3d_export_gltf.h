@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file  c3d_export_gltf.h
+ * @brief export the board and its 3D models to a binary glTF 2.0 file (.glb)
+ */
+
+#ifndef C3D_EXPORT_GLTF_H_
+#define C3D_EXPORT_GLTF_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <plugins/3dapi/c3dmodel.h>
+#include "../3d_canvas/cinfo3d_visu.h"
+
+/**
+ * @brief Class C3D_EXPORT_GLTF writes the board, as seen in the 3D viewer, to a
+ * binary glTF 2.0 file.
+ *
+ * The board body and the layers are the polygons computed by CINFO3D_VISU, triangulated
+ * as the OpenGL renderer does, with indexed vertices. Each 3D model of the S3D_CACHE is
+ * written once, as a mesh, and every footprint using it is a node instancing this mesh.
+ * Coordinates are in meters, with Y up, as glTF expects.
+ */
+class C3D_EXPORT_GLTF
+{
+public:
+    /**
+     * @param aSettings: the settings of the 3D viewer, with the layers already built
+     *                   by CINFO3D_VISU::InitSettings()
+     */
+    explicit C3D_EXPORT_GLTF( const CINFO3D_VISU &aSettings );
+
+    /**
+     * @brief Export - builds and writes the file
+     * @param aFileName: the .glb file to write
+     * @param aStatusTextReporter: the reporter of the progress, can be NULL
+     * @return true on success, else GetErrorMessage() tells why
+     */
+    bool Export( const wxString &aFileName, REPORTER *aStatusTextReporter = NULL );
+
+    const wxString &GetErrorMessage() const { return m_errorMessage; }
+
+    /**
+     * @brief GetWarnings - the parts of the board which could not be exported
+     */
+    const wxString &GetWarnings() const { return m_warnings; }
+
+private:
+    void addBoardBody();
+    void addLayers();
+    void addModels();
+
+    /// Triangulates a polygon set into a prism between aZbot and aZtop
+    void addPolygonMesh( const std::string &aName, const SHAPE_POLY_SET &aPoly,
+                         float aZbot, float aZtop, int aMaterial );
+
+    /// @return the glTF mesh of a 3D model, created on first use
+    int getModelMesh( const wxString &aFileName, const S3DMODEL *aModel );
+
+    int addMaterial( const SFVEC3F &aColor, float aTransparency, float aShininess );
+
+    /// @return the accessor of an array copied to the binary buffer
+    int addAccessor( const void *aData, unsigned int aCount, int aComponentType,
+                     const char *aType, int aTarget, const SFVEC3F *aMin = NULL,
+                     const SFVEC3F *aMax = NULL );
+
+    int addPositions( const SFVEC3F *aPositions, unsigned int aCount );
+
+    /// @return the primitive JSON object, or an empty string if the mesh is empty
+    std::string addPrimitive( const SFVEC3F *aPositions, const SFVEC3F *aNormals,
+                              const SFVEC3F *aColors, unsigned int aVertexCount,
+                              const unsigned int *aIndices, unsigned int aIndexCount,
+                              int aMaterial );
+
+    void addNode( const std::string &aName, int aMesh, const glm::mat4 *aMatrix = NULL );
+
+    bool write( const wxString &aFileName );
+
+    const CINFO3D_VISU &m_settings;
+
+    std::vector<char>           m_buffer;       ///< content of the BIN chunk
+    std::vector<std::string>    m_bufferViews;  ///< JSON objects of each array
+    std::vector<std::string>    m_accessors;
+    std::vector<std::string>    m_materials;
+    std::vector<std::string>    m_meshes;
+    std::vector<std::string>    m_nodes;        ///< children of the root node
+
+    std::map< wxString, int >   m_modelMeshes;  ///< the mesh of each 3D model file
+
+    wxString m_errorMessage;
+    wxString m_warnings;
+};
+
+#endif // C3D_EXPORT_GLTF_H_
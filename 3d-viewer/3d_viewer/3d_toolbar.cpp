@@ -149,6 +149,10 @@ void EDA_3D_VIEWER::CreateMenuBar()
                  _( "Create Image (jpeg format)" ),
                  KiBitmap( export_xpm ) );
 
+    AddMenuItem( fileMenu, ID_MENU3D_EXPORT_GLTF,
+                 _( "Export 3D Model (glTF binary format)" ),
+                 KiBitmap( export_xpm ) );
+
     fileMenu->AppendSeparator();
     AddMenuItem( fileMenu, ID_TOOL_SCREENCOPY_TOCLIBBOARD,
                  _( "Copy 3D Image to Clipboard" ),
@@ -29,6 +29,7 @@
 
 #include "eda_3d_viewer.h"
 #include "../3d_viewer_id.h"
+#include "../3d_rendering/c3d_export_gltf.h"
 #include <project.h>
 #include <gestfich.h>
 #include <wx/colordlg.h>
@@ -340,6 +341,10 @@ void EDA_3D_VIEWER::Process_Special_Functions( wxCommandEvent &event )
         takeScreenshot( event );
         return;
 
+    case ID_MENU3D_EXPORT_GLTF:
+        export3DModel( event );
+        return;
+
     case ID_MENU3D_BGCOLOR_BOTTOM_SELECTION:
         if( Set3DColorFromUser( m_settings.m_BgColorBot, _( "Background Color, Bottom" ) ) )
         {
@@ -993,6 +998,38 @@ void EDA_3D_VIEWER::takeScreenshot( wxCommandEvent& event )
 }
 
 
+void EDA_3D_VIEWER::export3DModel( wxCommandEvent& event )
+{
+    // Remember path between saves during this session only.
+    static wxFileName fn;
+    const wxString file_ext = wxT( "glb" );
+    const wxString mask     = wxT( "*." ) + file_ext;
+
+    // First time path is set to the project path.
+    if( !fn.IsOk() )
+        fn = Parent()->Prj().GetProjectFullName();
+
+    fn.SetExt( file_ext );
+
+    wxString fullFileName = EDA_FILE_SELECTOR( _( "glTF File Name:" ), fn.GetPath(),
+                                               fn.GetFullName(), file_ext, mask, this,
+                                               wxFD_SAVE | wxFD_OVERWRITE_PROMPT, true );
+
+    if( fullFileName.IsEmpty() )
+        return;
+
+    fn = fullFileName;
+
+    wxBusyCursor    dummy;
+    C3D_EXPORT_GLTF exporter( m_settings );
+
+    if( !exporter.Export( fullFileName ) )
+        wxMessageBox( exporter.GetErrorMessage() );
+    else if( !exporter.GetWarnings().IsEmpty() )
+        wxMessageBox( exporter.GetWarnings(), _( "glTF Export" ), wxOK | wxICON_WARNING, this );
+}
+
+
 void EDA_3D_VIEWER::RenderEngineChanged()
 {
     if( m_canvas )
@@ -202,6 +202,11 @@ class EDA_3D_VIEWER : public KIWAY_PLAYER
      */
     void takeScreenshot( wxCommandEvent& event );
 
+    /**
+     * @brief export3DModel - writes the board and its 3D models to a binary glTF file
+     */
+    void export3DModel( wxCommandEvent& event );
+
     /**
      * @brief RenderEngineChanged - Update toolbar icon and call canvas RenderEngineChanged
      */
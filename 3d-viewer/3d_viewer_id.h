@@ -85,6 +85,7 @@ enum id_3dview_frm
     ID_MENU_SCREENCOPY_PNG,
     ID_MENU_SCREENCOPY_JPEG,
     ID_MENU_SCREENCOPY_TOCLIBBOARD,
+    ID_MENU3D_EXPORT_GLTF,
 
     ID_MENU3D_RESET_DEFAULTS,
 
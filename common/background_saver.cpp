@@ -0,0 +1,207 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <richio.h>
+#include <background_saver.h>
+
+#include <wx/filename.h>
+
+
+wxDEFINE_EVENT( EVT_BACKGROUND_SAVE_DONE, wxThreadEvent );
+
+
+BACKGROUND_SAVER::BACKGROUND_SAVER( wxEvtHandler* aOwner ) :
+    m_owner( aOwner ),
+    m_pending( 0 ),
+    m_running( false ),
+    m_quit( false )
+{
+    Bind( EVT_BACKGROUND_SAVE_DONE, &BACKGROUND_SAVER::onJobDone, this );
+}
+
+
+BACKGROUND_SAVER::~BACKGROUND_SAVER()
+{
+    m_owner = NULL;
+
+    if( m_thread.joinable() )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_lock );
+            m_quit = true;
+        }
+
+        m_changed.notify_all();
+        m_thread.join();
+    }
+
+    // Drop the reports nobody is left to see.
+    DeletePendingEvents();
+}
+
+
+void BACKGROUND_SAVER::Queue( const wxString& aFileName, FORMAT_FUNC aFormat,
+                              const wxString& aBackupFileName )
+{
+    m_pending++;
+
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        JOB job;
+
+        job.m_fileName       = aFileName.Clone();   // deep copy, for the worker thread
+        job.m_backupFileName = aBackupFileName.Clone();
+        job.m_format         = aFormat;
+
+        m_jobs.push_back( job );
+    }
+
+    if( !m_thread.joinable() )
+        m_thread = std::thread( &BACKGROUND_SAVER::worker, this );
+
+    m_changed.notify_all();
+}
+
+
+void BACKGROUND_SAVER::Wait()
+{
+    {
+        std::unique_lock<std::mutex> lock( m_lock );
+
+        m_changed.wait( lock, [this]() { return m_jobs.empty() && !m_running; } );
+    }
+
+    ProcessPendingEvents();
+}
+
+
+void BACKGROUND_SAVER::worker()
+{
+    std::unique_lock<std::mutex> lock( m_lock );
+
+    while( true )
+    {
+        m_changed.wait( lock, [this]() { return m_quit || !m_jobs.empty(); } );
+
+        if( m_jobs.empty() )        // m_quit, and nothing left to write
+            return;
+
+        JOB job = m_jobs.front();
+
+        m_jobs.pop_front();
+        m_running = true;
+
+        lock.unlock();
+        run( job );
+        lock.lock();
+
+        m_running = false;
+        m_changed.notify_all();
+    }
+}
+
+
+void BACKGROUND_SAVER::run( const JOB& aJob )
+{
+    wxString tempFileName = aJob.m_fileName + wxT( ".saving" );
+    wxString error;
+    wxString warning;
+    bool     written = false;
+
+    try
+    {
+        FILE_OUTPUTFORMATTER formatter( tempFileName );
+
+        aJob.m_format( &formatter );
+
+        formatter.Finish( true );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        error = ioe.What();
+    }
+    catch( const std::exception& e )
+    {
+        error = wxString::FromUTF8( e.what() );
+    }
+
+    if( !error.IsEmpty() )
+    {
+        // Nothing usable was written: the previous file is still in place.
+        if( wxFileName::FileExists( tempFileName ) )
+            wxRemoveFile( tempFileName );
+    }
+    else
+    {
+        bool backedUp = false;
+
+        // Only now that the new file is safely written, move the previous one away.
+        if( !aJob.m_backupFileName.IsEmpty() && wxFileName::FileExists( aJob.m_fileName ) )
+        {
+            if( wxFileName::FileExists( aJob.m_backupFileName ) )
+                wxRemoveFile( aJob.m_backupFileName );
+
+            backedUp = wxRenameFile( aJob.m_fileName, aJob.m_backupFileName );
+
+            if( !backedUp )
+            {
+                warning = wxString::Format( _( "Warning: unable to create backup file '%s'" ),
+                                            GetChars( aJob.m_backupFileName ) );
+            }
+        }
+
+        written = wxRenameFile( tempFileName, aJob.m_fileName, true );
+
+        if( !written )
+        {
+            // Put the previous file back under its name, and keep the new one, which
+            // is the only copy of the data just saved.
+            if( backedUp && !wxFileName::FileExists( aJob.m_fileName ) )
+                wxRenameFile( aJob.m_backupFileName, aJob.m_fileName );
+
+            error = wxString::Format( _( "Cannot rename temporary file '%s' to '%s'.\n"
+                                         "The saved data is kept in the temporary file." ),
+                                      GetChars( tempFileName ), GetChars( aJob.m_fileName ) );
+        }
+    }
+
+    wxThreadEvent* event = new wxThreadEvent( EVT_BACKGROUND_SAVE_DONE );
+
+    event->SetInt( written );
+    event->SetString( aJob.m_fileName );
+    event->SetPayload( error.IsEmpty() ? warning : error );
+
+    wxQueueEvent( this, event );
+}
+
+
+void BACKGROUND_SAVER::onJobDone( wxThreadEvent& aEvent )
+{
+    m_pending--;
+
+    if( m_owner )
+        m_owner->ProcessEvent( aEvent );
+}
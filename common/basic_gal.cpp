@@ -39,7 +39,7 @@
 
 using namespace KIGFX;
 
-BASIC_GAL basic_gal;
+thread_local BASIC_GAL basic_gal;
 
 const VECTOR2D BASIC_GAL::transform( const VECTOR2D& aPoint ) const
 {
@@ -39,6 +39,7 @@
 #include <wx/config.h>
 #include <wx/utils.h>
 #include <wx/stdpaths.h>
+#include <wx/thread.h>
 
 #include <pgm_base.h>
 
@@ -68,6 +69,23 @@ std::atomic<unsigned int> LOCALE_IO::m_c_count(0);
 
 LOCALE_IO::LOCALE_IO()
 {
+    // setlocale() acts on the whole process, so a secondary thread only switches
+    // its own locale.  This needs no counting, the locales are restored in order.
+    m_thread = !wxThread::IsMain();
+
+    if( m_thread )
+    {
+#ifdef _WIN32
+        m_thread_config = _configthreadlocale( _ENABLE_PER_THREAD_LOCALE );
+        m_user_locale = setlocale( LC_ALL, 0 );
+        setlocale( LC_ALL, "C" );
+#else
+        m_c_locale    = newlocale( LC_ALL_MASK, "C", (locale_t) 0 );
+        m_prev_locale = uselocale( m_c_locale );
+#endif
+        return;
+    }
+
     // use thread safe, atomic operation
     if( m_c_count++ == 0 )
     {
@@ -80,6 +98,18 @@ LOCALE_IO::LOCALE_IO()
 
 LOCALE_IO::~LOCALE_IO()
 {
+    if( m_thread )
+    {
+#ifdef _WIN32
+        setlocale( LC_ALL, m_user_locale.c_str() );
+        _configthreadlocale( m_thread_config );
+#else
+        uselocale( m_prev_locale );
+        freelocale( m_c_locale );
+#endif
+        return;
+    }
+
     // use thread safe, atomic operation
     if( --m_c_count == 0 )
     {
@@ -263,15 +293,18 @@ int ProcessExecute( const wxString& aCommandLine, int aFlags, wxProcess *callbac
 
 time_t GetNewTimeStamp()
 {
-    static time_t oldTimeStamp;
+    // Atomic, since e.g. the schematic sheet reader threads call this concurrently.
+    static std::atomic<time_t> oldTimeStamp( 0 );
     time_t newTimeStamp;
+    time_t old = oldTimeStamp.load();
 
-    newTimeStamp = time( NULL );
-
-    if( newTimeStamp <= oldTimeStamp )
-        newTimeStamp = oldTimeStamp + 1;
+    do
+    {
+        newTimeStamp = time( NULL );
 
-    oldTimeStamp = newTimeStamp;
+        if( newTimeStamp <= old )
+            newTimeStamp = old + 1;
+    } while( !oldTimeStamp.compare_exchange_weak( old, newTimeStamp ) );
 
     return newTimeStamp;
 }
@@ -61,6 +61,7 @@ GERBER_PLOTTER::GERBER_PLOTTER()
     m_gerberUnitFmt = 6;
     m_useX2Attributes = false;
     m_useNetAttributes = true;
+    m_useApertureMacros = false;
 }
 
 
@@ -281,31 +282,67 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int width, void* aData )
 }
 
 
+/**
+ * Function hashAperture
+ * @return a hash of the parameters identifying an aperture
+ */
+static size_t hashAperture( const wxSize& aSize, APERTURE::APERTURE_TYPE aType,
+                            int aApertureAttribute, const std::vector<wxPoint>* aCorners )
+{
+    size_t hash = aType;
+
+    auto combine = [&hash]( int aValue )
+    {
+        hash ^= std::hash<int>()( aValue ) + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+    };
+
+    combine( aSize.x );
+    combine( aSize.y );
+    combine( aApertureAttribute );
+
+    if( aCorners )
+    {
+        for( const wxPoint& corner : *aCorners )
+        {
+            combine( corner.x );
+            combine( corner.y );
+        }
+    }
+
+    return hash;
+}
+
+
 std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize,
-                        APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
+                        APERTURE::APERTURE_TYPE aType, int aApertureAttribute,
+                        const std::vector<wxPoint>* aCorners )
 {
-    int last_D_code = 9;
+    size_t hash = hashAperture( aSize, aType, aApertureAttribute, aCorners );
 
     // Search an existing aperture
-    std::vector<APERTURE>::iterator tool = apertures.begin();
+    auto candidates = m_apertureIndex.equal_range( hash );
 
-    while( tool != apertures.end() )
+    for( auto it = candidates.first; it != candidates.second; ++it )
     {
-        last_D_code = tool->m_DCode;
+        std::vector<APERTURE>::iterator tool = apertures.begin() + it->second;
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) && (tool->m_ApertureAttribute == aApertureAttribute) )
+        if( (tool->m_Type == aType) && (tool->m_Size == aSize)
+            && (tool->m_ApertureAttribute == aApertureAttribute)
+            && ( !aCorners || tool->m_Corners == *aCorners ) )
             return tool;
-
-        ++tool;
     }
 
     // Allocate a new aperture
     APERTURE new_tool;
     new_tool.m_Size  = aSize;
     new_tool.m_Type  = aType;
-    new_tool.m_DCode = last_D_code + 1;
+    new_tool.m_DCode = FIRST_DCODE_VALUE + apertures.size();
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
+    if( aCorners )
+        new_tool.m_Corners = *aCorners;
+
+    m_apertureIndex.insert( std::make_pair( hash, (int) apertures.size() ) );
     apertures.push_back( new_tool );
 
     return apertures.end() - 1;
@@ -314,11 +351,13 @@ std::vector<APERTURE>::iterator GERBER_PLOTTER::getAperture( const wxSize& aSize
 
 void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
                                      APERTURE::APERTURE_TYPE aType,
-                                     int aApertureAttribute )
+                                     int aApertureAttribute,
+                                     const std::vector<wxPoint>* aCorners )
 {
     bool change = ( currentAperture == apertures.end() ) ||
                   ( currentAperture->m_Type != aType ) ||
-                  ( currentAperture->m_Size != aSize );
+                  ( currentAperture->m_Size != aSize ) ||
+                  ( aCorners && currentAperture->m_Corners != *aCorners );
 
     if( !m_useX2Attributes || !m_useNetAttributes )
         aApertureAttribute = 0;
@@ -328,7 +367,7 @@ void GERBER_PLOTTER::selectAperture( const wxSize&           aSize,
     if( change )
     {
         // Pick an existing aperture or create a new one
-        currentAperture = getAperture( aSize, aType, aApertureAttribute );
+        currentAperture = getAperture( aSize, aType, aApertureAttribute, aCorners );
         fprintf( outputFile, "D%d*\n", currentAperture->m_DCode );
     }
 }
@@ -356,6 +395,25 @@ void GERBER_PLOTTER::writeApertureList()
             fputs( GBR_APERTURE_METADATA::FormatAttribute(
                     (GBR_APERTURE_METADATA::GBR_APERTURE_ATTRIB) attribute ).c_str(), outputFile );
 
+        if( tool->m_Type == APERTURE::Outline )
+        {
+            // Outline primitive: exposure on, vertex count (the closing
+            // vertex excluded), vertices, rotation
+            double devUnit = pow( 10.0, m_gerberUnitFmt );
+            DPOINT origin = userToDeviceCoordinates( wxPoint( 0, 0 ) );
+
+            fprintf( outputFile, "%%AMOUTLINE%d*\n4,1,%d,\n",
+                     tool->m_DCode, (int) tool->m_Corners.size() - 1 );
+
+            for( const wxPoint& corner : tool->m_Corners )
+            {
+                DPOINT pos = userToDeviceCoordinates( corner ) - origin;
+                fprintf( outputFile, "%#f,%#f,\n", pos.x / devUnit, pos.y / devUnit );
+            }
+
+            fputs( "0*%\n", outputFile );
+        }
+
         char* text = cbuf + sprintf( cbuf, "%%ADD%d", tool->m_DCode );
 
         /* Please note: the Gerber specs for mass parameters say that
@@ -386,6 +444,10 @@ void GERBER_PLOTTER::writeApertureList()
 	            tool->m_Size.x * fscale,
 		    tool->m_Size.y * fscale );
             break;
+
+        case APERTURE::Outline:
+            sprintf( text, "OUTLINE%d*%%\n", tool->m_DCode );
+            break;
         }
 
         fputs( cbuf, outputFile );
@@ -769,9 +831,10 @@ void GERBER_PLOTTER::FlashPadRect( const wxPoint& pos, const wxSize& aSize,
         }
         break;
 
-    default: // plot pad shape as polygon
+    default: // any other rotation
 	{
-	    // XXX to do: use an aperture macro to declare the rotated pad
+	    // Rotated pads are flashed by FlashPadTrapez(), with an outline aperture
+	    // macro when they are allowed, as a polygon otherwise
 	    wxPoint coord[4];
 	    // coord[0] is assumed the lower left
 	    // coord[1] is assumed the upper left
@@ -799,10 +862,25 @@ void GERBER_PLOTTER::FlashPadRoundRect( const wxPoint& aPadPos, const wxSize& aS
                                      EDA_DRAW_MODE_T aTraceMode, void* aData )
 
 {
-    // Currently, a Pad RoundRect is plotted as polygon.
-    // TODO: use Aperture macro and flash it
+    // A Pad RoundRect is plotted as polygon, unless aperture macros are allowed
     SHAPE_POLY_SET outline;
     const int segmentToCircleCount = 64;
+
+    if( m_useApertureMacros && aTraceMode == FILLED )
+    {
+        TransformRoundRectToPolygon( outline, wxPoint( 0, 0 ), aSize, aOrient,
+                                     aCornerRadius, segmentToCircleCount );
+
+        std::vector< wxPoint > corners;
+        SHAPE_LINE_CHAIN& poly = outline.Outline( 0 );
+
+        for( int ii = 0; ii < poly.PointCount(); ++ii )
+            corners.push_back( wxPoint( poly.Point( ii ).x, poly.Point( ii ).y ) );
+
+        flashOutline( aPadPos, corners, aData );
+        return;
+    }
+
     TransformRoundRectToPolygon( outline, aPadPos, aSize, aOrient,
                                  aCornerRadius, segmentToCircleCount );
 
@@ -831,7 +909,7 @@ void GERBER_PLOTTER::FlashPadRoundRect( const wxPoint& aPadPos, const wxSize& aS
     PlotPoly( cornerList, ( aTraceMode == FILLED ) ? FILLED_SHAPE : NO_FILL, USE_DEFAULT_LINE_WIDTH, &gbr_metadata );
 
     // Now, flash a pad anchor, if a netlist attribute is set
-    // (remove me when a Aperture macro will be used)
+    // (a polygon cannot hold the attribute, an aperture macro does)
     if( aData && aTraceMode == FILLED )
     {
         int diameter = std::min( aSize.x, aSize.y );
@@ -884,8 +962,7 @@ void GERBER_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos,  const wxPoint* aCo
                                      double aPadOrient, EDA_DRAW_MODE_T aTrace_Mode, void* aData )
 
 {
-    // Currently, a Pad Trapezoid is plotted as polygon.
-    // TODO: use Aperture macro and flash it
+    // A Pad Trapezoid is plotted as polygon, unless aperture macros are allowed
 
     // polygon corners list
     std::vector< wxPoint > cornerList;
@@ -893,8 +970,17 @@ void GERBER_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos,  const wxPoint* aCo
     for( int ii = 0; ii < 4; ii++ )
         cornerList.push_back( aCorners[ii] );
 
+    if( m_useApertureMacros && aTrace_Mode == FILLED )
+    {
+        for( wxPoint& corner : cornerList )
+            RotatePoint( &corner, aPadOrient );
+
+        flashOutline( aPadPos, cornerList, aData );
+        return;
+    }
+
     // Now, flash a pad anchor, if a netlist attribute is set
-    // (remove me when a Aperture macro will be used)
+    // (a polygon cannot hold the attribute, an aperture macro does)
     if( aData && (aTrace_Mode==FILLED) )
     {
         // Calculate the radius of the circle inside the shape
@@ -938,6 +1024,31 @@ void GERBER_PLOTTER::FlashPadTrapez( const wxPoint& aPadPos,  const wxPoint* aCo
 }
 
 
+void GERBER_PLOTTER::flashOutline( const wxPoint& aPos, std::vector<wxPoint>& aCorners,
+                                   void* aData )
+{
+    if( aCorners.front() != aCorners.back() )
+        aCorners.push_back( aCorners.front() );
+
+    // The bounding box size is kept for information: the corners identify the aperture
+    EDA_RECT bbox( aCorners[0], wxSize( 0, 0 ) );
+
+    for( const wxPoint& corner : aCorners )
+        bbox.Merge( corner );
+
+    GBR_METADATA* gbr_metadata = static_cast<GBR_METADATA*>( aData );
+    DPOINT pos_dev = userToDeviceCoordinates( aPos );
+    int aperture_attrib = gbr_metadata ? gbr_metadata->GetApertureAttrib() : 0;
+
+    selectAperture( bbox.GetSize(), APERTURE::Outline, aperture_attrib, &aCorners );
+
+    if( gbr_metadata )
+        formatNetAttribute( &gbr_metadata->m_NetlistMetadata );
+
+    emitDcode( pos_dev, 3 );
+}
+
+
 void GERBER_PLOTTER::Text( const wxPoint& aPos, enum EDA_COLOR_T aColor,
                            const wxString& aText, double aOrient, const wxSize& aSize,
                            enum EDA_TEXT_HJUSTIFY_T aH_justify, enum EDA_TEXT_VJUSTIFY_T aV_justify,
@@ -37,7 +37,46 @@
 #include <macros.h>
 #include <kicad_string.h>
 #include <wx/zstream.h>
-#include <wx/mstream.h>
+
+#include <stdarg.h>
+
+
+/// Size of the page stream content compressed at once
+static const size_t STREAM_BUFFER_SIZE = 64 * 1024;
+
+
+/**
+ * Class PDF_FILE_OUTPUT_STREAM
+ * writes the compressed page streams directly to the PDF file, or to a string
+ * for pages plotted in memory.
+ */
+class PDF_FILE_OUTPUT_STREAM : public wxOutputStream
+{
+public:
+    PDF_FILE_OUTPUT_STREAM( FILE* aFile ) : m_file( aFile ), m_string( NULL ) {}
+    PDF_FILE_OUTPUT_STREAM( std::string* aString ) : m_file( NULL ), m_string( aString ) {}
+
+protected:
+    size_t OnSysWrite( const void* aBuffer, size_t aSize ) override
+    {
+        if( m_string )
+        {
+            m_string->append( static_cast<const char*>( aBuffer ), aSize );
+            return aSize;
+        }
+
+        size_t written = fwrite( aBuffer, 1, aSize, m_file );
+
+        if( written != aSize )
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+
+        return written;
+    }
+
+private:
+    FILE*        m_file;
+    std::string* m_string;
+};
 
 
 /*
@@ -58,19 +97,20 @@ bool PDF_PLOTTER::OpenFile( const wxString& aFullFilename )
     if( outputFile == NULL )
         return false ;
 
+    writeError = false;
     return true;
 }
 
 void PDF_PLOTTER::SetPageSettings( const PAGE_INFO& aPageSettings )
 {
-    wxASSERT( !workFile );
+    wxASSERT( !zStream );
     pageInfo = aPageSettings;
 }
 
 void PDF_PLOTTER::SetViewport( const wxPoint& aOffset, double aIusPerDecimil,
                               double aScale, bool aMirror )
 {
-    wxASSERT( !workFile );
+    wxASSERT( !zStream );
     m_plotMirror = aMirror;
     plotOffset = aOffset;
     plotScale = aScale;
@@ -96,7 +136,7 @@ void PDF_PLOTTER::SetViewport( const wxPoint& aOffset, double aIusPerDecimil,
  */
 void PDF_PLOTTER::SetCurrentLineWidth( int width, void* aData )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     int pen_width;
 
     if( width > 0 )
@@ -107,7 +147,7 @@ void PDF_PLOTTER::SetCurrentLineWidth( int width, void* aData )
         pen_width = defaultPenWidth;
 
     if( pen_width != currentPenWidth )
-        fprintf( workFile, "%g w\n",
+        streamPrintf( "%g w\n",
                  userToDeviceSize( pen_width ) );
 
     currentPenWidth = pen_width;
@@ -125,8 +165,8 @@ void PDF_PLOTTER::SetCurrentLineWidth( int width, void* aData )
  */
 void PDF_PLOTTER::emitSetRGBColor( double r, double g, double b )
 {
-    wxASSERT( workFile );
-    fprintf( workFile, "%g %g %g rg %g %g %g RG\n",
+    wxASSERT( zStream );
+    streamPrintf( "%g %g %g rg %g %g %g RG\n",
              r, g, b, r, g, b );
 }
 
@@ -135,12 +175,12 @@ void PDF_PLOTTER::emitSetRGBColor( double r, double g, double b )
  */
 void PDF_PLOTTER::SetDash( bool dashed )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     if( dashed )
-        fprintf( workFile, "[%d %d] 0 d\n",
+        streamPrintf( "[%d %d] 0 d\n",
                  (int) GetDashMarkLenIU(), (int) GetDashGapLenIU() );
     else
-        fputs( "[] 0 d\n", workFile );
+        streamPrintf( "[] 0 d\n" );
 }
 
 
@@ -149,12 +189,12 @@ void PDF_PLOTTER::SetDash( bool dashed )
  */
 void PDF_PLOTTER::Rect( const wxPoint& p1, const wxPoint& p2, FILL_T fill, int width )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     DPOINT p1_dev = userToDeviceCoordinates( p1 );
     DPOINT p2_dev = userToDeviceCoordinates( p2 );
 
     SetCurrentLineWidth( width );
-    fprintf( workFile, "%g %g %g %g re %c\n", p1_dev.x, p1_dev.y,
+    streamPrintf( "%g %g %g %g re %c\n", p1_dev.x, p1_dev.y,
              p2_dev.x - p1_dev.x, p2_dev.y - p1_dev.y,
              fill == NO_FILL ? 'S' : 'B' );
 }
@@ -165,7 +205,7 @@ void PDF_PLOTTER::Rect( const wxPoint& p1, const wxPoint& p2, FILL_T fill, int w
  */
 void PDF_PLOTTER::Circle( const wxPoint& pos, int diametre, FILL_T aFill, int width )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     DPOINT pos_dev = userToDeviceCoordinates( pos );
     double radius = userToDeviceSize( diametre / 2.0 );
 
@@ -179,11 +219,11 @@ void PDF_PLOTTER::Circle( const wxPoint& pos, int diametre, FILL_T aFill, int wi
     double magic = radius * 0.551784; // You don't want to know where this come from
 
     // This is the convex hull for the bezier approximated circle
-    fprintf( workFile, "%g %g m "
-                       "%g %g %g %g %g %g c "
-                       "%g %g %g %g %g %g c "
-                       "%g %g %g %g %g %g c "
-                       "%g %g %g %g %g %g c %c\n",
+    streamPrintf( "%g %g m "
+                  "%g %g %g %g %g %g c "
+                  "%g %g %g %g %g %g c "
+                  "%g %g %g %g %g %g c "
+                  "%g %g %g %g %g %g c %c\n",
              pos_dev.x - radius, pos_dev.y,
 
              pos_dev.x - radius, pos_dev.y + magic,
@@ -213,7 +253,7 @@ void PDF_PLOTTER::Circle( const wxPoint& pos, int diametre, FILL_T aFill, int wi
 void PDF_PLOTTER::Arc( const wxPoint& centre, double StAngle, double EndAngle, int radius,
                       FILL_T fill, int width )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     if( radius <= 0 )
         return;
 
@@ -231,30 +271,30 @@ void PDF_PLOTTER::Arc( const wxPoint& centre, double StAngle, double EndAngle, i
     start.x = centre.x + KiROUND( cosdecideg( radius, -StAngle ) );
     start.y = centre.y + KiROUND( sindecideg( radius, -StAngle ) );
     DPOINT pos_dev = userToDeviceCoordinates( start );
-    fprintf( workFile, "%g %g m ", pos_dev.x, pos_dev.y );
+    streamPrintf( "%g %g m ", pos_dev.x, pos_dev.y );
     for( int ii = StAngle + delta; ii < EndAngle; ii += delta )
     {
         end.x = centre.x + KiROUND( cosdecideg( radius, -ii ) );
         end.y = centre.y + KiROUND( sindecideg( radius, -ii ) );
         pos_dev = userToDeviceCoordinates( end );
-        fprintf( workFile, "%g %g l ", pos_dev.x, pos_dev.y );
+        streamPrintf( "%g %g l ", pos_dev.x, pos_dev.y );
     }
 
     end.x = centre.x + KiROUND( cosdecideg( radius, -EndAngle ) );
     end.y = centre.y + KiROUND( sindecideg( radius, -EndAngle ) );
     pos_dev = userToDeviceCoordinates( end );
-    fprintf( workFile, "%g %g l ", pos_dev.x, pos_dev.y );
+    streamPrintf( "%g %g l ", pos_dev.x, pos_dev.y );
 
     // The arc is drawn... if not filled we stroke it, otherwise we finish
     // closing the pie at the center
     if( fill == NO_FILL )
     {
-        fputs( "S\n", workFile );
+        streamPrintf( "S\n" );
     }
     else
     {
         pos_dev = userToDeviceCoordinates( centre );
-        fprintf( workFile, "%g %g l b\n", pos_dev.x, pos_dev.y );
+        streamPrintf( "%g %g l b\n", pos_dev.x, pos_dev.y );
     }
 }
 
@@ -265,34 +305,34 @@ void PDF_PLOTTER::Arc( const wxPoint& centre, double StAngle, double EndAngle, i
 void PDF_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
                            FILL_T aFill, int aWidth, void * aData )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     if( aCornerList.size() <= 1 )
         return;
 
     SetCurrentLineWidth( aWidth );
 
     DPOINT pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( workFile, "%g %g m\n", pos.x, pos.y );
+    streamPrintf( "%g %g m\n", pos.x, pos.y );
 
     for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( workFile, "%g %g l\n", pos.x, pos.y );
+        streamPrintf( "%g %g l\n", pos.x, pos.y );
     }
 
     // Close path and stroke(/fill)
-    fprintf( workFile, "%c\n", aFill == NO_FILL ? 'S' : 'b' );
+    streamPrintf( "%c\n", aFill == NO_FILL ? 'S' : 'b' );
 }
 
 
 void PDF_PLOTTER::PenTo( const wxPoint& pos, char plume )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     if( plume == 'Z' )
     {
         if( penState != 'Z' )
         {
-            fputs( "S\n", workFile );
+            streamPrintf( "S\n" );
             penState     = 'Z';
             penLastpos.x = -1;
             penLastpos.y = -1;
@@ -303,7 +343,7 @@ void PDF_PLOTTER::PenTo( const wxPoint& pos, char plume )
     if( penState != plume || pos != penLastpos )
     {
         DPOINT pos_dev = userToDeviceCoordinates( pos );
-        fprintf( workFile, "%g %g %c\n",
+        streamPrintf( "%g %g %c\n",
                  pos_dev.x, pos_dev.y,
                  ( plume=='D' ) ? 'l' : 'm' );
     }
@@ -317,7 +357,7 @@ void PDF_PLOTTER::PenTo( const wxPoint& pos, char plume )
 void PDF_PLOTTER::PlotImage( const wxImage & aImage, const wxPoint& aPos,
                             double aScaleFactor )
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
     wxSize pix_size( aImage.GetWidth(), aImage.GetHeight() );
 
     // Requested size (in IUs)
@@ -340,7 +380,7 @@ void PDF_PLOTTER::PlotImage( const wxImage & aImage, const wxPoint& aPos,
        3) restore the CTM
        4) profit
      */
-    fprintf( workFile, "q %g 0 0 %g %g %g cm\n", // Step 1
+    streamPrintf( "q %g 0 0 %g %g %g cm\n", // Step 1
             userToDeviceSize( drawsize.x ),
             userToDeviceSize( drawsize.y ),
             dev_start.x, dev_start.y );
@@ -349,39 +389,45 @@ void PDF_PLOTTER::PlotImage( const wxImage & aImage, const wxPoint& aPos,
        A real ugly construct (compared with the elegance of the PDF
        format). Also it accepts some 'abbreviations', which is stupid
        since the content stream is usually compressed anyway... */
-    fprintf( workFile,
-             "BI\n"
-             "  /BPC 8\n"
-             "  /CS %s\n"
-             "  /W %d\n"
-             "  /H %d\n"
-             "ID\n", colorMode ? "/RGB" : "/G", pix_size.x, pix_size.y );
+    streamPrintf( "BI\n"
+                  "  /BPC 8\n"
+                  "  /CS %s\n"
+                  "  /W %d\n"
+                  "  /H %d\n"
+                  "ID\n", colorMode ? "/RGB" : "/G", pix_size.x, pix_size.y );
 
     /* Here comes the stream (in binary!). I *could* have hex or ascii84
        encoded it, but who cares? I'll go through zlib anyway */
+    std::vector<char> row;
+    row.reserve( pix_size.x * 3 );
+
     for( int y = 0; y < pix_size.y; y++ )
     {
+        row.clear();
+
         for( int x = 0; x < pix_size.x; x++ )
         {
             unsigned char r = aImage.GetRed( x, y ) & 0xFF;
             unsigned char g = aImage.GetGreen( x, y ) & 0xFF;
             unsigned char b = aImage.GetBlue( x, y ) & 0xFF;
-            // As usual these days, stdio buffering has to suffeeeeerrrr
+
             if( colorMode )
             {
-            putc( r, workFile );
-            putc( g, workFile );
-            putc( b, workFile );
+                row.push_back( r );
+                row.push_back( g );
+                row.push_back( b );
             }
             else
             {
                 // Grayscale conversion
-                putc( (r + g + b) / 3, workFile );
+                row.push_back( (r + g + b) / 3 );
             }
         }
+
+        streamWrite( row.data(), row.size() );
     }
 
-    fputs( "EI Q\n", workFile ); // Finish step 2 and do step 3
+    streamPrintf( "EI Q\n" ); // Finish step 2 and do step 3
 }
 
 
@@ -404,7 +450,7 @@ int PDF_PLOTTER::allocPdfObject()
 int PDF_PLOTTER::startPdfObject(int handle)
 {
     wxASSERT( outputFile );
-    wxASSERT( !workFile );
+    wxASSERT( !zStream );
     if( handle < 0)
         handle = allocPdfObject();
 
@@ -420,7 +466,7 @@ int PDF_PLOTTER::startPdfObject(int handle)
 void PDF_PLOTTER::closePdfObject()
 {
     wxASSERT( outputFile );
-    wxASSERT( !workFile );
+    wxASSERT( !zStream );
     fputs( "endobj\n", outputFile );
 }
 
@@ -434,7 +480,7 @@ void PDF_PLOTTER::closePdfObject()
 int PDF_PLOTTER::startPdfStream(int handle)
 {
     wxASSERT( outputFile );
-    wxASSERT( !workFile );
+    wxASSERT( !zStream );
     handle = startPdfObject( handle );
 
     // This is guaranteed to be handle+1 but needs to be allocated since
@@ -444,10 +490,16 @@ int PDF_PLOTTER::startPdfStream(int handle)
              "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
              "stream\n", handle + 1 );
 
-    // Open a temporary file to accumulate the stream
-    workFilename = filename + wxT(".tmp");
-    workFile = wxFopen( workFilename, wxT( "w+b" ));
-    wxASSERT( workFile );
+    streamStart = ftell( outputFile );
+
+    /* The stream is compressed as it is written. The PDF spec is misleading,
+     * it says it wants a DEFLATE stream but it really want a ZLIB stream!
+     * (a DEFLATE stream would be generated with -15 instead of 15)
+     */
+    zStream = new wxZlibOutputStream( new PDF_FILE_OUTPUT_STREAM( outputFile ),
+                                      compressionLevel, wxZLIB_ZLIB );
+    streamBuffer.reserve( STREAM_BUFFER_SIZE );
+
     return handle;
 }
 
@@ -457,61 +509,81 @@ int PDF_PLOTTER::startPdfStream(int handle)
  */
 void PDF_PLOTTER::closePdfStream()
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
+
+    closeZStream();
+
+    long out_count = ftell( outputFile ) - streamStart;
+
+    fputs( "endstream\n", outputFile );
+    closePdfObject();
+
+    // Writing the deferred length as an indirect object
+    startPdfObject( streamLengthHandle );
+    fprintf( outputFile, "%ld\n", out_count );
+    closePdfObject();
+}
+
+
+void PDF_PLOTTER::streamPrintf( const char* aFormat, ... )
+{
+    char    buf[512];
+    va_list args;
 
-    long stream_len = ftell( workFile );
+    va_start( args, aFormat );
+    int len = vsnprintf( buf, sizeof( buf ), aFormat, args );
+    va_end( args );
 
-    if( stream_len < 0 )
+    if( len < (int) sizeof( buf ) )
     {
-        wxASSERT( false );
-        return;
+        streamWrite( buf, len );
     }
+    else
+    {
+        std::vector<char> bigbuf( len + 1 );
 
-    // Rewind the file, read in the page stream and DEFLATE it
-    fseek( workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
+        va_start( args, aFormat );
+        vsnprintf( bigbuf.data(), bigbuf.size(), aFormat, args );
+        va_end( args );
 
-    int rc = fread( inbuf, 1, stream_len, workFile );
-    wxASSERT( rc == stream_len );
-    (void) rc;
+        streamWrite( bigbuf.data(), len );
+    }
+}
 
-    // We are done with the temporary file, junk it
-    fclose( workFile );
-    workFile = 0;
-    ::wxRemoveFile( workFilename );
 
-    // NULL means memos owns the memory, but provide a hint on optimum size needed.
-    wxMemoryOutputStream    memos( NULL, std::max( 2000l, stream_len ) ) ;
+void PDF_PLOTTER::streamWrite( const void* aData, size_t aSize )
+{
+    wxASSERT( zStream );
 
-    {
-        /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-         * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-         * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-         * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-         *                    8, Z_DEFAULT_STRATEGY );
-         */
+    const char* data = static_cast<const char*>( aData );
 
-        wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+    streamBuffer.insert( streamBuffer.end(), data, data + aSize );
 
-        zos.Write( inbuf, stream_len );
+    if( streamBuffer.size() >= STREAM_BUFFER_SIZE )
+        flushStreamBuffer();
+}
 
-        delete[] inbuf;
 
-    }   // flush the zip stream using zos destructor
+void PDF_PLOTTER::flushStreamBuffer()
+{
+    if( !streamBuffer.empty() )
+        zStream->Write( streamBuffer.data(), streamBuffer.size() );
 
-    wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+    streamBuffer.clear();
+}
 
-    unsigned out_count = sb->Tell();
 
-    fwrite( sb->GetBufferStart(), 1, out_count, outputFile );
+void PDF_PLOTTER::closeZStream()
+{
+    flushStreamBuffer();
 
-    fputs( "endstream\n", outputFile );
-    closePdfObject();
+    // Closing the zip stream flushes it to the file stream, which fails if fwrite() did.
+    // Deleting it deletes the file stream, too
+    if( !zStream->Close() )
+        writeError = true;
 
-    // Writing the deferred length as an indirect object
-    startPdfObject( streamLengthHandle );
-    fprintf( outputFile, "%u\n", out_count );
-    closePdfObject();
+    delete zStream;
+    zStream = NULL;
 }
 
 /**
@@ -520,36 +592,87 @@ void PDF_PLOTTER::closePdfStream()
 void PDF_PLOTTER::StartPage()
 {
     wxASSERT( outputFile );
-    wxASSERT( !workFile );
+    wxASSERT( !zStream );
+
+    // Open the content stream; the page object will go later
+    pageStreamHandle = startPdfStream();
+
+    /* Now, until ClosePage *everything* must be wrote in the page stream,
+       with streamPrintf() or streamWrite() */
+    startPageContent();
+}
 
+
+void PDF_PLOTTER::startPageContent()
+{
     // Compute the paper size in IUs
     paperSize = pageInfo.GetSizeMils();
     paperSize.x *= 10.0 / iuPerDeviceUnit;
     paperSize.y *= 10.0 / iuPerDeviceUnit;
 
-    // Open the content stream; the page object will go later
-    pageStreamHandle = startPdfStream();
-
-    /* Now, until ClosePage *everything* must be wrote in workFile, to be
-       compressed later in closePdfStream */
-
     // Default graphic settings (coordinate system, default color and line style)
-    fprintf( workFile,
-             "%g 0 0 %g 0 0 cm 1 J 1 j 0 0 0 rg 0 0 0 RG %g w\n",
+    streamPrintf( "%g 0 0 %g 0 0 cm 1 J 1 j 0 0 0 rg 0 0 0 RG %g w\n",
              0.0072 * plotScaleAdjX, 0.0072 * plotScaleAdjY,
              userToDeviceSize( defaultPenWidth ) );
 }
 
+
+void PDF_PLOTTER::StartPageContent()
+{
+    wxASSERT( !outputFile );
+    wxASSERT( !zStream );
+
+    pageContent.clear();
+    zStream = new wxZlibOutputStream( new PDF_FILE_OUTPUT_STREAM( &pageContent ),
+                                      compressionLevel, wxZLIB_ZLIB );
+    streamBuffer.reserve( STREAM_BUFFER_SIZE );
+
+    startPageContent();
+}
+
+
+bool PDF_PLOTTER::ClosePageContent()
+{
+    wxASSERT( zStream );
+
+    closeZStream();
+
+    return !writeError;
+}
+
+
+void PDF_PLOTTER::AddPage( const std::string& aContent )
+{
+    wxASSERT( outputFile );
+    wxASSERT( !zStream );
+
+    pageStreamHandle = startPdfObject();
+    fprintf( outputFile,
+             "<< /Length %lu /Filter /FlateDecode >>\n"
+             "stream\n", (unsigned long) aContent.size() );
+    fwrite( aContent.data(), 1, aContent.size(), outputFile );
+    fputs( "endstream\n", outputFile );
+    closePdfObject();
+
+    emitPageObject();
+}
+
 /**
  * Close the current page in the PDF document (and emit its compressed stream)
  */
 void PDF_PLOTTER::ClosePage()
 {
-    wxASSERT( workFile );
+    wxASSERT( zStream );
 
     // Close the page stream (and compress it)
     closePdfStream();
 
+    emitPageObject();
+}
+
+
+void PDF_PLOTTER::emitPageObject()
+{
     // Emit the page object and put it in the page list for later
     pageHandles.push_back( startPdfObject() );
 
@@ -589,6 +712,18 @@ void PDF_PLOTTER::ClosePage()
  * each page parameters can be set
  */
 bool PDF_PLOTTER::StartPlot()
+{
+    StartDocument();
+
+    /* Now, the PDF is read from the end, (more or less)... so we start
+       with the page stream for page 1. Other more important stuff is written
+       at the end */
+    StartPage();
+    return true;
+}
+
+
+bool PDF_PLOTTER::StartDocument()
 {
     wxASSERT( outputFile );
 
@@ -609,10 +744,6 @@ bool PDF_PLOTTER::StartPlot()
        (it *could* be inherited via the Pages tree */
     fontResDictHandle = allocPdfObject();
 
-    /* Now, the PDF is read from the end, (more or less)... so we start
-       with the page stream for page 1. Other more important stuff is written
-       at the end */
-    StartPage();
     return true;
 }
 
@@ -621,8 +752,9 @@ bool PDF_PLOTTER::EndPlot()
 {
     wxASSERT( outputFile );
 
-    // Close the current page (often the only one)
-    ClosePage();
+    // Close the current page (often the only one), unless pages were added by AddPage()
+    if( zStream )
+        ClosePage();
 
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
@@ -740,10 +872,16 @@ bool PDF_PLOTTER::EndPlot()
              "%%%%EOF\n",
              (unsigned long) xrefTable.size(), catalogHandle, infoDictHandle, xref_start );
 
-    fclose( outputFile );
+    // The file is written with fprintf() and fwrite(), whose errors are kept by the FILE
+    if( ferror( outputFile ) )
+        writeError = true;
+
+    if( fclose( outputFile ) != 0 )
+        writeError = true;
+
     outputFile = NULL;
 
-    return true;
+    return !writeError;
 }
 
 void PDF_PLOTTER::Text( const wxPoint&              aPos,
@@ -789,15 +927,16 @@ void PDF_PLOTTER::Text( const wxPoint&              aPos,
            for the trig part of the matrix to avoid %g going in exponential
            format (which is not supported)
            Rendermode 0 shows the text, rendermode 3 is invisible */
-        fprintf( workFile, "q %f %f %f %f %g %g cm BT %s %g Tf %d Tr %g Tz ",
+        streamPrintf( "q %f %f %f %f %g %g cm BT %s %g Tf %d Tr %g Tz ",
                 ctm_a, ctm_b, ctm_c, ctm_d, ctm_e, ctm_f,
                 fontname, heightFactor,
                 (m_textMode == PLOTTEXTMODE_NATIVE) ? 0 : 3,
                 wideningFactor * 100 );
 
         // The text must be escaped correctly
-        fputsPostscriptString( workFile, aText );
-        fputs( " Tj ET\n", workFile );
+        std::string encoded = encodePostscriptString( aText );
+        streamWrite( encoded.data(), encoded.size() );
+        streamPrintf( " Tj ET\n" );
 
         /* We are still in text coordinates, plot the overbars (if we're
          * not doing phantom text) */
@@ -814,13 +953,13 @@ void PDF_PLOTTER::Text( const wxPoint&              aPos,
                    is the right function to use here... */
                 DPOINT dev_from = userToDeviceSize( wxSize( pos_pairs[i], overbar_y ) );
                 DPOINT dev_to = userToDeviceSize( wxSize( pos_pairs[i + 1], overbar_y ) );
-                fprintf( workFile, "%g %g m %g %g l ",
+                streamPrintf( "%g %g m %g %g l ",
                         dev_from.x, dev_from.y, dev_to.x, dev_to.y );
             }
         }
 
         // Stroke and restore the CTM
-        fputs( "S Q\n", workFile );
+        streamPrintf( "S Q\n" );
     }
 
     // Plot the stroked text (if requested)
@@ -37,6 +37,7 @@
 #include "worksheet_shape_builder.h"
 #include "class_worksheet_dataitem.h"
 #include <wx/filename.h>
+#include <mutex>
 
 
 
@@ -95,8 +96,16 @@ void PlotWorkSheet( PLOTTER* plotter, const TITLE_BLOCK& aTitleBlock,
     drawList.SetSheetName( aSheetDesc );
 
 
-    drawList.BuildWorkSheetGraphicList( aPageInfo,
-                            aTitleBlock, plotColor, plotColor );
+    {
+        // The page layout items are shared, and updated while building the list:
+        // sheets or layers plotted by several threads build their lists one at a time.
+        // The list is then plotted without the lock
+        static std::mutex buildLock;
+        std::lock_guard<std::mutex> lock( buildLock );
+
+        drawList.BuildWorkSheetGraphicList( aPageInfo,
+                                aTitleBlock, plotColor, plotColor );
+    }
 
     // Draw item list
     for( WS_DRAW_ITEM_BASE* item = drawList.GetFirst(); item;
@@ -58,6 +58,7 @@ EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     m_painter    = NULL;
     m_eventDispatcher = NULL;
     m_lostFocus  = false;
+    m_frameTime  = 0.0;
 
     SetLayoutDirection( wxLayout_LeftToRight );
 
@@ -160,10 +161,8 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
     if( m_drawing )
         return;
 
-#ifdef PROFILE
     prof_counter totalRealTime;
     prof_start( &totalRealTime );
-#endif /* PROFILE */
 
     m_drawing = true;
     KIGFX::PCB_RENDER_SETTINGS* settings = static_cast<KIGFX::PCB_RENDER_SETTINGS*>( m_painter->GetSettings() );
@@ -195,9 +194,23 @@ void EDA_DRAW_PANEL_GAL::onPaint( wxPaintEvent& WXUNUSED( aEvent ) )
     m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
     m_gal->EndDrawing();
 
-#ifdef PROFILE
     prof_end( &totalRealTime );
-    wxLogDebug( wxT( "EDA_DRAW_PANEL_GAL::onPaint(): %.1f ms" ), totalRealTime.msecs() );
+
+    // Average over about the last ten frames, so the level of detail effect is readable
+    if( m_frameTime > 0.0 )
+        m_frameTime = 0.9 * m_frameTime + 0.1 * totalRealTime.msecs();
+    else
+        m_frameTime = totalRealTime.msecs();
+
+    wxLogTrace( "GAL_PROFILE",
+                wxT( "EDA_DRAW_PANEL_GAL::onPaint(): %.1f ms, average %.1f ms, "
+                     "%d items drawn as proxies, %d hidden" ),
+                totalRealTime.msecs(), m_frameTime,
+                m_view->GetProxyItemsCount(), m_view->GetHiddenItemsCount() );
+
+#ifdef PROFILE
+    wxLogDebug( wxT( "EDA_DRAW_PANEL_GAL::onPaint(): %.1f ms, %d items updated" ),
+                totalRealTime.msecs(), m_view->GetUpdatedItemsCount() );
 #endif /* PROFILE */
 
     m_lastRefresh = wxGetLocalTimeMillis();
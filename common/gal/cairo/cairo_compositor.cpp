@@ -145,6 +145,22 @@ void CAIRO_COMPOSITOR::DrawBuffer( unsigned int aBufferHandle )
 }
 
 
+cairo_surface_t* CAIRO_COMPOSITOR::GetBufferSurface( unsigned int aBufferHandle ) const
+{
+    wxASSERT_MSG( aBufferHandle <= usedBuffers(), wxT( "Tried to use a not existing buffer" ) );
+
+    return m_buffers[aBufferHandle - 1].surface;
+}
+
+
+cairo_t* CAIRO_COMPOSITOR::GetBufferContext( unsigned int aBufferHandle ) const
+{
+    wxASSERT_MSG( aBufferHandle <= usedBuffers(), wxT( "Tried to use a not existing buffer" ) );
+
+    return m_buffers[aBufferHandle - 1].context;
+}
+
+
 void CAIRO_COMPOSITOR::clean()
 {
     CAIRO_BUFFERS::const_iterator it;
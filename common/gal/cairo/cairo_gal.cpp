@@ -32,6 +32,8 @@
 #include <gal/definitions.h>
 
 #include <limits>
+#include <cstring>
+#include <thread>
 
 #include <pixman.h>
 
@@ -54,6 +56,9 @@ CAIRO_GAL::CAIRO_GAL( wxWindow* aParent, wxEvtHandler* aMouseListener,
     validCompositor     = false;
     groupCounter        = 0;
 
+    // Rasterize the cached groups on all the processors by default
+    renderingThreads = std::max( 1u, std::min( 8u, std::thread::hardware_concurrency() ) );
+
     // Connecting the event handlers
     Connect( wxEVT_PAINT,       wxPaintEventHandler( CAIRO_GAL::onPaint ) );
 
@@ -302,6 +307,8 @@ void CAIRO_GAL::Flush()
 
 void CAIRO_GAL::ClearScreen( const COLOR4D& aColor )
 {
+    drawQueuedGroups();
+
     backgroundColor = aColor;
     cairo_set_source_rgb( currentContext, aColor.r, aColor.g, aColor.b );
     cairo_rectangle( currentContext, 0.0, 0.0, screenSize.x, screenSize.y );
@@ -542,56 +549,99 @@ void CAIRO_GAL::EndGroup()
 
 
 void CAIRO_GAL::DrawGroup( int aGroupNumber )
+{
+    if( isElementAdded )
+        storePath();
+
+    // Groups drawn on the main buffer are queued, so they can be rasterized in parallel
+    if( renderingThreads > 1 && validCompositor && currentTarget != TARGET_OVERLAY )
+    {
+        cairo_matrix_t matrix;
+        cairo_get_matrix( currentContext, &matrix );
+
+        if( !queuedGroups.empty() && memcmp( &matrix, &queuedMatrix, sizeof( matrix ) ) != 0 )
+            drawQueuedGroups();
+
+        if( queuedGroups.empty() )
+        {
+            queuedMatrix                = matrix;
+            queuedState.isFillEnabled   = isFillEnabled;
+            queuedState.isStrokeEnabled = isStrokeEnabled;
+            queuedState.fillColor       = fillColor;
+            queuedState.strokeColor     = strokeColor;
+            queuedState.lineWidth       = cairo_get_line_width( currentContext );
+        }
+
+        queuedGroups.push_back( aGroupNumber );
+        return;
+    }
+
+    GROUP_STATE state = { isFillEnabled, isStrokeEnabled, fillColor, strokeColor, 0.0 };
+
+    replayGroup( currentContext, aGroupNumber, state );
+
+    isFillEnabled   = state.isFillEnabled;
+    isStrokeEnabled = state.isStrokeEnabled;
+    fillColor       = state.fillColor;
+    strokeColor     = state.strokeColor;
+}
+
+
+void CAIRO_GAL::replayGroup( cairo_t* aContext, int aGroupNumber, GROUP_STATE& aState ) const
 {
     // This method implements a small Virtual Machine - all stored commands
     // are executed; nested calling is also possible
 
-    storePath();
+    auto group = groups.find( aGroupNumber );
 
-    for( GROUP::iterator it = groups[aGroupNumber].begin();
-         it != groups[aGroupNumber].end(); ++it )
+    if( group == groups.end() )
+        return;
+
+    for( GROUP::const_iterator it = group->second.begin(); it != group->second.end(); ++it )
     {
         switch( it->command )
         {
         case CMD_SET_FILL:
-            isFillEnabled = it->argument.boolArg;
+            aState.isFillEnabled = it->argument.boolArg;
             break;
 
         case CMD_SET_STROKE:
-            isStrokeEnabled = it->argument.boolArg;
+            aState.isStrokeEnabled = it->argument.boolArg;
             break;
 
         case CMD_SET_FILLCOLOR:
-            fillColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1], it->argument.dblArg[2],
-                                 it->argument.dblArg[3] );
+            aState.fillColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1],
+                                        it->argument.dblArg[2], it->argument.dblArg[3] );
             break;
 
         case CMD_SET_STROKECOLOR:
-            strokeColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1], it->argument.dblArg[2],
-                                   it->argument.dblArg[3] );
+            aState.strokeColor = COLOR4D( it->argument.dblArg[0], it->argument.dblArg[1],
+                                          it->argument.dblArg[2], it->argument.dblArg[3] );
             break;
 
         case CMD_SET_LINE_WIDTH:
             {
                 // Make lines appear at least 1 pixel wide, no matter of zoom
                 double x = 1.0, y = 1.0;
-                cairo_device_to_user_distance( currentContext, &x, &y );
+                cairo_device_to_user_distance( aContext, &x, &y );
                 double minWidth = std::min( fabs( x ), fabs( y ) );
-                cairo_set_line_width( currentContext, std::max( it->argument.dblArg[0], minWidth ) );
+                cairo_set_line_width( aContext, std::max( it->argument.dblArg[0], minWidth ) );
             }
             break;
 
 
         case CMD_STROKE_PATH:
-            cairo_set_source_rgb( currentContext, strokeColor.r, strokeColor.g, strokeColor.b );
-            cairo_append_path( currentContext, it->cairoPath );
-            cairo_stroke( currentContext );
+            cairo_set_source_rgb( aContext, aState.strokeColor.r, aState.strokeColor.g,
+                                  aState.strokeColor.b );
+            cairo_append_path( aContext, it->cairoPath );
+            cairo_stroke( aContext );
             break;
 
         case CMD_FILL_PATH:
-            cairo_set_source_rgb( currentContext, fillColor.r, fillColor.g, fillColor.b );
-            cairo_append_path( currentContext, it->cairoPath );
-            cairo_fill( currentContext );
+            cairo_set_source_rgb( aContext, aState.fillColor.r, aState.fillColor.g,
+                                  aState.fillColor.b );
+            cairo_append_path( aContext, it->cairoPath );
+            cairo_fill( aContext );
             break;
 
             /*
@@ -599,38 +649,123 @@ void CAIRO_GAL::DrawGroup( int aGroupNumber )
             cairo_matrix_t matrix;
             cairo_matrix_init( &matrix, it->argument.dblArg[0], it->argument.dblArg[1], it->argument.dblArg[2],
                                it->argument.dblArg[3], it->argument.dblArg[4], it->argument.dblArg[5] );
-            cairo_transform( currentContext, &matrix );
+            cairo_transform( aContext, &matrix );
             break;
             */
 
         case CMD_ROTATE:
-            cairo_rotate( currentContext, it->argument.dblArg[0] );
+            cairo_rotate( aContext, it->argument.dblArg[0] );
             break;
 
         case CMD_TRANSLATE:
-            cairo_translate( currentContext, it->argument.dblArg[0], it->argument.dblArg[1] );
+            cairo_translate( aContext, it->argument.dblArg[0], it->argument.dblArg[1] );
             break;
 
         case CMD_SCALE:
-            cairo_scale( currentContext, it->argument.dblArg[0], it->argument.dblArg[1] );
+            cairo_scale( aContext, it->argument.dblArg[0], it->argument.dblArg[1] );
             break;
 
         case CMD_SAVE:
-            cairo_save( currentContext );
+            cairo_save( aContext );
             break;
 
         case CMD_RESTORE:
-            cairo_restore( currentContext );
+            cairo_restore( aContext );
             break;
 
         case CMD_CALL_GROUP:
-            DrawGroup( it->argument.intArg );
+            replayGroup( aContext, it->argument.intArg, aState );
             break;
         }
     }
 }
 
 
+void CAIRO_GAL::drawQueuedGroups()
+{
+    if( queuedGroups.empty() )
+        return;
+
+    cairo_surface_t* target = compositor->GetBufferSurface( mainBuffer );
+    unsigned char*   pixels = cairo_image_surface_get_data( target );
+    cairo_format_t   format = cairo_image_surface_get_format( target );
+    int              width  = cairo_image_surface_get_width( target );
+    int              height = cairo_image_surface_get_height( target );
+    int              stride = cairo_image_surface_get_stride( target );
+
+    // Bands of rows are contiguous in the buffer, so every thread may wrap its own band
+    // in a surface and draw all the queued groups clipped to it
+    int bandCount  = std::max( 1, std::min<int>( renderingThreads, height ) );
+    int bandHeight = ( height + bandCount - 1 ) / bandCount;
+    std::vector<GROUP_STATE> endStates( bandCount, queuedState );
+
+    auto drawBand = [&]( int aBand )
+    {
+        int top  = aBand * bandHeight;
+        int rows = std::min( bandHeight, height - top );
+
+        if( rows <= 0 )
+            return;
+
+        cairo_surface_t* band = cairo_image_surface_create_for_data( pixels + top * stride,
+                                                                     format, width, rows, stride );
+        cairo_t* bandContext = cairo_create( band );
+
+        cairo_matrix_t matrix = queuedMatrix;
+        matrix.y0 -= top;
+        cairo_set_matrix( bandContext, &matrix );
+
+        // Same settings as the buffer contexts of the compositor
+        cairo_set_antialias( bandContext, CAIRO_ANTIALIAS_NONE );
+        cairo_set_line_join( bandContext, CAIRO_LINE_JOIN_ROUND );
+        cairo_set_line_cap( bandContext, CAIRO_LINE_CAP_ROUND );
+        cairo_set_line_width( bandContext, queuedState.lineWidth );
+
+        GROUP_STATE& state = endStates[aBand];
+
+        for( int group : queuedGroups )
+            replayGroup( bandContext, group, state );
+
+        state.lineWidth = cairo_get_line_width( bandContext );
+
+        cairo_destroy( bandContext );
+        cairo_surface_destroy( band );
+    };
+
+    cairo_surface_flush( target );
+
+    std::vector<std::thread> workers;
+
+    for( int i = 1; i < bandCount; ++i )
+        workers.push_back( std::thread( drawBand, i ) );
+
+    drawBand( 0 );
+
+    for( std::thread& worker : workers )
+        worker.join();
+
+    cairo_surface_mark_dirty( target );
+
+    // Leave the state as if the groups were drawn one after another
+    const GROUP_STATE& state = endStates[0];
+
+    isFillEnabled   = state.isFillEnabled;
+    isStrokeEnabled = state.isStrokeEnabled;
+    fillColor       = state.fillColor;
+    strokeColor     = state.strokeColor;
+    cairo_set_line_width( compositor->GetBufferContext( mainBuffer ), state.lineWidth );
+
+    queuedGroups.clear();
+}
+
+
+void CAIRO_GAL::SetRenderingThreads( unsigned int aCount )
+{
+    drawQueuedGroups();
+    renderingThreads = std::max( 1u, aCount );
+}
+
+
 void CAIRO_GAL::ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColor )
 {
     storePath();
@@ -752,6 +887,8 @@ RENDER_TARGET CAIRO_GAL::GetTarget() const
 
 void CAIRO_GAL::ClearTarget( RENDER_TARGET aTarget )
 {
+    drawQueuedGroups();
+
     // Save the current state
     unsigned int currentBuffer = compositor->GetBuffer();
 
@@ -791,6 +928,8 @@ void CAIRO_GAL::DrawCursor( const VECTOR2D& aCursorPosition )
 
 void CAIRO_GAL::drawGridLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
 {
+    drawQueuedGroups();
+
     cairo_move_to( currentContext, aStartPoint.x, aStartPoint.y );
     cairo_line_to( currentContext, aEndPoint.x, aEndPoint.y );
     cairo_set_source_rgba( currentContext, gridColor.r, gridColor.g, gridColor.b, strokeColor.a );
@@ -800,6 +939,8 @@ void CAIRO_GAL::drawGridLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndP
 
 void CAIRO_GAL::flushPath()
 {
+        drawQueuedGroups();
+
         if( isFillEnabled )
         {
             cairo_set_source_rgba( currentContext,
@@ -822,6 +963,9 @@ void CAIRO_GAL::flushPath()
 
 void CAIRO_GAL::storePath()
 {
+    // Whatever comes next must be drawn over the queued groups
+    drawQueuedGroups();
+
     if( isElementAdded )
     {
         isElementAdded = false;
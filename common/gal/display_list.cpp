@@ -0,0 +1,315 @@
+/*
+ * This program source code file is part of KICAD, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 Kicad Developers, see change_log.txt for contributors.
+ *
+ * Graphics Abstraction Layer (GAL) - recorded drawing commands
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/display_list.h>
+
+using namespace KIGFX;
+
+
+void DISPLAY_LIST::Clear()
+{
+    m_commands.clear();
+    m_values.clear();
+    m_points.clear();
+    m_texts.clear();
+}
+
+
+void DISPLAY_LIST::add( COMMAND_TYPE aType, unsigned aPointCount )
+{
+    COMMAND cmd;
+
+    cmd.m_type   = aType;
+    cmd.m_values = m_values.size();
+    cmd.m_points = m_points.size();
+    cmd.m_count  = aPointCount;
+
+    m_commands.push_back( cmd );
+}
+
+
+void DISPLAY_LIST::Replay( GAL* aGal, size_t aBegin, size_t aEnd ) const
+{
+    for( size_t i = aBegin; i < aEnd; ++i )
+    {
+        const COMMAND&  cmd = m_commands[i];
+        const double*   v = m_values.data() + cmd.m_values;
+        const VECTOR2D* p = m_points.data() + cmd.m_points;
+
+        switch( cmd.m_type )
+        {
+        case CMD_SET_IS_FILL:       aGal->SetIsFill( v[0] != 0.0 );                     break;
+        case CMD_SET_IS_STROKE:     aGal->SetIsStroke( v[0] != 0.0 );                   break;
+        case CMD_SET_FILL_COLOR:    aGal->SetFillColor( COLOR4D( v[0], v[1], v[2], v[3] ) );   break;
+        case CMD_SET_STROKE_COLOR:  aGal->SetStrokeColor( COLOR4D( v[0], v[1], v[2], v[3] ) ); break;
+        case CMD_SET_LINE_WIDTH:    aGal->SetLineWidth( v[0] );                         break;
+        case CMD_SET_LAYER_DEPTH:   aGal->SetLayerDepth( v[0] );                        break;
+        case CMD_LINE:              aGal->DrawLine( p[0], p[1] );                       break;
+        case CMD_SEGMENT:           aGal->DrawSegment( p[0], p[1], v[0] );              break;
+        case CMD_POLYLINE:          aGal->DrawPolyline( p, cmd.m_count );               break;
+        case CMD_CIRCLE:            aGal->DrawCircle( p[0], v[0] );                     break;
+        case CMD_ARC:               aGal->DrawArc( p[0], v[0], v[1], v[2] );            break;
+        case CMD_RECTANGLE:         aGal->DrawRectangle( p[0], p[1] );                  break;
+        case CMD_POLYGON:           aGal->DrawPolygon( p, cmd.m_count );                break;
+        case CMD_CURVE:             aGal->DrawCurve( p[0], p[1], p[2], p[3] );          break;
+
+        case CMD_BITMAP_TEXT:
+            aGal->SetGlyphSize( p[1] );
+            aGal->SetHorizontalJustify( (EDA_TEXT_HJUSTIFY_T) v[1] );
+            aGal->SetVerticalJustify( (EDA_TEXT_VJUSTIFY_T) v[2] );
+            aGal->SetFontBold( v[3] != 0.0 );
+            aGal->SetFontItalic( v[4] != 0.0 );
+            aGal->SetTextMirrored( v[5] != 0.0 );
+            aGal->BitmapText( m_texts[cmd.m_count], p[0], v[0] );
+            break;
+
+        case CMD_TRANSFORM:
+        {
+            MATRIX3x3D matrix;
+
+            for( int j = 0; j < 3; ++j )
+                for( int k = 0; k < 3; ++k )
+                    matrix.m_data[j][k] = v[3 * j + k];
+
+            aGal->Transform( matrix );
+            break;
+        }
+
+        case CMD_ROTATE:            aGal->Rotate( v[0] );                               break;
+        case CMD_TRANSLATE:         aGal->Translate( p[0] );                            break;
+        case CMD_SCALE:             aGal->Scale( p[0] );                                break;
+        case CMD_SAVE:              aGal->Save();                                       break;
+        case CMD_RESTORE:           aGal->Restore();                                    break;
+        }
+    }
+}
+
+
+DISPLAY_LIST_RECORDER::DISPLAY_LIST_RECORDER( DISPLAY_LIST& aList, const GAL& aTarget ) :
+    m_list( aList )
+{
+    worldScale = aTarget.GetWorldScale();
+}
+
+
+void DISPLAY_LIST_RECORDER::addColor( const COLOR4D& aColor )
+{
+    addValue( aColor.r );
+    addValue( aColor.g );
+    addValue( aColor.b );
+    addValue( aColor.a );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+{
+    m_list.add( DISPLAY_LIST::CMD_LINE );
+    addPoint( aStartPoint );
+    addPoint( aEndPoint );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                                         double aWidth )
+{
+    m_list.add( DISPLAY_LIST::CMD_SEGMENT );
+    addPoint( aStartPoint );
+    addPoint( aEndPoint );
+    addValue( aWidth );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawPolyline( const std::deque<VECTOR2D>& aPointList )
+{
+    m_list.add( DISPLAY_LIST::CMD_POLYLINE, aPointList.size() );
+    m_list.m_points.insert( m_list.m_points.end(), aPointList.begin(), aPointList.end() );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawPolyline( const VECTOR2D aPointList[], int aListSize )
+{
+    m_list.add( DISPLAY_LIST::CMD_POLYLINE, aListSize );
+    m_list.m_points.insert( m_list.m_points.end(), aPointList, aPointList + aListSize );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawCircle( const VECTOR2D& aCenterPoint, double aRadius )
+{
+    m_list.add( DISPLAY_LIST::CMD_CIRCLE );
+    addPoint( aCenterPoint );
+    addValue( aRadius );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawArc( const VECTOR2D& aCenterPoint, double aRadius,
+                                     double aStartAngle, double aEndAngle )
+{
+    m_list.add( DISPLAY_LIST::CMD_ARC );
+    addPoint( aCenterPoint );
+    addValue( aRadius );
+    addValue( aStartAngle );
+    addValue( aEndAngle );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawRectangle( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+{
+    m_list.add( DISPLAY_LIST::CMD_RECTANGLE );
+    addPoint( aStartPoint );
+    addPoint( aEndPoint );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawPolygon( const std::deque<VECTOR2D>& aPointList )
+{
+    m_list.add( DISPLAY_LIST::CMD_POLYGON, aPointList.size() );
+    m_list.m_points.insert( m_list.m_points.end(), aPointList.begin(), aPointList.end() );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawPolygon( const VECTOR2D aPointList[], int aListSize )
+{
+    m_list.add( DISPLAY_LIST::CMD_POLYGON, aListSize );
+    m_list.m_points.insert( m_list.m_points.end(), aPointList, aPointList + aListSize );
+}
+
+
+void DISPLAY_LIST_RECORDER::DrawCurve( const VECTOR2D& startPoint, const VECTOR2D& controlPointA,
+                                       const VECTOR2D& controlPointB, const VECTOR2D& endPoint )
+{
+    m_list.add( DISPLAY_LIST::CMD_CURVE );
+    addPoint( startPoint );
+    addPoint( controlPointA );
+    addPoint( controlPointB );
+    addPoint( endPoint );
+}
+
+
+void DISPLAY_LIST_RECORDER::BitmapText( const wxString& aText, const VECTOR2D& aPosition,
+                                        double aRotationAngle )
+{
+    // The text attributes are not virtual, so they are stored along with the text
+    m_list.add( DISPLAY_LIST::CMD_BITMAP_TEXT, m_list.m_texts.size() );
+    m_list.m_texts.push_back( aText );
+    addPoint( aPosition );
+    addPoint( GetGlyphSize() );
+    addValue( aRotationAngle );
+    addValue( GetHorizontalJustify() );
+    addValue( GetVerticalJustify() );
+    addValue( IsFontBold() );
+    addValue( IsFontItalic() );
+    addValue( IsTextMirrored() );
+}
+
+
+void DISPLAY_LIST_RECORDER::SetIsFill( bool aIsFillEnabled )
+{
+    GAL::SetIsFill( aIsFillEnabled );
+    m_list.add( DISPLAY_LIST::CMD_SET_IS_FILL );
+    addValue( aIsFillEnabled );
+}
+
+
+void DISPLAY_LIST_RECORDER::SetIsStroke( bool aIsStrokeEnabled )
+{
+    GAL::SetIsStroke( aIsStrokeEnabled );
+    m_list.add( DISPLAY_LIST::CMD_SET_IS_STROKE );
+    addValue( aIsStrokeEnabled );
+}
+
+
+void DISPLAY_LIST_RECORDER::SetFillColor( const COLOR4D& aColor )
+{
+    GAL::SetFillColor( aColor );
+    m_list.add( DISPLAY_LIST::CMD_SET_FILL_COLOR );
+    addColor( aColor );
+}
+
+
+void DISPLAY_LIST_RECORDER::SetStrokeColor( const COLOR4D& aColor )
+{
+    GAL::SetStrokeColor( aColor );
+    m_list.add( DISPLAY_LIST::CMD_SET_STROKE_COLOR );
+    addColor( aColor );
+}
+
+
+void DISPLAY_LIST_RECORDER::SetLineWidth( double aLineWidth )
+{
+    GAL::SetLineWidth( aLineWidth );
+    m_list.add( DISPLAY_LIST::CMD_SET_LINE_WIDTH );
+    addValue( aLineWidth );
+}
+
+
+void DISPLAY_LIST_RECORDER::SetLayerDepth( double aLayerDepth )
+{
+    GAL::SetLayerDepth( aLayerDepth );
+    m_list.add( DISPLAY_LIST::CMD_SET_LAYER_DEPTH );
+    addValue( aLayerDepth );
+}
+
+
+void DISPLAY_LIST_RECORDER::Transform( const MATRIX3x3D& aTransformation )
+{
+    m_list.add( DISPLAY_LIST::CMD_TRANSFORM );
+
+    for( int j = 0; j < 3; ++j )
+        for( int k = 0; k < 3; ++k )
+            addValue( aTransformation.m_data[j][k] );
+}
+
+
+void DISPLAY_LIST_RECORDER::Rotate( double aAngle )
+{
+    m_list.add( DISPLAY_LIST::CMD_ROTATE );
+    addValue( aAngle );
+}
+
+
+void DISPLAY_LIST_RECORDER::Translate( const VECTOR2D& aTranslation )
+{
+    m_list.add( DISPLAY_LIST::CMD_TRANSLATE );
+    addPoint( aTranslation );
+}
+
+
+void DISPLAY_LIST_RECORDER::Scale( const VECTOR2D& aScale )
+{
+    m_list.add( DISPLAY_LIST::CMD_SCALE );
+    addPoint( aScale );
+}
+
+
+void DISPLAY_LIST_RECORDER::Save()
+{
+    m_list.add( DISPLAY_LIST::CMD_SAVE );
+}
+
+
+void DISPLAY_LIST_RECORDER::Restore()
+{
+    m_list.add( DISPLAY_LIST::CMD_RESTORE );
+}
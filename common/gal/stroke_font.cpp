@@ -30,6 +30,13 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <wx/string.h>
 
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 using namespace KIGFX;
 
 const double STROKE_FONT::INTERLINE_PITCH_RATIO = 1.5;
@@ -46,19 +53,49 @@ STROKE_FONT::STROKE_FONT( GAL* aGal ) :
 
 bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNewStrokeFontSize )
 {
-    m_glyphs.clear();
-    m_glyphBoundingBoxes.clear();
-    m_glyphs.resize( aNewStrokeFontSize );
-    m_glyphBoundingBoxes.resize( aNewStrokeFontSize );
+    // Every GAL loads the same font, so it is decoded only once and then shared.  Each
+    // instance holds its table, so a table replaced here lives on until nobody uses it.
+    typedef std::map< const char* const*, std::shared_ptr<const GLYPH_TABLE> > TABLE_MAP;
+
+    static std::mutex tablesLock;
+    static TABLE_MAP  tables;
+
+    std::lock_guard<std::mutex> lock( tablesLock );
+    std::shared_ptr<const GLYPH_TABLE>& table = tables[aNewStrokeFont];
+
+    if( !table || table->GlyphCount() != aNewStrokeFontSize )
+    {
+        table.reset( decodeNewStrokeFont( aNewStrokeFont, aNewStrokeFontSize ) );
+
+        // The cached lines of text are keyed by table, and the address may be reused.
+        ClearTextCache();
+    }
+
+    m_glyphTable = table;
+
+    return true;
+}
+
+
+STROKE_FONT::GLYPH_TABLE* STROKE_FONT::decodeNewStrokeFont( const char* const aNewStrokeFont[],
+                                                            int aNewStrokeFontSize )
+{
+    GLYPH_TABLE* table = new GLYPH_TABLE;
+
+    table->m_glyphs.reserve( aNewStrokeFontSize + 1 );
+    table->m_boundingBoxes.reserve( aNewStrokeFontSize );
 
     for( int j = 0; j < aNewStrokeFontSize; j++ )
     {
-        GLYPH    glyph;
         double   glyphStartX = 0.0;
         double   glyphEndX = 0.0;
-        VECTOR2D glyphBoundingX;
+        unsigned strokeStart = table->m_points.size();
+
+        table->m_glyphs.push_back( table->m_strokes.size() );
 
-        std::deque<VECTOR2D> pointList;
+        // The bounding box spans the glyph width and the height of all its points
+        double   ymin = 0.0;
+        double   ymax = 0.0;
 
         int i = 0;
 
@@ -77,15 +114,14 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
                 // The first two values contain the width of the char
                 glyphStartX     = ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE;
                 glyphEndX       = ( coordinate[1] - 'R' ) * STROKE_FONT_SCALE;
-                glyphBoundingX  = VECTOR2D( 0, glyphEndX - glyphStartX );
             }
             else if( ( coordinate[0] == ' ' ) && ( coordinate[1] == 'R' ) )
             {
                 // Raise pen
-                if( pointList.size() > 0 )
-                    glyph.push_back( pointList );
+                if( table->m_points.size() > strokeStart )
+                    table->m_strokes.push_back( strokeStart );
 
-                pointList.clear();
+                strokeStart = table->m_points.size();
             }
             else
             {
@@ -99,63 +135,170 @@ bool STROKE_FONT::LoadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
                 //  * a few shapes have a height slightly bigger than 1.0 ( like '{' '[' )
                 point.x = (double) ( coordinate[0] - 'R' ) * STROKE_FONT_SCALE - glyphStartX;
                 #define FONT_OFFSET -10
-				// FONT_OFFSET is here for historical reasons, due to the way the stroke font
+                // FONT_OFFSET is here for historical reasons, due to the way the stroke font
                 // was built. It allows shapes coordinates like W M ... to be >= 0
                 // Only shapes like j y have coordinates < 0
                 point.y = (double) ( coordinate[1] - 'R' + FONT_OFFSET ) * STROKE_FONT_SCALE;
-                pointList.push_back( point );
+                table->m_points.push_back( point );
+
+                ymin = std::min( ymin, point.y );
+                ymax = std::max( ymax, point.y );
             }
 
             i += 2;
         }
 
-        if( pointList.size() > 0 )
-            glyph.push_back( pointList );
-
-        m_glyphs[j] = glyph;
+        if( table->m_points.size() > strokeStart )
+            table->m_strokes.push_back( strokeStart );
 
-        // Compute the bounding box of the glyph
-        m_glyphBoundingBoxes[j] = computeBoundingBox( glyph, glyphBoundingX );
+        BOX2D bbox( VECTOR2D( 0.0, ymin ), VECTOR2D( glyphEndX - glyphStartX, ymax - ymin ) );
+        table->m_boundingBoxes.push_back( bbox );
     }
 
-    return true;
+    table->m_strokes.push_back( table->m_points.size() );
+    table->m_glyphs.push_back( table->m_strokes.size() - 1 );
+
+    return table;
 }
 
 
-// Static function:
-double STROKE_FONT::GetInterline( double aGlyphHeight, double aGlyphThickness )
+/// Strokes of a line of text, ready to be drawn
+struct STROKE_FONT::GLYPH_RUN
 {
-    return ( aGlyphHeight * INTERLINE_PITCH_RATIO ) + aGlyphThickness;
-}
+    struct STROKE
+    {
+        unsigned m_first;       ///< First point in m_points
+        unsigned m_count;
+        bool     m_overbar;     ///< Drawn as a line rather than a polyline
+    };
 
+    std::vector<VECTOR2D> m_points;
+    std::vector<STROKE>   m_strokes;
+};
 
-int STROKE_FONT::getInterline() const
+
+/**
+ * Class GLYPH_RUN_CACHE
+ * keeps the most recently drawn lines of text, for all the STROKE_FONT instances and
+ * all the threads.
+ */
+class STROKE_FONT::GLYPH_RUN_CACHE
 {
-    return KiROUND( GetInterline( m_gal->GetGlyphSize().y, m_gal->GetLineWidth() ) );
-}
+public:
+    struct KEY
+    {
+        const GLYPH_TABLE* m_table;
+        std::string m_text;
+        VECTOR2D    m_glyphSize;
+        double      m_lineWidth;
+        bool        m_italic;
+        bool        m_mirrored;
+
+        bool operator==( const KEY& aOther ) const
+        {
+            return m_table == aOther.m_table && m_text == aOther.m_text
+                && m_glyphSize == aOther.m_glyphSize
+                && m_lineWidth == aOther.m_lineWidth && m_italic == aOther.m_italic
+                && m_mirrored == aOther.m_mirrored;
+        }
+    };
 
+    std::shared_ptr<const GLYPH_RUN> Get( const KEY& aKey )
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
 
-BOX2D STROKE_FONT::computeBoundingBox( const GLYPH& aGLYPH, const VECTOR2D& aGLYPHBoundingX ) const
-{
-    BOX2D boundingBox;
+        auto it = m_index.find( aKey );
 
-    std::deque<VECTOR2D> boundingPoints;
+        if( it == m_index.end() )
+            return std::shared_ptr<const GLYPH_RUN>();
 
-    boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, 0 ) );
-    boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.y, 0 ) );
+        // Move the entry to the front, it is the most recently used now
+        m_entries.splice( m_entries.begin(), m_entries, it->second );
 
-    for( GLYPH::const_iterator pointListIt = aGLYPH.begin(); pointListIt != aGLYPH.end(); ++pointListIt )
+        return it->second->second;
+    }
+
+    void Put( const KEY& aKey, const std::shared_ptr<const GLYPH_RUN>& aRun )
     {
-        for( std::deque<VECTOR2D>::const_iterator pointIt = pointListIt->begin();
-                pointIt != pointListIt->end(); ++pointIt )
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        if( m_index.count( aKey ) )     // added by another thread meanwhile
+            return;
+
+        m_entries.emplace_front( aKey, aRun );
+        m_index[aKey] = m_entries.begin();
+
+        if( m_entries.size() > MAX_ENTRIES )
         {
-            boundingPoints.push_back( VECTOR2D( aGLYPHBoundingX.x, pointIt->y ) );
+            m_index.erase( m_entries.back().first );
+            m_entries.pop_back();
         }
     }
 
-    boundingBox.Compute( boundingPoints );
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        m_index.clear();
+        m_entries.clear();
+    }
+
+private:
+    static const size_t MAX_ENTRIES = 16384;    ///< About the texts of 8000 footprints
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            size_t hash = std::hash<std::string>()( aKey.m_text );
+
+            auto combine = [&hash]( size_t aValue )
+            {
+                hash ^= aValue + 0x9e3779b9 + ( hash << 6 ) + ( hash >> 2 );
+            };
+
+            combine( std::hash<double>()( aKey.m_glyphSize.x ) );
+            combine( std::hash<double>()( aKey.m_glyphSize.y ) );
+            combine( std::hash<double>()( aKey.m_lineWidth ) );
+            combine( aKey.m_italic + 2 * aKey.m_mirrored );
+            combine( std::hash<const GLYPH_TABLE*>()( aKey.m_table ) );
+
+            return hash;
+        }
+    };
+
+    typedef std::list< std::pair<KEY, std::shared_ptr<const GLYPH_RUN> > > ENTRY_LIST;
+
+    std::mutex                                              m_lock;
+    ENTRY_LIST                                              m_entries;  ///< Most recent first
+    std::unordered_map<KEY, ENTRY_LIST::iterator, KEY_HASH> m_index;
+};
+
 
-    return boundingBox;
+STROKE_FONT::GLYPH_RUN_CACHE& STROKE_FONT::glyphRunCache()
+{
+    static GLYPH_RUN_CACHE cache;
+
+    return cache;
+}
+
+
+void STROKE_FONT::ClearTextCache()
+{
+    glyphRunCache().Clear();
+}
+
+
+// Static function:
+double STROKE_FONT::GetInterline( double aGlyphHeight, double aGlyphThickness )
+{
+    return ( aGlyphHeight * INTERLINE_PITCH_RATIO ) + aGlyphThickness;
+}
+
+
+int STROKE_FONT::getInterline() const
+{
+    return KiROUND( GetInterline( m_gal->GetGlyphSize().y, m_gal->GetLineWidth() ) );
 }
 
 
@@ -241,15 +384,8 @@ void STROKE_FONT::Draw( const UTF8& aText, const VECTOR2D& aPosition, double aRo
 
 void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 {
-    // By default the overbar is turned off
-    bool overbar = false;
-
     double      xOffset;
     VECTOR2D    glyphSize( m_gal->GetGlyphSize() );
-    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
-
-    if( m_gal->IsTextMirrored() )
-        overbar_italic_comp = -overbar_italic_comp;
 
     // Compute the text size
     VECTOR2D textSize = computeTextLineSize( aText );
@@ -299,6 +435,58 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
         xOffset = 0.0;
     }
 
+    // Texts are very repetitive (references, values, pin names...), so the strokes of
+    // a line are built once and then only moved by the GAL transformations
+    GLYPH_RUN_CACHE::KEY key;
+
+    key.m_table     = m_glyphTable.get();
+    key.m_text      = aText;
+    key.m_glyphSize = glyphSize;
+    key.m_lineWidth = m_gal->GetLineWidth();
+    key.m_italic    = m_gal->IsFontItalic();
+    key.m_mirrored  = m_gal->IsTextMirrored();
+
+    std::shared_ptr<const GLYPH_RUN> run = glyphRunCache().Get( key );
+
+    if( !run )
+    {
+        std::shared_ptr<GLYPH_RUN> newRun = std::make_shared<GLYPH_RUN>();
+
+        buildGlyphRun( aText, glyphSize, xOffset, *newRun );
+        glyphRunCache().Put( key, newRun );
+        run = newRun;
+    }
+
+    for( const GLYPH_RUN::STROKE& stroke : run->m_strokes )
+    {
+        const VECTOR2D* points = run->m_points.data() + stroke.m_first;
+
+        if( stroke.m_overbar )
+        {
+            m_gal->DrawLine( points[0], points[1] );
+        }
+        else
+        {
+            std::deque<VECTOR2D> pointList( points, points + stroke.m_count );
+            m_gal->DrawPolyline( pointList );
+        }
+    }
+
+    m_gal->Restore();
+}
+
+
+void STROKE_FONT::buildGlyphRun( const UTF8& aText, const VECTOR2D& aGlyphSize, double aXOffset,
+                                 GLYPH_RUN& aRun ) const
+{
+    // By default the overbar is turned off
+    bool overbar = false;
+
+    double overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
+
+    if( m_gal->IsTextMirrored() )
+        overbar_italic_comp = -overbar_italic_comp;
+
     // The overbar is indented inward at the beginning of an italicized section, but
     // must not be indented on subsequent letters to ensure that the bar segments
     // overlap.
@@ -320,17 +508,16 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 
         int dd = *chIt - ' ';
 
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
+        if( dd >= m_glyphTable->GlyphCount() || dd < 0 )
             dd = '?' - ' ';
 
-        GLYPH& glyph = m_glyphs[dd];
-        BOX2D& bbox  = m_glyphBoundingBoxes[dd];
+        const BOX2D& bbox = m_glyphTable->m_boundingBoxes[dd];
 
         if( overbar )
         {
-            double overbar_start_x = xOffset;
+            double overbar_start_x = aXOffset;
             double overbar_start_y = - computeOverbarVerticalPosition();
-            double overbar_end_x = xOffset + glyphSize.x * bbox.GetEnd().x;
+            double overbar_end_x = aXOffset + aGlyphSize.x * bbox.GetEnd().x;
             double overbar_end_y = overbar_start_y;
 
             if( !last_had_overbar )
@@ -339,25 +526,28 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                 last_had_overbar = true;
             }
 
-            VECTOR2D startOverbar( overbar_start_x, overbar_start_y );
-            VECTOR2D endOverbar( overbar_end_x, overbar_end_y );
+            GLYPH_RUN::STROKE line = { (unsigned) aRun.m_points.size(), 2, true };
 
-            m_gal->DrawLine( startOverbar, endOverbar );
+            aRun.m_points.push_back( VECTOR2D( overbar_start_x, overbar_start_y ) );
+            aRun.m_points.push_back( VECTOR2D( overbar_end_x, overbar_end_y ) );
+            aRun.m_strokes.push_back( line );
         }
         else
         {
             last_had_overbar = false;
         }
 
-        for( GLYPH::iterator pointListIt = glyph.begin(); pointListIt != glyph.end();
-             ++pointListIt )
+        for( unsigned stroke = m_glyphTable->m_glyphs[dd];
+             stroke < m_glyphTable->m_glyphs[dd + 1]; ++stroke )
         {
-            std::deque<VECTOR2D> pointListScaled;
+            GLYPH_RUN::STROKE polyline = { (unsigned) aRun.m_points.size(), 0, false };
 
-            for( std::deque<VECTOR2D>::iterator pointIt = pointListIt->begin();
-                 pointIt != pointListIt->end(); ++pointIt )
+            for( unsigned point = m_glyphTable->m_strokes[stroke];
+                 point < m_glyphTable->m_strokes[stroke + 1]; ++point )
             {
-                VECTOR2D pointPos( pointIt->x * glyphSize.x + xOffset, pointIt->y * glyphSize.y );
+                const VECTOR2D& glyphPoint = m_glyphTable->m_points[point];
+                VECTOR2D pointPos( glyphPoint.x * aGlyphSize.x + aXOffset,
+                                   glyphPoint.y * aGlyphSize.y );
 
                 if( m_gal->IsFontItalic() )
                 {
@@ -369,16 +559,15 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                         pointPos.x -= pointPos.y * STROKE_FONT::ITALIC_TILT;
                 }
 
-                pointListScaled.push_back( pointPos );
+                aRun.m_points.push_back( pointPos );
             }
 
-            m_gal->DrawPolyline( pointListScaled );
+            polyline.m_count = aRun.m_points.size() - polyline.m_first;
+            aRun.m_strokes.push_back( polyline );
         }
 
-        xOffset += glyphSize.x * bbox.GetEnd().x;
+        aXOffset += aGlyphSize.x * bbox.GetEnd().x;
     }
-
-    m_gal->Restore();
 }
 
 
@@ -429,10 +618,10 @@ VECTOR2D STROKE_FONT::ComputeStringBoundaryLimits( const UTF8& aText, VECTOR2D a
         // Index in the bounding boxes table
         int dd = *it - ' ';
 
-        if( dd >= (int) m_glyphBoundingBoxes.size() || dd < 0 )
+        if( dd >= m_glyphTable->GlyphCount() || dd < 0 )
             dd = '?' - ' ';
 
-        const BOX2D& box = m_glyphBoundingBoxes[dd];
+        const BOX2D& box = m_glyphTable->m_boundingBoxes[dd];
 
         string_bbox.x += box.GetEnd().x;
 
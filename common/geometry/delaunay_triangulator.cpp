@@ -0,0 +1,507 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * The sweep-hull algorithm follows the one of the Delaunator library (ISC license):
+ * the points are added in the order of their distance to a seed triangle, each one
+ * is joined to the visible part of the convex hull, and the new triangles are flipped
+ * until they satisfy the Delaunay condition.
+ */
+
+#include <geometry/delaunay_triangulator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+static inline double squaredDistance( const VECTOR2D& aA, const VECTOR2D& aB )
+{
+    double dx = aA.x - aB.x;
+    double dy = aA.y - aB.y;
+
+    return dx * dx + dy * dy;
+}
+
+
+///> Returns true if the points are in clockwise order (the y axis pointing down).
+static inline bool orient( const VECTOR2D& aP, const VECTOR2D& aQ, const VECTOR2D& aR )
+{
+    return ( aQ.y - aP.y ) * ( aR.x - aQ.x ) - ( aQ.x - aP.x ) * ( aR.y - aQ.y ) < 0.0;
+}
+
+
+///> Returns true if aP is inside the circumcircle of aA, aB and aC.
+static inline bool inCircle( const VECTOR2D& aA, const VECTOR2D& aB, const VECTOR2D& aC,
+                             const VECTOR2D& aP )
+{
+    double dx = aA.x - aP.x;
+    double dy = aA.y - aP.y;
+    double ex = aB.x - aP.x;
+    double ey = aB.y - aP.y;
+    double fx = aC.x - aP.x;
+    double fy = aC.y - aP.y;
+
+    double ap = dx * dx + dy * dy;
+    double bp = ex * ex + ey * ey;
+    double cp = fx * fx + fy * fy;
+
+    return dx * ( ey * cp - bp * fy ) - dy * ( ex * cp - bp * fx ) + ap * ( ex * fy - ey * fx ) < 0.0;
+}
+
+
+///> Returns the offset of the circumcenter of aA, aB and aC from aA.
+static inline VECTOR2D circumcenterOffset( const VECTOR2D& aA, const VECTOR2D& aB,
+                                           const VECTOR2D& aC )
+{
+    double dx = aB.x - aA.x;
+    double dy = aB.y - aA.y;
+    double ex = aC.x - aA.x;
+    double ey = aC.y - aA.y;
+
+    double bl = dx * dx + dy * dy;
+    double cl = ex * ex + ey * ey;
+    double d = 0.5 / ( dx * ey - dy * ex );
+
+    return VECTOR2D( ( ey * bl - dy * cl ) * d, ( dx * cl - ex * bl ) * d );
+}
+
+
+static inline double circumradius( const VECTOR2D& aA, const VECTOR2D& aB, const VECTOR2D& aC )
+{
+    VECTOR2D offset = circumcenterOffset( aA, aB, aC );
+    double r = offset.x * offset.x + offset.y * offset.y;
+
+    // Collinear points give an infinite or undefined radius
+    return std::isfinite( r ) ? r : std::numeric_limits<double>::infinity();
+}
+
+
+///> Monotonic function of the angle of a vector, in the range [0..1].
+static inline double pseudoAngle( double aDx, double aDy )
+{
+    double p = aDx / ( std::abs( aDx ) + std::abs( aDy ) );
+
+    return ( aDy > 0.0 ? 3.0 - p : 1.0 + p ) / 4.0;
+}
+
+
+static inline int nextHalfedge( int aEdge )
+{
+    return ( aEdge % 3 == 2 ) ? aEdge - 2 : aEdge + 1;
+}
+
+
+DELAUNAY_TRIANGULATOR::DELAUNAY_TRIANGULATOR() :
+    m_trianglesLen( 0 ),
+    m_hullStart( 0 )
+{
+}
+
+
+void DELAUNAY_TRIANGULATOR::Triangulate( const std::vector<VECTOR2I>& aPoints )
+{
+    const int n = aPoints.size();
+
+    m_edges.clear();
+    m_skipped.clear();
+    m_trianglesLen = 0;
+
+    if( n < 2 )
+        return;
+
+    m_points.resize( n );
+    m_ids.resize( n );
+
+    VECTOR2D bboxMin( std::numeric_limits<double>::max(), std::numeric_limits<double>::max() );
+    VECTOR2D bboxMax( -bboxMin.x, -bboxMin.y );
+
+    for( int i = 0; i < n; ++i )
+    {
+        m_points[i] = VECTOR2D( aPoints[i].x, aPoints[i].y );
+        m_ids[i] = i;
+
+        bboxMin.x = std::min( bboxMin.x, m_points[i].x );
+        bboxMin.y = std::min( bboxMin.y, m_points[i].y );
+        bboxMax.x = std::max( bboxMax.x, m_points[i].x );
+        bboxMax.y = std::max( bboxMax.y, m_points[i].y );
+    }
+
+    // The seed triangle is made of the point closest to the center, its closest neighbour
+    // and the point giving the smallest circumcircle with them
+    VECTOR2D bboxCenter( ( bboxMin.x + bboxMax.x ) / 2, ( bboxMin.y + bboxMax.y ) / 2 );
+    double minDist = std::numeric_limits<double>::infinity();
+    int i0 = 0, i1 = -1, i2 = -1;
+
+    for( int i = 0; i < n; ++i )
+    {
+        double d = squaredDistance( bboxCenter, m_points[i] );
+
+        if( d < minDist )
+        {
+            i0 = i;
+            minDist = d;
+        }
+    }
+
+    minDist = std::numeric_limits<double>::infinity();
+
+    for( int i = 0; i < n; ++i )
+    {
+        double d = squaredDistance( m_points[i0], m_points[i] );
+
+        if( i != i0 && d < minDist && d > 0.0 )
+        {
+            i1 = i;
+            minDist = d;
+        }
+    }
+
+    double minRadius = std::numeric_limits<double>::infinity();
+
+    for( int i = 0; i < n && i1 >= 0; ++i )
+    {
+        if( i == i0 || i == i1 )
+            continue;
+
+        double r = circumradius( m_points[i0], m_points[i1], m_points[i] );
+
+        if( r < minRadius )
+        {
+            i2 = i;
+            minRadius = r;
+        }
+    }
+
+    if( i2 < 0 )
+    {
+        // All the points are on a line, so sorting them gives their order on this line
+        std::sort( m_ids.begin(), m_ids.end(), [this]( int aA, int aB )
+        {
+            return m_points[aA].x < m_points[aB].x
+                || ( m_points[aA].x == m_points[aB].x && m_points[aA].y < m_points[aB].y );
+        } );
+
+        for( int i = 1; i < n; ++i )
+            m_edges.push_back( { m_ids[i - 1], m_ids[i] } );
+
+        return;
+    }
+
+    if( orient( m_points[i0], m_points[i1], m_points[i2] ) )
+        std::swap( i1, i2 );
+
+    m_center = m_points[i0] + circumcenterOffset( m_points[i0], m_points[i1], m_points[i2] );
+
+    m_dists.resize( n );
+
+    for( int i = 0; i < n; ++i )
+        m_dists[i] = squaredDistance( m_points[i], m_center );
+
+    std::sort( m_ids.begin(), m_ids.end(), [this]( int aA, int aB )
+    {
+        return m_dists[aA] < m_dists[aB];
+    } );
+
+    // A triangulation of n points has at most 2n - 5 triangles
+    int maxTriangles = std::max( 2 * n - 5, 1 );
+
+    m_triangles.resize( maxTriangles * 3 );
+    m_halfedges.resize( maxTriangles * 3 );
+
+    m_hullPrev.resize( n );
+    m_hullNext.resize( n );
+    m_hullTri.resize( n );
+    m_hullHash.assign( std::ceil( std::sqrt( n ) ), -1 );
+
+    m_hullStart = i0;
+    m_hullNext[i0] = m_hullPrev[i2] = i1;
+    m_hullNext[i1] = m_hullPrev[i0] = i2;
+    m_hullNext[i2] = m_hullPrev[i1] = i0;
+
+    m_hullTri[i0] = 0;
+    m_hullTri[i1] = 1;
+    m_hullTri[i2] = 2;
+
+    m_hullHash[hashKey( m_points[i0] )] = i0;
+    m_hullHash[hashKey( m_points[i1] )] = i1;
+    m_hullHash[hashKey( m_points[i2] )] = i2;
+
+    addTriangle( i0, i1, i2, -1, -1, -1 );
+
+    const int hashSize = m_hullHash.size();
+
+    for( int k = 0; k < n; ++k )
+    {
+        const int i = m_ids[k];
+        const VECTOR2D& p = m_points[i];
+
+        if( i == i0 || i == i1 || i == i2 )
+            continue;
+
+        // Find an edge of the hull that is visible from the point, starting from the hull
+        // point with the closest angle
+        int start = 0;
+
+        for( int j = 0, key = hashKey( p ); j < hashSize; ++j )
+        {
+            start = m_hullHash[( key + j ) % hashSize];
+
+            if( start != -1 && start != m_hullNext[start] )
+                break;
+        }
+
+        start = m_hullPrev[start];
+        int e = start;
+        int q;
+
+        while( q = m_hullNext[e], !orient( p, m_points[e], m_points[q] ) )
+        {
+            e = q;
+
+            if( e == start )
+            {
+                e = -1;
+                break;
+            }
+        }
+
+        if( e == -1 )
+        {
+            // Rounding errors, the point is joined to its neighbour later
+            m_skipped.push_back( i );
+            continue;
+        }
+
+        int t = addTriangle( e, i, m_hullNext[e], -1, -1, m_hullTri[e] );
+
+        m_hullTri[i] = legalize( t + 2 );
+        m_hullTri[e] = t;
+
+        // Walk forward through the hull, adding triangles to the visible edges
+        int next = m_hullNext[e];
+
+        while( q = m_hullNext[next], orient( p, m_points[next], m_points[q] ) )
+        {
+            t = addTriangle( next, i, q, m_hullTri[i], -1, m_hullTri[next] );
+            m_hullTri[i] = legalize( t + 2 );
+            m_hullNext[next] = next;    // removed from the hull
+            next = q;
+        }
+
+        // Walk backward from the other side
+        if( e == start )
+        {
+            while( q = m_hullPrev[e], orient( p, m_points[q], m_points[e] ) )
+            {
+                t = addTriangle( q, i, e, -1, m_hullTri[e], m_hullTri[q] );
+                legalize( t + 2 );
+                m_hullTri[q] = t;
+                m_hullNext[e] = e;      // removed from the hull
+                e = q;
+            }
+        }
+
+        m_hullStart = m_hullPrev[i] = e;
+        m_hullNext[e] = m_hullPrev[next] = i;
+        m_hullNext[i] = next;
+
+        m_hullHash[hashKey( p )] = i;
+        m_hullHash[hashKey( m_points[e] )] = e;
+    }
+
+    // Every edge is shared by two half-edges, except the ones of the hull
+    for( int e = 0; e < m_trianglesLen; ++e )
+    {
+        if( e > m_halfedges[e] )
+            m_edges.push_back( { m_triangles[e], m_triangles[nextHalfedge( e )] } );
+    }
+
+    if( !m_skipped.empty() )
+        joinSkippedPoints();
+}
+
+
+int DELAUNAY_TRIANGULATOR::addTriangle( int aI0, int aI1, int aI2, int aA, int aB, int aC )
+{
+    int t = m_trianglesLen;
+
+    m_triangles[t] = aI0;
+    m_triangles[t + 1] = aI1;
+    m_triangles[t + 2] = aI2;
+
+    link( t, aA );
+    link( t + 1, aB );
+    link( t + 2, aC );
+
+    m_trianglesLen += 3;
+
+    return t;
+}
+
+
+void DELAUNAY_TRIANGULATOR::link( int aA, int aB )
+{
+    m_halfedges[aA] = aB;
+
+    if( aB != -1 )
+        m_halfedges[aB] = aA;
+}
+
+
+int DELAUNAY_TRIANGULATOR::legalize( int aA )
+{
+    int ar = 0;
+
+    m_edgeStack.clear();
+
+    while( true )
+    {
+        /* If the triangles sharing the edge a/b do not satisfy the Delaunay condition
+         * (p1 is inside the circumcircle of p0, pl and pr), the edge is flipped:
+         *
+         *           pl                    pl
+         *          /||\                  /  \
+         *       al/ || \bl            al/    \a
+         *        /  ||  \              /      \
+         *       /  a||b  \    flip    /___ar___\
+         *     p0\   ||   /p1   =>   p0\---bl---/p1
+         *        \  ||  /              \      /
+         *       ar\ || /br             b\    /br
+         *          \||/                  \  /
+         *           pr                    pr
+         *
+         * and the new edges facing p0 and p1 are checked in turn.
+         */
+        int b = m_halfedges[aA];
+        int a0 = aA - aA % 3;
+
+        ar = a0 + ( aA + 2 ) % 3;
+
+        if( b == -1 )   // edge of the hull
+        {
+            if( m_edgeStack.empty() )
+                break;
+
+            aA = m_edgeStack.back();
+            m_edgeStack.pop_back();
+            continue;
+        }
+
+        int b0 = b - b % 3;
+        int al = a0 + ( aA + 1 ) % 3;
+        int bl = b0 + ( b + 2 ) % 3;
+
+        int p0 = m_triangles[ar];
+        int pr = m_triangles[aA];
+        int pl = m_triangles[al];
+        int p1 = m_triangles[bl];
+
+        if( inCircle( m_points[p0], m_points[pr], m_points[pl], m_points[p1] ) )
+        {
+            m_triangles[aA] = p1;
+            m_triangles[b] = p0;
+
+            int hbl = m_halfedges[bl];
+
+            // The flipped edge was on the hull (rare), so fix the hull reference
+            if( hbl == -1 )
+            {
+                int e = m_hullStart;
+
+                do
+                {
+                    if( m_hullTri[e] == bl )
+                    {
+                        m_hullTri[e] = aA;
+                        break;
+                    }
+
+                    e = m_hullPrev[e];
+                }
+                while( e != m_hullStart );
+            }
+
+            link( aA, hbl );
+            link( b, m_halfedges[ar] );
+            link( ar, bl );
+
+            m_edgeStack.push_back( b0 + ( b + 1 ) % 3 );
+        }
+        else
+        {
+            if( m_edgeStack.empty() )
+                break;
+
+            aA = m_edgeStack.back();
+            m_edgeStack.pop_back();
+        }
+    }
+
+    return ar;
+}
+
+
+int DELAUNAY_TRIANGULATOR::hashKey( const VECTOR2D& aPoint ) const
+{
+    double dx = aPoint.x - m_center.x;
+    double dy = aPoint.y - m_center.y;
+
+    if( dx == 0.0 && dy == 0.0 )
+        return 0;
+
+    int size = m_hullHash.size();
+
+    return (int) std::floor( pseudoAngle( dx, dy ) * size ) % size;
+}
+
+
+void DELAUNAY_TRIANGULATOR::joinSkippedPoints()
+{
+    // m_dists is not needed anymore, it marks the points that were not triangulated
+    for( int skipped : m_skipped )
+        m_dists[skipped] = -1.0;
+
+    for( int skipped : m_skipped )
+    {
+        double minDist = std::numeric_limits<double>::infinity();
+        int closest = -1;
+
+        for( int i = 0; i < (int) m_points.size(); ++i )
+        {
+            if( m_dists[i] < 0.0 )
+                continue;
+
+            double d = squaredDistance( m_points[skipped], m_points[i] );
+
+            if( d < minDist )
+            {
+                closest = i;
+                minDist = d;
+            }
+        }
+
+        if( closest >= 0 )
+            m_edges.push_back( { skipped, closest } );
+    }
+}
@@ -26,6 +26,7 @@
 
 #include <painter.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <view/view_item.h>
 
 using namespace KIGFX;
 
@@ -41,6 +42,9 @@ RENDER_SETTINGS::RENDER_SETTINGS()
     m_highlightNetcode      = -1;
     m_outlineWidth          = 1;
     m_worksheetLineWidth    = 100000;
+    m_lodEnabled            = true;
+    m_lodHideSize           = 1.0;
+    m_lodProxySize          = 3.0;
 
     // Store the predefined colors used in KiCad in format used by GAL
     for( int i = 0; i < NBCOLORS; i++ )
@@ -74,3 +78,35 @@ PAINTER::PAINTER( GAL* aGal ) :
 PAINTER::~PAINTER()
 {
 }
+
+
+void PAINTER::DrawProxy( const VIEW_ITEM* aItem, int aLayer )
+{
+    const BOX2I bbox = aItem->ViewBBox();
+
+    m_gal->SetIsFill( true );
+    m_gal->SetIsStroke( false );
+    m_gal->SetFillColor( GetSettings()->GetColor( aItem, aLayer ) );
+    m_gal->DrawRectangle( VECTOR2D( bbox.GetOrigin() ), VECTOR2D( bbox.GetEnd() ) );
+}
+
+
+PAINTER::LOD_LEVEL PAINTER::lodBySize( const BOX2I& aBBox, bool aMayHide, bool aMayProxy )
+{
+    const RENDER_SETTINGS* settings = GetSettings();
+
+    if( !settings->IsLODEnabled() )
+        return LOD_FULL;
+
+    double scale = m_gal->GetWorldScale();
+    double minSize = std::min( aBBox.GetWidth(), aBBox.GetHeight() ) * scale;
+    double maxSize = std::max( aBBox.GetWidth(), aBBox.GetHeight() ) * scale;
+
+    if( aMayHide && minSize < settings->GetLODHideSize() )
+        return LOD_HIDDEN;
+
+    if( aMayProxy && maxSize < settings->GetLODProxySize() )
+        return LOD_PROXY;
+
+    return LOD_FULL;
+}
@@ -23,9 +23,17 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
+#ifdef _WIN32
+#include <io.h>         // _commit()
+#else
+#include <unistd.h>     // fsync()
+#endif
+
 #include <richio.h>
 
 
@@ -409,47 +417,61 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... ) throw( IO_ERRO
 {
 #define NESTWIDTH           2   ///< how many spaces per nestLevel
 
-    va_list     args;
+    static const char spaces[] = "                                ";
 
-    va_start( args, fmt );
+    int total = 0;
+
+    // no error checking needed, an exception indicates an error.
+    for( int count = nestLevel * NESTWIDTH; count > 0; )
+    {
+        int len = std::min( count, int( sizeof( spaces ) - 1 ) );
 
-    int result = 0;
-    int total  = 0;
+        write( spaces, len );
+        count -= len;
+        total += len;
+    }
 
-    for( int i=0; i<nestLevel;  ++i )
+    // Constant text such as ")\n" needs no formatting.
+    if( !strchr( fmt, '%' ) )
     {
-        // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        int len = strlen( fmt );
+
+        if( len )
+            write( fmt, len );
 
-        total += result;
+        return total + len;
     }
 
-    // no error checking needed, an exception indicates an error.
-    result = vprint( fmt, args );
+    va_list     args;
+
+    va_start( args, fmt );
+
+    total += vprint( fmt, args );
 
     va_end( args );
 
-    total += result;
     return total;
 }
 
 
-std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee ) throw( IO_ERROR )
+std::string OUTPUTFORMATTER::quotes( const char* aWrapee, size_t aLength )
 {
     static const char quoteThese[] = "\t ()\n\r";
 
-    if( !aWrapee.size() ||  // quote null string as ""
+    const char* end = aWrapee + aLength;
+
+    if( !aLength ||         // quote null string as ""
         aWrapee[0]=='#' ||  // quote a potential s-expression comment, so it is not a comment
         aWrapee[0]=='"' ||  // NextTok() will travel through DSN_STRING path anyway, then must apply escapes
-        aWrapee.find_first_of( quoteThese ) != std::string::npos )
+        std::find_first_of( aWrapee, end, quoteThese, quoteThese + sizeof( quoteThese ) - 1 ) != end )
     {
         std::string ret;
 
-        ret.reserve( aWrapee.size()*2 + 2 );
+        ret.reserve( aLength*2 + 2 );
 
         ret += '"';
 
-        for( std::string::const_iterator it = aWrapee.begin(); it!=aWrapee.end(); ++it )
+        for( const char* it = aWrapee; it != end; ++it )
         {
             switch( *it )
             {
@@ -479,18 +501,23 @@ std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee ) throw( IO_ERRO
         return ret;
     }
 
-    return aWrapee;
+    return std::string( aWrapee, aLength );
+}
+
+
+std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee ) throw( IO_ERROR )
+{
+    return quotes( aWrapee.data(), aWrapee.size() );
 }
 
 
 std::string OUTPUTFORMATTER::Quotew( const wxString& aWrapee ) throw( IO_ERROR )
 {
     // wxStrings are always encoded as UTF-8 as we convert to a byte sequence.
-    // The non-virutal function calls the virtual workhorse function, and if
-    // a different quoting or escaping strategy is desired from the standard,
-    // a derived class can overload Quotes() above, but
-    // should never be a reason to overload this Quotew() here.
-    return Quotes( (const char*) aWrapee.utf8_str() );
+    // The bytes are quoted where they are, without an intermediate std::string.
+    wxCharBuffer utf8 = aWrapee.ToUTF8();
+
+    return quotes( utf8.data(), utf8.length() );
 }
 
 
@@ -523,6 +550,8 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName,
     OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
     m_filename( aFileName )
 {
+    m_buffer.reserve( FILEFMTBUFZ );
+
     m_fp = wxFopen( aFileName, aMode );
 
     if( !m_fp )
@@ -538,13 +567,39 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName,
 FILE_OUTPUTFORMATTER::~FILE_OUTPUTFORMATTER()
 {
     if( m_fp )
+    {
+        // Finish() was not called, so there is nobody left to report an error to.
+        if( m_buffer.size() )
+            fwrite( m_buffer.data(), m_buffer.size(), 1, m_fp );
+
         fclose( m_fp );
+    }
 }
 
 
-void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount ) throw( IO_ERROR )
+void FILE_OUTPUTFORMATTER::Finish( bool aSyncToDisk ) throw( IO_ERROR )
 {
-    if( 1 != fwrite( aOutBuf, aCount, 1, m_fp ) )
+    if( !m_fp )
+        return;
+
+    flush();
+
+    FILE* fp = m_fp;
+
+    m_fp = NULL;
+
+    bool synced = true;
+
+    if( aSyncToDisk )
+    {
+#ifdef _WIN32
+        synced = fflush( fp ) == 0 && _commit( _fileno( fp ) ) == 0;
+#else
+        synced = fflush( fp ) == 0 && fsync( fileno( fp ) ) == 0;
+#endif
+    }
+
+    if( fclose( fp ) != 0 || !synced )
     {
         wxString msg = wxString::Format(
                             _( "error writing to file '%s'" ),
@@ -554,6 +609,32 @@ void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount ) throw( IO_ER
 }
 
 
+void FILE_OUTPUTFORMATTER::flush() throw( IO_ERROR )
+{
+    if( m_buffer.size() && 1 != fwrite( m_buffer.data(), m_buffer.size(), 1, m_fp ) )
+    {
+        m_buffer.clear();
+
+        wxString msg = wxString::Format(
+                            _( "error writing to file '%s'" ),
+                            m_filename.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_buffer.clear();
+}
+
+
+void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount ) throw( IO_ERROR )
+{
+    // Most writes are a few bytes, collecting them saves a locked fwrite() call each.
+    if( m_buffer.size() + aCount > m_buffer.capacity() )
+        flush();
+
+    m_buffer.append( aOutBuf, aCount );
+}
+
+
 //-----<STREAM_OUTPUTFORMATTER>--------------------------------------
 
 void STREAM_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount ) throw( IO_ERROR )
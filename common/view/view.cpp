@@ -33,8 +33,15 @@
 #include <view/view_rtree.h>
 #include <gal/definitions.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <gal/display_list.h>
 #include <painter.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
 #ifdef __WXDEBUG__
 #include <profile.h>
 #endif /* __WXDEBUG__  */
@@ -49,6 +56,7 @@ public:
     VIEW_ITEM_DATA() :
         m_flags( KIGFX::VISIBLE ),
         m_requiredUpdate( KIGFX::NONE ),
+        m_dirtyIndex( -1 ),
         m_groups( nullptr ),
         m_groupsSize( 0 ) {}
 
@@ -88,6 +96,7 @@ private:
     VIEW*   m_view;             ///< Current dynamic view the item is assigned to.
     int     m_flags;            ///< Visibility flags
     int     m_requiredUpdate;   ///< Flag required for updating
+    int     m_dirtyIndex;       ///< Index in VIEW::m_dirtyItems, or -1 if not queued
 
     ///> Helper for storing cached items group ids
     typedef std::pair<int, int> GroupPair;
@@ -115,6 +124,41 @@ private:
         return -1;
     }
 
+    /**
+     * Function getProxyGroup()
+     * Returns the group id of the proxy drawn instead of the item on the given layer, or -1
+     * if there is none. Proxy groups are stored with the regular ones, under the layer number
+     * shifted past the last layer.
+     */
+    int getProxyGroup( int aLayer ) const
+    {
+        return getGroup( aLayer + VIEW::VIEW_MAX_LAYERS );
+    }
+
+    /**
+     * Function setProxyGroup()
+     * Sets the group id of the proxy drawn instead of the item on the given layer.
+     */
+    void setProxyGroup( int aLayer, int aGroup )
+    {
+        setGroup( aLayer + VIEW::VIEW_MAX_LAYERS, aGroup );
+    }
+
+    /**
+     * Function deleteProxyGroup()
+     * Removes the proxy drawn on the given layer from the GAL cache, if there is one.
+     */
+    void deleteProxyGroup( GAL* aGal, int aLayer )
+    {
+        int group = getProxyGroup( aLayer );
+
+        if( group >= 0 )
+        {
+            aGal->DeleteGroup( group );
+            setProxyGroup( aLayer, -1 );
+        }
+    }
+
     /**
      * Function getAllGroups()
      * Returns all group ids for the item (collected from all layers the item occupies).
@@ -263,6 +307,9 @@ VIEW::VIEW( bool aIsDynamic ) :
 {
     m_boundary.SetMaximum();
     m_allItems.reserve( 32768 );
+    m_updatedItemsCount = 0;
+    m_proxyItemsCount = 0;
+    m_hiddenItemsCount = 0;
 
     // Redraw everything at the beginning
     MarkDirty();
@@ -342,6 +389,8 @@ void VIEW::Remove( VIEW_ITEM* aItem )
         viewData->clearUpdateFlags();
     }
 
+    dequeueItem( aItem );
+
     int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
     viewData->getLayers( layers, layers_count );
 
@@ -356,6 +405,8 @@ void VIEW::Remove( VIEW_ITEM* aItem )
 
         if( prevGroup >= 0 )
             m_gal->DeleteGroup( prevGroup );
+
+        viewData->deleteProxyGroup( m_gal, layers[i] );
     }
 
     viewData->deleteGroups();
@@ -626,6 +677,11 @@ struct VIEW::updateItemsColor
         const COLOR4D color = painter->GetSettings()->GetColor( aItem, layer );
         int group = aItem->viewPrivData()->getGroup( layer );
 
+        if( group >= 0 )
+            gal->ChangeGroupColor( group, color );
+
+        group = aItem->viewPrivData()->getProxyGroup( layer );
+
         if( group >= 0 )
             gal->ChangeGroupColor( group, color );
 
@@ -691,6 +747,11 @@ struct VIEW::changeItemsDepth
     {
         int group = aItem->viewPrivData()->getGroup( layer );
 
+        if( group >= 0 )
+            gal->ChangeGroupDepth( group, depth );
+
+        group = aItem->viewPrivData()->getProxyGroup( layer );
+
         if( group >= 0 )
             gal->ChangeGroupDepth( group, depth );
 
@@ -827,7 +888,22 @@ struct VIEW::drawItem
         if( !drawCondition )
             return true;
 
-        view->draw( aItem, layer );
+        // Items small on the screen may be skipped or simplified
+        switch( view->m_painter->GetLOD( aItem, layer ) )
+        {
+        case PAINTER::LOD_FULL:
+            view->draw( aItem, layer );
+            break;
+
+        case PAINTER::LOD_PROXY:
+            view->drawProxy( aItem, layer );
+            ++view->m_proxyItemsCount;
+            break;
+
+        case PAINTER::LOD_HIDDEN:
+            ++view->m_hiddenItemsCount;
+            break;
+        }
 
         return true;
     }
@@ -889,6 +965,36 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
 }
 
 
+void VIEW::drawProxy( VIEW_ITEM* aItem, int aLayer )
+{
+    auto viewData = aItem->viewPrivData();
+
+    if( !viewData )
+        return;
+
+    if( IsCached( aLayer ) )
+    {
+        int group = viewData->getProxyGroup( aLayer );
+
+        if( group >= 0 )
+        {
+            m_gal->DrawGroup( group );
+        }
+        else
+        {
+            group = m_gal->BeginGroup();
+            viewData->setProxyGroup( aLayer, group );
+            m_painter->DrawProxy( aItem, aLayer );
+            m_gal->EndGroup();
+        }
+    }
+    else
+    {
+        m_painter->DrawProxy( aItem, aLayer );
+    }
+}
+
+
 void VIEW::draw( VIEW_ITEM* aItem, bool aImmediate )
 {
     int layers[VIEW_MAX_LAYERS], layers_count;
@@ -943,6 +1049,7 @@ struct VIEW::recacheItem
             gal->DeleteGroup( group );
 
         viewData->setGroup( layer, -1 );
+        viewData->deleteProxyGroup( gal, layer );
         view->Update( aItem );
 
         return true;
@@ -962,6 +1069,11 @@ void VIEW::Clear()
 
     m_allItems.clear();
 
+    for( VIEW_ITEM* item : m_dirtyItems )
+        item->viewPrivData()->m_dirtyIndex = -1;
+
+    m_dirtyItems.clear();
+
     for( LAYER_MAP_ITER i = m_layers.begin(); i != m_layers.end(); ++i )
     {
         VIEW_LAYER* l = &( ( *i ).second );
@@ -1008,6 +1120,9 @@ void VIEW::Redraw()
                    ToWorld( screenSize ) - ToWorld( VECTOR2D( 0, 0 ) ) );
     rect.Normalize();
 
+    m_proxyItemsCount  = 0;
+    m_hiddenItemsCount = 0;
+
     redrawRect( rect );
 
     // All targets were redrawn, so nothing is dirty
@@ -1061,7 +1176,7 @@ void VIEW::clearGroupCache()
 }
 
 
-void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
+void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags, const recordedItem* aRecorded )
 {
     // updateLayers updates geometry too, so we do not have to update both of them at the same time
     if( aUpdateFlags & LAYERS )
@@ -1080,7 +1195,7 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         if( IsCached( layerId ) )
         {
             if( aUpdateFlags & ( GEOMETRY | LAYERS ) )
-                updateItemGeometry( aItem, layerId );
+                updateItemGeometry( aItem, layerId, aRecorded );
             else if( aUpdateFlags & COLOR )
                 updateItemColor( aItem, layerId );
         }
@@ -1124,10 +1239,15 @@ void VIEW::updateItemColor( VIEW_ITEM* aItem, int aLayer )
     // Change the color, only if it has group assigned
     if( group >= 0 )
         m_gal->ChangeGroupColor( group, color );
+
+    group = viewData->getProxyGroup( aLayer );
+
+    if( group >= 0 )
+        m_gal->ChangeGroupColor( group, color );
 }
 
 
-void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
+void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer, const recordedItem* aRecorded )
 {
     auto viewData = aItem->viewPrivData();
     wxASSERT( (unsigned) aLayer < m_layers.size() );
@@ -1147,10 +1267,16 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     if( group >= 0 )
         m_gal->DeleteGroup( group );
 
+    // The proxy is drawn again when needed
+    viewData->deleteProxyGroup( m_gal, aLayer );
+
     group = m_gal->BeginGroup();
     viewData->setGroup( aLayer, group );
 
-    if( !m_painter->Draw( static_cast<EDA_ITEM*>( aItem ), aLayer ) )
+    // Items recorded in advance were already drawn by the painter, on a worker thread
+    bool replayed = aRecorded && aRecorded->Replay( aLayer, m_gal );
+
+    if( !replayed && !m_painter->Draw( static_cast<EDA_ITEM*>( aItem ), aLayer ) )
         aItem->ViewDraw( aLayer, this ); // Alternative drawing method
 
     m_gal->EndGroup();
@@ -1200,6 +1326,8 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
                 m_gal->DeleteGroup( prevGroup );
                 viewData->setGroup( l.id, -1 );
             }
+
+            viewData->deleteProxyGroup( m_gal, l.id );
         }
     }
 
@@ -1253,27 +1381,250 @@ void VIEW::RecacheAllItems()
 }
 
 
+struct VIEW::recordedItem
+{
+    ///> Range of DISPLAY_LIST commands drawing the item on a layer
+    struct LAYER
+    {
+        int    layer;
+        bool   drawn;       ///< False if the painter does not know the item
+        size_t begin;
+        size_t end;
+    };
+
+    recordedItem() :
+        item( nullptr ), thread( 0 ), first( 0 ), count( 0 ), list( nullptr ), layers( nullptr )
+    {
+    }
+
+    bool Replay( int aLayer, GAL* aGal ) const
+    {
+        for( unsigned i = 0; i < count; ++i )
+        {
+            if( layers[i].layer == aLayer )
+            {
+                if( !layers[i].drawn )
+                    return false;
+
+                list->Replay( aGal, layers[i].begin, layers[i].end );
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    VIEW_ITEM*              item;       ///< NULL if nothing was recorded
+    unsigned                thread;
+    unsigned                first;      ///< Index of the first layer recorded by the thread
+    unsigned                count;
+    const DISPLAY_LIST*     list;
+    const LAYER*            layers;
+};
+
+
+/**
+ * Struct geometryRecorder
+ * lets the painter draw the items queued for UpdateItems() on worker threads, each one
+ * with its own copy of the painter and a DISPLAY_LIST_RECORDER.  UpdateItems() then only
+ * has to replay the recorded commands into the cached groups of the real GAL, which
+ * does not support being called from several threads.
+ */
+struct VIEW::geometryRecorder
+{
+    ///> Minimal number of queued items worth starting threads for, e.g. on board load
+    ///> or RecacheAllItems()
+    static const unsigned MIN_ITEMS = 1000;
+
+    ///> Number of items taken at once by a thread
+    static const unsigned BLOCK_SIZE = 64;
+
+    static const unsigned MAX_THREADS = 8;
+
+    struct THREAD
+    {
+        DISPLAY_LIST                list;
+        std::vector<recordedItem::LAYER> layers;
+    };
+
+    geometryRecorder( VIEW* aView ) :
+        view( aView )
+    {
+    }
+
+    /**
+     * Function Run
+     * records the geometry of the queued items, if there are enough of them and the
+     * painter can be cloned.
+     */
+    void Run()
+    {
+        unsigned count = view->m_dirtyItems.size();
+        unsigned threadCount = std::thread::hardware_concurrency();
+
+        if( threadCount > MAX_THREADS )
+            threadCount = MAX_THREADS;
+
+        if( count < MIN_ITEMS || threadCount < 2 || !view->m_painter )
+            return;
+
+        std::vector<std::unique_ptr<PAINTER>> painters;
+
+        for( unsigned i = 0; i < threadCount; ++i )
+        {
+            PAINTER* painter = view->m_painter->Clone();
+
+            if( !painter )
+                return;
+
+            painters.emplace_back( painter );
+        }
+
+        items.resize( count );
+        threads.resize( threadCount );
+
+        std::atomic<unsigned> nextItem( 0 );
+        std::vector<std::thread> workers;
+
+        for( unsigned i = 0; i < threadCount; ++i )
+            workers.emplace_back( &geometryRecorder::record, this, i, painters[i].get(),
+                                  std::ref( nextItem ) );
+
+        for( auto& worker : workers )
+            worker.join();
+
+        // The thread buffers do not move any more
+        for( recordedItem& rec : items )
+        {
+            if( rec.item )
+            {
+                rec.list   = &threads[rec.thread].list;
+                rec.layers = threads[rec.thread].layers.data() + rec.first;
+            }
+        }
+    }
+
+    /// Returns the geometry recorded for queued item aIndex, or NULL if there is none
+    const recordedItem* Get( unsigned aIndex, VIEW_ITEM* aItem ) const
+    {
+        // Items removed while updating others change the queue order
+        if( aIndex < items.size() && items[aIndex].item == aItem )
+            return &items[aIndex];
+
+        return nullptr;
+    }
+
+    void record( unsigned aThread, PAINTER* aPainter, std::atomic<unsigned>& aNextItem )
+    {
+        THREAD& thread = threads[aThread];
+        DISPLAY_LIST_RECORDER gal( thread.list, *view->m_gal );
+
+        aPainter->SetGAL( &gal );
+
+        while( true )
+        {
+            unsigned begin = aNextItem.fetch_add( BLOCK_SIZE );
+
+            if( begin >= items.size() )
+                break;
+
+            unsigned end = std::min<unsigned>( begin + BLOCK_SIZE, items.size() );
+
+            for( unsigned i = begin; i < end; ++i )
+            {
+                VIEW_ITEM* item = view->m_dirtyItems[i];
+
+                if( !( item->viewPrivData()->m_requiredUpdate & ( GEOMETRY | LAYERS ) ) )
+                    continue;
+
+                int layers[VIEW_MAX_LAYERS], layers_count;
+                item->ViewGetLayers( layers, layers_count );
+
+                recordedItem& rec = items[i];
+                rec.item   = item;
+                rec.thread = aThread;
+                rec.first  = thread.layers.size();
+
+                for( int j = 0; j < layers_count; ++j )
+                {
+                    if( !view->IsCached( layers[j] ) )
+                        continue;
+
+                    recordedItem::LAYER layer;
+                    layer.layer = layers[j];
+                    layer.begin = thread.list.Size();
+                    layer.drawn = aPainter->Draw( static_cast<EDA_ITEM*>( item ), layers[j] );
+                    layer.end   = thread.list.Size();
+                    thread.layers.push_back( layer );
+                }
+
+                rec.count = thread.layers.size() - rec.first;
+            }
+        }
+    }
+
+    VIEW*                     view;
+    std::vector<recordedItem> items;
+    std::vector<THREAD>       threads;
+};
+
+
 void VIEW::UpdateItems()
 {
+    m_updatedItemsCount = 0;
+
+    if( m_dirtyItems.empty() )
+        return;
+
+    // Run the painter in parallel first, when there is a lot to draw
+    geometryRecorder recorder( this );
+    recorder.Run();
+
     m_gal->BeginUpdate();
 
-    for( VIEW_ITEM* item : m_allItems )
+    // Updating an item may queue others, which are then updated as well.
+    for( unsigned i = 0; i < m_dirtyItems.size(); ++i )
     {
+        VIEW_ITEM* item = m_dirtyItems[i];
         auto viewData = item->viewPrivData();
 
-        if( !viewData )
-            continue;
-
         if( viewData->m_requiredUpdate != NONE )
-            invalidateItem( item, viewData->m_requiredUpdate );
+        {
+            invalidateItem( item, viewData->m_requiredUpdate, recorder.Get( i, item ) );
+            ++m_updatedItemsCount;
+        }
 
         viewData->m_requiredUpdate = NONE;
+        viewData->m_dirtyIndex = -1;
     }
 
+    m_dirtyItems.clear();
+
     m_gal->EndUpdate();
 }
 
 
+void VIEW::dequeueItem( VIEW_ITEM* aItem )
+{
+    auto viewData = aItem->viewPrivData();
+    int  index = viewData->m_dirtyIndex;
+
+    if( index < 0 )
+        return;
+
+    std::vector<VIEW_ITEM*>& dirtyItems = viewData->m_view->m_dirtyItems;
+
+    // Order does not matter, fill the hole with the last item.
+    VIEW_ITEM* last = dirtyItems.back();
+
+    dirtyItems[index] = last;
+    last->viewPrivData()->m_dirtyIndex = index;
+    dirtyItems.pop_back();
+
+    viewData->m_dirtyIndex = -1;
+}
+
+
 struct VIEW::extentsVisitor
 {
     BOX2I extents;
@@ -1376,6 +1727,14 @@ void VIEW::Update( VIEW_ITEM* aItem, int aUpdateFlags )
 
     viewData->m_requiredUpdate |= aUpdateFlags;
 
+    // Queue the item on the view it belongs to, which may not be this one.
+    VIEW* view = viewData->m_view;
+
+    if( viewData->m_dirtyIndex < 0 )
+    {
+        viewData->m_dirtyIndex = view->m_dirtyItems.size();
+        view->m_dirtyItems.push_back( aItem );
+    }
 }
 
 const int VIEW::TOP_LAYER_MODIFIER = -VIEW_MAX_LAYERS;
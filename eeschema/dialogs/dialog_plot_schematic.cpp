@@ -40,6 +40,10 @@
 #include <dialog_plot_schematic.h>
 #include <wx_html_report_panel.h>
 
+#include <thread>
+#include <atomic>
+#include <set>
+
 // Keys for configuration
 #define PLOT_FORMAT_KEY wxT( "PlotFormat" )
 #define PLOT_MODECOLOR_KEY wxT( "PlotModeColor" )
@@ -71,6 +75,7 @@ DIALOG_PLOT_SCHEMATIC::DIALOG_PLOT_SCHEMATIC( SCH_EDIT_FRAME* parent ) :
 {
     m_parent = parent;
     m_configChanged = false;
+    m_plotColor = true;
     m_config = Kiface().KifaceSettings();
 
     initDlg();
@@ -221,7 +226,8 @@ void DIALOG_PLOT_SCHEMATIC::OnButtonCancelClick( wxCommandEvent& event )
 
 void DIALOG_PLOT_SCHEMATIC::getPlotOptions()
 {
-    m_config->Write( PLOT_MODECOLOR_KEY, getModeColor() );
+    m_plotColor = getModeColor();
+    m_config->Write( PLOT_MODECOLOR_KEY, m_plotColor );
     m_config->Write( PLOT_FRAME_REFERENCE_KEY, getPlotFrameRef() );
     m_config->Write( PLOT_FORMAT_KEY, (long) GetPlotFileFormat() );
     m_config->Write( PLOT_HPGL_ORIGIN_KEY, GetPlotOriginCenter() );
@@ -356,3 +362,174 @@ wxFileName DIALOG_PLOT_SCHEMATIC::createPlotFileName( wxTextCtrl* aOutputDirecto
     fn.SetPath( outputDir.GetFullPath() );
     return fn;
 }
+
+
+void DIALOG_PLOT_SCHEMATIC::buildPlotJobs( bool aPlotAll, const wxString& aExtension,
+                                           std::vector<SHEET_PLOT_JOB>& aJobs )
+{
+    REPORTER&       reporter = m_MessagesBox->Reporter();
+    SCH_SHEET_LIST  sheetList;
+
+    if( aPlotAll )
+        sheetList.BuildSheetList( g_RootSheet );
+    else
+        sheetList.push_back( m_parent->GetCurrentSheet() );
+
+    for( unsigned i = 0; i < sheetList.size(); i++ )
+    {
+        m_parent->SetCurrentSheet( sheetList[i] );
+        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
+        m_parent->SetSheetNumberAndCount();
+
+        SHEET_PLOT_JOB job;
+
+        job.m_SheetPath = sheetList[i];
+        job.m_Screen = m_parent->GetCurrentSheet().LastScreen();
+
+        if( !job.m_Screen ) // LastScreen() may return NULL
+            job.m_Screen = m_parent->GetScreen();
+
+        // The links to the library parts are resolved here, not by the plot threads
+        job.m_Screen->CheckComponentsToPartsLinks();
+
+        job.m_TitleBlock  = m_parent->GetTitleBlock();
+        job.m_SheetDesc   = m_parent->GetScreenDesc();
+        job.m_SheetNumber = job.m_Screen->m_ScreenNumber;
+        job.m_SheetCount  = job.m_Screen->m_NumberOfScreens;
+        job.m_Success     = false;
+
+        if( !aExtension.IsEmpty() )
+        {
+            try
+            {
+                wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
+                wxString ext = aExtension;
+
+                job.m_FileName = createPlotFileName( m_outputDirectoryName, fname, ext,
+                                                     &reporter ).GetFullPath();
+            }
+            catch( const IO_ERROR& e )
+            {
+                // Cannot plot this sheet, the others are still plotted
+                wxString msg;
+                msg.Printf( wxT( "Plotter exception: %s" ), GetChars( e.What() ) );
+                reporter.Report( msg, REPORTER::RPT_ERROR );
+                continue;
+            }
+        }
+
+        aJobs.push_back( job );
+    }
+}
+
+
+bool DIALOG_PLOT_SCHEMATIC::canPlotInParallel( const std::vector<SHEET_PLOT_JOB>& aJobs )
+{
+    if( aJobs.size() < 2 )
+        return false;
+
+    // A screen used by several sheets holds the references of only one of them at a time
+    std::set<SCH_SCREEN*> screens;
+
+    for( const SHEET_PLOT_JOB& job : aJobs )
+    {
+        if( !screens.insert( job.m_Screen ).second )
+            return false;
+    }
+
+    return true;
+}
+
+
+void DIALOG_PLOT_SCHEMATIC::runPlotJobs( std::vector<SHEET_PLOT_JOB>& aJobs,
+                                         const std::function<bool( SHEET_PLOT_JOB& )>& aPlotSheet,
+                                         bool aReportFiles )
+{
+    // Held for all the plot threads, they do not change the locale themselves
+    LOCALE_IO toggle;
+
+    auto plotSheet = [&]( SHEET_PLOT_JOB& aJob )
+    {
+        try
+        {
+            aJob.m_Success = aPlotSheet( aJob );
+        }
+        catch( const IO_ERROR& e )
+        {
+            aJob.m_Success = false;
+            aJob.m_Error = e.What();
+        }
+        catch( const std::exception& e )
+        {
+            aJob.m_Success = false;
+            aJob.m_Error = FROM_UTF8( e.what() );
+        }
+    };
+
+    if( canPlotInParallel( aJobs ) )
+    {
+        // The threads only read the screens and the library parts. They share the page
+        // layout, whose drawing list is built under a lock by PlotWorkSheet(), and each
+        // one has its own basic_gal to plot and measure texts (GraphicTextWidth())
+        std::atomic<unsigned> nextJob( 0 );
+
+        auto plotSheets = [&]()
+        {
+            for( unsigned i = nextJob++; i < aJobs.size(); i = nextJob++ )
+                plotSheet( aJobs[i] );
+        };
+
+        unsigned threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+        std::vector<std::thread> workers;
+
+        wxLogTrace( wxT( "PLOT_JOB" ), wxT( "Plotting %u sheets on %u threads" ),
+                    (unsigned) aJobs.size(), std::min( threadCount, (unsigned) aJobs.size() ) );
+
+        // This thread plots too
+        for( unsigned i = 1; i < threadCount && i < aJobs.size(); i++ )
+            workers.push_back( std::thread( plotSheets ) );
+
+        plotSheets();
+
+        for( std::thread& worker : workers )
+            worker.join();
+    }
+    else
+    {
+        for( SHEET_PLOT_JOB& job : aJobs )
+        {
+            m_parent->SetCurrentSheet( job.m_SheetPath );
+            m_parent->GetCurrentSheet().UpdateAllScreenReferences();
+            m_parent->SetSheetNumberAndCount();
+
+            plotSheet( job );
+        }
+    }
+
+    if( !aReportFiles )
+        return;
+
+    REPORTER& reporter = m_MessagesBox->Reporter();
+
+    // Reported in the sheet order, whatever the order the sheets were plotted in
+    for( const SHEET_PLOT_JOB& job : aJobs )
+    {
+        wxString msg;
+
+        if( job.m_Success )
+        {
+            msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( job.m_FileName ) );
+            reporter.Report( msg, REPORTER::RPT_ACTION );
+        }
+        else if( !job.m_Error.IsEmpty() )
+        {
+            msg.Printf( wxT( "Plotter exception: %s" ), GetChars( job.m_Error ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+        }
+        else
+        {
+            msg.Printf( _( "Unable to create file '%s'.\n" ), GetChars( job.m_FileName ) );
+            reporter.Report( msg, REPORTER::RPT_ERROR );
+        }
+    }
+}
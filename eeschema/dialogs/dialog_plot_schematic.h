@@ -34,6 +34,10 @@
 #include <schframe.h>
 #include <dialog_plot_schematic_base.h>
 #include <reporter.h>
+#include <class_title_block.h>
+#include <sch_sheet_path.h>
+
+#include <functional>
 
 
 enum PageFormatReq {
@@ -43,6 +47,27 @@ enum PageFormatReq {
 };
 
 
+/**
+ * Struct SHEET_PLOT_JOB
+ * holds what is needed to plot one sheet. It is gathered on the main thread
+ * when the sheet is the current one, so sheets can be plotted by several threads.
+ */
+struct SHEET_PLOT_JOB
+{
+    SCH_SHEET_PATH  m_SheetPath;
+    SCH_SCREEN*     m_Screen;
+    TITLE_BLOCK     m_TitleBlock;
+    wxString        m_SheetDesc;        // the sheet path shown in the frame reference
+    int             m_SheetNumber;
+    int             m_SheetCount;
+    wxString        m_FileName;         // the plot file, empty when the sheet is not
+                                        // plotted in a file of its own
+    bool            m_Success;
+    wxString        m_Error;            // the error message, if any
+    std::string     m_PageContent;      // PDF only: the compressed content of the page
+};
+
+
 class DIALOG_PLOT_SCHEMATIC : public DIALOG_PLOT_SCHEMATIC_BASE
 {
 private:
@@ -54,6 +79,7 @@ private:
                                             // use default size or force A or A4 size
     int             m_HPGLPaperSizeSelect;  // for HPGL format only: last selected paper size
     double          m_HPGLPenSize;          // for HPGL format only: pen size
+    bool            m_plotColor;            // the color option, read for the threads
 
 public:
     // / Constructors
@@ -91,21 +117,51 @@ private:
 
     void PlotSchematic( bool aPlotAll );
 
+    /**
+     * Function buildPlotJobs
+     * makes the plot jobs of the current sheet or of all the sheets. Each sheet becomes the
+     * current one in turn, and its components are resolved.
+     * @param aExtension = the extension of the plot files, or empty if the sheets are not
+     *                     plotted in files of their own
+     * @param aJobs = the jobs, sheets whose file name cannot be built are reported and skipped
+     */
+    void buildPlotJobs( bool aPlotAll, const wxString& aExtension,
+                        std::vector<SHEET_PLOT_JOB>& aJobs );
+
+    /**
+     * Function canPlotInParallel
+     * @return true if the jobs can be plotted by several threads, i.e. there is more than
+     * one job and no screen is shared between the sheets (in complex hierarchies, the
+     * references of a shared screen depend on the current sheet)
+     */
+    static bool canPlotInParallel( const std::vector<SHEET_PLOT_JOB>& aJobs );
+
+    /**
+     * Function runPlotJobs
+     * calls aPlotSheet for every job, on several threads when possible, else in sequence,
+     * each sheet being the current one in turn.
+     * @param aReportFiles = true to report every plot file
+     */
+    void runPlotJobs( std::vector<SHEET_PLOT_JOB>& aJobs,
+                      const std::function<bool( SHEET_PLOT_JOB& )>& aPlotSheet,
+                      bool aReportFiles = true );
+
     // PDF
     void    createPDFFile( bool aPlotAll, bool aPlotFrameRef );
-    void    plotOneSheetPDF( PLOTTER* aPlotter, SCH_SCREEN* aScreen, bool aPlotFrameRef);
+    void    plotOneSheetPDF( PLOTTER* aPlotter, const SHEET_PLOT_JOB& aJob, bool aPlotFrameRef );
     void    setupPlotPagePDF( PLOTTER* aPlotter, SCH_SCREEN* aScreen );
 
     /**
     * Everything done, close the plot and restore the environment
     * @param aPlotter the plotter to close and destroy
     * @param aOldsheetpath the stored old sheet path for the current sheet before the plot started
+    * @return false if the end of the PDF file could not be written
     */
-    void    restoreEnvironment( PDF_PLOTTER* aPlotter, SCH_SHEET_PATH& aOldsheetpath );
+    bool    restoreEnvironment( PDF_PLOTTER* aPlotter, SCH_SHEET_PATH& aOldsheetpath );
 
     // DXF
     void    CreateDXFFile( bool aPlotAll, bool aPlotFrameRef );
-    bool    PlotOneSheetDXF( const wxString& aFileName, SCH_SCREEN* aScreen,
+    bool    PlotOneSheetDXF( const SHEET_PLOT_JOB& aJob,
                              wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
     // HPGL
@@ -121,13 +177,13 @@ private:
 
     void    createHPGLFile( bool aPlotAll, bool aPlotFrameRef );
     void    SetHPGLPenWidth();
-    bool    Plot_1_Page_HPGL( const wxString& aFileName, SCH_SCREEN* aScreen,
+    bool    Plot_1_Page_HPGL( const SHEET_PLOT_JOB& aJob,
                               const PAGE_INFO& aPageInfo,
                               wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
     // PS
     void    createPSFile( bool aPlotAll, bool aPlotFrameRef );
-    bool    plotOneSheetPS( const wxString& aFileName, SCH_SCREEN* aScreen,
+    bool    plotOneSheetPS( const SHEET_PLOT_JOB& aJob,
                             const PAGE_INFO& aPageInfo,
                             wxPoint aPlot0ffset, double aScale, bool aPlotFrameRef );
 
@@ -154,4 +210,7 @@ public:
     static bool plotOneSheetSVG( EDA_DRAW_FRAME* aFrame, const wxString& aFileName,
                                  SCH_SCREEN* aScreen,
                                  bool aPlotBlackAndWhite, bool aPlotFrameRef );
+
+    static bool plotOneSheetSVG( const SHEET_PLOT_JOB& aJob,
+                                 bool aPlotBlackAndWhite, bool aPlotFrameRef );
 };
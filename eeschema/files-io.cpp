@@ -42,21 +42,68 @@
 #include <sch_sheet.h>
 #include <sch_sheet_path.h>
 #include <sch_component.h>
+#include <sch_bitmap.h>
 #include <wildcards_and_files_ext.h>
 #include <project_rescue.h>
 #include <eeschema_config.h>
 #include <sch_legacy_plugin.h>
+#include <background_saver.h>
+
+#include <memory>
 
 
 //#define USE_SCH_LEGACY_IO_PLUGIN
 
 
+/**
+ * Function copyScreen
+ * makes a copy of \a aScreen holding everything SCH_LEGACY_PLUGIN writes, so that the
+ * copy can be formatted on another thread while the original is being edited.
+ */
+static SCH_SCREEN* copyScreen( SCH_SCREEN* aScreen, KIWAY* aKiway )
+{
+    SCH_SCREEN* copy = new SCH_SCREEN( aKiway );
+
+    copy->SetFileName( aScreen->GetFileName() );
+    copy->SetPageSettings( aScreen->GetPageSettings() );
+    copy->SetTitleBlock( aScreen->GetTitleBlock() );
+    copy->m_ScreenNumber    = aScreen->m_ScreenNumber;
+    copy->m_NumberOfScreens = aScreen->m_NumberOfScreens;
+
+    for( SCH_ITEM* item = aScreen->GetDrawItems(); item; item = item->Next() )
+    {
+        if( item->Type() == SCH_MARKER_T )      // not saved
+            continue;
+
+        SCH_ITEM* clone = static_cast<SCH_ITEM*>( item->Clone() );
+
+        if( clone->Type() == SCH_SHEET_T )
+        {
+            // A sheet copy shares the screen of the sheet, and would update its reference
+            // count from the worker thread.  Only the sheet file name is saved.
+            static_cast<SCH_SHEET*>( clone )->SetScreen( NULL );
+        }
+        else if( clone->Type() == SCH_BITMAP_T )
+        {
+            // The copied wxImage shares its data with the original one, and the wxBitmap
+            // used to draw it cannot be deleted by the worker thread.
+            BITMAP_BASE* image = static_cast<SCH_BITMAP*>( clone )->GetImage();
+
+            image->SetBitmap( NULL );
+            image->SetImage( new wxImage( image->GetImageData()->Copy() ) );
+        }
+
+        copy->Append( clone );
+    }
+
+    return copy;
+}
+
+
 bool SCH_EDIT_FRAME::SaveEEFile( SCH_SCREEN* aScreen, bool aSaveUnderNewName,
                                  bool aCreateBackupFile )
 {
-    wxString msg;
     wxFileName schematicFileName;
-    bool success;
 
     if( aScreen == NULL )
         aScreen = GetScreen();
@@ -88,93 +135,108 @@ bool SCH_EDIT_FRAME::SaveEEFile( SCH_SCREEN* aScreen, bool aSaveUnderNewName,
         return false;
 
     // Create backup if requested
+    wxFileName backupFileName;
+
     if( aCreateBackupFile && schematicFileName.FileExists() )
     {
-        wxFileName backupFileName = schematicFileName;
-
-        // Rename the old file to a '.bak' one:
+        backupFileName = schematicFileName;
         backupFileName.SetExt( SchematicBackupFileExtension );
-
-        if( backupFileName.FileExists() )
-            wxRemoveFile( backupFileName.GetFullPath() );
-
-        if( !wxRenameFile( schematicFileName.GetFullPath(), backupFileName.GetFullPath() ) )
-        {
-            msg.Printf( _( "Could not save backup of file '%s'" ),
-                        GetChars( schematicFileName.GetFullPath() ) );
-            DisplayError( this, msg );
-        }
     }
 
     // Save
     wxLogTrace( traceAutoSave,
                 wxT( "Saving file <" ) + schematicFileName.GetFullPath() + wxT( ">" ) );
 
-#ifdef KICAD_USE_SCH_IO_MANAGER
-        SCH_PLUGIN::SCH_PLUGIN_RELEASER pi( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_LEGACY ) );
+    // Copy the screen here, and format the copy on a worker thread while the user goes
+    // on editing.  The background saver also renames the old file to a '.bak' one, once
+    // the new file is written.
+    std::shared_ptr<SCH_SCREEN> copy( copyScreen( aScreen, &Kiway() ) );
+    wxArrayString               libNames;
 
-        try
-        {
-            pi->Save( schematicFileName.GetFullPath(), aScreen, &Kiway() );
-            success = true;
-        }
-        catch( const IO_ERROR& ioe )
+    for( const PART_LIB& lib : *Prj().SchLibs() )
+        libNames.Add( lib.GetName().Clone() );
+
+    m_backgroundSaver->Queue( schematicFileName.GetFullPath(),
+        [copy, libNames]( OUTPUTFORMATTER* aFormatter )
         {
-            msg.Printf( _( "Error saving schematic file '%s'.\n%s" ),
-                        GetChars( schematicFileName.GetFullPath() ), GetChars( ioe.What() ) );
-            DisplayError( this, msg );
+            SCH_LEGACY_PLUGIN().Format( copy.get(), aFormatter, libNames );
+        },
+        backupFileName.IsOk() ? backupFileName.GetFullPath() : wxString() );
 
-            msg.Printf( _( "Failed to save '%s'" ), GetChars( schematicFileName.GetFullPath() ) );
-            AppendMsgPanel( wxEmptyString, msg, CYAN );
+    // Update the screen and frame info.  The rest is done by onBackgroundSaveDone() once
+    // the file is written.
+    if( aSaveUnderNewName )
+        aScreen->SetFileName( schematicFileName.GetFullPath() );
+
+    aScreen->ClrSave();
+    aScreen->ClrModify();
+
+    return true;
+}
 
-            success = false;
-        }
-#else
-    FILE* f = wxFopen( schematicFileName.GetFullPath(), wxT( "wt" ) );
 
-    if( !f )
+void SCH_EDIT_FRAME::schematicSaved( const wxFileName& aFileName )
+{
+    // Delete auto save file.
+    wxFileName autoSaveFileName = aFileName;
+    autoSaveFileName.SetName( AUTOSAVE_PREFIX_FILENAME + aFileName.GetName() );
+
+    if( autoSaveFileName.FileExists() )
     {
-        msg.Printf( _( "Failed to create file '%s'" ),
-                    GetChars( schematicFileName.GetFullPath() ) );
-        DisplayError( this, msg );
-        return false;
+        wxLogTrace( traceAutoSave,
+                    wxT( "Removing auto save file <" ) + autoSaveFileName.GetFullPath() +
+                    wxT( ">" ) );
+
+        wxRemoveFile( autoSaveFileName.GetFullPath() );
     }
 
-    success = aScreen->Save( f );
-    fclose( f );
-#endif
+    wxString msg;
 
-    if( success )
+    msg.Printf( _( "File %s saved" ), GetChars( aFileName.GetFullPath() ) );
+    SetStatusText( msg, 0 );
+}
+
+
+void SCH_EDIT_FRAME::onBackgroundSaveDone( wxThreadEvent& aEvent )
+{
+    wxFileName schematicFileName = aEvent.GetString();
+
+    if( aEvent.GetInt() )
     {
-        // Delete auto save file.
-        wxFileName autoSaveFileName = schematicFileName;
-        autoSaveFileName.SetName( AUTOSAVE_PREFIX_FILENAME + schematicFileName.GetName() );
+        // A warning, e.g. the backup file could not be made.
+        if( !aEvent.GetPayload<wxString>().IsEmpty() )
+            DisplayError( this, aEvent.GetPayload<wxString>() );
 
-        if( autoSaveFileName.FileExists() )
-        {
-            wxLogTrace( traceAutoSave,
-                        wxT( "Removing auto save file <" ) + autoSaveFileName.GetFullPath() +
-                        wxT( ">" ) );
+        schematicSaved( schematicFileName );
+        return;
+    }
 
-            wxRemoveFile( autoSaveFileName.GetFullPath() );
-        }
+    wxString msg;
 
-        // Update the screen and frame info.
-        if( aSaveUnderNewName )
-            aScreen->SetFileName( schematicFileName.GetFullPath() );
+    msg.Printf( _( "Error saving schematic file '%s'.\n%s" ),
+                GetChars( schematicFileName.GetFullPath() ),
+                GetChars( aEvent.GetPayload<wxString>() ) );
+    DisplayError( this, msg );
 
-        aScreen->ClrSave();
-        aScreen->ClrModify();
+    msg.Printf( _( "Failed to save '%s'" ), GetChars( schematicFileName.GetFullPath() ) );
+    AppendMsgPanel( wxEmptyString, msg, CYAN );
 
-        msg.Printf( _( "File %s saved" ), GetChars( aScreen->GetFileName() ) );
-        SetStatusText( msg, 0 );
-    }
-    else
+    // The screen was marked saved when the file was queued.
+    SCH_SCREENS screens;
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
     {
-        DisplayError( this, _( "File write operation failed." ) );
+        if( Prj().AbsolutePath( screen->GetFileName() ) == schematicFileName.GetFullPath() )
+            screen->SetModify();
     }
 
-    return success;
+    OnModify();
+}
+
+
+void SCH_EDIT_FRAME::WaitForBackgroundSave()
+{
+    m_backgroundSaver->Wait();
 }
 
 
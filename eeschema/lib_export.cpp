@@ -139,6 +139,7 @@ void LIB_EDIT_FRAME::OnExportPart( wxCommandEvent& event )
         FILE_OUTPUTFORMATTER    formatter( fn.GetFullPath() );
 
         result = temp_lib.get()->Save( formatter );
+        formatter.Finish();
     }
     catch( ... /* IO_ERROR ioe */ )
     {
@@ -157,6 +158,7 @@ void LIB_EDIT_FRAME::OnExportPart( wxCommandEvent& event )
         FILE_OUTPUTFORMATTER    formatter( docFileName.GetFullPath() );
 
         result = temp_lib.get()->SaveDocs( formatter );
+        formatter.Finish();
     }
     catch( ... /* IO_ERROR ioe */ )
     {
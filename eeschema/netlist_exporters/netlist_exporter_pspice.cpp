@@ -43,7 +43,11 @@ bool NETLIST_EXPORTER_PSPICE::WriteNetlist( const wxString& aOutFileName, unsign
 {
     FILE_OUTPUTFORMATTER outputFile( aOutFileName, wxT( "wt" ), '\'' );
 
-    return Format( &outputFile, aNetlistOptions );
+    bool success = Format( &outputFile, aNetlistOptions );
+
+    outputFile.Finish();
+
+    return success;
 }
 
 void  NETLIST_EXPORTER_PSPICE::ReplaceForbiddenChars( wxString &aNetName )
@@ -39,7 +39,6 @@
 void DIALOG_PLOT_SCHEMATIC::CreateDXFFile( bool aPlotAll, bool aPlotFrameRef )
 {
     SCH_EDIT_FRAME* schframe  = m_parent;
-    SCH_SCREEN*     screen    = schframe->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = schframe->GetCurrentSheet();
 
     /* When printing all pages, the printed page is not the current page.
@@ -48,55 +47,16 @@ void DIALOG_PLOT_SCHEMATIC::CreateDXFFile( bool aPlotAll, bool aPlotFrameRef )
      *  because in complex hierarchies a SCH_SCREEN (a schematic drawings)
      *  is shared between many sheets
      */
-    SCH_SHEET_LIST sheetList;
+    std::vector<SHEET_PLOT_JOB> jobs;
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( schframe->GetCurrentSheet() );
+    buildPlotJobs( aPlotAll, DXF_PLOTTER::GetDefaultFileExtension(), jobs );
 
-    REPORTER& reporter = m_MessagesBox->Reporter();
+    runPlotJobs( jobs, [&]( SHEET_PLOT_JOB& aJob )
+                 {
+                     wxPoint plot_offset;
 
-    for( unsigned i = 0; i < sheetList.size();  i++ )
-    {
-        schframe->SetCurrentSheet( sheetList[i] );
-        schframe->GetCurrentSheet().UpdateAllScreenReferences();
-        schframe->SetSheetNumberAndCount();
-        screen = schframe->GetCurrentSheet().LastScreen();
-
-        wxPoint plot_offset;
-        wxString msg;
-
-        try
-        {
-            wxString fname = schframe->GetUniqueFilenameForCurrentSheet();
-            wxString ext = DXF_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName, fname,
-                                                          ext, &reporter );
-
-            if( PlotOneSheetDXF( plotFileName.GetFullPath(), screen, plot_offset, 1.0,
-                                 aPlotFrameRef ) )
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-            else    // Error
-            {
-                msg.Printf( _( "Unable to create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-        }
-        catch( IO_ERROR& e )
-        {
-            msg.Printf( wxT( "DXF Plotter exception: %s"), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-            schframe->SetCurrentSheet( oldsheetpath );
-            schframe->GetCurrentSheet().UpdateAllScreenReferences();
-            schframe->SetSheetNumberAndCount();
-            return;
-        }
-    }
+                     return PlotOneSheetDXF( aJob, plot_offset, 1.0, aPlotFrameRef );
+                 } );
 
     schframe->SetCurrentSheet( oldsheetpath );
     schframe->GetCurrentSheet().UpdateAllScreenReferences();
@@ -104,43 +64,40 @@ void DIALOG_PLOT_SCHEMATIC::CreateDXFFile( bool aPlotAll, bool aPlotFrameRef )
 }
 
 
-bool DIALOG_PLOT_SCHEMATIC::PlotOneSheetDXF( const wxString&    aFileName,
-                                             SCH_SCREEN*        aScreen,
+bool DIALOG_PLOT_SCHEMATIC::PlotOneSheetDXF( const SHEET_PLOT_JOB& aJob,
                                              wxPoint            aPlotOffset,
                                              double             aScale,
                                              bool aPlotFrameRef )
 {
     DXF_PLOTTER* plotter = new DXF_PLOTTER();
 
-    const PAGE_INFO&   pageInfo = aScreen->GetPageSettings();
+    const PAGE_INFO&   pageInfo = aJob.m_Screen->GetPageSettings();
     plotter->SetPageSettings( pageInfo );
-    plotter->SetColorMode( getModeColor() );
+    plotter->SetColorMode( m_plotColor );
     // Currently, plot units are in decimil
     plotter->SetViewport( aPlotOffset, IU_PER_MILS/10, aScale, false );
 
     // Init :
     plotter->SetCreator( wxT( "Eeschema-DXF" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aJob.m_FileName ) )
     {
         delete plotter;
         return false;
     }
 
-    LOCALE_IO   toggle;
-
     plotter->StartPlot();
 
     if( aPlotFrameRef )
     {
-        PlotWorkSheet( plotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
+        PlotWorkSheet( plotter, aJob.m_TitleBlock,
+                       pageInfo,
+                       aJob.m_SheetNumber, aJob.m_SheetCount,
+                       aJob.m_SheetDesc,
+                       aJob.m_Screen->GetFileName() );
     }
 
-    aScreen->Plot( plotter );
+    aJob.m_Screen->Plot( plotter );
 
     // finish
     plotter->EndPlot();
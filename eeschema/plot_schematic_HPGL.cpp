@@ -110,7 +110,6 @@ void DIALOG_PLOT_SCHEMATIC::SetHPGLPenWidth()
 
 void DIALOG_PLOT_SCHEMATIC::createHPGLFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
 
     /* When printing all pages, the printed page is not the current page.
@@ -119,78 +118,41 @@ void DIALOG_PLOT_SCHEMATIC::createHPGLFile( bool aPlotAll, bool aPlotFrameRef )
      *  because in complex hierarchies a SCH_SCREEN (a schematic drawings)
      *  is shared between many sheets
      */
-    SCH_SHEET_LIST  sheetList;
+    std::vector<SHEET_PLOT_JOB> jobs;
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    SetHPGLPenWidth();
 
-    REPORTER& reporter = m_MessagesBox->Reporter();
+    // The controls are read here, the sheets may be plotted by other threads
+    int     paperSize = m_HPGLPaperSizeOption->GetSelection();
+    bool    originCenter = GetPlotOriginCenter();
 
-    SetHPGLPenWidth();
+    buildPlotJobs( aPlotAll, HPGL_PLOTTER::GetDefaultFileExtension(), jobs );
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-
-        screen = m_parent->GetCurrentSheet().LastScreen();
-
-        if( !screen ) // LastScreen() may return NULL
-            screen = m_parent->GetScreen();
-
-        const PAGE_INFO&    curPage = screen->GetPageSettings();
-
-        PAGE_INFO           plotPage = curPage;
-
-        // if plotting on a page size other than curPage
-        if( m_HPGLPaperSizeOption->GetSelection() != PAGE_DEFAULT )
-            plotPage.SetType( plot_sheet_list( m_HPGLPaperSizeOption->GetSelection() ) );
-
-        // Calculation of conversion scales.
-        double  plot_scale = (double) plotPage.GetWidthMils() / curPage.GetWidthMils();
-
-        // Calculate offsets
-        wxPoint plotOffset;
-        wxString msg;
-
-        if( GetPlotOriginCenter() )
-        {
-            plotOffset.x    = plotPage.GetWidthIU() / 2;
-            plotOffset.y    = -plotPage.GetHeightIU() / 2;
-        }
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = HPGL_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName, fname,
-                                                          ext, &reporter );
-
-            LOCALE_IO toggle;
-
-            if( Plot_1_Page_HPGL( plotFileName.GetFullPath(), screen, plotPage, plotOffset,
-                                  plot_scale, aPlotFrameRef ) )
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-            else
-            {
-                msg.Printf( _( "Unable to create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-        }
-        catch( IO_ERROR& e )
-        {
-            msg.Printf( wxT( "HPGL Plotter exception: %s"), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-        }
+    runPlotJobs( jobs, [&]( SHEET_PLOT_JOB& aJob )
+                 {
+                     const PAGE_INFO&    curPage = aJob.m_Screen->GetPageSettings();
 
-    }
+                     PAGE_INFO           plotPage = curPage;
+
+                     // if plotting on a page size other than curPage
+                     if( paperSize != PAGE_DEFAULT )
+                         plotPage.SetType( plot_sheet_list( paperSize ) );
+
+                     // Calculation of conversion scales.
+                     double  plot_scale = (double) plotPage.GetWidthMils() / curPage.GetWidthMils();
+
+                     // Calculate offsets
+                     wxPoint plotOffset;
+
+                     if( originCenter )
+                     {
+                         plotOffset.x    = plotPage.GetWidthIU() / 2;
+                         plotOffset.y    = -plotPage.GetHeightIU() / 2;
+                     }
+
+                     return Plot_1_Page_HPGL( aJob, plotPage, plotOffset, plot_scale,
+                                              aPlotFrameRef );
+                 } );
 
     m_parent->SetCurrentSheet( oldsheetpath );
     m_parent->GetCurrentSheet().UpdateAllScreenReferences();
@@ -198,8 +160,7 @@ void DIALOG_PLOT_SCHEMATIC::createHPGLFile( bool aPlotAll, bool aPlotFrameRef )
 }
 
 
-bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
-                                              SCH_SCREEN*       aScreen,
+bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const SHEET_PLOT_JOB& aJob,
                                               const PAGE_INFO&  aPageInfo,
                                               wxPoint           aPlot0ffset,
                                               double            aScale,
@@ -214,14 +175,12 @@ bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
     // Init :
     plotter->SetCreator( wxT( "Eeschema-HPGL" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aJob.m_FileName ) )
     {
         delete plotter;
         return false;
     }
 
-    LOCALE_IO toggle;
-
     // Pen num and pen speed are not initialized here.
     // Default HPGL driver values are used
     plotter->SetPenDiameter( m_HPGLPenSize );
@@ -229,14 +188,14 @@ bool DIALOG_PLOT_SCHEMATIC::Plot_1_Page_HPGL( const wxString&   aFileName,
 
     plotter->SetColor( BLACK );
 
-    if( getPlotFrameRef() )
-        PlotWorkSheet( plotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
+    if( aPlotFrameRef )
+        PlotWorkSheet( plotter, aJob.m_TitleBlock,
+                       aJob.m_Screen->GetPageSettings(),
+                       aJob.m_SheetNumber, aJob.m_SheetCount,
+                       aJob.m_SheetDesc,
+                       aJob.m_Screen->GetFileName() );
 
-    aScreen->Plot( plotter );
+    aJob.m_Screen->Plot( plotter );
 
     plotter->EndPlot();
     delete plotter;
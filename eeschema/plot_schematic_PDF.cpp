@@ -40,7 +40,6 @@
 
 void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();     // sheetpath is saved here
 
     /* When printing all pages, the printed page is not the current page.  In
@@ -50,17 +49,18 @@ void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
      * between many sheets and component references depend on the actual sheet
      * path used
      */
-    SCH_SHEET_LIST sheetList;
+    std::vector<SHEET_PLOT_JOB> jobs;
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    // All the sheets go in one file, named after the first one
+    buildPlotJobs( aPlotAll, wxEmptyString, jobs );
+
+    if( jobs.empty() )
+        return;
 
     // Allocate the plotter and set the job level parameter
     PDF_PLOTTER* plotter = new PDF_PLOTTER();
     plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
-    plotter->SetColorMode( getModeColor() );
+    plotter->SetColorMode( m_plotColor );
     plotter->SetCreator( wxT( "Eeschema-PDF" ) );
 
     wxString msg;
@@ -68,12 +68,42 @@ void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
     REPORTER& reporter = m_MessagesBox->Reporter();
     LOCALE_IO toggle;       // Switch the locale to standard C
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
+    /* When the sheets do not share screens, every page is plotted in memory by a
+     * plotter of its own, on several threads, and the pages are then added to the
+     * document in the sheet order */
+    bool parallel = canPlotInParallel( jobs );
+    int  missingPages = 0;
+
+    if( parallel )
+    {
+        runPlotJobs( jobs, [&]( SHEET_PLOT_JOB& aJob )
+                     {
+                         PDF_PLOTTER page;
+
+                         page.SetDefaultLineWidth( GetDefaultLineThickness() );
+                         page.SetColorMode( m_plotColor );
+                         setupPlotPagePDF( &page, aJob.m_Screen );
+                         page.StartPageContent();
+                         plotOneSheetPDF( &page, aJob, aPlotFrameRef );
+
+                         if( !page.ClosePageContent() )
+                         {
+                             aJob.m_Error = wxT( "the page cannot be compressed" );
+                             return false;
+                         }
+
+                         aJob.m_PageContent = page.GetPageContent();
+                         return true;
+                     }, false );
+    }
+
+    for( unsigned i = 0; i < jobs.size(); i++ )
     {
-        m_parent->SetCurrentSheet( sheetList[i] );
+        SHEET_PLOT_JOB& job = jobs[i];
+
+        m_parent->SetCurrentSheet( job.m_SheetPath );
         m_parent->GetCurrentSheet().UpdateAllScreenReferences();
         m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
 
         if( i == 0 )
         {
@@ -91,12 +121,19 @@ void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
                                 GetChars( plotFileName.GetFullPath() ) );
                     reporter.Report( msg, REPORTER::RPT_ERROR );
                     delete plotter;
+                    m_parent->SetCurrentSheet( oldsheetpath );
+                    m_parent->GetCurrentSheet().UpdateAllScreenReferences();
+                    m_parent->SetSheetNumberAndCount();
                     return;
                 }
 
                 // Open the plotter and do the first page
-                setupPlotPagePDF( plotter, screen );
-                plotter->StartPlot();
+                setupPlotPagePDF( plotter, job.m_Screen );
+
+                if( parallel )
+                    plotter->StartDocument();
+                else
+                    plotter->StartPlot();
             }
             catch( const IO_ERROR& e )
             {
@@ -109,54 +146,91 @@ void DIALOG_PLOT_SCHEMATIC::createPDFFile( bool aPlotAll, bool aPlotFrameRef )
             }
 
         }
+        else if( parallel )
+        {
+            setupPlotPagePDF( plotter, job.m_Screen );
+        }
         else
         {
             /* For the following pages you need to close the (finished) page,
              *  reconfigure, and then start a new one */
             plotter->ClosePage();
-            setupPlotPagePDF( plotter, screen );
+            setupPlotPagePDF( plotter, job.m_Screen );
             plotter->StartPage();
         }
 
-        plotOneSheetPDF( plotter, screen, aPlotFrameRef );
+        if( parallel )
+        {
+            if( job.m_Success )
+            {
+                plotter->AddPage( job.m_PageContent );
+                std::string().swap( job.m_PageContent );
+            }
+            else
+            {
+                // A sheet which could not be plotted has no valid compressed content,
+                // so it gets no page
+                msg.Printf( wxT( "PDF Plotter exception: %s" ), GetChars( job.m_Error ) );
+                reporter.Report( msg, REPORTER::RPT_ERROR );
+                missingPages++;
+            }
+        }
+        else
+        {
+            plotOneSheetPDF( plotter, job, aPlotFrameRef );
+        }
     }
 
     // Everything done, close the plot and restore the environment
-    msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-    reporter.Report( msg, REPORTER::RPT_ACTION );
-
-    restoreEnvironment( plotter, oldsheetpath );
+    if( !restoreEnvironment( plotter, oldsheetpath ) )
+    {
+        msg.Printf( _( "Unable to write file '%s'.\n" ), GetChars( plotFileName.GetFullPath() ) );
+        reporter.Report( msg, REPORTER::RPT_ERROR );
+    }
+    else if( missingPages )
+    {
+        msg.Printf( _( "Plot: '%s' lacks %d sheet(s) which could not be plotted.\n" ),
+                    GetChars( plotFileName.GetFullPath() ), missingPages );
+        reporter.Report( msg, REPORTER::RPT_ERROR );
+    }
+    else
+    {
+        msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
+        reporter.Report( msg, REPORTER::RPT_ACTION );
+    }
 }
 
 
-void DIALOG_PLOT_SCHEMATIC::restoreEnvironment( PDF_PLOTTER* aPlotter,
+bool DIALOG_PLOT_SCHEMATIC::restoreEnvironment( PDF_PLOTTER* aPlotter,
                                                 SCH_SHEET_PATH& aOldsheetpath )
 {
-    aPlotter->EndPlot();
+    bool success = aPlotter->EndPlot();
     delete aPlotter;
 
     // Restore the previous sheet
     m_parent->SetCurrentSheet( aOldsheetpath );
     m_parent->GetCurrentSheet().UpdateAllScreenReferences();
     m_parent->SetSheetNumberAndCount();
+
+    return success;
 }
 
 
 void DIALOG_PLOT_SCHEMATIC::plotOneSheetPDF( PLOTTER* aPlotter,
-                                             SCH_SCREEN* aScreen,
+                                             const SHEET_PLOT_JOB& aJob,
                                              bool aPlotFrameRef )
 {
     if( aPlotFrameRef )
     {
         aPlotter->SetColor( BLACK );
-        PlotWorkSheet( aPlotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
+        PlotWorkSheet( aPlotter, aJob.m_TitleBlock,
+                       aJob.m_Screen->GetPageSettings(),
+                       aJob.m_SheetNumber, aJob.m_SheetCount,
+                       aJob.m_SheetDesc,
+                       aJob.m_Screen->GetFileName() );
     }
 
-    aScreen->Plot( aPlotter );
+    aJob.m_Screen->Plot( aPlotter );
 }
 
 
@@ -38,10 +38,7 @@
 
 void DIALOG_PLOT_SCHEMATIC::createPSFile( bool aPlotAll, bool aPlotFrameRef )
 {
-    SCH_SCREEN*     screen = m_parent->GetScreen();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();  // sheetpath is saved here
-    PAGE_INFO       actualPage;                                  // page size selected in schematic
-    PAGE_INFO       plotPage;                                    // page size selected to plot
 
     /* When printing all pages, the printed page is not the current page.
      * In complex hierarchies, we must update component references
@@ -49,79 +46,42 @@ void DIALOG_PLOT_SCHEMATIC::createPSFile( bool aPlotAll, bool aPlotFrameRef )
      *  because in complex hierarchies a SCH_SCREEN (a drawing )
      *  is shared between many sheets and component references depend on the actual sheet path used
      */
-    SCH_SHEET_LIST  sheetList;
+    std::vector<SHEET_PLOT_JOB> jobs;
 
-    if( aPlotAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    buildPlotJobs( aPlotAll, PS_PLOTTER::GetDefaultFileExtension(), jobs );
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
-        actualPage = screen->GetPageSettings();
-
-        switch( m_pageSizeSelect )
-        {
-        case PAGE_SIZE_A:
-            plotPage.SetType( wxT( "A" ) );
-            plotPage.SetPortrait( actualPage.IsPortrait() );
-            break;
-
-        case PAGE_SIZE_A4:
-            plotPage.SetType( wxT( "A4" ) );
-            plotPage.SetPortrait( actualPage.IsPortrait() );
-            break;
-
-        case PAGE_SIZE_AUTO:
-        default:
-            plotPage = actualPage;
-            break;
-        }
-
-        double  scalex  = (double) plotPage.GetWidthMils() / actualPage.GetWidthMils();
-        double  scaley  = (double) plotPage.GetHeightMils() / actualPage.GetHeightMils();
-
-        double  scale = std::min( scalex, scaley );
-
-        wxPoint plot_offset;
-
-        wxString outputDirName = m_outputDirectoryName->GetValue();
-
-        wxString msg;
-        REPORTER& reporter = m_MessagesBox->Reporter();
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = PS_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                          fname, ext, &reporter );
-
-            if( plotOneSheetPS( plotFileName.GetFullPath(), screen, plotPage, plot_offset,
-                                scale, aPlotFrameRef ) )
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ), GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-            else
-            {
-                // Error
-                msg.Printf( _( "Unable to create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-
-        }
-        catch( IO_ERROR& e )
-        {
-            msg.Printf( wxT( "PS Plotter exception: %s"), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-        }
-    }
+    runPlotJobs( jobs, [&]( SHEET_PLOT_JOB& aJob )
+                 {
+                     const PAGE_INFO& actualPage = aJob.m_Screen->GetPageSettings();
+                     PAGE_INFO        plotPage;     // page size selected to plot
+
+                     switch( m_pageSizeSelect )
+                     {
+                     case PAGE_SIZE_A:
+                         plotPage.SetType( wxT( "A" ) );
+                         plotPage.SetPortrait( actualPage.IsPortrait() );
+                         break;
+
+                     case PAGE_SIZE_A4:
+                         plotPage.SetType( wxT( "A4" ) );
+                         plotPage.SetPortrait( actualPage.IsPortrait() );
+                         break;
+
+                     case PAGE_SIZE_AUTO:
+                     default:
+                         plotPage = actualPage;
+                         break;
+                     }
+
+                     double  scalex  = (double) plotPage.GetWidthMils() / actualPage.GetWidthMils();
+                     double  scaley  = (double) plotPage.GetHeightMils() / actualPage.GetHeightMils();
+
+                     double  scale = std::min( scalex, scaley );
+
+                     wxPoint plot_offset;
+
+                     return plotOneSheetPS( aJob, plotPage, plot_offset, scale, aPlotFrameRef );
+                 } );
 
     m_parent->SetCurrentSheet( oldsheetpath );
     m_parent->GetCurrentSheet().UpdateAllScreenReferences();
@@ -129,8 +89,7 @@ void DIALOG_PLOT_SCHEMATIC::createPSFile( bool aPlotAll, bool aPlotFrameRef )
 }
 
 
-bool DIALOG_PLOT_SCHEMATIC::plotOneSheetPS( const wxString&     aFileName,
-                                            SCH_SCREEN*         aScreen,
+bool DIALOG_PLOT_SCHEMATIC::plotOneSheetPS( const SHEET_PLOT_JOB& aJob,
                                             const PAGE_INFO&    aPageInfo,
                                             wxPoint             aPlot0ffset,
                                             double              aScale,
@@ -139,34 +98,32 @@ bool DIALOG_PLOT_SCHEMATIC::plotOneSheetPS( const wxString&     aFileName,
     PS_PLOTTER* plotter = new PS_PLOTTER();
     plotter->SetPageSettings( aPageInfo );
     plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
-    plotter->SetColorMode( getModeColor() );
+    plotter->SetColorMode( m_plotColor );
     // Currently, plot units are in decimil
     plotter->SetViewport( aPlot0ffset, IU_PER_MILS/10, aScale, false );
 
     // Init :
     plotter->SetCreator( wxT( "Eeschema-PS" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aJob.m_FileName ) )
     {
         delete plotter;
         return false;
     }
 
-    LOCALE_IO toggle;       // Switch the locale to standard C
-
     plotter->StartPlot();
 
     if( aPlotFrameRef )
     {
         plotter->SetColor( BLACK );
-        PlotWorkSheet( plotter, m_parent->GetTitleBlock(),
-                       m_parent->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       m_parent->GetScreenDesc(),
-                       aScreen->GetFileName() );
+        PlotWorkSheet( plotter, aJob.m_TitleBlock,
+                       aJob.m_Screen->GetPageSettings(),
+                       aJob.m_SheetNumber, aJob.m_SheetCount,
+                       aJob.m_SheetDesc,
+                       aJob.m_Screen->GetFileName() );
     }
 
-    aScreen->Plot( plotter );
+    aJob.m_Screen->Plot( plotter );
 
     plotter->EndPlot();
     delete plotter;
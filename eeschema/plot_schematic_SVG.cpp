@@ -43,56 +43,16 @@
 
 void DIALOG_PLOT_SCHEMATIC::createSVGFile( bool aPrintAll, bool aPrintFrameRef )
 {
-    wxString        msg;
-    REPORTER&       reporter = m_MessagesBox->Reporter();
     SCH_SHEET_PATH  oldsheetpath = m_parent->GetCurrentSheet();
-    SCH_SHEET_LIST  sheetList;
+    std::vector<SHEET_PLOT_JOB> jobs;
+    bool            blackAndWhite = !m_plotColor;
 
-    if( aPrintAll )
-        sheetList.BuildSheetList( g_RootSheet );
-    else
-        sheetList.push_back( m_parent->GetCurrentSheet() );
+    buildPlotJobs( aPrintAll, SVG_PLOTTER::GetDefaultFileExtension(), jobs );
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        SCH_SCREEN*  screen;
-        m_parent->SetCurrentSheet( sheetList[i] );
-        m_parent->GetCurrentSheet().UpdateAllScreenReferences();
-        m_parent->SetSheetNumberAndCount();
-        screen = m_parent->GetCurrentSheet().LastScreen();
-
-        try
-        {
-            wxString fname = m_parent->GetUniqueFilenameForCurrentSheet();
-            wxString ext = SVG_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( m_outputDirectoryName,
-                                                          fname, ext, &reporter );
-
-            bool success = plotOneSheetSVG( m_parent, plotFileName.GetFullPath(), screen,
-                                            getModeColor() ? false : true,
-                                            aPrintFrameRef );
-
-            if( !success )
-            {
-                msg.Printf( _( "Cannot create file '%s'.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ERROR );
-            }
-            else
-            {
-                msg.Printf( _( "Plot: '%s' OK.\n" ),
-                            GetChars( plotFileName.GetFullPath() ) );
-                reporter.Report( msg, REPORTER::RPT_ACTION );
-            }
-        }
-        catch( const IO_ERROR& e )
-        {
-            // Cannot plot SVG file
-            msg.Printf( wxT( "SVG Plotter exception: %s" ), GetChars( e.What() ) );
-            reporter.Report( msg, REPORTER::RPT_ERROR );
-            break;
-        }
-    }
+    runPlotJobs( jobs, [&]( SHEET_PLOT_JOB& aJob )
+                 {
+                     return plotOneSheetSVG( aJob, blackAndWhite, aPrintFrameRef );
+                 } );
 
     m_parent->SetCurrentSheet( oldsheetpath );
     m_parent->GetCurrentSheet().UpdateAllScreenReferences();
@@ -105,10 +65,29 @@ bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( EDA_DRAW_FRAME*    aFrame,
                                              SCH_SCREEN*        aScreen,
                                              bool               aPlotBlackAndWhite,
                                              bool               aPlotFrameRef )
+{
+    SHEET_PLOT_JOB job;
+
+    job.m_Screen      = aScreen;
+    job.m_TitleBlock  = aFrame->GetTitleBlock();
+    job.m_SheetDesc   = aFrame->GetScreenDesc();
+    job.m_SheetNumber = aScreen->m_ScreenNumber;
+    job.m_SheetCount  = aScreen->m_NumberOfScreens;
+    job.m_FileName    = aFileName;
+
+    LOCALE_IO   toggle;
+
+    return plotOneSheetSVG( job, aPlotBlackAndWhite, aPlotFrameRef );
+}
+
+
+bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( const SHEET_PLOT_JOB& aJob,
+                                             bool                  aPlotBlackAndWhite,
+                                             bool                  aPlotFrameRef )
 {
     SVG_PLOTTER* plotter = new SVG_PLOTTER();
 
-    const PAGE_INFO&   pageInfo = aScreen->GetPageSettings();
+    const PAGE_INFO&   pageInfo = aJob.m_Screen->GetPageSettings();
     plotter->SetPageSettings( pageInfo );
     plotter->SetDefaultLineWidth( GetDefaultLineThickness() );
     plotter->SetColorMode( aPlotBlackAndWhite ? false : true );
@@ -120,27 +99,25 @@ bool DIALOG_PLOT_SCHEMATIC::plotOneSheetSVG( EDA_DRAW_FRAME*    aFrame,
     // Init :
     plotter->SetCreator( wxT( "Eeschema-SVG" ) );
 
-    if( ! plotter->OpenFile( aFileName ) )
+    if( ! plotter->OpenFile( aJob.m_FileName ) )
     {
         delete plotter;
         return false;
     }
 
-    LOCALE_IO   toggle;
-
     plotter->StartPlot();
 
     if( aPlotFrameRef )
     {
         plotter->SetColor( BLACK );
-        PlotWorkSheet( plotter, aFrame->GetTitleBlock(),
-                       aFrame->GetPageSettings(),
-                       aScreen->m_ScreenNumber, aScreen->m_NumberOfScreens,
-                       aFrame->GetScreenDesc(),
-                       aScreen->GetFileName() );
+        PlotWorkSheet( plotter, aJob.m_TitleBlock,
+                       pageInfo,
+                       aJob.m_SheetNumber, aJob.m_SheetCount,
+                       aJob.m_SheetDesc,
+                       aJob.m_Screen->GetFileName() );
     }
 
-    aScreen->Plot( plotter );
+    aJob.m_Screen->Plot( plotter );
 
     plotter->EndPlot();
     delete plotter;
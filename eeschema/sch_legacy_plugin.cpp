@@ -22,6 +22,9 @@
 
 #include <ctype.h>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 #include <wx/mstream.h>
 #include <wx/filename.h>
@@ -58,6 +61,10 @@
 #include <lib_text.h>
 
 
+/// Number of threads reading the sheet files of a level of the hierarchy.
+#define SHEET_READER_THREADS    6
+
+
 #define SCH_PARSE_ERROR( text, reader, pos )                         \
     THROW_PARSE_ERROR( text, reader.GetSource(), reader.Line(),      \
                        reader.LineNumber(), pos - reader.Line() )
@@ -523,54 +530,150 @@ SCH_SHEET* SCH_LEGACY_PLUGIN::Load( const wxString& aFileName, KIWAY* aKiway,
 
 void SCH_LEGACY_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
 {
-    SCH_SCREEN* screen = NULL;
+    if( aSheet->GetScreen() )
+        return;
 
-    if( !aSheet->GetScreen() )
+    // The hierarchy is loaded one level at a time: the sheets found in the files of a
+    // level make up the next one, and the new files of a level are read concurrently.
+    std::vector< SCH_SHEET* > level( 1, aSheet );
+
+    while( !level.empty() )
     {
-        // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
-        // stores the file name and extension.  Add the project path to the file name and
-        // extension to compare when calling SCH_SHEET::SearchHierarchy().
-        wxFileName fileName = aSheet->GetFileName();
+        std::vector< SCH_SHEET* > toLoad;
 
-        if( !fileName.IsAbsolute() )
-            fileName.SetPath( m_path );
+        for( SCH_SHEET* sheet : level )
+        {
+            SCH_SCREEN* screen = NULL;
 
-        m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+            // SCH_SCREEN objects store the full path and file name where the SCH_SHEET
+            // object only stores the file name and extension.  Add the project path to the
+            // file name and extension to compare when calling SCH_SHEET::SearchHierarchy().
+            wxFileName fileName = sheet->GetFileName();
 
-        if( screen )
-        {
-            aSheet->SetScreen( screen );
+            if( !fileName.IsAbsolute() )
+                fileName.SetPath( m_path );
+
+            // This also finds the screens of the sheets of this level already seen, which
+            // are in the hierarchy, though not read yet.
+            m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+
+            if( screen )
+            {
+                sheet->SetScreen( screen );
 
-            // Do not need to load the sub-sheets - this has already been done.
+                // Do not need to load the sub-sheets - this has already been done.
+            }
+            else
+            {
+                sheet->SetScreen( new SCH_SCREEN( m_kiway ) );
+                sheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+                toLoad.push_back( sheet );
+            }
         }
-        else
-        {
-            aSheet->SetScreen( new SCH_SCREEN( m_kiway ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
-            loadFile( fileName.GetFullPath(), aSheet->GetScreen() );
 
-            EDA_ITEM* item = aSheet->GetScreen()->GetDrawItems();
+        loadFiles( toLoad );
+
+        level.clear();
 
-            while( item )
+        for( SCH_SHEET* sheet : toLoad )
+        {
+            for( EDA_ITEM* item = sheet->GetScreen()->GetDrawItems();  item;  item = item->Next() )
             {
                 if( item->Type() == SCH_SHEET_T )
                 {
-                    SCH_SHEET* sheet = (SCH_SHEET*) item;
+                    SCH_SHEET* subSheet = (SCH_SHEET*) item;
 
-                    // Set the parent to aSheet.  This effectively creates a method to find
+                    // Set the parent to sheet.  This effectively creates a method to find
                     // the root sheet from any sheet so a pointer to the root sheet does not
                     // need to be stored globally.  Note: this is not the same as a hierarchy.
                     // Complex hierarchies can have multiple copies of a sheet.  This only
                     // provides a simple tree to find the root sheet.
-                    sheet->SetParent( aSheet );
+                    subSheet->SetParent( sheet );
+                    level.push_back( subSheet );
+                }
+                else if( item->Type() == SCH_BITMAP_T )
+                {
+                    // wxBitmaps can only be made on the main thread, see loadBitmap().
+                    BITMAP_BASE* image = ( (SCH_BITMAP*) item )->GetImage();
 
-                    // Recursion starts here.
-                    loadHierarchy( sheet );
+                    if( image->GetImageData() )
+                        image->SetBitmap( new wxBitmap( *image->GetImageData() ) );
                 }
+            }
+        }
+    }
+}
+
+
+void SCH_LEGACY_PLUGIN::loadFiles( const std::vector< SCH_SHEET* >& aSheets )
+{
+    if( aSheets.size() == 1 )
+    {
+        loadFile( aSheets[0]->GetScreen()->GetFileName(), aSheets[0]->GetScreen() );
+        return;
+    }
+
+    // Each thread reads with a plugin of its own, the parser state is in the plugin.
+    // The C locale is already set by Load() for the duration of the threads.
+    std::vector< std::unique_ptr< IO_ERROR > > errors( aSheets.size() );
+    std::atomic<unsigned> nextSheet( 0 );
+
+    auto reader = [&]()
+    {
+        SCH_LEGACY_PLUGIN plugin;
 
-                item = item->Next();
+        plugin.init( m_kiway, m_props );
+        plugin.m_path = m_path;
+        plugin.m_rootSheet = m_rootSheet;
+
+        for( unsigned i = nextSheet++;  i < aSheets.size();  i = nextSheet++ )
+        {
+            SCH_SCREEN* screen = aSheets[i]->GetScreen();
+
+            try
+            {
+                plugin.loadFile( screen->GetFileName(), screen );
+            }
+            catch( const IO_ERROR& ioe )
+            {
+                errors[i].reset( new IO_ERROR( ioe ) );
+            }
+            catch( const std::exception& se )
+            {
+                // Map anything unexpected into the expected, this runs on a GUI-less
+                // worker thread.
+                try
+                {
+                    THROW_IO_ERROR( se.what() );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    errors[i].reset( new IO_ERROR( ioe ) );
+                }
             }
         }
+    };
+
+    std::vector< std::thread > threads;
+
+    unsigned threadCount = std::min< unsigned >( aSheets.size(), SHEET_READER_THREADS );
+
+    // I am one of the readers.
+    for( unsigned i = 1;  i < threadCount;  ++i )
+        threads.push_back( std::thread( reader ) );
+
+    reader();
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    // Report the error of the first failing sheet of this level, in the file order.  This
+    // is not always the error a sequential load would report: it read the hierarchy depth
+    // first, so a failing sheet below an earlier sheet of this level came before it.
+    for( const std::unique_ptr< IO_ERROR >& error : errors )
+    {
+        if( error )
+            throw IO_ERROR( *error );
     }
 }
 
@@ -942,7 +1045,8 @@ SCH_BITMAP* SCH_LEGACY_PLUGIN::loadBitmap( FILE_LINE_READER& aReader )
                     wxMemoryInputStream istream( stream );
                     image->LoadFile( istream, wxBITMAP_TYPE_PNG );
                     bitmap->GetImage()->SetImage( image );
-                    bitmap->GetImage()->SetBitmap( new wxBitmap( *image ) );
+
+                    // The wxBitmap is made by loadHierarchy(), this may be a worker thread.
                     break;
                 }
 
@@ -1465,6 +1569,24 @@ void SCH_LEGACY_PLUGIN::Save( const wxString& aFileName, SCH_SCREEN* aScreen, KI
     m_out = &formatter;     // no ownership
 
     Format( aScreen );
+
+    formatter.Finish();
+}
+
+
+void SCH_LEGACY_PLUGIN::Format( SCH_SCREEN* aScreen, OUTPUTFORMATTER* aFormatter,
+                                const wxArrayString& aLibNames, const PROPERTIES* aProperties )
+{
+    wxCHECK_RET( aFormatter != NULL, "NULL OUTPUTFORMATTER* object." );
+    wxCHECK_RET( aScreen != NULL, "NULL SCH_SCREEN* object." );
+
+    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+
+    init( NULL, aProperties );
+
+    m_out = aFormatter;     // no ownership
+
+    format( aScreen, aLibNames );
 }
 
 
@@ -1473,12 +1595,23 @@ void SCH_LEGACY_PLUGIN::Format( SCH_SCREEN* aScreen )
     wxCHECK_RET( aScreen != NULL, "NULL SCH_SCREEN* object." );
     wxCHECK_RET( m_kiway != NULL, "NULL KIWAY* object." );
 
+    wxArrayString libNames;
+
+    for( const PART_LIB& lib : *m_kiway->Prj().SchLibs() )
+        libNames.Add( lib.GetName() );
+
+    format( aScreen, libNames );
+}
+
+
+void SCH_LEGACY_PLUGIN::format( SCH_SCREEN* aScreen, const wxArrayString& aLibNames )
+{
     // Write the header
     m_out->Print( 0, "%s %s %d\n", "EESchema", SCHEMATIC_HEAD_STRING, EESCHEMA_VERSION );
 
     // Write the project libraries.
-    for( const PART_LIB& lib : *m_kiway->Prj().SchLibs() )
-        m_out->Print( 0, "LIBS:%s\n", TO_UTF8( lib.GetName() ) );
+    for( const wxString& libName : aLibNames )
+        m_out->Print( 0, "LIBS:%s\n", TO_UTF8( libName ) );
 
     // This section is not used, but written for file compatibility
     m_out->Print( 0, "EELAYER %d %d\n", LAYERSCH_ID_COUNT, 0 );
@@ -3230,6 +3363,7 @@ void SCH_LEGACY_PLUGIN_CACHE::Save()
     }
 
     formatter.Print( 0, "#\n#End Library\n" );
+    formatter.Finish();
     m_fileModTime = m_libFileName.GetModificationTime();
     m_isModified = false;
 }
@@ -23,6 +23,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <vector>
+
 #include <sch_io_mgr.h>
 
 
@@ -85,6 +87,18 @@ public:
 
     void Format( SCH_SCREEN* aScreen );
 
+    /**
+     * Function Format
+     * writes the schematic file for \a aScreen to \a aFormatter, as Save() does
+     * to a file.  The project is not used, so \a aScreen can be formatted on any
+     * thread as long as it is not shared with another one.
+     *
+     * @param aLibNames are the names of the project libraries written in the header.
+     * @throw IO_ERROR on write error.
+     */
+    void Format( SCH_SCREEN* aScreen, OUTPUTFORMATTER* aFormatter,
+                 const wxArrayString& aLibNames, const PROPERTIES* aProperties = NULL );
+
     void EnumerateSymbolLib( wxArrayString&    aAliasNameList,
                              const wxString&   aLibraryPath,
                              const PROPERTIES* aProperties = NULL ) override;
@@ -108,6 +122,7 @@ private:
     void loadHierarchy( SCH_SHEET* aSheet );
     void loadHeader( FILE_LINE_READER& aReader, SCH_SCREEN* aScreen );
     void loadPageSettings( FILE_LINE_READER& aReader, SCH_SCREEN* aScreen );
+    void loadFiles( const std::vector<SCH_SHEET*>& aSheets );
     void loadFile( const wxString& aFileName, SCH_SCREEN* aScreen );
     SCH_SHEET* loadSheet( FILE_LINE_READER& aReader );
     SCH_BITMAP* loadBitmap( FILE_LINE_READER& aReader );
@@ -118,6 +133,7 @@ private:
     SCH_TEXT* loadText( FILE_LINE_READER& aReader );
     SCH_COMPONENT* loadComponent( FILE_LINE_READER& aReader );
 
+    void format( SCH_SCREEN* aScreen, const wxArrayString& aLibNames );
     void saveComponent( SCH_COMPONENT* aComponent );
     void saveField( SCH_FIELD* aField );
     void saveBitmap( SCH_BITMAP* aBitmap );
@@ -137,7 +153,7 @@ protected:
     const PROPERTIES* m_props;      ///< Passed via Save() or Load(), no ownership, may be NULL.
     KIWAY*            m_kiway;      ///< Required for path to legacy component libraries.
     SCH_SHEET*        m_rootSheet;  ///< The root sheet of the schematic being loaded..
-    FILE_OUTPUTFORMATTER* m_out;    ///< The output formatter for saving SCH_SCREEN objects.
+    OUTPUTFORMATTER*  m_out;        ///< The output formatter for saving SCH_SCREEN objects.
     SCH_LEGACY_PLUGIN_CACHE* m_cache;
 
     /// initialize PLUGIN like a constructor would.
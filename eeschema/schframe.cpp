@@ -63,6 +63,7 @@
 
 #include <netlist_exporter_kicad.h>
 #include <kiway.h>
+#include <background_saver.h>
 
 
 // non-member so it can be moved easily, and kept REALLY private.
@@ -348,6 +349,9 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
     m_CurrentSheet = new SCH_SHEET_PATH;
     m_DefaultSchematicFileName = NAMELESS_PROJECT;
     m_DefaultSchematicFileName += wxT( ".sch" );
+
+    m_backgroundSaver = new BACKGROUND_SAVER( this );
+    Bind( EVT_BACKGROUND_SAVE_DONE, &SCH_EDIT_FRAME::onBackgroundSaveDone, this );
     m_showAllPins = false;
     m_previewPosition = wxDefaultPosition;
     m_previewSize = wxDefaultSize;
@@ -439,6 +443,7 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ):
 
 SCH_EDIT_FRAME::~SCH_EDIT_FRAME()
 {
+    delete m_backgroundSaver;
     delete m_item_to_repeat;        // we own the cloned object, see this->SetRepeatItem()
 
     SetScreen( NULL );
@@ -659,6 +664,9 @@ void SCH_EDIT_FRAME::OnCloseWindow( wxCloseEvent& aEvent )
         }
     }
 
+    // The files must be on disk before their auto save files go away.
+    WaitForBackgroundSave();
+
     // Close the find dialog and preserve it's setting if it is displayed.
     if( m_dlgFindReplace )
     {
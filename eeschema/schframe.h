@@ -64,6 +64,7 @@ class DIALOG_SCH_FIND;
 class wxFindDialogEvent;
 class wxFindReplaceData;
 class SCHLIB_FILTER;
+class BACKGROUND_SAVER;
 
 
 /// enum used in RotationMiroir()
@@ -155,6 +156,8 @@ private:
     bool                    m_autoplaceJustify;   ///< allow autoplace to change justification
     bool                    m_autoplaceAlign;     ///< align autoplaced fields to the grid
 
+    BACKGROUND_SAVER*       m_backgroundSaver;    ///< writes the files, see SaveEEFile()
+
     /// An index to the last find item in the found items list #m_foundItems.
     int         m_foundItemIndex;
 
@@ -195,6 +198,19 @@ protected:
      */
     virtual bool doAutoSave() override;
 
+    /**
+     * Function schematicSaved
+     * deletes the auto save file of \a aFileName, which has just been written, and
+     * tells the user.
+     */
+    void schematicSaved( const wxFileName& aFileName );
+
+    /**
+     * Function onBackgroundSaveDone
+     * reports a schematic file written by m_backgroundSaver.
+     */
+    void onBackgroundSaveDone( wxThreadEvent& aEvent );
+
     /**
      * Function autoSaveRequired
      * returns true if the schematic has been modified.
@@ -773,12 +789,20 @@ public:
      *                          if true.
      *                           Helper definitions #CREATE_BACKUP_FILE and
      *                          #NO_BACKUP_FILE are defined for improved code readability.
-     * @return True if the file has been saved.
+     * @return True if the file was queued for writing.  A copy of the screen is taken
+     *         here, the file is formatted and written by a background thread, see
+     *         WaitForBackgroundSave().
      */
     bool SaveEEFile( SCH_SCREEN* aScreen,
                      bool        aSaveUnderNewName = false,
                      bool        aCreateBackupFile = CREATE_BACKUP_FILE );
 
+    /**
+     * Function WaitForBackgroundSave
+     * blocks until the files queued by SaveEEFile() are written, and reports them.
+     */
+    void WaitForBackgroundSave();
+
     // General search:
 
     bool IsSearchCacheObsolete( const SCH_FIND_REPLACE_DATA& aSearchCriteria );
@@ -207,6 +207,7 @@ bool SCH_EDIT_FRAME::EditSheet( SCH_SHEET* aSheet, SCH_SHEET_PATH* aHierarchy )
         {
             aSheet->GetScreen()->SetFileName( newFilename );
             SaveEEFile( aSheet->GetScreen() );
+            WaitForBackgroundSave();     // the file is read back below
 
             // If the the associated screen is shared by more than one sheet, remove the
             // screen and reload the file to a new screen.  Failure to do this will trash
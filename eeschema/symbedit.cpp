@@ -238,6 +238,7 @@ void LIB_EDIT_FRAME::SaveOneSymbol()
 
             formatter.Print( 0, "ENDDRAW\n" );
             formatter.Print( 0, "ENDDEF\n" );
+            formatter.Finish();
         }
         catch( const IO_ERROR& )
         {
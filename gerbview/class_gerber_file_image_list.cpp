@@ -28,14 +28,19 @@
  */
 
 #include <fctsys.h>
+#include <common.h>
 
 #include <gerbview.h>
 #include <gerbview_frame.h>
 #include <class_gerber_file_image.h>
 #include <class_gerber_file_image_list.h>
 #include <class_X2_gerber_attributes.h>
+#include <class_excellon.h>
 
+#include <algorithm>
 #include <map>
+#include <atomic>
+#include <thread>
 
 
 // The global image list:
@@ -236,3 +241,63 @@ void GERBER_FILE_IMAGE_LIST::SortImagesByZOrder()
     }
 }
 
+
+// Number of threads reading files in GERBER_FILE_IMAGE_LIST::ReadFiles()
+#define READER_THREADS      6
+
+
+std::vector<GERBER_FILE_IMAGE*> GERBER_FILE_IMAGE_LIST::ReadFiles(
+        const std::vector<wxString>& aFileNames, bool aExcellon )
+{
+    std::vector<GERBER_FILE_IMAGE*> images( aFileNames.size(), NULL );
+
+    // The images are made here and only filled by the threads.  The graphic layer
+    // is set when the image is added to a list.
+    for( unsigned ii = 0; ii < images.size(); ++ii )
+    {
+        if( aExcellon )
+            images[ii] = new EXCELLON_IMAGE( 0 );
+        else
+            images[ii] = new GERBER_FILE_IMAGE( 0 );
+    }
+
+    // Keep the C locale for the duration of all threads, as FOOTPRINT_LIST does, so
+    // that the LOCALE_IO of each reader does not toggle it behind the others' backs.
+    LOCALE_IO toggleIo;
+
+    std::atomic<unsigned> nextFile( 0 );
+
+    auto reader = [&]()
+    {
+        for( unsigned ii = nextFile++;  ii < images.size();  ii = nextFile++ )
+        {
+            try
+            {
+                if( aExcellon )
+                    static_cast<EXCELLON_IMAGE*>( images[ii] )->LoadFile( aFileNames[ii] );
+                else
+                    images[ii]->LoadGerberFile( aFileNames[ii] );
+            }
+            catch( const IO_ERROR& ioe )
+            {
+                images[ii]->m_InUse = false;
+                images[ii]->AddMessageToList( ioe.What() );
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    unsigned threadCount = std::min<unsigned>( images.size(), READER_THREADS );
+
+    // This thread is one of the readers.
+    for( unsigned ii = 1; ii < threadCount; ++ii )
+        threads.push_back( std::thread( reader ) );
+
+    reader();
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    return images;
+}
@@ -115,6 +115,17 @@ public:
      * (SortImagesByZOrder updates the graphic layer of these items)
      */
     void SortImagesByZOrder();
+
+    /**
+     * Read Gerber or drill files concurrently, each in a new image which is not in any
+     * list.  Files which cannot be read give an image with m_InUse false and the
+     * reason, if any, in its messages.
+     * @param aFileNames = the full file names
+     * @param aExcellon = true for drill files, false for Gerber files
+     * @return the new images, owned by the caller, in the order of aFileNames
+     */
+    static std::vector<GERBER_FILE_IMAGE*> ReadFiles( const std::vector<wxString>& aFileNames,
+                                                      bool aExcellon );
 };
 
 #endif  // ifndef CLASS_GERBER_FILE_IMAGE_LIST_H
@@ -157,27 +157,45 @@ static EXCELLON_CMD excellon_G_CmdList[] =
 };
 
 
-bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
+bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName,
+                                         EXCELLON_IMAGE* aPreloaded )
 {
     wxString msg;
     int layerId = getActiveLayer();      // current layer used in GerbView
     GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
     EXCELLON_IMAGE* drill_Layer = (EXCELLON_IMAGE*) images->GetGbrImage( layerId );
+    bool preloaded = aPreloaded && drill_Layer == NULL;
 
-    if( drill_Layer == NULL )
+    if( preloaded )
     {
-        drill_Layer = new EXCELLON_IMAGE( layerId );
+        // Already read by GERBER_FILE_IMAGE_LIST::ReadFiles(), which leaves m_InUse false
+        // if the file could not be read.
+        drill_Layer = aPreloaded;
+        drill_Layer->m_GraphicLayer = layerId;
         layerId = images->AddGbrImage( drill_Layer, layerId );
     }
+    else
+    {
+        delete aPreloaded;
+
+        if( drill_Layer == NULL )
+        {
+            drill_Layer = new EXCELLON_IMAGE( layerId );
+            layerId = images->AddGbrImage( drill_Layer, layerId );
+        }
+    }
 
     if( layerId < 0 )
     {
+        if( preloaded )
+            delete drill_Layer;
+
         DisplayError( this, _( "No room to load file" ) );
         return false;
     }
 
     // Read the Excellon drill file:
-    bool success = drill_Layer->LoadFile( aFullFileName );
+    bool success = preloaded ? drill_Layer->m_InUse : drill_Layer->LoadFile( aFullFileName );
 
     if( !success )
     {
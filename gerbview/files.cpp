@@ -34,6 +34,9 @@
 #include <gerbview_id.h>
 #include <class_gerbview_layer_widget.h>
 #include <wildcards_and_files_ext.h>
+#include <class_gerber_file_image.h>
+#include <class_gerber_file_image_list.h>
+#include <class_excellon.h>
 
 
 void GERBVIEW_FRAME::OnGbrFileHistory( wxCommandEvent& event )
@@ -174,8 +177,7 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
         m_mruPath = currentPath;
     }
 
-    // Read gerber files: each file is loaded on a new GerbView layer
-    int layer = getActiveLayer();
+    std::vector<wxString> fullFileNames;
 
     for( unsigned ii = 0; ii < filenamesList.GetCount(); ii++ )
     {
@@ -184,11 +186,29 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
         if( !filename.IsAbsolute() )
             filename.SetPath( currentPath );
 
-        m_lastFileName = filename.GetFullPath();
+        fullFileNames.push_back( filename.GetFullPath() );
+    }
+
+    // Read all the files at once, then put them on the layers one by one
+    std::vector<GERBER_FILE_IMAGE*> preloaded( fullFileNames.size(), NULL );
+
+    if( fullFileNames.size() > 1 )
+        preloaded = GERBER_FILE_IMAGE_LIST::ReadFiles( fullFileNames, false );
+
+    // Read gerber files: each file is loaded on a new GerbView layer
+    int layer = getActiveLayer();
+
+    for( unsigned ii = 0; ii < fullFileNames.size(); ii++ )
+    {
+        m_lastFileName = fullFileNames[ii];
 
         setActiveLayer( layer, false );
 
-        if( Read_GERBER_File( filename.GetFullPath() ) )
+        bool success = Read_GERBER_File( fullFileNames[ii], preloaded[ii] );
+
+        preloaded[ii] = NULL;       // owned by Read_GERBER_File()
+
+        if( success )
         {
             UpdateFileHistory( m_lastFileName );
 
@@ -206,6 +226,10 @@ bool GERBVIEW_FRAME::LoadGerberFiles( const wxString& aFullFileName )
         }
     }
 
+    // The files left when there are no more layers
+    for( GERBER_FILE_IMAGE* image : preloaded )
+        delete image;
+
     Zoom_Automatique( false );
 
     // Synchronize layers tools with actual active layer:
@@ -258,8 +282,7 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
         m_mruPath = currentPath;
     }
 
-    // Read gerber files: each file is loaded on a new GerbView layer
-    int layer = getActiveLayer();
+    std::vector<wxString> fullFileNames;
 
     for( unsigned ii = 0; ii < filenamesList.GetCount(); ii++ )
     {
@@ -268,14 +291,33 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
         if( !filename.IsAbsolute() )
             filename.SetPath( currentPath );
 
-        m_lastFileName = filename.GetFullPath();
+        fullFileNames.push_back( filename.GetFullPath() );
+    }
+
+    // Read all the files at once, then put them on the layers one by one
+    std::vector<GERBER_FILE_IMAGE*> preloaded( fullFileNames.size(), NULL );
+
+    if( fullFileNames.size() > 1 )
+        preloaded = GERBER_FILE_IMAGE_LIST::ReadFiles( fullFileNames, true );
+
+    // Read gerber files: each file is loaded on a new GerbView layer
+    int layer = getActiveLayer();
+
+    for( unsigned ii = 0; ii < fullFileNames.size(); ii++ )
+    {
+        m_lastFileName = fullFileNames[ii];
 
         setActiveLayer( layer, false );
 
-        if( Read_EXCELLON_File( filename.GetFullPath() ) )
+        bool success = Read_EXCELLON_File( fullFileNames[ii],
+                                           static_cast<EXCELLON_IMAGE*>( preloaded[ii] ) );
+
+        preloaded[ii] = NULL;       // owned by Read_EXCELLON_File()
+
+        if( success )
         {
             // Update the list of recent drill files.
-            UpdateFileHistory( filename.GetFullPath(),  &m_drillFileHistory );
+            UpdateFileHistory( fullFileNames[ii],  &m_drillFileHistory );
 
             layer = getNextAvailableLayer( layer );
 
@@ -291,6 +333,10 @@ bool GERBVIEW_FRAME::LoadExcellonFiles( const wxString& aFullFileName )
         }
     }
 
+    // The files left when there are no more layers
+    for( GERBER_FILE_IMAGE* image : preloaded )
+        delete image;
+
     Zoom_Automatique( false );
 
     // Synchronize layers tools with actual active layer:
@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_load_bench.cpp
+ * @brief Times reading Gerber files one after another, as GerbView did, and with
+ * GERBER_FILE_IMAGE_LIST::ReadFiles().
+ *
+ * Usage: gerber_load_bench [directory [repeat count]]
+ *
+ * The *.gbr files of the directory, gerbview/gerber_test_files by default, are read
+ * repeat count times each (20 by default), as the test files are small.
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <gerbview.h>
+#include <class_gerber_file_image.h>
+#include <class_gerber_file_image_list.h>
+
+#include <wx/dir.h>
+#include <wx/init.h>
+
+#include <cstdio>
+#include <memory>
+
+
+int main( int argc, char** argv )
+{
+    wxInitializer initializer( argc, argv );
+
+    wxString dirName = GERBER_TEST_FILES_DIR;
+    long     repeatCount = 20;
+
+    if( argc > 1 )
+        dirName = FROM_UTF8( argv[1] );
+
+    if( argc > 2 )
+        FROM_UTF8( argv[2] ).ToLong( &repeatCount );
+
+    wxArrayString found;
+
+    wxDir::GetAllFiles( dirName, &found, wxT( "*.gbr" ), wxDIR_FILES );
+    found.Sort();
+
+    std::vector<wxString> fileNames;
+
+    for( long ii = 0; ii < repeatCount; ++ii )
+    {
+        for( unsigned jj = 0; jj < found.GetCount(); ++jj )
+            fileNames.push_back( found[jj] );
+    }
+
+    if( fileNames.empty() )
+    {
+        fprintf( stderr, "no Gerber files in '%s'\n", TO_UTF8( dirName ) );
+        return 1;
+    }
+
+    unsigned sequentialItems = 0;
+    unsigned start = GetRunningMicroSecs();
+
+    for( const wxString& fileName : fileNames )
+    {
+        std::unique_ptr<GERBER_FILE_IMAGE> image( new GERBER_FILE_IMAGE( 0 ) );
+
+        image->LoadGerberFile( fileName );
+        sequentialItems += image->m_Drawings.GetCount();
+    }
+
+    unsigned sequentialTime = GetRunningMicroSecs() - start;
+
+    start = GetRunningMicroSecs();
+
+    std::vector<GERBER_FILE_IMAGE*> images = GERBER_FILE_IMAGE_LIST::ReadFiles( fileNames,
+                                                                                false );
+
+    unsigned concurrentTime = GetRunningMicroSecs() - start;
+    unsigned concurrentItems = 0;
+
+    for( GERBER_FILE_IMAGE* image : images )
+    {
+        concurrentItems += image->m_Drawings.GetCount();
+        delete image;
+    }
+
+    printf( "%u files, %u items: one by one %.1f ms, concurrently %.1f ms\n",
+            (unsigned) fileNames.size(), sequentialItems,
+            sequentialTime / 1000.0, concurrentTime / 1000.0 );
+
+    if( concurrentItems != sequentialItems )
+    {
+        fprintf( stderr, "item count mismatch: %u read concurrently\n", concurrentItems );
+        return 1;
+    }
+
+    return 0;
+}
@@ -48,6 +48,7 @@ class GBR_LAYER_BOX_SELECTOR;
 class GERBER_DRAW_ITEM;
 class GERBER_FILE_IMAGE;
 class GERBER_FILE_IMAGE_LIST;
+class EXCELLON_IMAGE;
 
 
 /**
@@ -599,7 +600,17 @@ public:
      * @return true if file was opened successfully.
      */
     bool                LoadGerberFiles( const wxString& aFileName );
-    bool                Read_GERBER_File( const wxString&   GERBER_FullFileName );
+
+    /**
+     * function Read_GERBER_File
+     * loads a Gerber file on the active layer.
+     * @param aPreloaded - the file already read by GERBER_FILE_IMAGE_LIST::ReadFiles(),
+     *                     or NULL to read it here.  Owned by this function, which reads
+     *                     the file again if the active layer is in use.
+     * @return true if file was opened successfully.
+     */
+    bool                Read_GERBER_File( const wxString&   GERBER_FullFileName,
+                                          GERBER_FILE_IMAGE* aPreloaded = NULL );
 
     /**
      * function Read_EXCELLON_File
@@ -610,7 +621,15 @@ public:
      * @return true if file was opened successfully.
      */
     bool                LoadExcellonFiles( const wxString& aFileName );
-    bool                Read_EXCELLON_File( const wxString& aFullFileName );
+
+    /**
+     * function Read_EXCELLON_File
+     * loads a drill file on the active layer.
+     * @param aPreloaded - as in Read_GERBER_File().
+     * @return true if file was opened successfully.
+     */
+    bool                Read_EXCELLON_File( const wxString& aFullFileName,
+                                            EXCELLON_IMAGE* aPreloaded = NULL );
 
     bool                GeneralControl( wxDC* aDC, const wxPoint& aPosition, EDA_KEY aHotKey = 0 ) override;
 
@@ -36,22 +36,38 @@
 
 /* Read a gerber file, RS274D, RS274X or RS274X2 format.
  */
-bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
+bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName,
+                                       GERBER_FILE_IMAGE* aPreloaded )
 {
     wxString msg;
 
     int layer = getActiveLayer();
     GERBER_FILE_IMAGE_LIST* images = GetImagesList();
     GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
+    bool success;
 
-    if( gerber == NULL )
+    if( aPreloaded && gerber == NULL )
     {
-        gerber = new GERBER_FILE_IMAGE( layer );
+        // Already read by GERBER_FILE_IMAGE_LIST::ReadFiles(), which leaves m_InUse false
+        // if the file could not be read.
+        gerber = aPreloaded;
+        gerber->m_GraphicLayer = layer;
         images->AddGbrImage( gerber, layer );
+        success = gerber->m_InUse;
     }
+    else
+    {
+        delete aPreloaded;
 
-    /* Read the gerber file */
-    bool success = gerber->LoadGerberFile( GERBER_FullFileName );
+        if( gerber == NULL )
+        {
+            gerber = new GERBER_FILE_IMAGE( layer );
+            images->AddGbrImage( gerber, layer );
+        }
+
+        /* Read the gerber file */
+        success = gerber->LoadGerberFile( GERBER_FullFileName );
+    }
 
     if( !success )
     {
@@ -101,12 +117,8 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     m_FileName = aFullFileName;
 
-    wxString path = wxPathOnly( aFullFileName );
-
-    // This change is needed to load included files, if exists:
-    if( path != wxEmptyString )
-        wxSetWorkingDirectory( path );
-
+    // Included files are searched relative to m_FileName, see the INCLUDE_FILE command.
+    // Do not change the working directory here, several files can be read at once.
     LOCALE_IO toggleIo;
 
     wxString msg;
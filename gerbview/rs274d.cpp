@@ -343,9 +343,10 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
                           bool aLayerNegative  )
 {
     /* in order to calculate arc parameters, we use fillArcGBRITEM
-     * so we muse create a dummy track and use its geometric parameters
+     * so we muse create a dummy track and use its geometric parameters.
+     * Not static: several files can be read at once.
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( NULL );
+    GERBER_DRAW_ITEM dummyGbrItem( NULL );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef BACKGROUND_SAVER_H_
+#define BACKGROUND_SAVER_H_
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <wx/event.h>
+
+
+class OUTPUTFORMATTER;
+
+
+/**
+ * Event sent to the owner of a BACKGROUND_SAVER for each finished file.  GetInt()
+ * is 1 if the file was written and 0 if not, GetString() is the destination file
+ * name and GetPayload<wxString>() the error message on failure.  A written file
+ * may come with a warning in GetPayload<wxString>(), e.g. when the backup of the
+ * previous file could not be made.
+ */
+wxDECLARE_EVENT( EVT_BACKGROUND_SAVE_DONE, wxThreadEvent );
+
+
+/**
+ * Class BACKGROUND_SAVER
+ * writes files on a worker thread, so saving a large document does not freeze
+ * the editor.
+ * <p>
+ * The editor takes a snapshot of its document on the main thread, cheap compared
+ * to formatting it, and queues a function formatting that snapshot, and nothing
+ * else, to an OUTPUTFORMATTER.  Jobs run one at a time in the order queued.  Each
+ * is written to a temporary file next to the destination, synced to disk and then
+ * renamed over the destination, so a failed save leaves the previous file alone.
+ * The previous file is moved to its backup name only once the new one is written.
+ * If the final rename fails, the previous file is moved back and the temporary file
+ * is kept, its name is given in the error message.
+ * <p>
+ * A LOCALE_IO created by a job switches the locale of the worker thread only.
+ */
+class BACKGROUND_SAVER : public wxEvtHandler
+{
+public:
+    typedef std::function< void( OUTPUTFORMATTER* aFormatter ) > FORMAT_FUNC;
+
+    /**
+     * Constructor
+     * @param aOwner receives an EVT_BACKGROUND_SAVE_DONE event for every job.
+     */
+    BACKGROUND_SAVER( wxEvtHandler* aOwner );
+
+    /// Waits for the queued jobs, but does not report them any more.
+    ~BACKGROUND_SAVER();
+
+    /**
+     * Function Queue
+     * adds a job writing \a aFileName.
+     * @param aFileName is the absolute destination file name.
+     * @param aFormat writes the file contents, on the worker thread.  It may throw
+     *  an IO_ERROR, which is then reported as a failure.
+     * @param aBackupFileName if not empty, the previous \a aFileName, if any, is
+     *  renamed to this name when the new file is written.
+     */
+    void Queue( const wxString& aFileName, FORMAT_FUNC aFormat,
+                const wxString& aBackupFileName = wxEmptyString );
+
+    /**
+     * Function Wait
+     * blocks until all queued jobs are written and reports them to the owner, e.g.
+     * before the owner closes.
+     */
+    void Wait();
+
+    /**
+     * Function IsBusy
+     * @return true while jobs are queued or not yet reported.
+     */
+    bool IsBusy() const { return m_pending > 0; }
+
+private:
+    struct JOB
+    {
+        wxString    m_fileName;
+        wxString    m_backupFileName;
+        FORMAT_FUNC m_format;
+    };
+
+    void worker();
+    void run( const JOB& aJob );
+    void onJobDone( wxThreadEvent& aEvent );
+
+    wxEvtHandler*               m_owner;
+    int                         m_pending;      ///< jobs not yet reported, main thread only
+
+    std::thread                 m_thread;
+    std::mutex                  m_lock;         ///< guards the members below
+    std::condition_variable     m_changed;
+    std::deque<JOB>             m_jobs;
+    bool                        m_running;      ///< the worker is in run()
+    bool                        m_quit;
+};
+
+#endif  // BACKGROUND_SAVER_H_
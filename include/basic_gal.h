@@ -158,6 +158,7 @@ private:
 };
 
 
-extern BASIC_GAL basic_gal;
+/// Texts are drawn and plotted from several threads, so each thread has its own BASIC_GAL
+extern thread_local BASIC_GAL basic_gal;
 
 #endif      // define BASIC_GAL_H
@@ -176,6 +176,16 @@ public:
         return m_edaFrame;
     }
 
+    /**
+     * Function GetFrameTime()
+     * Returns the time needed to draw a frame in milliseconds, averaged over the last
+     * frames. The details of every frame are traced with the GAL_PROFILE mask.
+     */
+    double GetFrameTime() const
+    {
+        return m_frameTime;
+    }
+
     /**
      * Function SaveGalSettings()
      * Stores GAL related settings in the configuration storage.
@@ -220,6 +230,9 @@ protected:
     /// True if GAL is currently redrawing the view
     bool                     m_drawing;
 
+    /// Average time needed to draw a frame, in milliseconds
+    double                   m_frameTime;
+
     /// Flag that determines if VIEW may use GAL for redrawing the screen.
     bool                     m_drawingEnabled;
 
@@ -43,6 +43,11 @@
 #include <colors.h>
 
 #include <atomic>
+#include <clocale>
+
+#if defined( __APPLE__ )
+#include <xlocale.h>
+#endif
 
 
 class wxAboutDialogInfo;
@@ -190,6 +195,10 @@ extern EDA_COLOR_T  g_GhostColor;
  * to read/print files with fp numbers.
  * Its destructor insures that the default locale is restored if an exception
  * is thrown, or not.
+ * <p>
+ * On the main thread the locale of the whole process is switched.  On any other
+ * thread only the locale of that thread is, so that e.g. a file written in the
+ * background does not change the locale under the feet of the user interface.
  */
 class LOCALE_IO
 {
@@ -206,6 +215,15 @@ private:
     // The locale in use before switching to the "C" locale
     // (the locale can be set by user, and is not always the system locale)
     std::string m_user_locale;
+
+    bool        m_thread;           ///< switched the locale of a secondary thread only
+
+#ifdef _WIN32
+    int         m_thread_config;    ///< _configthreadlocale() setting to restore
+#else
+    locale_t    m_c_locale;         ///< C locale in use by the secondary thread
+    locale_t    m_prev_locale;      ///< locale of the secondary thread to restore
+#endif
 };
 
 
@@ -0,0 +1,106 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef DISJOINT_SET_H_
+#define DISJOINT_SET_H_
+
+#include <vector>
+#include <utility>
+
+/**
+ * Class DISJOINT_SET
+ * partitions the elements 0 .. N-1 into disjoint subsets (a union-find structure).
+ * <p>
+ * Merging two subsets and finding the subset of an element take nearly constant time,
+ * thanks to union by size and path halving.  Every subset is identified by one of its
+ * elements, its representative.
+ */
+class DISJOINT_SET
+{
+public:
+    DISJOINT_SET( int aSize = 0 )
+    {
+        Reset( aSize );
+    }
+
+    /**
+     * Function Reset
+     * puts each one of \a aSize elements in a subset of its own.
+     */
+    void Reset( int aSize )
+    {
+        m_parent.resize( aSize );
+        m_size.assign( aSize, 1 );
+
+        for( int i = 0; i < aSize; ++i )
+            m_parent[i] = i;
+    }
+
+    /**
+     * Function Find
+     * @return the representative of the subset containing \a aElement.
+     */
+    int Find( int aElement )
+    {
+        while( m_parent[aElement] != aElement )
+        {
+            m_parent[aElement] = m_parent[m_parent[aElement]];
+            aElement = m_parent[aElement];
+        }
+
+        return aElement;
+    }
+
+    /**
+     * Function Union
+     * merges the subsets containing two elements.
+     * @return false if both elements already were in the same subset.
+     */
+    bool Union( int aFirst, int aSecond )
+    {
+        aFirst  = Find( aFirst );
+        aSecond = Find( aSecond );
+
+        if( aFirst == aSecond )
+            return false;
+
+        if( m_size[aFirst] < m_size[aSecond] )
+            std::swap( aFirst, aSecond );
+
+        m_parent[aSecond] = aFirst;
+        m_size[aFirst] += m_size[aSecond];
+
+        return true;
+    }
+
+    int Size() const
+    {
+        return m_parent.size();
+    }
+
+private:
+    std::vector<int> m_parent;      ///< parent of each element, roots are their own parent
+    std::vector<int> m_size;        ///< number of elements below each root
+};
+
+#endif  // DISJOINT_SET_H_
@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ENDPOINT_INDEX_H_
+#define ENDPOINT_INDEX_H_
+
+#include <vector>
+#include <unordered_map>
+#include <stdlib.h>
+#include <limits.h>
+
+#include <wx/gdicmn.h>
+
+/**
+ * Class ENDPOINT_INDEX
+ * finds, among items having two end points (segments, arcs ...), an item with an end
+ * point at or near a given point.  The items are numbered 0 .. N-1, and are removed
+ * from the index once they have been used, as when chaining items into outlines.
+ * <p>
+ * The end points are hashed in a grid of square cells: an exact match is found by
+ * looking at a single cell, and the closest end point within a tolerance by looking
+ * at the few cells around the point.  The distance is the manhattan distance, so the
+ * tolerance should not be much larger than the cell size.
+ */
+class ENDPOINT_INDEX
+{
+public:
+    /**
+     * Constructor
+     * @param aCellSize is the size of the grid cells, usually the largest tolerance
+     *                  given to Find().
+     */
+    ENDPOINT_INDEX( int aCellSize ) :
+        m_cellSize( aCellSize > 0 ? aCellSize : 1 ),
+        m_count( 0 ),
+        m_first( 0 )
+    {
+    }
+
+    /**
+     * Function Add
+     * adds the next item, numbered Size(), with its two end points.
+     */
+    void Add( const wxPoint& aStart, const wxPoint& aEnd )
+    {
+        int item = m_ends.size() / 2;
+
+        m_ends.push_back( aStart );
+        m_ends.push_back( aEnd );
+        m_removed.push_back( false );
+
+        m_grid[ cellKey( cell( aStart.x ), cell( aStart.y ) ) ].push_back( 2 * item );
+        m_grid[ cellKey( cell( aEnd.x ), cell( aEnd.y ) ) ].push_back( 2 * item + 1 );
+        ++m_count;
+    }
+
+    /// @return the number of items added, removed or not.
+    int Size() const
+    {
+        return m_removed.size();
+    }
+
+    /// @return the number of items not removed yet.
+    int Count() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Function First
+     * @return the lowest numbered item not removed yet, or -1 if none.
+     */
+    int First()
+    {
+        while( m_first < Size() && m_removed[m_first] )
+            ++m_first;
+
+        return m_first < Size() ? m_first : -1;
+    }
+
+    bool IsRemoved( int aItem ) const
+    {
+        return m_removed[aItem];
+    }
+
+    void Remove( int aItem )
+    {
+        if( !m_removed[aItem] )
+        {
+            m_removed[aItem] = true;
+            --m_count;
+        }
+    }
+
+    /**
+     * Function Find
+     * searches the items not removed yet for the one whose end point is the closest
+     * to \a aPoint, the lowest numbered one if several are as close.
+     * @param aLimit is the largest distance, a manhattan distance, still accepted.
+     * @return the item found, or -1 if no end point is within aLimit.
+     */
+    int Find( const wxPoint& aPoint, unsigned aLimit ) const
+    {
+        int cx = cell( aPoint.x );
+        int cy = cell( aPoint.y );
+
+        // Most of the time, an item ends exactly at aPoint
+        int found = -1;
+
+        auto exact = m_grid.find( cellKey( cx, cy ) );
+
+        if( exact != m_grid.end() )
+        {
+            for( int end : exact->second )
+            {
+                if( !m_removed[end / 2] && m_ends[end] == aPoint
+                    && ( found < 0 || end / 2 < found ) )
+                    found = end / 2;
+            }
+        }
+
+        if( found >= 0 || aLimit == 0 )
+            return found;
+
+        // Else look for the closest end point in the cells within aLimit
+        int      limit = aLimit > INT_MAX / 2 ? INT_MAX / 2 : aLimit;
+        unsigned min_d = UINT_MAX;
+
+        for( int x = cell( aPoint.x - limit ); x <= cell( aPoint.x + limit ); ++x )
+        {
+            for( int y = cell( aPoint.y - limit ); y <= cell( aPoint.y + limit ); ++y )
+            {
+                auto it = m_grid.find( cellKey( x, y ) );
+
+                if( it == m_grid.end() )
+                    continue;
+
+                for( int end : it->second )
+                {
+                    if( m_removed[end / 2] )
+                        continue;
+
+                    const wxPoint& pt = m_ends[end];
+                    unsigned d = unsigned( abs( pt.x - aPoint.x ) + abs( pt.y - aPoint.y ) );
+
+                    if( d < min_d || ( d == min_d && end / 2 < found ) )
+                    {
+                        min_d = d;
+                        found = end / 2;
+                    }
+                }
+            }
+        }
+
+        return min_d <= aLimit ? found : -1;
+    }
+
+private:
+    int cell( int aCoord ) const
+    {
+        // Round towards minus infinity, so cells are the same size around 0
+        if( aCoord >= 0 )
+            return aCoord / m_cellSize;
+
+        return -int( ( -(long long) aCoord - 1 ) / m_cellSize ) - 1;
+    }
+
+    static unsigned long long cellKey( int aX, int aY )
+    {
+        return ( (unsigned long long) (unsigned) aX << 32 ) | (unsigned) aY;
+    }
+
+    int                     m_cellSize;
+    int                     m_count;        ///< number of items not removed
+    int                     m_first;        ///< no item below this one is left
+    std::vector<wxPoint>    m_ends;         ///< start and end point of each item
+    std::vector<bool>       m_removed;
+
+    /// The end points in each cell, as 2 * item for the start, 2 * item + 1 for the end
+    std::unordered_map<unsigned long long, std::vector<int>> m_grid;
+};
+
+#endif  // ENDPOINT_INDEX_H_
@@ -68,6 +68,22 @@ public:
     /// @copydoc COMPOSITOR::DrawBuffer()
     virtual void DrawBuffer( unsigned int aBufferHandle ) override;
 
+    /**
+     * Function GetBufferSurface()
+     * Returns the image surface holding the pixels of a buffer.
+     *
+     * @param aBufferHandle is the handle of the buffer.
+     */
+    cairo_surface_t* GetBufferSurface( unsigned int aBufferHandle ) const;
+
+    /**
+     * Function GetBufferContext()
+     * Returns the context drawing on a buffer.
+     *
+     * @param aBufferHandle is the handle of the buffer.
+     */
+    cairo_t* GetBufferContext( unsigned int aBufferHandle ) const;
+
     /**
      * Function SetMainContext()
      * Sets a context to be treated as the main context (ie. as a target of buffers rendering and
@@ -117,7 +133,7 @@ protected:
     void clean();
 
     /// Returns number of currently used buffers
-    unsigned int usedBuffers()
+    unsigned int usedBuffers() const
     {
         return m_buffers.size();
     }
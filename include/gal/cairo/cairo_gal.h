@@ -28,6 +28,7 @@
 #define CAIROGAL_H_
 
 #include <map>
+#include <vector>
 #include <iterator>
 
 #include <cairo.h>
@@ -267,6 +268,17 @@ public:
         paintListener = aPaintListener;
     }
 
+    /**
+     * @brief Sets the number of threads rasterizing the cached groups.
+     *
+     * With more than one thread, the groups drawn on the main buffer are queued and
+     * replayed later in parallel, each thread drawing a horizontal band of the buffer.
+     * The default is the number of processors, up to 8.
+     *
+     * @param aCount is the number of threads, 1 draws the groups right away.
+     */
+    void SetRenderingThreads( unsigned int aCount );
+
 protected:
     virtual void drawGridLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
 
@@ -337,6 +349,22 @@ private:
     unsigned int                groupCounter;       ///< Counter used for generating keys for groups
     GROUP*                      currentGroup;       ///< Currently used group
 
+    /// State of the group virtual machine, changed by the group commands
+    struct GROUP_STATE
+    {
+        bool    isFillEnabled;
+        bool    isStrokeEnabled;
+        COLOR4D fillColor;
+        COLOR4D strokeColor;
+        double  lineWidth;
+    };
+
+    // Variables for the parallel rasterization of groups
+    unsigned int                renderingThreads;   ///< Threads drawing the queued groups
+    std::vector<int>            queuedGroups;       ///< Groups waiting to be drawn
+    GROUP_STATE                 queuedState;        ///< State before the first queued group
+    cairo_matrix_t              queuedMatrix;       ///< Transformation of the queued groups
+
     // Variables related to Cairo <-> wxWidgets
     cairo_matrix_t      cairoWorldScreenMatrix; ///< Cairo world to screen transformation matrix
     cairo_t*            currentContext;         ///< Currently used Cairo context for drawing
@@ -354,6 +382,18 @@ private:
     // Methods
     void storePath();                           ///< Store the actual path
 
+    /**
+     * @brief Executes the commands of a group.
+     *
+     * @param aContext is the context to draw on.
+     * @param aGroupNumber is the group to be executed.
+     * @param aState is the state of the group virtual machine, updated by the commands.
+     */
+    void replayGroup( cairo_t* aContext, int aGroupNumber, GROUP_STATE& aState ) const;
+
+    /// Draws the queued groups on the main buffer, one band of it per thread
+    void drawQueuedGroups();
+
     // Event handlers
     /**
      * @brief Paint event handler.
@@ -0,0 +1,178 @@
+/*
+ * This program source code file is part of KICAD, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 Kicad Developers, see change_log.txt for contributors.
+ *
+ * Graphics Abstraction Layer (GAL) - recorded drawing commands
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef DISPLAY_LIST_H_
+#define DISPLAY_LIST_H_
+
+#include <vector>
+
+#include <gal/graphics_abstraction_layer.h>
+
+namespace KIGFX
+{
+/**
+ * @brief Class DISPLAY_LIST stores a sequence of drawing commands, so they can be
+ * produced by a DISPLAY_LIST_RECORDER and played back later on any GAL.
+ *
+ * Stroke texts are stored as the lines they are made of, bitmap texts as text, so the
+ * target GAL may still use its own bitmap font.
+ */
+class DISPLAY_LIST
+{
+public:
+    /// @brief Removes all the commands.
+    void Clear();
+
+    /// @brief Returns the number of commands, a position usable with Replay().
+    size_t Size() const
+    {
+        return m_commands.size();
+    }
+
+    /**
+     * @brief Sends the commands to a GAL.
+     *
+     * @param aGal is the target GAL.
+     * @param aBegin is the position of the first command to be sent.
+     * @param aEnd is the position after the last command to be sent.
+     */
+    void Replay( GAL* aGal, size_t aBegin, size_t aEnd ) const;
+
+    /// @brief Sends all the commands to a GAL.
+    void Replay( GAL* aGal ) const
+    {
+        Replay( aGal, 0, m_commands.size() );
+    }
+
+private:
+    friend class DISPLAY_LIST_RECORDER;
+
+    enum COMMAND_TYPE
+    {
+        CMD_SET_IS_FILL,
+        CMD_SET_IS_STROKE,
+        CMD_SET_FILL_COLOR,
+        CMD_SET_STROKE_COLOR,
+        CMD_SET_LINE_WIDTH,
+        CMD_SET_LAYER_DEPTH,
+        CMD_LINE,
+        CMD_SEGMENT,
+        CMD_POLYLINE,
+        CMD_CIRCLE,
+        CMD_ARC,
+        CMD_RECTANGLE,
+        CMD_POLYGON,
+        CMD_CURVE,
+        CMD_BITMAP_TEXT,
+        CMD_TRANSFORM,
+        CMD_ROTATE,
+        CMD_TRANSLATE,
+        CMD_SCALE,
+        CMD_SAVE,
+        CMD_RESTORE
+    };
+
+    struct COMMAND
+    {
+        COMMAND_TYPE m_type;
+        unsigned     m_values;      ///< Index of the first parameter in m_values
+        unsigned     m_points;      ///< Index of the first point in m_points
+        unsigned     m_count;       ///< Number of points, or index in m_texts
+    };
+
+    void add( COMMAND_TYPE aType, unsigned aPointCount = 0 );
+
+    std::vector<COMMAND>  m_commands;
+    std::vector<double>   m_values;
+    std::vector<VECTOR2D> m_points;
+    std::vector<wxString> m_texts;
+};
+
+
+/**
+ * @brief Class DISPLAY_LIST_RECORDER is a GAL that stores everything drawn on it in a
+ * DISPLAY_LIST instead of rendering it.
+ *
+ * It does not need any window or graphics context, so painters may draw on recorders
+ * from worker threads, as long as every thread uses its own recorder and painter.
+ */
+class DISPLAY_LIST_RECORDER : public GAL
+{
+public:
+    /**
+     * @param aList is the list receiving the commands.
+     * @param aTarget is the GAL the commands are meant for, its world scale is copied
+     * for painters depending on it.
+     */
+    DISPLAY_LIST_RECORDER( DISPLAY_LIST& aList, const GAL& aTarget );
+
+    virtual void DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
+    virtual void DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                              double aWidth ) override;
+    virtual void DrawPolyline( const std::deque<VECTOR2D>& aPointList ) override;
+    virtual void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
+    virtual void DrawCircle( const VECTOR2D& aCenterPoint, double aRadius ) override;
+    virtual void DrawArc( const VECTOR2D& aCenterPoint, double aRadius,
+                          double aStartAngle, double aEndAngle ) override;
+    virtual void DrawRectangle( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
+    virtual void DrawPolygon( const std::deque<VECTOR2D>& aPointList ) override;
+    virtual void DrawPolygon( const VECTOR2D aPointList[], int aListSize ) override;
+    virtual void DrawCurve( const VECTOR2D& startPoint, const VECTOR2D& controlPointA,
+                            const VECTOR2D& controlPointB, const VECTOR2D& endPoint ) override;
+    virtual void BitmapText( const wxString& aText, const VECTOR2D& aPosition,
+                             double aRotationAngle ) override;
+
+    virtual void SetIsFill( bool aIsFillEnabled ) override;
+    virtual void SetIsStroke( bool aIsStrokeEnabled ) override;
+    virtual void SetFillColor( const COLOR4D& aColor ) override;
+    virtual void SetStrokeColor( const COLOR4D& aColor ) override;
+    virtual void SetLineWidth( double aLineWidth ) override;
+    virtual void SetLayerDepth( double aLayerDepth ) override;
+
+    virtual void Transform( const MATRIX3x3D& aTransformation ) override;
+    virtual void Rotate( double aAngle ) override;
+    virtual void Translate( const VECTOR2D& aTranslation ) override;
+    virtual void Scale( const VECTOR2D& aScale ) override;
+    virtual void Save() override;
+    virtual void Restore() override;
+
+private:
+    void addPoint( const VECTOR2D& aPoint )
+    {
+        m_list.m_points.push_back( aPoint );
+    }
+
+    void addValue( double aValue )
+    {
+        m_list.m_values.push_back( aValue );
+    }
+
+    void addColor( const COLOR4D& aColor );
+
+    DISPLAY_LIST& m_list;
+};
+} // namespace KIGFX
+
+#endif /* DISPLAY_LIST_H_ */
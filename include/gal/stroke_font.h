@@ -30,6 +30,8 @@
 #define STROKE_FONT_H_
 
 #include <deque>
+#include <memory>
+#include <vector>
 #include <utf8.h>
 
 #include <eda_text.h>
@@ -120,12 +122,66 @@ public:
      */
     static double GetInterline( double aGlyphHeight, double aGlyphThickness );
 
+    /**
+     * @brief Forgets the strokes of the lines of text drawn so far.
+     *
+     * Lines of text are stroked once for a given size, thickness and style, and later
+     * only translated and rotated.  The cache is shared by all the STROKE_FONT instances.
+     */
+    static void ClearTextCache();
+
 
 
 private:
+    /**
+     * @brief Glyphs of a font, decoded once and shared read-only by all the STROKE_FONT
+     * instances using the same font, whatever the thread.
+     *
+     * The points of all the strokes are stored contiguously, a stroke being a range of
+     * m_points and a glyph a range of m_strokes.
+     */
+    struct GLYPH_TABLE
+    {
+        std::vector<VECTOR2D>   m_points;           ///< Points of all the strokes
+        std::vector<unsigned>   m_strokes;          ///< First point of each stroke, and the end
+        std::vector<unsigned>   m_glyphs;           ///< First stroke of each glyph, and the end
+        std::vector<BOX2D>      m_boundingBoxes;    ///< Bounding boxes of the glyphs
+
+        int GlyphCount() const
+        {
+            return m_boundingBoxes.size();
+        }
+    };
+
+    struct GLYPH_RUN;
+    class GLYPH_RUN_CACHE;
+
     GAL*                m_gal;                  ///< Pointer to the GAL
-    GLYPH_LIST          m_glyphs;               ///< Glyph list
-    std::vector<BOX2D>  m_glyphBoundingBoxes;   ///< Bounding boxes of the glyphs
+    std::shared_ptr<const GLYPH_TABLE> m_glyphTable;    ///< Glyphs of the loaded font
+
+    /// Returns the cache of stroked lines of text shared by all the instances
+    static GLYPH_RUN_CACHE& glyphRunCache();
+
+    /**
+     * @brief Strokes a single line of text with the current text attributes.
+     *
+     * @param aText is the line of text.
+     * @param aGlyphSize is the glyph size, with a negative width for mirrored texts.
+     * @param aXOffset is the X position of the first glyph.
+     * @param aRun receives the strokes.
+     */
+    void buildGlyphRun( const UTF8& aText, const VECTOR2D& aGlyphSize, double aXOffset,
+                        GLYPH_RUN& aRun ) const;
+
+    /**
+     * @brief Decodes a font in the Newstroke format.
+     *
+     * @param aNewStrokeFont is the pointer to the font data.
+     * @param aNewStrokeFontSize is the size of the font data.
+     * @return the decoded font, the caller takes ownership.
+     */
+    static GLYPH_TABLE* decodeNewStrokeFont( const char* const aNewStrokeFont[],
+                                             int aNewStrokeFontSize );
 
     /**
      * @brief Compute the X and Y size of a given text. The text is expected to be
@@ -150,15 +206,6 @@ private:
      */
     int getInterline() const;
 
-    /**
-     * @brief Compute the bounding box of a given glyph.
-     *
-     * @param aGlyph is the glyph.
-     * @param aGlyphBoundingX is the x-component of the bounding box size.
-     * @return is the complete bounding box size.
-     */
-    BOX2D computeBoundingBox( const GLYPH& aGlyph, const VECTOR2D& aGlyphBoundingX ) const;
-
     /**
      * @brief Draws a single line of text. Multiline texts should be split before using the
      * function.
@@ -0,0 +1,104 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __DELAUNAY_TRIANGULATOR_H
+#define __DELAUNAY_TRIANGULATOR_H
+
+#include <vector>
+
+#include <math/vector2d.h>
+
+/**
+ * Class DELAUNAY_TRIANGULATOR
+ * computes the Delaunay triangulation of a set of points with the sweep-hull algorithm.
+ * <p>
+ * Triangles and edges are stored in plain arrays, and refer to the points by their index.
+ * The arrays are kept between calls, so an object that triangulates many sets of points
+ * allocates memory only when a set is larger than all the previous ones.
+ */
+class DELAUNAY_TRIANGULATOR
+{
+public:
+    ///> Edge of the triangulation, given by the indexes of its end points.
+    struct EDGE
+    {
+        int m_source;
+        int m_target;
+    };
+
+    DELAUNAY_TRIANGULATOR();
+
+    /**
+     * Function Triangulate
+     * replaces the previous triangulation with the one of \a aPoints.  The points must be
+     * distinct.  If they are all on one line, every point is joined to the next one on the
+     * line instead.
+     */
+    void Triangulate( const std::vector<VECTOR2I>& aPoints );
+
+    /**
+     * Function GetEdges
+     * @return the edges of the last triangulation, each edge is listed once.
+     */
+    const std::vector<EDGE>& GetEdges() const
+    {
+        return m_edges;
+    }
+
+private:
+    ///> Adds a triangle and links its edges to the opposite half-edges.
+    int addTriangle( int aI0, int aI1, int aI2, int aA, int aB, int aC );
+
+    ///> Makes two half-edges opposite to each other.
+    void link( int aA, int aB );
+
+    ///> Flips the triangles around a new half-edge until they satisfy the Delaunay condition.
+    int legalize( int aA );
+
+    ///> Returns the bucket of the hull hash table used for a point.
+    int hashKey( const VECTOR2D& aPoint ) const;
+
+    ///> Joins points that could not be triangulated to their closest neighbour.
+    void joinSkippedPoints();
+
+    std::vector<VECTOR2D> m_points;
+    std::vector<int>      m_triangles;  ///< 3 point indexes per triangle
+    std::vector<int>      m_halfedges;  ///< opposite half-edge of each half-edge, or -1
+    int                   m_trianglesLen;
+
+    // The convex hull of the points added so far, as a doubly linked list
+    std::vector<int>      m_hullPrev;
+    std::vector<int>      m_hullNext;
+    std::vector<int>      m_hullTri;    ///< triangle half-edge of each hull point
+    std::vector<int>      m_hullHash;   ///< hull points by their angle to the center
+    int                   m_hullStart;
+    VECTOR2D              m_center;
+
+    std::vector<int>      m_ids;        ///< points sorted by their distance to the center
+    std::vector<double>   m_dists;
+    std::vector<int>      m_edgeStack;
+    std::vector<int>      m_skipped;
+    std::vector<EDGE>     m_edges;
+};
+
+#endif  // __DELAUNAY_TRIANGULATOR_H
@@ -31,6 +31,7 @@
 #include <set>
 
 #include <gal/color4d.h>
+#include <math/box2.h>
 #include <colors.h>
 #include <worksheet_shape_builder.h>
 #include <memory>
@@ -207,6 +208,43 @@ public:
         m_backgroundColor = aColor;
     }
 
+    /**
+     * Function SetLODEnabled
+     * Turns on or off the simplified drawing of items that are small on the screen (see
+     * PAINTER::GetLOD()).
+     */
+    inline void SetLODEnabled( bool aEnabled )
+    {
+        m_lodEnabled = aEnabled;
+    }
+
+    inline bool IsLODEnabled() const
+    {
+        return m_lodEnabled;
+    }
+
+    /**
+     * Function SetLODSizes
+     * Sets the sizes on the screen below which items may be skipped or drawn as proxies.
+     * @param aHideSize is the size in pixels below which items may be skipped.
+     * @param aProxySize is the size in pixels below which items may be drawn as proxies.
+     */
+    inline void SetLODSizes( double aHideSize, double aProxySize )
+    {
+        m_lodHideSize  = aHideSize;
+        m_lodProxySize = aProxySize;
+    }
+
+    inline double GetLODHideSize() const
+    {
+        return m_lodHideSize;
+    }
+
+    inline double GetLODProxySize() const
+    {
+        return m_lodProxySize;
+    }
+
 protected:
     /**
      * Function update
@@ -235,6 +273,11 @@ protected:
 
     COLOR4D m_backgroundColor;      ///< The background color
 
+    /// Level of detail settings
+    bool    m_lodEnabled;           ///< Small items are skipped or drawn as proxies
+    double  m_lodHideSize;          ///< Size in pixels below which items may be skipped
+    double  m_lodProxySize;         ///< Size in pixels below which items may be proxies
+
     /// Map of colors that were usually used for display
     std::map<EDA_COLOR_T, COLOR4D> m_legacyColorMap;
 };
@@ -301,7 +344,61 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Function Clone
+     * Returns a copy of the painter, with the same settings, to draw items on a worker
+     * thread.  The copy has to be given its own GAL with SetGAL() before being used.
+     * @return the copy or NULL if the painter cannot be used from several threads.
+     */
+    virtual PAINTER* Clone() const
+    {
+        return NULL;
+    }
+
+    /// Ways of drawing an item, depending on its size on the screen
+    enum LOD_LEVEL
+    {
+        LOD_FULL,       ///< The item is drawn by Draw()
+        LOD_PROXY,      ///< The item is drawn by DrawProxy()
+        LOD_HIDDEN      ///< The item is not drawn
+    };
+
+    /**
+     * Function GetLOD
+     * Tells how an item should be drawn at the current zoom. By default items are always
+     * drawn in full.
+     *
+     * @param aItem is the item to be drawn.
+     * @param aLayer is the layer it is drawn on.
+     */
+    virtual LOD_LEVEL GetLOD( const VIEW_ITEM* aItem, int aLayer )
+    {
+        return LOD_FULL;
+    }
+
+    /**
+     * Function DrawProxy
+     * Draws the simplified shape standing for an item that is small on the screen, by
+     * default its bounding box filled with the item color. Proxies are cached like the
+     * full geometry, so they must not depend on the zoom.
+     *
+     * @param aItem is the item to be drawn.
+     * @param aLayer is the layer it is drawn on.
+     */
+    virtual void DrawProxy( const VIEW_ITEM* aItem, int aLayer );
+
 protected:
+    /**
+     * Function lodBySize
+     * Returns the level of detail of an item from the size of its bounding box on the
+     * screen, according to the level of detail settings.
+     *
+     * @param aBBox is the bounding box of the item.
+     * @param aMayHide tells if the item may be skipped when very small.
+     * @param aMayProxy tells if the item may be drawn as a proxy when small.
+     */
+    LOD_LEVEL lodBySize( const BOX2I& aBBox, bool aMayHide, bool aMayProxy );
+
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
     GAL* m_gal;
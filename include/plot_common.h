@@ -33,11 +33,13 @@
 #define PLOT_COMMON_H_
 
 #include <vector>
+#include <unordered_map>
 #include <math/box2.h>
 #include <drawtxt.h>
 #include <class_page_info.h>
 #include <eda_text.h>       // FILL_T
 
+class wxOutputStream;
 class SHAPE_POLY_SET;
 class GBR_NETLIST_METADATA;
 
@@ -705,6 +707,9 @@ protected:
                                       std::vector<int> *pos_pairs );
     void fputsPostscriptString(FILE *fout, const wxString& txt);
 
+    /// Returns a string escaped for postscript/PDF, parentheses included
+    static std::string encodePostscriptString( const wxString& txt );
+
     /// Virtual primitive for emitting the setrgbcolor operator
     virtual void emitSetRGBColor( double r, double g, double b ) = 0;
 
@@ -783,7 +788,8 @@ protected:
 class PDF_PLOTTER : public PSLIKE_PLOTTER
 {
 public:
-    PDF_PLOTTER() : pageStreamHandle( 0 ), workFile( NULL )
+    PDF_PLOTTER() : pageStreamHandle( 0 ), streamStart( 0 ), zStream( NULL ),
+        compressionLevel( 1 ), writeError( false )
     {
         // Avoid non initialized variables:
         pageStreamHandle = streamLengthHandle = fontResDictHandle = 0;
@@ -811,12 +817,46 @@ public:
     virtual bool OpenFile( const wxString& aFullFilename ) override;
 
     virtual bool StartPlot() override;
+
+    /**
+     * Write the end of the document and close the file
+     * @return false if a write to the file failed
+     */
     virtual bool EndPlot() override;
     virtual void StartPage();
     virtual void ClosePage();
     virtual void SetCurrentLineWidth( int width, void* aData = NULL ) override;
     virtual void SetDash( bool dashed ) override;
 
+    /**
+     * Start the document like StartPlot(), but without opening its first page:
+     * pages are then added with StartPage() or AddPage()
+     */
+    bool StartDocument();
+
+    /**
+     * Start a page plotted in memory instead of in a file, on a plotter of its own:
+     * no file is opened, the page settings and viewport are set as for a page in a
+     * document. Pages of a document can so be plotted by several threads, and added
+     * to the document by AddPage() in the right order.
+     */
+    void StartPageContent();
+
+    /**
+     * Finish a page started by StartPageContent()
+     * @return false if the page could not be compressed
+     */
+    bool ClosePageContent();
+
+    /// @return the compressed content of a page plotted by StartPageContent()
+    const std::string& GetPageContent() const { return pageContent; }
+
+    /**
+     * Add a page plotted in memory to the document, with the current page settings
+     * @param aContent = the page content, from GetPageContent()
+     */
+    void AddPage( const std::string& aContent );
+
     /** PDF can have multiple pages, so SetPageSettings can be called
      * with the outputFile open (but not inside a page stream!) */
     virtual void SetPageSettings( const PAGE_INFO& aPageSettings ) override;
@@ -851,6 +891,11 @@ public:
     virtual void PlotImage( const wxImage& aImage, const wxPoint& aPos,
                             double aScaleFactor ) override;
 
+    /**
+     * Set the DEFLATE compression level of the page streams, from 0 (no compression)
+     * to 9 (smallest file). The default, 1, is the fastest one.
+     */
+    void SetCompressionLevel( int aLevel ) { compressionLevel = aLevel; }
 
 protected:
     virtual void emitSetRGBColor( double r, double g, double b ) override;
@@ -859,13 +904,36 @@ protected:
     void closePdfObject();
     int startPdfStream(int handle = -1);
     void closePdfStream();
+
+    /// printf like output to the current stream
+    void streamPrintf( const char* aFormat, ... );
+
+    /// Raw output to the current stream
+    void streamWrite( const void* aData, size_t aSize );
+
+    /// Compress the buffered content of the current stream
+    void flushStreamBuffer();
+
+    /// Finish and delete zStream, a write error is kept in writeError
+    void closeZStream();
+
+    /// Set the paper size and emit the default graphic settings of a new page
+    void startPageContent();
+
+    /// Emit the page object of the page whose content is pageStreamHandle
+    void emitPageObject();
+
     int pageTreeHandle;		 /// Handle to the root of the page tree object
     int fontResDictHandle;	 /// Font resource dictionary
     std::vector<int> pageHandles;/// Handles to the page objects
     int pageStreamHandle;	 /// Handle of the page content object
     int streamLengthHandle;      /// Handle to the deferred stream length
-    wxString workFilename;
-    FILE* workFile;  	         /// Temporary file to costruct the stream before zipping
+    long streamStart;            /// Offset of the current stream data in outputFile
+    std::vector<char> streamBuffer;  /// Stream content waiting to be compressed
+    wxOutputStream* zStream;     /// Compresses the current stream to outputFile, or NULL
+    int compressionLevel;        /// DEFLATE level of the streams
+    std::string pageContent;     /// Compressed content of a page plotted in memory
+    bool writeError;             /// A stream could not be written, reported by EndPlot()
     std::vector<long> xrefTable; /// The PDF xref offset table
 };
 
@@ -964,7 +1032,8 @@ public:
         Circle   = 1,
         Rect     = 2,
         Plotting = 3,
-        Oval     = 4
+        Oval     = 4,
+        Outline  = 5        // polygon, defined by an aperture macro
     };
 
     wxSize        m_Size;     // horiz and Vert size
@@ -973,6 +1042,8 @@ public:
     int           m_ApertureAttribute;  // the attribute attached to this aperture
                                         // Only one attribute is allowed by aperture
                                         // 0 = no specific aperture attribute
+    std::vector<wxPoint> m_Corners;     // Outline apertures only: the closed polygon,
+                                        // relative to the flash position
 };
 
 
@@ -1059,16 +1130,14 @@ public:
                                EDA_DRAW_MODE_T trace_mode, void* aData ) override;
     /**
      * Filled rect flashes are handled as aperture in the 0 90 180 or 270 degree orientation only
-     * and as polygon for other orientations
-     * TODO: always use flashed shapes (aperture macros)
+     * and as trapezoidal pads for other orientations
      */
     virtual void FlashPadRect( const wxPoint& pos, const wxSize& size,
                                double orient, EDA_DRAW_MODE_T trace_mode, void* aData ) override;
 
     /**
-     * Roundrect pad at the moment are not handled as aperture, since
-     * they require aperture macros
-     * TODO: always use flashed shapes (aperture macros)
+     * Roundrect pads are handled as aperture macros if UseApertureMacros() is set,
+     * as polygons otherwise
      */
     virtual void FlashPadRoundRect( const wxPoint& aPadPos, const wxSize& aSize,
                                     int aCornerRadius, double aOrient,
@@ -1077,9 +1146,8 @@ public:
                                  SHAPE_POLY_SET* aPolygons,
                                  EDA_DRAW_MODE_T aTraceMode, void* aData ) override;
     /**
-     * Trapezoidal pad at the moment are *never* handled as aperture, since
-     * they require aperture macros
-     * TODO: always use flashed shapes (aperture macros)
+     * Trapezoidal pads are handled as aperture macros if UseApertureMacros() is set,
+     * as polygons otherwise
      */
     virtual void FlashPadTrapez( const wxPoint& aPadPos, const wxPoint *aCorners,
                                  double aPadOrient, EDA_DRAW_MODE_T aTrace_Mode, void* aData ) override;
@@ -1105,6 +1173,14 @@ public:
     void UseX2Attributes( bool aEnable ) { m_useX2Attributes = aEnable; }
     void UseX2NetAttributes( bool aEnable ) { m_useNetAttributes = aEnable; }
 
+    /**
+     * Function UseApertureMacros
+     * when enabled, filled trapezoidal, rotated rectangular and round rect pads are
+     * flashed with outline aperture macros, one per distinct shape, instead of being
+     * plotted as G36/G37 regions, one per pad
+     */
+    void UseApertureMacros( bool aEnable ) { m_useApertureMacros = aEnable; }
+
     /**
      * calling this function allows to define the beginning of a group
      * of drawing items (used in X2 format with netlist attributes)
@@ -1127,7 +1203,16 @@ protected:
      * write the DCode selection on gerber file
      */
     void selectAperture( const wxSize& aSize, APERTURE::APERTURE_TYPE aType,
-                         int aApertureAttribute );
+                         int aApertureAttribute, const std::vector<wxPoint>* aCorners = NULL );
+
+    /**
+     * Function flashOutline
+     * flashes a polygonal pad as an Outline aperture (aperture macro)
+     * @param aPos = the pad position
+     * @param aCorners = the pad outline, relative to aPos. It is closed if needed
+     * @param aData = the GBR_METADATA of the pad, or NULL
+     */
+    void flashOutline( const wxPoint& aPos, std::vector<wxPoint>& aCorners, void* aData );
 
     /**
      * Emit a D-Code record, using proper conversions
@@ -1158,9 +1243,11 @@ protected:
      * @param aType = the type ( shape ) of tool
      * @param aApertureAttribute = an aperture attribute of the tool (a tool can have onlu one attribute)
      * 0 = no specific attribute
+     * @param aCorners = the polygon of an Outline aperture, NULL for other types
      */
     std::vector<APERTURE>::iterator getAperture( const wxSize& aSize,
-                    APERTURE::APERTURE_TYPE aType, int aApertureAttribute );
+                    APERTURE::APERTURE_TYPE aType, int aApertureAttribute,
+                    const std::vector<wxPoint>* aCorners = NULL );
 
     // the attributes dictionnary created/modifed by %TO, attached the objects, when they are created
     // by D01, D03 G36/G37 commands
@@ -1186,6 +1273,10 @@ protected:
     std::vector<APERTURE>           apertures;
     std::vector<APERTURE>::iterator currentAperture;
 
+    // Hash of the type, size, attribute (and corners) of apertures -> index in apertures,
+    // to find existing apertures without scanning the whole list
+    std::unordered_multimap<size_t, int> m_apertureIndex;
+
     bool     m_gerberUnitInch;  // true if the gerber units are inches, false for mm
     int      m_gerberUnitFmt;   // number of digits in mantissa.
                                 // usually 6 in Inches and 5 or 6  in mm
@@ -1194,6 +1285,7 @@ protected:
     bool    m_useNetAttributes; // In recent gerber files, netlist info can be added.
                                 // It will be added if this parm is true
                                 // (imply m_useX2Attributes == true)
+    bool    m_useApertureMacros;    // Flash polygonal pads as aperture macros
 };
 
 
@@ -307,6 +307,7 @@ public:
 
 
 #define OUTPUTFMTBUFZ    500        ///< default buffer size for any OUTPUT_FORMATTER
+#define FILEFMTBUFZ      65536      ///< size of the FILE_OUTPUTFORMATTER write buffer
 
 /**
  * Class OUTPUTFORMATTER
@@ -332,6 +333,13 @@ class OUTPUTFORMATTER
     int sprint( const char* fmt, ... )  throw( IO_ERROR );
     int vprint( const char* fmt,  va_list ap )  throw( IO_ERROR );
 
+    /**
+     * Function quotes
+     * is the workhorse of Quotes() and Quotew(), working on the UTF8 bytes directly
+     * so neither needs an intermediate std::string.
+     */
+    static std::string quotes( const char* aWrapee, size_t aLength );
+
 
 protected:
     OUTPUTFORMATTER( int aReserve = OUTPUTFMTBUFZ, char aQuoteChar = '"' ) :
@@ -429,7 +437,7 @@ public:
      *
      * @throw IO_ERROR, if there is any kind of problem with the input string.
      */
-     virtual std::string Quotes( const std::string& aWrapee ) throw( IO_ERROR );
+     std::string Quotes( const std::string& aWrapee ) throw( IO_ERROR );
 
      std::string Quotew( const wxString& aWrapee ) throw( IO_ERROR );
 
@@ -509,13 +517,29 @@ public:
 
     ~FILE_OUTPUTFORMATTER();
 
+    /**
+     * Function Finish
+     * writes out any buffered text and closes the file.  Output is buffered
+     * in memory, so call this when done to have write errors reported as an
+     * IO_ERROR, the destructor can only ignore them.  Nothing may be output
+     * after this call.
+     * @param aSyncToDisk when true, also waits for the operating system to have
+     *  the file on disk, for callers about to replace a file with this one.
+     * @throw IO_ERROR, if the text cannot be written or the file closed.
+     */
+    void Finish( bool aSyncToDisk = false ) throw( IO_ERROR );
+
 protected:
     //-----<OUTPUTFORMATTER>------------------------------------------------
     void write( const char* aOutBuf, int aCount ) throw( IO_ERROR ) override;
     //-----</OUTPUTFORMATTER>-----------------------------------------------
 
+    /// Write the buffered text to m_fp.
+    void flush() throw( IO_ERROR );
+
     FILE*       m_fp;               ///< takes ownership
     wxString    m_filename;
+    std::string m_buffer;           ///< pending output, written in large blocks
 };
 
 
@@ -615,6 +615,34 @@ public:
      */
     void UpdateItems();
 
+    /**
+     * Function GetUpdatedItemsCount()
+     * Returns the number of items updated by the last call to UpdateItems(), for profiling.
+     */
+    int GetUpdatedItemsCount() const
+    {
+        return m_updatedItemsCount;
+    }
+
+    /**
+     * Function GetProxyItemsCount()
+     * Returns the number of items drawn as proxies by the last redraw, for profiling.
+     */
+    int GetProxyItemsCount() const
+    {
+        return m_proxyItemsCount;
+    }
+
+    /**
+     * Function GetHiddenItemsCount()
+     * Returns the number of items skipped by the last redraw for being too small on the
+     * screen, for profiling.
+     */
+    int GetHiddenItemsCount() const
+    {
+        return m_hiddenItemsCount;
+    }
+
     const BOX2I CalculateExtents() ;
 
     static const int VIEW_MAX_LAYERS = 256;      ///< maximum number of layers that may be shown
@@ -645,6 +673,8 @@ private:
     struct updateItemsColor;
     struct changeItemsDepth;
     struct extentsVisitor;
+    struct recordedItem;
+    struct geometryRecorder;
 
 
     ///* Redraws contents within rect aRect
@@ -669,6 +699,16 @@ private:
      */
     void draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate = false );
 
+    /**
+     * Function drawProxy()
+     * Draws the simplified shape standing for an item on a given layer, see
+     * PAINTER::DrawProxy(). Proxies of cached layers are cached in their own groups.
+     *
+     * @param aItem is the item to be drawn.
+     * @param aLayer is the layer which should be drawn.
+     */
+    void drawProxy( VIEW_ITEM* aItem, int aLayer );
+
     /**
      * Function draw()
      * Draws an item on all layers that the item uses.
@@ -701,14 +741,24 @@ private:
      * Manages dirty flags & redraw queueing when updating an item.
      * @param aItem is the item to be updated.
      * @param aUpdateFlags determines the way an item is refreshed.
+     * @param aRecorded is the item geometry recorded in advance, if any.
      */
-    void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags );
+    void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags,
+                         const recordedItem* aRecorded = nullptr );
+
+    /**
+     * Function dequeueItem()
+     * Takes an item off the list of items waiting for UpdateItems(), if it is on it.
+     */
+    void dequeueItem( VIEW_ITEM* aItem );
 
     /// Updates colors that are used for an item to be drawn
     void updateItemColor( VIEW_ITEM* aItem, int aLayer );
 
-    /// Updates all informations needed to draw an item
-    void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
+    /// Updates all informations needed to draw an item, replaying aRecorded if the
+    /// geometry was recorded in advance
+    void updateItemGeometry( VIEW_ITEM* aItem, int aLayer,
+                             const recordedItem* aRecorded = nullptr );
 
     /// Updates bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
@@ -776,6 +826,16 @@ private:
 
     /// Flat list of all items
     std::vector<VIEW_ITEM*> m_allItems;
+
+    /// Items waiting for UpdateItems(), each once, see VIEW::Update()
+    std::vector<VIEW_ITEM*> m_dirtyItems;
+
+    /// Number of items updated by the last UpdateItems() call
+    int m_updatedItemsCount;
+
+    /// Number of items drawn as proxies and skipped by the last Redraw() call
+    int m_proxyItemsCount;
+    int m_hiddenItemsCount;
 };
 } // namespace KIGFX
 
@@ -87,6 +87,7 @@ extern const wxString LegacyPcbFileWildcard;
 extern const wxString PcbFileWildcard;
 extern const wxString EaglePcbFileWildcard;
 extern const wxString PCadPcbFileWildcard;
+extern const wxString PcbBinaryFileWildcard;
 extern const wxString PdfFileWildcard;
 extern const wxString PSFileWildcard;
 extern const wxString MacrosFileWildcard;
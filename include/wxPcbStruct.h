@@ -30,6 +30,8 @@
 #define  WXPCB_STRUCT_H_
 
 
+#include <deque>
+
 #include <pcb_base_edit_frame.h>
 #include <config_params.h>
 #include <class_undoredo_container.h>
@@ -65,6 +67,7 @@ class REPORTER;
 struct PARSE_ERROR;
 class IO_ERROR;
 class FP_LIB_TABLE;
+class BACKGROUND_SAVER;
 
 namespace PCB { struct IFACE; }     // KIFACE_I is in pcbnew.cpp
 
@@ -98,6 +101,18 @@ protected:
 
     wxString          m_lastNetListRead;        ///< Last net list read with relative path.
 
+    BACKGROUND_SAVER* m_backgroundSaver;        ///< writes the board files, see SavePcbFile()
+
+    /// A board file queued to m_backgroundSaver.  Jobs are reported in the order queued.
+    struct QUEUED_SAVE
+    {
+        bool     m_autoSave;                    ///< an auto save file, see doAutoSave()
+        unsigned m_modifyCount;                 ///< m_modifyCount when the board was copied
+    };
+
+    std::deque<QUEUED_SAVE> m_queuedSaves;      ///< files not yet reported
+    unsigned          m_modifyCount;            ///< number of OnModify() calls
+
     // The Tool Framework initalization
     void setupTools();
 
@@ -173,6 +188,13 @@ protected:
      */
     virtual bool doAutoSave() override;
 
+    /**
+     * Function onBackgroundSaveDone
+     * reports a board file written by m_backgroundSaver.  Once the board file is written,
+     * the board is marked as saved, unless it was modified after SavePcbFile() copied it.
+     */
+    void onBackgroundSaveDone( wxThreadEvent& aEvent );
+
     /**
      * Function isautoSaveRequired
      * returns true if the board has been modified.
@@ -826,16 +848,29 @@ public:
      * Function SavePcbFile
      * writes the board data structures to \a a aFileName
      * Creates backup when requested and update flags (modified and saved flgs)
+     * <p>
+     * Only a snapshot of the board is taken here, the file itself is written by a
+     * background thread and write errors are reported when it has finished.  Call
+     * WaitForBackgroundSave() when the file must be complete before going on.
+     * The modified flag is cleared only when the file is written, and only if the
+     * board was not modified in the meantime.
      *
      * @param aFileName The file name to write or wxEmptyString to prompt user for
      *                  file name.
      * @param aCreateBackupFile Creates a back of \a aFileName if true.  Helper
      *                          definitions #CREATE_BACKUP_FILE and #NO_BACKUP_FILE
      *                          are defined for improved code readability.
-     * @return True if file was saved successfully.
+     * @return True if the file was queued for writing, not that it is written.  False if
+     *         it cannot be written at all, e.g. the directory is read only.
      */
     bool SavePcbFile( const wxString& aFileName, bool aCreateBackupFile = CREATE_BACKUP_FILE );
 
+    /**
+     * Function WaitForBackgroundSave
+     * blocks until the files queued by SavePcbFile() are written, and reports them.
+     */
+    void WaitForBackgroundSave();
+
     /**
      * Function SavePcbCopy
      * writes the board data structures to \a a aFileName
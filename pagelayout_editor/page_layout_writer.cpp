@@ -93,7 +93,7 @@ class WORKSHEET_LAYOUT_FILEIO: public WORKSHEET_LAYOUT_IO
 
 public:
     WORKSHEET_LAYOUT_FILEIO( const wxString& aFilename ):
-        WORKSHEET_LAYOUT_IO()
+        WORKSHEET_LAYOUT_IO(), m_fileout( NULL )
     {
         try
         {
@@ -108,6 +108,16 @@ public:
 
     ~WORKSHEET_LAYOUT_FILEIO()
     {
+        try
+        {
+            if( m_fileout )
+                m_fileout->Finish();
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxMessageBox( ioe.What(), _( "Error writing page layout descr file" ) );
+        }
+
         delete m_fileout;
     }
 };
@@ -102,6 +102,8 @@ bool PCB_CALCULATOR_FRAME::WriteDataFile()
 
         while( nestlevel-- )
             formatter.Print( nestlevel, ")\n" );
+
+        formatter.Finish();
     }
     catch( const IO_ERROR& )
     {
@@ -86,84 +86,89 @@ wxString BOARD_ITEM::GetLayerName() const
 }
 
 
-std::string BOARD_ITEM::FormatInternalUnits( int aValue )
+/**
+ * Function formatInternalUnits
+ * writes \a aValue in millimeters to \a aBuf, without any trailing zeros, and
+ * returns the length written.  With nanometer internal units this is integer
+ * arithmetic only and gives the same text as "%.10g" (the fractional part has
+ * at most 6 digits and a 32 bit value at most 10 significant digits).
+ */
+static int formatInternalUnits( char* aBuf, int aValue )
 {
-#if 1
-
-    char    buf[50];
-    int     len;
-    double  mm = aValue / IU_PER_MM;
-
-    if( mm != 0.0 && fabs( mm ) <= 0.0001 )
+    if( IU_PER_MM != 1e6 )
     {
-        len = sprintf( buf, "%.10f", mm );
+        int     len;
+        double  mm = aValue / IU_PER_MM;
+
+        if( mm != 0.0 && fabs( mm ) <= 0.0001 )
+        {
+            len = sprintf( aBuf, "%.10f", mm );
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+            while( --len > 0 && aBuf[len] == '0' )
+                aBuf[len] = '\0';
 
-        if( buf[len] == '.' )
-            buf[len] = '\0';
+            if( aBuf[len] == '.' )
+                aBuf[len] = '\0';
+            else
+                ++len;
+        }
         else
-            ++len;
-    }
-    else
-    {
-        len = sprintf( buf, "%.10g", mm );
-    }
+        {
+            len = sprintf( aBuf, "%.10g", mm );
+        }
 
-    return std::string( buf, len );
+        return len;
+    }
 
-#else
+    char*       p = aBuf;
+    unsigned    value = aValue;
 
-    // Assume aValue is in nanometers, and that we want the result in millimeters,
-    // and that int is 32 bits wide.  Then perform an alternative algorithm.
-    // Can be used to verify that the above algorithm is correctly generating text.
-    // Convert aValue into an integer string, then insert a decimal point manually.
-    // Results are the same as above general purpose algorithm.
+    if( aValue < 0 )
+    {
+        *p++  = '-';
+        value = 0u - value;
+    }
 
-    wxASSERT( sizeof(int) == 4 );
+    unsigned    integer  = value / 1000000;
+    unsigned    fraction = value % 1000000;
+    char        digits[10];
+    int         count = 0;
 
-    if( aValue == 0 )
-        return std::string( 1, '0' );
-    else
+    do
     {
-        char    buf[50];
-        int     len = sprintf( buf, aValue > 0 ? "%06d" : "%07d", aValue );     // optionally pad w/leading zeros
-
-        std::string ret( buf, len );
+        digits[count++] = char( '0' + integer % 10 );
+        integer /= 10;
+    } while( integer );
 
-        std::string::iterator it = ret.end() - 1;           // last byte
+    while( count )
+        *p++ = digits[--count];
 
-        // insert '.' at 6 positions from end, dividing by 10e6 (a million), nm => mm
-        std::string::iterator decpoint = ret.end() - 6;
+    if( fraction )
+    {
+        for( count = 6; fraction % 10 == 0; --count )
+            fraction /= 10;
 
-        // truncate trailing zeros, up to decimal point position
-        for(  ; *it=='0' && it >= decpoint;  --it )
-            ret.erase( it );    // does not invalidate iterators it or decpoint
+        *p++ = '.';
 
-        if( it >= decpoint )
+        for( int i = count - 1; i >= 0; --i )
         {
-            ret.insert( decpoint, '.' );
-
-            // decpoint is invalidated here, after insert()
-
-#if 1       // want a leading zero when decimal point is in first position?
-            if( ret[0] == '.' )
-            {
-                // insert leading zero ahead of decimal point.
-                ret.insert( ret.begin(), '0' );
-            }
-            else if( ret[0]=='-' && ret[1]=='.' )
-            {
-                ret.insert( ret.begin() + 1, '0' );
-            }
-#endif
+            p[i] = char( '0' + fraction % 10 );
+            fraction /= 10;
         }
 
-        return ret;
+        p += count;
     }
 
-#endif
+    return p - aBuf;
+}
+
+
+std::string BOARD_ITEM::FormatInternalUnits( int aValue )
+{
+    char    buf[50];
+    int     len = formatInternalUnits( buf, aValue );
+
+    return std::string( buf, len );
 }
 
 
@@ -179,13 +184,25 @@ std::string BOARD_ITEM::FormatAngle( double aAngle )
 
 std::string BOARD_ITEM::FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    char    buf[100];
+    int     len = formatInternalUnits( buf, aPoint.x );
+
+    buf[len++] = ' ';
+    len += formatInternalUnits( buf + len, aPoint.y );
+
+    return std::string( buf, len );
 }
 
 
 std::string BOARD_ITEM::FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    char    buf[100];
+    int     len = formatInternalUnits( buf, aSize.GetWidth() );
+
+    buf[len++] = ' ';
+    len += formatInternalUnits( buf + len, aSize.GetHeight() );
+
+    return std::string( buf, len );
 }
 
 
@@ -108,10 +108,14 @@ MODULE::MODULE( const MODULE& aModule ) :
     m_Value = new TEXTE_MODULE( *aModule.m_Value );
     m_Value->SetParent( this );
 
-    // Copy auxiliary data: Pads
+    // Copy auxiliary data: Pads.  The copies are appended as they are: Add() would
+    // reverse their order and recompute their local coordinates, with rounding.
     for( D_PAD* pad = aModule.m_Pads;  pad;  pad = pad->Next() )
     {
-        Add( new D_PAD( *pad ) );
+        D_PAD* newPad = new D_PAD( *pad );
+
+        newPad->SetParent( this );
+        m_Pads.PushBack( newPad );
     }
 
     // Copy auxiliary data: Drawings
@@ -121,7 +125,12 @@ MODULE::MODULE( const MODULE& aModule ) :
         {
         case PCB_MODULE_TEXT_T:
         case PCB_MODULE_EDGE_T:
-            Add( static_cast<BOARD_ITEM*>( item->Clone() ) );
+            {
+                BOARD_ITEM* newItem = static_cast<BOARD_ITEM*>( item->Clone() );
+
+                newItem->SetParent( this );
+                m_Drawings.PushBack( newItem );
+            }
             break;
 
         default:
@@ -38,8 +38,11 @@
 #include <connect.h>
 #include <dialog_cleaning_options.h>
 #include <board_commit.h>
+#include <track_end_index.h>
 
 #include <tuple>
+#include <vector>
+#include <algorithm>
 
 // Helper class used to clean tracks and vias
 class TRACKS_CLEANER: CONNECTIONS
@@ -119,8 +122,14 @@ private:
 
     bool testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPoint );
 
+    /// Remove a track from the board and from the index, and store the change in the commit
+    void removeTrack( TRACK* aTrack );
+
     BOARD* m_brd;
     BOARD_COMMIT& m_commit;
+
+    /// Tracks and vias by their ends, to be rebuilt when tracks are added or moved in the list
+    TRACK_END_INDEX m_trackIndex;
 };
 
 
@@ -222,6 +231,14 @@ TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit )
 }
 
 
+void TRACKS_CLEANER::removeTrack( TRACK* aTrack )
+{
+    m_trackIndex.Remove( aTrack );
+    m_brd->Remove( aTrack );
+    m_commit.Removed( aTrack );
+}
+
+
 void TRACKS_CLEANER::buildTrackConnectionInfo()
 {
     BuildTracksCandidatesList( m_brd->m_Track, NULL );
@@ -313,8 +330,7 @@ bool TRACKS_CLEANER::removeBadTrackSegments()
         if( segment->GetState( FLAG0 ) )    // Segment is flagged to be removed
         {
             isModified = true;
-            m_brd->Remove( segment );
-            m_commit.Removed( segment );
+            removeTrack( segment );
         }
     }
 
@@ -333,24 +349,32 @@ bool TRACKS_CLEANER::removeBadTrackSegments()
 
 bool TRACKS_CLEANER::remove_duplicates_of_via( const VIA *aVia )
 {
-    bool modified = false;
+    int ref = m_trackIndex.Position( aVia );
 
-    // Search and delete others vias at same location
-    VIA* next_via;
+    if( ref < 0 )
+        return false;
+
+    // Search and delete others vias at same location, following this one in the list
+    std::vector<std::pair<int, VIA*> > duplicates;
 
-    for( VIA* alt_via = GetFirstVia( aVia->Next() ); alt_via != NULL; alt_via = next_via )
+    for( TRACK* track : m_trackIndex.TracksAt( aVia->GetStart() ) )
     {
-        next_via = GetFirstVia( alt_via->Next() );
+        VIA* alt_via = dyn_cast<VIA*>( track );
+        int position = m_trackIndex.Position( track );
 
-        if( ( alt_via->GetViaType() == VIA_THROUGH ) &&
-                ( alt_via->GetStart() == aVia->GetStart() ) )
+        if( alt_via && alt_via->GetViaType() == VIA_THROUGH
+                && alt_via->GetStart() == aVia->GetStart() && position > ref )
         {
-            m_brd->Remove( alt_via );
-            m_commit.Removed( alt_via );
-            modified = true;
+            duplicates.push_back( std::make_pair( position, alt_via ) );
         }
     }
-    return modified;
+
+    std::sort( duplicates.begin(), duplicates.end() );
+
+    for( const std::pair<int, VIA*>& duplicate : duplicates )
+        removeTrack( duplicate.second );
+
+    return !duplicates.empty();
 }
 
 
@@ -358,6 +382,8 @@ bool TRACKS_CLEANER::clean_vias()
 {
     bool modified = false;
 
+    m_trackIndex.Build( m_brd->m_Track );
+
     for( VIA* via = GetFirstVia( m_brd->m_Track ); via != NULL;
             via = GetFirstVia( via->Next() ) )
     {
@@ -385,8 +411,7 @@ bool TRACKS_CLEANER::clean_vias()
                 if( ( pad->GetLayerSet() & all_cu ) == all_cu )
                 {
                     // redundant: delete the via
-                    m_brd->Remove( via );
-                    m_commit.Removed( via );
+                    removeTrack( via );
                     modified = true;
                     break;
                 }
@@ -425,7 +450,7 @@ bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPo
 {
     bool flag_erase = false;
 
-    TRACK* other = aTrack->GetTrack( m_brd->m_Track, NULL, aEndPoint, true, false );
+    TRACK* other = m_trackIndex.FindConnected( aTrack, aEndPoint );
 
     if( !other && !zoneForTrackEndpoint( aTrack, aEndPoint ) )
         flag_erase = true; // Start endpoint is neither on pad, zone or other track
@@ -447,7 +472,7 @@ bool TRACKS_CLEANER::testTrackEndpointDangling( TRACK* aTrack, ENDPOINT_T aEndPo
             // search for another segment following the via
             aTrack->SetState( BUSY, true );
 
-            other = via->GetTrack( m_brd->m_Track, NULL, aEndPoint, true, false );
+            other = m_trackIndex.FindConnected( via, aEndPoint );
 
             // There is a via on the start but it goes nowhere
             if( !other && !zoneForTrackEndpoint( via, aEndPoint ) )
@@ -473,6 +498,8 @@ bool TRACKS_CLEANER::deleteDanglingTracks()
     bool modified = false;
     bool item_erased;
 
+    m_trackIndex.Build( m_brd->m_Track );
+
     do // Iterate when at least one track is deleted
     {
         item_erased = false;
@@ -501,8 +528,7 @@ bool TRACKS_CLEANER::deleteDanglingTracks()
 
             if( flag_erase )
             {
-                m_brd->Remove( track );
-                m_commit.Removed( track );
+                removeTrack( track );
 
                 /* keep iterating, because a track connected to the deleted track
                  * now perhaps is not connected and should be deleted */
@@ -529,8 +555,7 @@ bool TRACKS_CLEANER::delete_null_segments()
 
         if( segment->IsNull() )     // Length segment = 0; delete it
         {
-            m_brd->Remove( segment );
-            m_commit.Removed( segment );
+            removeTrack( segment );
             modified = true;
         }
     }
@@ -541,16 +566,20 @@ bool TRACKS_CLEANER::delete_null_segments()
 
 bool TRACKS_CLEANER::remove_duplicates_of_track( const TRACK *aTrack )
 {
-    bool modified = false;
-    TRACK* nextsegment;
+    int ref = m_trackIndex.Position( aTrack );
+
+    if( ref < 0 )
+        return false;
 
-    for( TRACK* other = aTrack->Next(); other; other = nextsegment )
+    std::vector<std::pair<int, TRACK*> > duplicates;
+
+    for( TRACK* other : m_trackIndex.TracksAt( aTrack->GetStart() ) )
     {
-        nextsegment = other->Next();
+        int position = m_trackIndex.Position( other );
 
-        // New netcode, break out (can't be there any other)
-        if( aTrack->GetNetCode() != other->GetNetCode() )
-            break;
+        // Only the following tracks of the same net range are checked
+        if( position <= ref || !m_trackIndex.SameRun( aTrack, other ) )
+            continue;
 
         // Must be of the same type, on the same layer and the endpoints
         // must be the same (maybe swapped)
@@ -562,14 +591,17 @@ bool TRACKS_CLEANER::remove_duplicates_of_track( const TRACK *aTrack )
                 ( ( aTrack->GetStart() == other->GetEnd() ) &&
                  ( aTrack->GetEnd() == other->GetStart() ) ) )
             {
-                m_brd->Remove( other );
-                m_commit.Removed( other );
-                modified = true;
+                duplicates.push_back( std::make_pair( position, other ) );
             }
         }
     }
 
-    return modified;
+    std::sort( duplicates.begin(), duplicates.end() );
+
+    for( const std::pair<int, TRACK*>& duplicate : duplicates )
+        removeTrack( duplicate.second );
+
+    return !duplicates.empty();
 }
 
 
@@ -585,7 +617,7 @@ bool TRACKS_CLEANER::merge_collinear_of_track( TRACK* aSegment )
 
         if( other )
         {
-            other = aSegment->GetTrack( other, NULL, endpoint, true, false );
+            other = m_trackIndex.FindConnected( aSegment, endpoint );
 
             if( other )
             {
@@ -596,21 +628,21 @@ bool TRACKS_CLEANER::merge_collinear_of_track( TRACK* aSegment )
                 {
                     // There can be only one segment connected
                     other->SetState( BUSY, true );
-                    TRACK* yet_another = aSegment->GetTrack( m_brd->m_Track, NULL,
-                            endpoint, true, false );
+                    TRACK* yet_another = m_trackIndex.FindConnected( aSegment, endpoint );
                     other->SetState( BUSY, false );
 
                     if( !yet_another )
                     {
-                        // Try to merge them
+                        // Try to merge them, the ends of aSegment may move
+                        m_trackIndex.RemoveEnds( aSegment );
                         TRACK* segDelete = mergeCollinearSegmentIfPossible( aSegment,
                                 other, endpoint );
+                        m_trackIndex.AddEnds( aSegment );
 
                         // Merge succesful, the other one has to go away
                         if( segDelete )
                         {
-                            m_brd->Remove( segDelete );
-                            m_commit.Removed( segDelete );
+                            removeTrack( segDelete );
                             merged_this = true;
                         }
                     }
@@ -628,6 +660,8 @@ bool TRACKS_CLEANER::clean_segments()
 {
     bool modified = false;
 
+    m_trackIndex.Build( m_brd->m_Track );
+
     // Easy things first
     modified |= delete_null_segments();
 
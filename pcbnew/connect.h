@@ -87,7 +87,9 @@ public:
     const wxPoint & GetPoint() const { return m_point; }
 };
 
-// A helper class to handle connections calculations:
+// A helper class to handle connections calculations.
+// Used by TestConnections(), DRC and the track cleanup.  The GAL tools and the ratsnest
+// use the copper clusters of RN_DATA instead.
 class CONNECTIONS
 {
 private:
@@ -367,8 +367,10 @@ bool DIALOG_SVG_PRINT::CreateSVGFile( const wxString& aFullFileName, bool aOnlyO
         plotter->SetColorMode( !m_printBW );
         if( aOnlyOneFile )
         {
+            PLOT_ITEM_INDEX itemIndex( m_board );
+
             for( LSEQ seq = m_printMaskLayer.SeqStackupBottom2Top();  seq;  ++seq )
-                PlotOneBoardLayer( m_board, plotter, *seq, plot_opts );
+                PlotOneBoardLayer( m_board, plotter, *seq, plot_opts, &itemIndex );
         }
         else
         {
@@ -97,6 +97,12 @@ DIALOG_GENDRILL_BASE::DIALOG_GENDRILL_BASE( wxWindow* parent, wxWindowID id, con
 	
 	sbOptSizer->Add( m_Check_Merge_PTH_NPTH, 0, wxALL, 5 );
 	
+	m_Check_Optimize_Order = new wxCheckBox( sbOptSizer->GetStaticBox(), wxID_ANY, _("Optimize the drilling order"), wxDefaultPosition, wxDefaultSize, 0 );
+	m_Check_Optimize_Order->SetValue(true); 
+	m_Check_Optimize_Order->SetToolTip( _("Sort the holes of each tool to shorten the travel of the drill.\nUncheck to sort them by X then Y position.") );
+	
+	sbOptSizer->Add( m_Check_Optimize_Order, 0, wxBOTTOM|wxRIGHT|wxLEFT, 5 );
+	
 	
 	bMiddleBoxSizer->Add( sbOptSizer, 0, wxEXPAND|wxRIGHT|wxLEFT, 5 );
 	
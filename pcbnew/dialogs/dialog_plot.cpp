@@ -746,6 +746,9 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    // The board is scanned once for all layers
+    PLOT_ITEM_INDEX itemIndex( m_board );
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         LAYER_ID layer = *seq;
@@ -781,12 +784,20 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
         if( plotter )
         {
-            PlotOneBoardLayer( board, plotter, layer, m_plotOpts );
-            plotter->EndPlot();
+            PlotOneBoardLayer( board, plotter, layer, m_plotOpts, &itemIndex );
+            bool success = plotter->EndPlot();
             delete plotter;
 
-            msg.Printf( _( "Plot file '%s' created." ), GetChars( fn.GetFullPath() ) );
-            reporter.Report( msg, REPORTER::RPT_ACTION );
+            if( success )
+            {
+                msg.Printf( _( "Plot file '%s' created." ), GetChars( fn.GetFullPath() ) );
+                reporter.Report( msg, REPORTER::RPT_ACTION );
+            }
+            else
+            {
+                msg.Printf( _( "Unable to write file '%s'." ), GetChars( fn.GetFullPath() ) );
+                reporter.Report( msg, REPORTER::RPT_ERROR );
+            }
         }
         else
         {
@@ -297,6 +297,9 @@ bool EXCELLON_WRITER::GenDrillReportFile( const wxString& aFullFileName )
     unsigned    totalHoleCount;
     wxString    brdFilename = m_pcb->GetFileName();
 
+    // The board may have changed since the holes were last read
+    m_holesCollected = false;
+
     std::vector<LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
     out.Print( 0, "Drill report for %s\n", TO_UTF8( brdFilename ) );
@@ -383,6 +386,15 @@ bool EXCELLON_WRITER::GenDrillReportFile( const wxString& aFullFileName )
     totalHoleCount = printToolSummary( out, true );
     out.Print( 0, "    Total unplated holes count %u\n", totalHoleCount );
 
+    try
+    {
+        out.Finish();
+    }
+    catch( const IO_ERROR& )
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -55,7 +55,6 @@
 #include <gendrill_Excellon_writer.h>
 #include <wildcards_and_files_ext.h>
 #include <reporter.h>
-#include <collectors.h>
 
 // Comment/uncomment this to write or not a comment
 // in drill file when PTH and NPTH are merged to flag
@@ -72,6 +71,8 @@ EXCELLON_WRITER::EXCELLON_WRITER( BOARD* aPcb )
     m_unitsDecimal    = true;
     m_mirror = false;
     m_merge_PTH_NPTH = false;
+    m_optimizeDrillOrder = true;
+    m_holesCollected = false;
     m_minimalHeader = false;
     m_ShortHeader = false;
     m_mapFileFmt = PLOT_FORMAT_PDF;
@@ -79,13 +80,17 @@ EXCELLON_WRITER::EXCELLON_WRITER( BOARD* aPcb )
 }
 
 
-void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
+bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenDrill, bool aGenMap,
                                                  REPORTER * aReporter )
 {
     wxFileName  fn;
     wxString    msg;
 
+    // The holes are read once for the whole set of files, the board may have changed
+    // since a previous set was created by this writer
+    m_holesCollected = false;
+
     std::vector<LAYER_PAIR> hole_sets = getUniqueLayerPairs();
 
     // append a pair representing the NPTH set of holes, for separate drill files.
@@ -121,7 +126,8 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                         msg.Printf( _( "** Unable to create %s **\n" ), GetChars( fullFilename ) );
                         aReporter->Report( msg );
                     }
-                    break;
+
+                    return false;
                 }
                 else
                 {
@@ -151,7 +157,7 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                         aReporter->Report( msg );
                     }
 
-                    return;
+                    return false;
                 }
                 else
                 {
@@ -164,6 +170,8 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
             }
         }
     }
+
+    return true;
 }
 
 
@@ -554,83 +562,104 @@ static bool CmpHoleSettings( const HOLE_INFO& a, const HOLE_INFO& b )
 }
 
 
-void EXCELLON_WRITER::BuildHolesList( LAYER_PAIR aLayerPair,
-                                      bool aGenerateNPTH_list )
+void EXCELLON_WRITER::collectHoles()
 {
-    HOLE_INFO new_hole;
+    if( m_holesCollected )
+        return;
 
-    m_holeListBuffer.clear();
-    m_toolListBuffer.clear();
+    m_holesCollected = true;
+    m_viaHoles.clear();
+    m_padHoles.clear();
 
-    wxASSERT(  aLayerPair.first < aLayerPair.second );  // fix the caller
+    HOLE_INFO new_hole;
 
-    // build hole list for vias
-    if( ! aGenerateNPTH_list )  // vias are always plated !
+    // build hole list for vias, per layer pair
+    for( VIA* via = GetFirstVia( m_pcb->m_Track ); via; via = GetFirstVia( via->Next() ) )
     {
-        for( VIA* via = GetFirstVia( m_pcb->m_Track ); via; via = GetFirstVia( via->Next() ) )
-        {
-            int hole_sz = via->GetDrillValue();
+        LAYER_PAIR layer_pair;
 
-            if( hole_sz == 0 )   // Should not occur.
-                continue;
+        // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
+        // Remember: top layer = 0 and bottom layer = 31 for through hole vias
+        via->LayerPair( &layer_pair.first, &layer_pair.second );
 
-            new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
-            new_hole.m_Hole_Orient    = 0;
-            new_hole.m_Hole_Diameter  = hole_sz;
-            new_hole.m_Hole_NotPlated = false;
-            new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+        // The layer pair is known even if the via has no hole
+        std::vector<HOLE_INFO>& pair_holes = m_viaHoles[layer_pair];
 
-            new_hole.m_Hole_Shape = 0;              // hole shape: round
-            new_hole.m_Hole_Pos = via->GetStart();
+        int hole_sz = via->GetDrillValue();
 
-            via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
+        if( hole_sz == 0 )   // Should not occur.
+            continue;
 
-            // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
-            // Remember: top layer = 0 and bottom layer = 31 for through hole vias
-            // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
-            if( new_hole.m_Hole_Top_Layer    != aLayerPair.first ||
-                new_hole.m_Hole_Bottom_Layer != aLayerPair.second )
-                continue;
+        new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
+        new_hole.m_Hole_Orient    = 0;
+        new_hole.m_Hole_Diameter  = hole_sz;
+        new_hole.m_Hole_NotPlated = false;      // vias are always plated !
+        new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
 
-            m_holeListBuffer.push_back( new_hole );
-        }
+        new_hole.m_Hole_Shape = 0;              // hole shape: round
+        new_hole.m_Hole_Pos = via->GetStart();
+        new_hole.m_Hole_Top_Layer    = layer_pair.first;
+        new_hole.m_Hole_Bottom_Layer = layer_pair.second;
+
+        pair_holes.push_back( new_hole );
     }
 
-    if( aLayerPair == LAYER_PAIR( F_Cu, B_Cu ) )
+    // add holes for thru hole pads
+    for( MODULE* module = m_pcb->m_Modules;  module;  module = module->Next() )
     {
-        // add holes for thru hole pads
-        for( MODULE* module = m_pcb->m_Modules;  module;  module = module->Next() )
+        for( D_PAD* pad = module->Pads();  pad;  pad = pad->Next() )
         {
-            for( D_PAD* pad = module->Pads();  pad;  pad = pad->Next() )
-            {
-                if( !m_merge_PTH_NPTH )
-                {
-                    if( !aGenerateNPTH_list && pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED )
-                        continue;
+            if( pad->GetDrillSize().x == 0 )
+                continue;
 
-                    if( aGenerateNPTH_list && pad->GetAttribute() != PAD_ATTRIB_HOLE_NOT_PLATED )
-                        continue;
-                }
+            new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
+            new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
+            new_hole.m_Hole_Orient    = pad->GetOrientation();
+            new_hole.m_Hole_Shape     = 0;           // hole shape: round
+            new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
+            new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+
+            if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE )
+                new_hole.m_Hole_Shape = 1; // oval flag set
+
+            new_hole.m_Hole_Size         = pad->GetDrillSize();
+            new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
+            new_hole.m_Hole_Bottom_Layer = B_Cu;
+            new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
+            m_padHoles.push_back( new_hole );
+        }
+    }
+}
 
-                if( pad->GetDrillSize().x == 0 )
-                    continue;
 
-                new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED);
-                new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
-                new_hole.m_Hole_Orient    = pad->GetOrientation();
-                new_hole.m_Hole_Shape     = 0;           // hole shape: round
-                new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
-                new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+void EXCELLON_WRITER::BuildHolesList( LAYER_PAIR aLayerPair,
+                                      bool aGenerateNPTH_list )
+{
+    m_holeListBuffer.clear();
+    m_toolListBuffer.clear();
 
-                if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE )
-                    new_hole.m_Hole_Shape = 1; // oval flag set
+    wxASSERT(  aLayerPair.first < aLayerPair.second );  // fix the caller
 
-                new_hole.m_Hole_Size         = pad->GetDrillSize();
-                new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
-                new_hole.m_Hole_Bottom_Layer = B_Cu;
-                new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
-                m_holeListBuffer.push_back( new_hole );
-            }
+    collectHoles();
+
+    // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
+    if( ! aGenerateNPTH_list )  // vias are always plated !
+    {
+        std::map<LAYER_PAIR, std::vector<HOLE_INFO> >::const_iterator it =
+                m_viaHoles.find( aLayerPair );
+
+        if( it != m_viaHoles.end() )
+            m_holeListBuffer.insert( m_holeListBuffer.end(), it->second.begin(), it->second.end() );
+    }
+
+    if( aLayerPair == LAYER_PAIR( F_Cu, B_Cu ) )
+    {
+        for( unsigned ii = 0; ii < m_padHoles.size(); ii++ )
+        {
+            if( !m_merge_PTH_NPTH && m_padHoles[ii].m_Hole_NotPlated != aGenerateNPTH_list )
+                continue;
+
+            m_holeListBuffer.push_back( m_padHoles[ii] );
         }
     }
 
@@ -669,46 +698,115 @@ void EXCELLON_WRITER::BuildHolesList( LAYER_PAIR aLayerPair,
         if( m_holeListBuffer[ii].m_Hole_Shape )
             m_toolListBuffer.back().m_OvalCount++;
     }
+
+    if( m_optimizeDrillOrder )
+        optimizeDrillOrder();
 }
 
 
-std::vector<LAYER_PAIR> EXCELLON_WRITER::getUniqueLayerPairs() const
+/* Helper function for optimizeDrillOrder().
+ * Returns the distance along a Hilbert curve filling a 65536 x 65536 grid
+ * of the grid point aX, aY.
+ */
+static uint64_t hilbertDistance( unsigned aX, unsigned aY )
 {
-    wxASSERT( m_pcb );
+    const unsigned grid_size = 1 << 16;
+    uint64_t       dist = 0;
 
-    static const KICAD_T interesting_stuff_to_collect[] = {
-        PCB_VIA_T,
-        EOT
-    };
+    for( unsigned s = grid_size / 2; s > 0; s /= 2 )
+    {
+        unsigned rx = ( aX & s ) ? 1 : 0;
+        unsigned ry = ( aY & s ) ? 1 : 0;
 
-    PCB_TYPE_COLLECTOR  vias;
+        dist += uint64_t( s ) * s * ( ( 3 * rx ) ^ ry );
 
-    vias.Collect( m_pcb, interesting_stuff_to_collect );
+        // Rotate the quadrant, so that the curve is continuous
+        if( ry == 0 )
+        {
+            if( rx == 1 )
+            {
+                aX = grid_size - 1 - aX;
+                aY = grid_size - 1 - aY;
+            }
 
-    std::set< LAYER_PAIR >  unique;
+            std::swap( aX, aY );
+        }
+    }
 
-    LAYER_PAIR  layer_pair;
+    return dist;
+}
 
-    for( int i = 0; i < vias.GetCount(); ++i )
+
+void EXCELLON_WRITER::optimizeDrillOrder()
+{
+    // The holes are already grouped by tool: each group is sorted along a Hilbert
+    // curve through its bounding box, which keeps consecutive holes close to each
+    // other, for a cost of a sort.
+    std::vector< std::pair<uint64_t, unsigned> > order;
+    std::vector<HOLE_INFO> sorted;
+
+    for( unsigned first = 0; first < m_holeListBuffer.size(); )
     {
-        VIA*  v = (VIA*) vias[i];
+        int      tool = m_holeListBuffer[first].m_Tool_Reference;
+        unsigned last = first;
+        EDA_RECT bbox( m_holeListBuffer[first].m_Hole_Pos, wxSize( 0, 0 ) );
 
-        v->LayerPair( &layer_pair.first, &layer_pair.second );
+        while( last < m_holeListBuffer.size() && m_holeListBuffer[last].m_Tool_Reference == tool )
+        {
+            bbox.Merge( m_holeListBuffer[last].m_Hole_Pos );
+            last++;
+        }
 
-        // only make note of blind buried.
-        // thru hole is placed unconditionally as first in fetched list.
-        if( layer_pair != LAYER_PAIR( F_Cu, B_Cu ) )
+        if( last - first > 2 )
         {
-            unique.insert( layer_pair );
+            double scale = 65535.0 / std::max( 1, std::max( bbox.GetWidth(), bbox.GetHeight() ) );
+
+            order.clear();
+
+            for( unsigned ii = first; ii < last; ii++ )
+            {
+                const wxPoint& pos = m_holeListBuffer[ii].m_Hole_Pos;
+                unsigned x = KiROUND( ( pos.x - bbox.GetX() ) * scale );
+                unsigned y = KiROUND( ( pos.y - bbox.GetY() ) * scale );
+
+                order.push_back( std::make_pair( hilbertDistance( x, y ), ii ) );
+            }
+
+            // The index breaks the ties, so the order does not depend on the sort
+            std::sort( order.begin(), order.end() );
+
+            sorted.clear();
+
+            for( unsigned ii = 0; ii < order.size(); ii++ )
+                sorted.push_back( m_holeListBuffer[order[ii].second] );
+
+            std::copy( sorted.begin(), sorted.end(), m_holeListBuffer.begin() + first );
         }
+
+        first = last;
     }
+}
+
+
+std::vector<LAYER_PAIR> EXCELLON_WRITER::getUniqueLayerPairs()
+{
+    wxASSERT( m_pcb );
+
+    collectHoles();
 
     std::vector<LAYER_PAIR>    ret;
 
     ret.push_back( LAYER_PAIR( F_Cu, B_Cu ) );      // always first in returned list
 
-    for( std::set< LAYER_PAIR >::const_iterator it = unique.begin();  it != unique.end(); ++it )
-        ret.push_back( *it );
+    // only make note of blind buried.
+    // thru hole is placed unconditionally as first in fetched list.
+    // The map is sorted by layer pair.
+    for( std::map<LAYER_PAIR, std::vector<HOLE_INFO> >::const_iterator it = m_viaHoles.begin();
+         it != m_viaHoles.end(); ++it )
+    {
+        if( it->first != LAYER_PAIR( F_Cu, B_Cu ) )
+            ret.push_back( it->first );
+    }
 
     return ret;
 }
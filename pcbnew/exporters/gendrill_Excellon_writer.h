@@ -30,6 +30,7 @@
 #ifndef _GENDRILL_EXCELLON_WRITER_
 #define _GENDRILL_EXCELLON_WRITER_
 
+#include <map>
 #include <vector>
 
 
@@ -148,9 +149,15 @@ private:
     bool                     m_mirror;
     wxPoint                  m_offset;                  // Drill offset coordinates
     bool                     m_merge_PTH_NPTH;          // True to generate only one drill file
+    bool                     m_optimizeDrillOrder;      // True to sort the holes of each tool
+                                                        // to shorten the drill travel
     std::vector<HOLE_INFO>   m_holeListBuffer;          // Buffer containing holes
     std::vector<DRILL_TOOL>  m_toolListBuffer;          // Buffer containing tools
 
+    bool                     m_holesCollected;          // True when the 2 lists below are built
+    std::map<LAYER_PAIR, std::vector<HOLE_INFO> > m_viaHoles; // via holes of each layer pair
+    std::vector<HOLE_INFO>   m_padHoles;                // pad holes (always through holes)
+
     PlotFormat              m_mapFileFmt;               // the format of the map drill file,
                                                         // if this map is needed
     const PAGE_INFO*        m_pageInfo;                 // the page info used to plot drill maps
@@ -199,6 +206,14 @@ public:
      */
     void SetMapFileFormat( PlotFormat aMapFmt ) { m_mapFileFmt = aMapFmt; }
 
+    /**
+     * Function SetDrillOrderOptimization
+     * @param aOptimize = true (default) to sort the holes of each tool along a space
+     * filling curve, which shortens the travel of the drill between holes,
+     * false to sort them by X then Y position
+     */
+    void SetDrillOrderOptimization( bool aOptimize ) { m_optimizeDrillOrder = aOptimize; }
+
 
     /**
      * Function SetOptions
@@ -219,6 +234,9 @@ public:
      * Function BuildHolesList
      * Create the list of holes and tools for a given board
      * The list is sorted by increasing drill size.
+     * The holes of the board are collected only once, on the first call,
+     * and then picked for each layer pair.  CreateDrillandMapFilesSet() and
+     * GenDrillReportFile() collect them again.
      * Only holes included within aLayerPair are listed.
      * If aLayerPair identifies with [F_Cu, B_Cu], then
      * pad holes are always included also.
@@ -241,8 +259,9 @@ public:
      * @param aGenDrill = true to generate the EXCELLON drill file
      * @param aGenMap = true to generate a drill map file
      * @param aReporter = a REPORTER to return activity or any message (can be NULL)
+     * @return true if all files were created
      */
-    void CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
+    bool CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                     bool aGenDrill, bool aGenMap,
                                     REPORTER * aReporter = NULL );
 
@@ -348,7 +367,21 @@ private:
     bool PlotDrillMarks( PLOTTER* aPlotter );
 
     /// Get unique layer pairs by examining the micro and blind_buried vias.
-    std::vector<LAYER_PAIR> getUniqueLayerPairs() const;
+    std::vector<LAYER_PAIR> getUniqueLayerPairs();
+
+    /**
+     * Function collectHoles
+     * Reads the via and pad holes of the board in one pass, and stores them in
+     * m_viaHoles and m_padHoles, if not already done.
+     */
+    void collectHoles();
+
+    /**
+     * Function optimizeDrillOrder
+     * Sorts the holes of each tool of m_holeListBuffer along a Hilbert curve, so
+     * that consecutive holes are close to each other.
+     */
+    void optimizeDrillOrder();
 
     /**
      * Function printToolSummary
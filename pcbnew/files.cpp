@@ -46,6 +46,11 @@
 #include <pcbnew.h>
 #include <pcbnew_id.h>
 #include <io_mgr.h>
+#include <kicad_plugin.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <background_saver.h>
 #include <wildcards_and_files_ext.h>
 
 #include <class_board.h>
@@ -55,6 +60,9 @@
 
 #include <wx/stdpaths.h>
 
+#include <map>
+#include <memory>
+
 
 //#define     USE_INSTRUMENTATION     1
 #define     USE_INSTRUMENTATION     0
@@ -98,6 +106,7 @@ bool AskLoadBoardFileName( wxWindow* aParent, int* aCtl, wxString* aFileName, bo
         { LegacyPcbFileWildcard,    IO_MGR::LEGACY },   // Old Kicad board files
         { EaglePcbFileWildcard,     IO_MGR::EAGLE },    // Import board files
         { PCadPcbFileWildcard,      IO_MGR::PCAD },     // Import board files
+        { PcbBinaryFileWildcard,    IO_MGR::KICAD_BINARY }, // Binary board snapshots
     };
 
     wxFileName  fileName( *aFileName );
@@ -392,6 +401,10 @@ IO_MGR::PCB_FILE_T plugin_type( const wxString& aFileName, int aCtl )
     {
         pluginType = IO_MGR::PCAD;
     }
+    else if( fn.GetExt().CmpNoCase(  IO_MGR::GetFileExtension( IO_MGR::KICAD_BINARY ) ) == 0 )
+    {
+        pluginType = IO_MGR::KICAD_BINARY;
+    }
     else
     {
         pluginType = IO_MGR::KICAD;
@@ -427,6 +440,9 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
         return false;
     }
 
+    // A save still being written clears the modified flag once it is done.
+    WaitForBackgroundSave();
+
     if( GetScreen()->IsModify() )
     {
         int response = YesNoCancelDialog( this, _(
@@ -439,7 +455,10 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
         if( response == wxID_CANCEL )
             return false;
         else if( response == wxID_YES )
+        {
             SavePcbFile( GetBoard()->GetFileName(), CREATE_BACKUP_FILE );
+            WaitForBackgroundSave();
+        }
         else
         {
             // response == wxID_NO, fall thru
@@ -638,37 +657,145 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
 }
 
 
-static wxString create_backup_file( const wxString& aFileName )
+/**
+ * Function backup_file_name
+ * @return the name the current <xxx>.kicad_pcb file is renamed to, <xxx>.kicad_pcb-bak,
+ *  once the new one is written, or an empty string if there is no current file.
+ */
+static wxString backup_file_name( const wxString& aFileName )
 {
     wxFileName  fn = aFileName;
     wxFileName  backupFileName = aFileName;
 
+    if( !fn.FileExists() )
+        return wxEmptyString;
+
     backupFileName.SetExt( fn.GetExt() + backupSuffix );
 
-    // If an old backup file exists, delete it.  If an old board file exists,
-    // rename it to the backup file name.
-    if( fn.FileExists() )
+    return backupFileName.GetFullPath();
+}
+
+
+/**
+ * Function copyBoard
+ * makes a deep copy of \a aBoard holding everything PCB_IO writes, so that the copy
+ * can be formatted on another thread while the original is being edited.  Nets and
+ * net classes are copied too, the items of the copy only point to its own ones.
+ */
+static BOARD* copyBoard( BOARD* aBoard )
+{
+    std::unique_ptr<BOARD> board( new BOARD() );
+
+    board->SetFileName( aBoard->GetFileName().Clone() );
+    board->SetPageSettings( aBoard->GetPageSettings() );
+    board->SetTitleBlock( aBoard->GetTitleBlock() );
+    board->SetPlotOptions( aBoard->GetPlotOptions() );
+    board->SetZoneSettings( aBoard->GetZoneSettings() );
+    board->SetBoundingBox( aBoard->GetBoundingBox() );
+
+    // The design settings share their net classes with aBoard, give them their own.
+    BOARD_DESIGN_SETTINGS       dsn = aBoard->GetDesignSettings();
+    const NETCLASSES&           netclasses = aBoard->GetDesignSettings().m_NetClasses;
+
+    dsn.m_NetClasses = NETCLASSES();
+    *dsn.GetDefault() = *netclasses.GetDefault();
+
+    for( NETCLASSES::const_iterator it = netclasses.begin(); it != netclasses.end(); ++it )
+        dsn.m_NetClasses.Add( std::make_shared<NETCLASS>( *it->second ) );
+
+    board->SetDesignSettings( dsn );
+
+    LSET enabled = aBoard->GetEnabledLayers();
+
+    for( LSEQ seq = enabled.Seq();  seq;  ++seq )
     {
-        // Remove the old file xxx.000 if it exists.
-        if( backupFileName.FileExists() )
-            wxRemoveFile( backupFileName.GetFullPath() );
+        LAYER layer;
+
+        layer.m_name    = aBoard->GetLayerName( *seq );
+        layer.m_type    = aBoard->GetLayerType( *seq );
+        layer.m_visible = aBoard->IsLayerVisible( *seq );
+        layer.m_number  = *seq;
+
+        board->SetLayerDescr( *seq, layer );
+    }
+
+    board->SetCopperLayerCount( aBoard->GetCopperLayerCount() );
+    board->SetEnabledLayers( enabled );
+    board->SetVisibleLayers( aBoard->GetVisibleLayers() );
+
+    // Nets, in net code order.  NETINFO_LIST::AppendNet() may give them other codes in
+    // the copy, the order is what matters for the codes written to the file.
+    std::map<int, NETINFO_ITEM*> nets;
+    std::map<int, int>           netCodes;
 
-        // Rename the current file from <xxx>.kicad_pcb to <xxx>.kicad_pcb-bak
-        if( !wxRenameFile( fn.GetFullPath(), backupFileName.GetFullPath() ) )
+    for( NETINFO_ITEM* net : aBoard->GetNetInfo() )
+        nets[net->GetNet()] = net;
+
+    for( const std::pair<const int, NETINFO_ITEM*>& net : nets )
+    {
+        if( net.first <= NETINFO_LIST::UNCONNECTED )
         {
-            wxString msg = wxString::Format( _(
-                    "Warning: unable to create backup file '%s'" ),
-                    GetChars( backupFileName.GetFullPath() )
-                    );
-            DisplayError( NULL, msg );
+            netCodes[net.first] = net.first;
+            continue;
         }
+
+        NETINFO_ITEM* copy = new NETINFO_ITEM( board.get(), net.second->GetNetname().Clone(),
+                                               net.first );
+        board->Add( copy );
+        netCodes[net.first] = copy->GetNet();
     }
-    else
+
+    // Called before the item is added, so the ratsnest sees only the net of the copy.
+    auto setNet = [&]( BOARD_CONNECTED_ITEM* aItem )
+    {
+        std::map<int, int>::const_iterator code = netCodes.find( aItem->GetNetCode() );
+
+        aItem->SetNetCode( code != netCodes.end() ? code->second : NETINFO_LIST::UNCONNECTED );
+    };
+
+    for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
+    {
+        MODULE* copy = new MODULE( *module );
+
+        copy->SetParent( board.get() );
+
+        for( D_PAD* pad = copy->Pads();  pad;  pad = pad->Next() )
+            setNet( pad );
+
+        board->Add( copy, ADD_APPEND );
+    }
+
+    for( BOARD_ITEM* item = aBoard->m_Drawings;  item;  item = item->Next() )
+        board->Add( static_cast<BOARD_ITEM*>( item->Clone() ), ADD_APPEND );
+
+    for( TRACK* track = aBoard->m_Track;  track;  track = track->Next() )
     {
-        backupFileName.Clear();
+        TRACK* copy = static_cast<TRACK*>( track->Clone() );
+
+        copy->SetParent( board.get() );
+        setNet( copy );
+        board->Add( copy, ADD_APPEND );
     }
 
-    return backupFileName.GetFullPath();
+    for( SEGZONE* segzone = aBoard->m_Zone;  segzone;  segzone = segzone->Next() )
+    {
+        SEGZONE* copy = static_cast<SEGZONE*>( segzone->Clone() );
+
+        copy->SetParent( board.get() );
+        setNet( copy );
+        board->Add( copy, ADD_APPEND );
+    }
+
+    for( int i = 0; i < aBoard->GetAreaCount();  ++i )
+    {
+        ZONE_CONTAINER* copy = new ZONE_CONTAINER( *aBoard->GetArea( i ) );
+
+        copy->SetParent( board.get() );
+        setNet( copy );
+        board->Add( copy, ADD_APPEND );
+    }
+
+    return board.release();
 }
 
 
@@ -698,7 +825,7 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
     // or new files in save as... command
     if( aCreateBackupFile )
     {
-        backupFileName = create_backup_file( aFileName );
+        backupFileName = backup_file_name( pcbFileName.GetFullPath() );
     }
 
     GetBoard()->m_Status_Pcb &= ~CONNEXION_OK;
@@ -711,42 +838,86 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
 
     ClearMsgPanel();
 
-    wxString    upperTxt;
-    wxString    lowerTxt;
+    wxASSERT( pcbFileName.IsAbsolute() );
 
-    try
-    {
-        PLUGIN::RELEASER    pi( IO_MGR::PluginFind( IO_MGR::KICAD ) );
+    // Copy the board here, and format the copy to the file on a worker thread while
+    // the user goes on editing.  Copying takes a fraction of the time needed to format.
+    std::shared_ptr<BOARD> copy( copyBoard( GetBoard() ) );
 
-        wxASSERT( pcbFileName.IsAbsolute() );
+    // The ratsnest is not copied, but its counts go in the file header.
+    copy->m_FullRatsnest.resize( GetBoard()->GetRatsnestsCount() );
+    copy->SetUnconnectedNetCount( GetBoard()->GetUnconnectedNetCount() );
 
-        pi->Save( pcbFileName.GetFullPath(), GetBoard(), NULL );
-    }
-    catch( const IO_ERROR& ioe )
+    m_backgroundSaver->Queue( pcbFileName.GetFullPath(),
+        [copy]( OUTPUTFORMATTER* aFormatter )
+        {
+            PCB_IO().Save( aFormatter, copy.get() );
+        }, backupFileName );
+
+    QUEUED_SAVE queued = { false, m_modifyCount };
+    m_queuedSaves.push_back( queued );
+
+    GetBoard()->SetFileName( pcbFileName.GetFullPath() );
+    UpdateTitle();
+
+    // Put the saved file in File History, unless aCreateBackupFile
+    // is false.
+    // aCreateBackupFile == false is mainly used to write autosave files
+    // and not need to have an autosave file in file history
+    if( aCreateBackupFile )
+        UpdateFileHistory( GetBoard()->GetFileName() );
+
+    if( !!backupFileName )
+        AppendMsgPanel( wxString::Format( _( "Backup file: '%s'" ), GetChars( backupFileName ) ),
+                        wxEmptyString, CYAN );
+
+    return true;
+}
+
+
+void PCB_EDIT_FRAME::onBackgroundSaveDone( wxThreadEvent& aEvent )
+{
+    wxFileName  pcbFileName = aEvent.GetString();
+    wxString    lowerTxt;
+    QUEUED_SAVE queued = m_queuedSaves.front();
+
+    m_queuedSaves.pop_front();
+
+    if( !aEvent.GetInt() )
     {
         wxString msg = wxString::Format( _(
                 "Error saving board file '%s'.\n%s" ),
                 GetChars( pcbFileName.GetFullPath() ),
-                GetChars( ioe.What() )
+                GetChars( aEvent.GetPayload<wxString>() )
                 );
         DisplayError( this, msg );
 
         lowerTxt.Printf( _( "Failed to create '%s'" ), GetChars( pcbFileName.GetFullPath() ) );
 
-        AppendMsgPanel( upperTxt, lowerTxt, CYAN );
+        AppendMsgPanel( wxEmptyString, lowerTxt, CYAN );
 
-        return false;
+        // The board is still modified.  Try the auto save again later.
+        if( queued.m_autoSave && m_autoSaveInterval > 0 )
+            m_autoSaveTimer->Start( m_autoSaveInterval * 1000, wxTIMER_ONE_SHOT );
+
+        return;
     }
 
-    GetBoard()->SetFileName( pcbFileName.GetFullPath() );
-    UpdateTitle();
+    if( queued.m_autoSave )
+    {
+        // The board stays modified, until it is saved under its own name.
+        m_autoSaveState = false;
+    }
+    else if( queued.m_modifyCount == m_modifyCount )
+    {
+        // Not cleared if the board was edited after it was copied: the file lacks these edits.
+        GetScreen()->ClrModify();
+        GetScreen()->ClrSave();
+    }
 
-    // Put the saved file in File History, unless aCreateBackupFile
-    // is false.
-    // aCreateBackupFile == false is mainly used to write autosave files
-    // and not need to have an autosave file in file history
-    if( aCreateBackupFile )
-        UpdateFileHistory( GetBoard()->GetFileName() );
+    // A warning, e.g. the backup file could not be made.
+    if( !aEvent.GetPayload<wxString>().IsEmpty() )
+        DisplayError( this, aEvent.GetPayload<wxString>() );
 
     // Delete auto save file on successful save.
     wxFileName autoSaveFileName = pcbFileName;
@@ -756,16 +927,15 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
     if( autoSaveFileName.FileExists() )
         wxRemoveFile( autoSaveFileName.GetFullPath() );
 
-    if( !!backupFileName )
-        upperTxt.Printf( _( "Backup file: '%s'" ), GetChars( backupFileName ) );
-
     lowerTxt.Printf( _( "Wrote board file: '%s'" ), GetChars( pcbFileName.GetFullPath() ) );
 
-    AppendMsgPanel( upperTxt, lowerTxt, CYAN );
+    AppendMsgPanel( wxEmptyString, lowerTxt, CYAN );
+}
 
-    GetScreen()->ClrModify();
-    GetScreen()->ClrSave();
-    return true;
+
+void PCB_EDIT_FRAME::WaitForBackgroundSave()
+{
+    m_backgroundSaver->Wait();
 }
 
 
@@ -856,12 +1026,13 @@ bool PCB_EDIT_FRAME::doAutoSave()
 
     wxLogTrace( traceAutoSave, "Creating auto save file <" + autoSaveFileName.GetFullPath() + ">" );
 
+    // The file is only queued here: m_autoSaveState is cleared by onBackgroundSaveDone()
+    // once it is written.
     if( SavePcbFile( autoSaveFileName.GetFullPath(), NO_BACKUP_FILE ) )
     {
-        GetScreen()->SetModify();
+        m_queuedSaves.back().m_autoSave = true;
         GetBoard()->SetFileName( tmpFileName.GetFullPath() );
         UpdateTitle();
-        m_autoSaveState = false;
         return true;
     }
 
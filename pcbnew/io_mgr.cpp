@@ -31,6 +31,7 @@
 #include <eagle_plugin.h>
 #include <pcad2kicadpcb_plugin/pcad_plugin.h>
 #include <gpcb_plugin.h>
+#include <kicad_binary_plugin.h>
 #include <config.h>
 
 #if defined(BUILD_GITHUB_PLUGIN)
@@ -84,6 +85,9 @@ PLUGIN* IO_MGR::PluginFind( PCB_FILE_T aFileType )
         THROW_IO_ERROR( "BUILD_GITHUB_PLUGIN not enabled in cmake build environment" );
 #endif
 
+    case KICAD_BINARY:
+        return new KICAD_BINARY_PLUGIN();
+
     case FILE_TYPE_NONE:
         return NULL;
     }
@@ -130,6 +134,9 @@ const wxString IO_MGR::ShowType( PCB_FILE_T aType )
 
     case GITHUB:
         return wxString( wxT( "Github" ) );
+
+    case KICAD_BINARY:
+        return wxString( wxT( "KiCad-Binary" ) );
     }
 }
 
@@ -158,6 +165,9 @@ IO_MGR::PCB_FILE_T IO_MGR::EnumFromStr( const wxString& aType )
     if( aType == wxT( "Github" ) )
         return GITHUB;
 
+    if( aType == wxT( "KiCad-Binary" ) )
+        return KICAD_BINARY;
+
     // wxASSERT( blow up here )
 
     return PCB_FILE_T( -1 );
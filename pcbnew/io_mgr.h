@@ -56,6 +56,7 @@ public:
         PCAD,
         GEDA_PCB,       ///< Geda PCB file formats.
         GITHUB,         ///< Read only http://github.com repo holding pretty footprints
+        KICAD_BINARY,   ///< Binary board snapshot, see kicad_binary_plugin.h
 
         // add your type here.
 
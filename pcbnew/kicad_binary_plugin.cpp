@@ -0,0 +1,1571 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file kicad_binary_plugin.cpp
+ * @brief Binary board snapshot file plugin implementation file.
+ *
+ * File layout, all integers in host byte order:
+ *
+ *   header      "KICADBRD", version, byte order mark, host build version
+ *   settings    general, page, title block, layers, setup (design, zone and plot settings)
+ *   nets        count, { code, name }
+ *   net classes count, { name, description, sizes, members }
+ *   modules     count, { module, texts, graphics, pads, 3D models }
+ *   drawings    count, { kind, record }
+ *   tracks      count, BIN_TRACK[ count ]
+ *   zones       count, { settings, outline corners, filled polygons, fill segments }
+ *   trailer     "KICADEND"
+ *
+ * Strings are a 32 bit byte count followed by UTF8 bytes.  Point lists are a 32 bit
+ * count followed by packed 32 bit x,y pairs so they can be copied in one go.
+ */
+
+#include <fctsys.h>
+#include <common.h>
+#include <kicad_string.h>
+#include <macros.h>
+#include <trigo.h>
+#include <build_version.h>
+#include <class_title_block.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pcb_text.h>
+#include <class_dimension.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <class_drawsegment.h>
+#include <class_mire.h>
+#include <class_edge_mod.h>
+#include <class_netclass.h>
+#include <class_netinfo.h>
+#include <pcb_plot_params.h>
+#include <pcb_plot_params_parser.h>
+#include <zones.h>
+#include <kicad_binary_plugin.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <memory>
+
+
+static const char       s_magic[]   = "KICADBRD";
+static const char       s_trailer[] = "KICADEND";
+static const size_t     s_magicLen  = 8;
+static const uint32_t   s_byteOrder = 0x01020304;
+
+
+/// Drawing record kinds, stored as one byte ahead of each board drawing.
+enum BIN_DRAWING_T
+{
+    BIN_DRAWSEGMENT,
+    BIN_TEXTE_PCB,
+    BIN_DIMENSION,
+    BIN_PCB_TARGET
+};
+
+
+/**
+ * Struct BIN_TRACK
+ * is the fixed size record of a TRACK or a VIA.  Tracks are by far the most numerous
+ * items of a routed board, so they are written and read as one packed array.
+ */
+struct BIN_TRACK
+{
+    int32_t     m_startX;
+    int32_t     m_startY;
+    int32_t     m_endX;
+    int32_t     m_endY;
+    int32_t     m_width;
+    int32_t     m_drill;        ///< via only
+    int32_t     m_netCode;      ///< file net code
+    uint32_t    m_timeStamp;
+    uint32_t    m_status;
+    uint8_t     m_isVia;
+    uint8_t     m_layer;        ///< track layer, or via top layer
+    uint8_t     m_bottomLayer;  ///< via only
+    uint8_t     m_viaType;      ///< via only
+};
+
+
+/**
+ * Struct BIN_SEGMENT
+ * is the packed record of one zone fill segment.
+ */
+struct BIN_SEGMENT
+{
+    int32_t     m_startX;
+    int32_t     m_startY;
+    int32_t     m_endX;
+    int32_t     m_endY;
+};
+
+
+static_assert( sizeof( BIN_TRACK ) == 40, "BIN_TRACK must be packed" );
+static_assert( sizeof( BIN_SEGMENT ) == 16, "BIN_SEGMENT must be packed" );
+static_assert( sizeof( wxPoint ) == 2 * sizeof( int32_t ), "wxPoint must be two int32_t" );
+static_assert( sizeof( VECTOR2I ) == 2 * sizeof( int32_t ), "VECTOR2I must be two int32_t" );
+
+
+/**
+ * Class BIN_OUTPUT
+ * accumulates a snapshot in memory so it can be written to disk with a single call.
+ */
+class BIN_OUTPUT
+{
+public:
+    BIN_OUTPUT()
+    {
+        m_buf.reserve( 1 << 20 );
+    }
+
+    void Raw( const void* aData, size_t aSize )
+    {
+        const char* data = (const char*) aData;
+        m_buf.insert( m_buf.end(), data, data + aSize );
+    }
+
+    void U8( uint8_t aValue )       { m_buf.push_back( (char) aValue ); }
+    void Bool( bool aValue )        { U8( aValue ? 1 : 0 ); }
+    void I32( int32_t aValue )      { Raw( &aValue, sizeof( aValue ) ); }
+    void U32( uint32_t aValue )     { Raw( &aValue, sizeof( aValue ) ); }
+    void Double( double aValue )    { Raw( &aValue, sizeof( aValue ) ); }
+
+    void Point( const wxPoint& aPoint )
+    {
+        I32( aPoint.x );
+        I32( aPoint.y );
+    }
+
+    void Size( const wxSize& aSize )
+    {
+        I32( aSize.x );
+        I32( aSize.y );
+    }
+
+    void Layers( const LSET& aSet )
+    {
+        uint32_t bits[2] = { 0, 0 };
+
+        for( unsigned i = 0; i < aSet.size(); ++i )
+        {
+            if( aSet[i] )
+                bits[i / 32] |= 1u << ( i % 32 );
+        }
+
+        Raw( bits, sizeof( bits ) );
+    }
+
+    void String( const wxString& aString )
+    {
+        wxScopedCharBuffer utf8 = aString.utf8_str();
+
+        U32( utf8.length() );
+        Raw( utf8.data(), utf8.length() );
+    }
+
+    void String( const std::string& aString )
+    {
+        U32( aString.size() );
+        Raw( aString.data(), aString.size() );
+    }
+
+    void Points( const std::vector<wxPoint>& aPoints )
+    {
+        U32( aPoints.size() );
+
+        if( aPoints.size() )
+            Raw( &aPoints[0], aPoints.size() * sizeof( wxPoint ) );
+    }
+
+    void Points( const SHAPE_LINE_CHAIN& aChain )
+    {
+        U32( aChain.PointCount() );
+
+        for( int i = 0; i < aChain.PointCount(); ++i )
+            Raw( &aChain.CPoint( i ), sizeof( VECTOR2I ) );
+    }
+
+    void Write( const wxString& aFileName ) const
+    {
+        FILE* fp = wxFopen( aFileName, wxT( "wb" ) );
+
+        if( !fp )
+            THROW_IO_ERROR( wxString::Format( _( "Unable to open file '%s'" ),
+                                              GetChars( aFileName ) ) );
+
+        size_t written = fwrite( &m_buf[0], 1, m_buf.size(), fp );
+
+        if( fclose( fp ) != 0 || written != m_buf.size() )
+            THROW_IO_ERROR( wxString::Format( _( "Error writing file '%s'" ),
+                                              GetChars( aFileName ) ) );
+    }
+
+private:
+    std::vector<char>   m_buf;
+};
+
+
+/**
+ * Class BIN_INPUT
+ * reads a whole snapshot into memory and hands out its fields, throwing an IO_ERROR
+ * rather than reading past the end of a truncated or corrupt file.
+ */
+class BIN_INPUT
+{
+public:
+    BIN_INPUT( const wxString& aFileName ) :
+        m_source( aFileName ),
+        m_pos( 0 )
+    {
+        FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+        if( !fp )
+            THROW_IO_ERROR( wxString::Format( _( "Unable to open file '%s'" ),
+                                              GetChars( aFileName ) ) );
+
+        fseek( fp, 0, SEEK_END );
+        long size = ftell( fp );
+        fseek( fp, 0, SEEK_SET );
+
+        if( size > 0 )
+        {
+            m_buf.resize( size );
+
+            if( fread( &m_buf[0], 1, size, fp ) != (size_t) size )
+                m_buf.clear();
+        }
+
+        fclose( fp );
+
+        if( m_buf.empty() )
+            THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
+                                              GetChars( aFileName ) ) );
+    }
+
+    const char* Raw( size_t aSize )
+    {
+        if( aSize > m_buf.size() - m_pos )
+            THROW_IO_ERROR( wxString::Format( _( "Binary board file '%s' is truncated or corrupt" ),
+                                              GetChars( m_source ) ) );
+
+        const char* data = &m_buf[m_pos];
+        m_pos += aSize;
+
+        return data;
+    }
+
+    template <typename T>
+    T Pod()
+    {
+        T value;
+        memcpy( &value, Raw( sizeof( T ) ), sizeof( T ) );
+        return value;
+    }
+
+    uint8_t  U8()       { return Pod<uint8_t>(); }
+    bool     Bool()     { return U8() != 0; }
+    int32_t  I32()      { return Pod<int32_t>(); }
+    uint32_t U32()      { return Pod<uint32_t>(); }
+    double   Double()   { return Pod<double>(); }
+
+    wxPoint Point()
+    {
+        int32_t x = I32();
+        int32_t y = I32();
+
+        return wxPoint( x, y );
+    }
+
+    wxSize Size()
+    {
+        int32_t x = I32();
+        int32_t y = I32();
+
+        return wxSize( x, y );
+    }
+
+    LSET Layers()
+    {
+        uint32_t bits[2];
+        LSET     set;
+
+        memcpy( bits, Raw( sizeof( bits ) ), sizeof( bits ) );
+
+        for( unsigned i = 0; i < set.size(); ++i )
+        {
+            if( bits[i / 32] & ( 1u << ( i % 32 ) ) )
+                set.set( i );
+        }
+
+        return set;
+    }
+
+    std::string UTF8String()
+    {
+        uint32_t    len = U32();
+        const char* data = Raw( len );
+
+        return std::string( data, len );
+    }
+
+    wxString String()
+    {
+        uint32_t    len = U32();
+        const char* data = Raw( len );
+
+        return wxString::FromUTF8( data, len );
+    }
+
+    /// Check an element count against the bytes left, so a corrupt count cannot
+    /// trigger a huge allocation.
+    uint32_t Count( size_t aElementSize )
+    {
+        uint32_t count = U32();
+
+        if( aElementSize && count > ( m_buf.size() - m_pos ) / aElementSize )
+            THROW_IO_ERROR( wxString::Format( _( "Binary board file '%s' is truncated or corrupt" ),
+                                              GetChars( m_source ) ) );
+
+        return count;
+    }
+
+    void Points( std::vector<wxPoint>& aPoints )
+    {
+        uint32_t count = Count( sizeof( wxPoint ) );
+
+        aPoints.resize( count );
+
+        if( count )
+            memcpy( &aPoints[0], Raw( count * sizeof( wxPoint ) ), count * sizeof( wxPoint ) );
+    }
+
+    SHAPE_LINE_CHAIN Chain()
+    {
+        uint32_t count = Count( sizeof( VECTOR2I ) );
+
+        std::vector<VECTOR2I> pts( count );
+
+        if( count )
+            memcpy( &pts[0], Raw( count * sizeof( VECTOR2I ) ), count * sizeof( VECTOR2I ) );
+
+        return SHAPE_LINE_CHAIN( count ? &pts[0] : NULL, count );
+    }
+
+    const wxString& GetSource() const { return m_source; }
+
+private:
+    wxString            m_source;
+    std::vector<char>   m_buf;
+    size_t              m_pos;
+};
+
+
+KICAD_BINARY_PLUGIN::KICAD_BINARY_PLUGIN() :
+    m_mapping( new NETINFO_MAPPING() )
+{
+    init( NULL );
+}
+
+
+KICAD_BINARY_PLUGIN::~KICAD_BINARY_PLUGIN()
+{
+    delete m_mapping;
+}
+
+
+void KICAD_BINARY_PLUGIN::init( const PROPERTIES* aProperties )
+{
+    m_board = NULL;
+    m_props = aProperties;
+    m_netCodes.clear();
+}
+
+
+void KICAD_BINARY_PLUGIN::Save( const wxString& aFileName, BOARD* aBoard,
+                                const PROPERTIES* aProperties )
+{
+    init( aProperties );
+
+    BIN_OUTPUT out;
+
+    save( out, aBoard );
+    out.Write( aFileName );
+}
+
+
+BOARD* KICAD_BINARY_PLUGIN::Load( const wxString& aFileName, BOARD* aAppendToMe,
+                                  const PROPERTIES* aProperties )
+{
+    init( aProperties );
+
+    BIN_INPUT in( aFileName );
+
+    BOARD* board = load( in, aAppendToMe );
+
+    // Give the filename to the board if it's new
+    if( !aAppendToMe )
+        board->SetFileName( aFileName );
+
+    return board;
+}
+
+
+void KICAD_BINARY_PLUGIN::save( BIN_OUTPUT& aOut, BOARD* aBoard )
+{
+    m_board = aBoard;
+
+    // Same net code compaction as the s-expression format.
+    m_mapping->SetBoard( aBoard );
+
+    aOut.Raw( s_magic, s_magicLen );
+    aOut.U32( BINARY_BOARD_FILE_VERSION );
+    aOut.U32( s_byteOrder );
+    aOut.String( GetBuildVersion() );
+
+    saveSettings( aOut );
+    saveNets( aOut );
+
+    aOut.U32( aBoard->m_Modules.GetCount() );
+
+    for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
+        saveModule( aOut, module );
+
+    aOut.U32( aBoard->m_Drawings.GetCount() );
+
+    for( BOARD_ITEM* item = aBoard->m_Drawings;  item;  item = item->Next() )
+        saveDrawing( aOut, item );
+
+    saveTracks( aOut );
+
+    // Old segment filled zones are not saved, as with the s-expression format.
+    aOut.U32( aBoard->GetAreaCount() );
+
+    for( int i = 0; i < aBoard->GetAreaCount();  ++i )
+        saveZone( aOut, aBoard->GetArea( i ) );
+
+    aOut.Raw( s_trailer, s_magicLen );
+}
+
+
+BOARD* KICAD_BINARY_PLUGIN::load( BIN_INPUT& aIn, BOARD* aAppendToMe )
+{
+    const wxString& source = aIn.GetSource();
+
+    if( memcmp( aIn.Raw( s_magicLen ), s_magic, s_magicLen ) != 0 )
+        THROW_IO_ERROR( wxString::Format( _( "File '%s' is not a KiCad binary board file" ),
+                                          GetChars( source ) ) );
+
+    uint32_t version   = aIn.U32();
+    uint32_t byteOrder = aIn.U32();
+
+    if( byteOrder != s_byteOrder )
+        THROW_IO_ERROR( wxString::Format( _( "Binary board file '%s' was written on a machine "
+                                             "with a different byte order" ),
+                                          GetChars( source ) ) );
+
+    if( version != BINARY_BOARD_FILE_VERSION )
+        THROW_IO_ERROR( wxString::Format( _( "Binary board file '%s' has version %u, "
+                                             "this Pcbnew reads version %d" ),
+                                          GetChars( source ), version,
+                                          BINARY_BOARD_FILE_VERSION ) );
+
+    aIn.String();       // host build version, informational only
+
+    std::unique_ptr<BOARD> deleter( aAppendToMe ? NULL : new BOARD() );
+
+    m_board = aAppendToMe ? aAppendToMe : deleter.get();
+
+    loadSettings( aIn );
+    loadNets( aIn );
+
+    uint32_t count = aIn.U32();
+
+    for( uint32_t i = 0; i < count; ++i )
+        m_board->Add( loadModule( aIn ), ADD_APPEND );
+
+    count = aIn.U32();
+
+    for( uint32_t i = 0; i < count; ++i )
+        m_board->Add( loadDrawing( aIn ), ADD_APPEND );
+
+    loadTracks( aIn );
+
+    count = aIn.U32();
+
+    for( uint32_t i = 0; i < count; ++i )
+        m_board->Add( loadZone( aIn ), ADD_APPEND );
+
+    if( memcmp( aIn.Raw( s_magicLen ), s_trailer, s_magicLen ) != 0 )
+        THROW_IO_ERROR( wxString::Format( _( "Binary board file '%s' is truncated or corrupt" ),
+                                          GetChars( source ) ) );
+
+    deleter.release();
+
+    return m_board;
+}
+
+
+int KICAD_BINARY_PLUGIN::netCode( int aFileNetCode ) const
+{
+    if( aFileNetCode >= 0 && aFileNetCode < (int) m_netCodes.size() )
+        return m_netCodes[aFileNetCode];
+
+    return NETINFO_LIST::UNCONNECTED;
+}
+
+
+void KICAD_BINARY_PLUGIN::saveSettings( BIN_OUTPUT& aOut ) const
+{
+    const BOARD_DESIGN_SETTINGS& dsn = m_board->GetDesignSettings();
+
+    // General
+    aOut.I32( dsn.GetBoardThickness() );
+
+    // Page
+    const PAGE_INFO& page = m_board->GetPageSettings();
+
+    aOut.String( page.GetType() );
+    aOut.I32( page.GetWidthMils() );
+    aOut.I32( page.GetHeightMils() );
+    aOut.Bool( page.IsPortrait() );
+
+    // Title block
+    const TITLE_BLOCK& tb = m_board->GetTitleBlock();
+
+    aOut.String( tb.GetTitle() );
+    aOut.String( tb.GetDate() );
+    aOut.String( tb.GetRevision() );
+    aOut.String( tb.GetCompany() );
+
+    for( int i = 0; i < 4; ++i )
+        aOut.String( tb.GetComment( i ) );
+
+    // Layers
+    LSET enabled = m_board->GetEnabledLayers();
+
+    aOut.I32( m_board->GetCopperLayerCount() );
+    aOut.Layers( enabled );
+    aOut.Layers( m_board->GetVisibleLayers() );
+
+    for( LSEQ seq = enabled.Seq();  seq;  ++seq )
+    {
+        aOut.String( m_board->GetLayerName( *seq ) );
+        aOut.U8( m_board->GetLayerType( *seq ) );
+    }
+
+    // Setup
+    NETCLASSPTR defaultNC = dsn.GetDefault();
+
+    aOut.U32( dsn.m_TrackWidthList.size() );
+
+    for( unsigned ii = 1; ii < dsn.m_TrackWidthList.size(); ii++ )
+        aOut.I32( dsn.m_TrackWidthList[ii] );
+
+    aOut.U32( dsn.m_ViasDimensionsList.size() );
+
+    for( unsigned ii = 1; ii < dsn.m_ViasDimensionsList.size(); ii++ )
+    {
+        aOut.I32( dsn.m_ViasDimensionsList[ii].m_Diameter );
+        aOut.I32( dsn.m_ViasDimensionsList[ii].m_Drill );
+    }
+
+    aOut.I32( m_board->GetZoneSettings().m_ZoneClearance );
+    aOut.Bool( m_board->GetZoneSettings().m_Zone_45_Only );
+
+    aOut.I32( dsn.m_TrackMinWidth );
+    aOut.I32( dsn.m_DrawSegmentWidth );
+    aOut.I32( dsn.m_EdgeSegmentWidth );
+    aOut.I32( dsn.m_ViasMinSize );
+    aOut.I32( dsn.m_ViasMinDrill );
+    aOut.Bool( dsn.m_BlindBuriedViaAllowed );
+    aOut.Bool( dsn.m_MicroViasAllowed );
+    aOut.I32( dsn.m_MicroViasMinSize );
+    aOut.I32( dsn.m_MicroViasMinDrill );
+    aOut.I32( dsn.m_PcbTextWidth );
+    aOut.Size( dsn.m_PcbTextSize );
+    aOut.I32( dsn.m_ModuleSegmentWidth );
+    aOut.Size( dsn.m_ModuleTextSize );
+    aOut.I32( dsn.m_ModuleTextWidth );
+    aOut.Size( dsn.m_Pad_Master.GetSize() );
+    aOut.Size( dsn.m_Pad_Master.GetDrillSize() );
+    aOut.I32( dsn.m_SolderMaskMargin );
+    aOut.I32( dsn.m_SolderMaskMinWidth );
+    aOut.I32( dsn.m_SolderPasteMargin );
+    aOut.Double( dsn.m_SolderPasteMarginRatio );
+    aOut.Point( m_board->GetAuxOrigin() );
+    aOut.Point( m_board->GetGridOrigin() );
+    aOut.I32( dsn.GetVisibleElements() );
+
+    // The plot options are small and have their own parser, reuse it.
+    STRING_FORMATTER sf;
+
+    {
+        LOCALE_IO toggle;
+        m_board->GetPlotOptions().Format( &sf, 0 );
+    }
+
+    aOut.String( sf.GetString() );
+
+    // Net classes, the default one first.
+    const NETCLASSES& netclasses = dsn.m_NetClasses;
+
+    aOut.U32( netclasses.GetCount() + 1 );
+
+    for( int ii = -1; ii < (int) netclasses.GetCount(); ++ii )
+    {
+        NETCLASSPTR nc = defaultNC;
+
+        if( ii >= 0 )
+        {
+            NETCLASSES::const_iterator it = netclasses.begin();
+            std::advance( it, ii );
+            nc = it->second;
+        }
+
+        aOut.String( nc->GetName() );
+        aOut.String( nc->GetDescription() );
+        aOut.I32( nc->GetClearance() );
+        aOut.I32( nc->GetTrackWidth() );
+        aOut.I32( nc->GetViaDiameter() );
+        aOut.I32( nc->GetViaDrill() );
+        aOut.I32( nc->GetuViaDiameter() );
+        aOut.I32( nc->GetuViaDrill() );
+        aOut.I32( nc->GetDiffPairWidth() );
+        aOut.I32( nc->GetDiffPairGap() );
+
+        aOut.U32( nc->GetCount() );
+
+        for( NETCLASS::const_iterator member = nc->begin(); member != nc->end(); ++member )
+            aOut.String( *member );
+    }
+}
+
+
+void KICAD_BINARY_PLUGIN::loadSettings( BIN_INPUT& aIn )
+{
+    BOARD_DESIGN_SETTINGS dsn = m_board->GetDesignSettings();
+    ZONE_SETTINGS         zoneSettings = m_board->GetZoneSettings();
+
+    // General
+    dsn.SetBoardThickness( aIn.I32() );
+
+    // Page
+    PAGE_INFO pageInfo;
+    wxString  pageType = aIn.String();
+    int       width    = aIn.I32();
+    int       height   = aIn.I32();
+
+    if( !pageInfo.SetType( pageType ) )
+        THROW_IO_ERROR( wxString::Format( _( "page type \"%s\" is not valid " ),
+                                          GetChars( pageType ) ) );
+
+    if( pageType == PAGE_INFO::Custom )
+    {
+        pageInfo.SetWidthMils( width );
+        pageInfo.SetHeightMils( height );
+    }
+
+    pageInfo.SetPortrait( aIn.Bool() );
+    m_board->SetPageSettings( pageInfo );
+
+    // Title block
+    TITLE_BLOCK tb;
+
+    tb.SetTitle( aIn.String() );
+    tb.SetDate( aIn.String() );
+    tb.SetRevision( aIn.String() );
+    tb.SetCompany( aIn.String() );
+
+    for( int i = 0; i < 4; ++i )
+        tb.SetComment( i, aIn.String() );
+
+    m_board->SetTitleBlock( tb );
+
+    // Layers
+    int  copperLayerCount = aIn.I32();
+    LSET enabled = aIn.Layers();
+    LSET visible = aIn.Layers();
+
+    if( copperLayerCount < 2 || ( copperLayerCount % 2 ) != 0 )
+        THROW_IO_ERROR( wxString::Format( _( "%d is not a valid layer count" ),
+                                          copperLayerCount ) );
+
+    for( LSEQ seq = enabled.Seq();  seq;  ++seq )
+    {
+        LAYER layer;
+
+        layer.m_name    = aIn.String();
+        layer.m_type    = (LAYER_T) aIn.U8();
+        layer.m_visible = visible[*seq];
+        layer.m_number  = *seq;
+
+        m_board->SetLayerDescr( *seq, layer );
+    }
+
+    m_board->SetCopperLayerCount( copperLayerCount );
+    m_board->SetEnabledLayers( enabled );
+
+    // call SetEnabledLayers before SetVisibleLayers()
+    m_board->SetVisibleLayers( visible );
+
+    // Setup
+    uint32_t count = aIn.Count( sizeof( int32_t ) );
+
+    for( uint32_t ii = 1; ii < count; ii++ )
+        dsn.m_TrackWidthList.push_back( aIn.I32() );
+
+    count = aIn.Count( 2 * sizeof( int32_t ) );
+
+    for( uint32_t ii = 1; ii < count; ii++ )
+    {
+        int diameter = aIn.I32();
+        int drill    = aIn.I32();
+
+        dsn.m_ViasDimensionsList.push_back( VIA_DIMENSION( diameter, drill ) );
+    }
+
+    zoneSettings.m_ZoneClearance = aIn.I32();
+    zoneSettings.m_Zone_45_Only  = aIn.Bool();
+
+    dsn.m_TrackMinWidth          = aIn.I32();
+    dsn.m_DrawSegmentWidth       = aIn.I32();
+    dsn.m_EdgeSegmentWidth       = aIn.I32();
+    dsn.m_ViasMinSize            = aIn.I32();
+    dsn.m_ViasMinDrill           = aIn.I32();
+    dsn.m_BlindBuriedViaAllowed  = aIn.Bool();
+    dsn.m_MicroViasAllowed       = aIn.Bool();
+    dsn.m_MicroViasMinSize       = aIn.I32();
+    dsn.m_MicroViasMinDrill      = aIn.I32();
+    dsn.m_PcbTextWidth           = aIn.I32();
+    dsn.m_PcbTextSize            = aIn.Size();
+    dsn.m_ModuleSegmentWidth     = aIn.I32();
+    dsn.m_ModuleTextSize         = aIn.Size();
+    dsn.m_ModuleTextWidth        = aIn.I32();
+    dsn.m_Pad_Master.SetSize( aIn.Size() );
+    dsn.m_Pad_Master.SetDrillSize( aIn.Size() );
+    dsn.m_SolderMaskMargin       = aIn.I32();
+    dsn.m_SolderMaskMinWidth     = aIn.I32();
+    dsn.m_SolderPasteMargin      = aIn.I32();
+    dsn.m_SolderPasteMarginRatio = aIn.Double();
+    dsn.m_AuxOrigin              = aIn.Point();
+    dsn.m_GridOrigin             = aIn.Point();
+    dsn.SetVisibleElements( aIn.I32() | MIN_VISIBILITY_MASK );
+
+    {
+        LOCALE_IO               toggle;
+        PCB_PLOT_PARAMS         plotParams;
+        STRING_LINE_READER      reader( aIn.UTF8String(), aIn.GetSource() );
+        PCB_PLOT_PARAMS_PARSER  parser( &reader );
+
+        plotParams.Parse( &parser );
+        m_board->SetPlotOptions( plotParams );
+    }
+
+    // Net classes, the default one first.
+    count = aIn.U32();
+
+    for( uint32_t ii = 0; ii < count; ++ii )
+    {
+        NETCLASSPTR nc = ii == 0 ? dsn.GetDefault() : std::make_shared<NETCLASS>( wxEmptyString );
+
+        nc->SetName( aIn.String() );
+        nc->SetDescription( aIn.String() );
+        nc->SetClearance( aIn.I32() );
+        nc->SetTrackWidth( aIn.I32() );
+        nc->SetViaDiameter( aIn.I32() );
+        nc->SetViaDrill( aIn.I32() );
+        nc->SetuViaDiameter( aIn.I32() );
+        nc->SetuViaDrill( aIn.I32() );
+        nc->SetDiffPairWidth( aIn.I32() );
+        nc->SetDiffPairGap( aIn.I32() );
+
+        uint32_t members = aIn.Count( sizeof( uint32_t ) );
+
+        for( uint32_t m = 0; m < members; ++m )
+            nc->Add( aIn.String() );
+
+        if( ii > 0 && !dsn.m_NetClasses.Add( nc ) )
+            THROW_IO_ERROR( wxString::Format( _( "duplicate NETCLASS name '%s' in file '%s'" ),
+                                              GetChars( nc->GetName() ),
+                                              GetChars( aIn.GetSource() ) ) );
+    }
+
+    m_board->SetDesignSettings( dsn );
+    m_board->SetZoneSettings( zoneSettings );
+}
+
+
+void KICAD_BINARY_PLUGIN::saveNets( BIN_OUTPUT& aOut ) const
+{
+    aOut.U32( m_mapping->GetSize() );
+
+    for( NETINFO_MAPPING::iterator net = m_mapping->begin(), netEnd = m_mapping->end();
+            net != netEnd; ++net )
+    {
+        aOut.I32( m_mapping->Translate( net->GetNet() ) );
+        aOut.String( net->GetNetname() );
+    }
+}
+
+
+void KICAD_BINARY_PLUGIN::loadNets( BIN_INPUT& aIn )
+{
+    uint32_t count = aIn.Count( sizeof( int32_t ) );
+
+    m_netCodes.assign( count, NETINFO_LIST::UNCONNECTED );
+
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        int      code = aIn.I32();
+        wxString name = aIn.String();
+
+        if( code < 0 || code >= (int) count )
+            THROW_IO_ERROR( wxString::Format( _( "invalid net code %d in file '%s'" ),
+                                              code, GetChars( aIn.GetSource() ) ) );
+
+        // net 0 is already in the BOARD's list
+        if( code > NETINFO_LIST::UNCONNECTED )
+        {
+            NETINFO_ITEM* net = new NETINFO_ITEM( m_board, name, code );
+            m_board->Add( net );
+            m_netCodes[code] = net->GetNet();
+        }
+    }
+}
+
+
+void KICAD_BINARY_PLUGIN::saveText( BIN_OUTPUT& aOut, const EDA_TEXT* aText ) const
+{
+    aOut.String( aText->GetText() );
+    aOut.Point( aText->GetTextPosition() );
+    aOut.Double( aText->GetOrientation() );
+    aOut.Size( aText->GetSize() );
+    aOut.I32( aText->GetThickness() );
+    aOut.I32( aText->GetAttributes() );
+    aOut.Bool( aText->IsItalic() );
+    aOut.Bool( aText->IsBold() );
+    aOut.Bool( aText->IsMirrored() );
+    aOut.Bool( aText->IsMultilineAllowed() );
+    aOut.U8( aText->GetHorizJustify() + 1 );     // -1 .. 1 stored as 0 .. 2
+    aOut.U8( aText->GetVertJustify() + 1 );
+}
+
+
+void KICAD_BINARY_PLUGIN::loadText( BIN_INPUT& aIn, EDA_TEXT* aText )
+{
+    aText->SetText( aIn.String() );
+    aText->SetTextPosition( aIn.Point() );
+    aText->SetOrientation( aIn.Double() );
+    aText->SetSize( aIn.Size() );
+    aText->SetThickness( aIn.I32() );
+    aText->SetAttributes( aIn.I32() );
+    aText->SetItalic( aIn.Bool() );
+    aText->SetBold( aIn.Bool() );
+    aText->SetMirrored( aIn.Bool() );
+    aText->SetMultilineAllowed( aIn.Bool() );
+    aText->SetHorizJustify( (EDA_TEXT_HJUSTIFY_T) ( aIn.U8() - 1 ) );
+    aText->SetVertJustify( (EDA_TEXT_VJUSTIFY_T) ( aIn.U8() - 1 ) );
+}
+
+
+void KICAD_BINARY_PLUGIN::saveDrawing( BIN_OUTPUT& aOut, BOARD_ITEM* aItem ) const
+{
+    switch( aItem->Type() )
+    {
+    case PCB_LINE_T:
+    case PCB_MODULE_EDGE_T:
+        {
+            DRAWSEGMENT* segment = static_cast<DRAWSEGMENT*>( aItem );
+
+            if( aItem->Type() == PCB_LINE_T )
+                aOut.U8( BIN_DRAWSEGMENT );
+
+            aOut.U8( segment->GetShape() );
+            aOut.U8( segment->GetLayer() );
+            aOut.I32( segment->GetWidth() );
+            aOut.Double( segment->GetAngle() );
+            aOut.U32( segment->GetTimeStamp() );
+            aOut.U32( segment->GetStatus() );
+
+            if( aItem->Type() == PCB_MODULE_EDGE_T )
+            {
+                EDGE_MODULE* edge = static_cast<EDGE_MODULE*>( aItem );
+                aOut.Point( edge->GetStart0() );
+                aOut.Point( edge->GetEnd0() );
+            }
+            else
+            {
+                aOut.Point( segment->GetStart() );
+                aOut.Point( segment->GetEnd() );
+            }
+
+            aOut.Point( segment->GetBezControl1() );
+            aOut.Point( segment->GetBezControl2() );
+            aOut.Points( segment->GetPolyPoints() );
+        }
+        break;
+
+    case PCB_TEXT_T:
+        {
+            TEXTE_PCB* text = static_cast<TEXTE_PCB*>( aItem );
+
+            aOut.U8( BIN_TEXTE_PCB );
+            aOut.U8( text->GetLayer() );
+            aOut.U32( text->GetTimeStamp() );
+            saveText( aOut, text );
+        }
+        break;
+
+    case PCB_DIMENSION_T:
+        {
+            DIMENSION* dim = static_cast<DIMENSION*>( aItem );
+
+            aOut.U8( BIN_DIMENSION );
+            aOut.U8( dim->GetLayer() );
+            aOut.U32( dim->GetTimeStamp() );
+            aOut.I32( dim->GetValue() );
+            aOut.I32( dim->GetWidth() );
+            aOut.U32( dim->Text().GetTimeStamp() );
+            saveText( aOut, &dim->Text() );
+            aOut.Point( dim->m_featureLineDO );
+            aOut.Point( dim->m_featureLineDF );
+            aOut.Point( dim->m_featureLineGO );
+            aOut.Point( dim->m_featureLineGF );
+            aOut.Point( dim->m_crossBarO );
+            aOut.Point( dim->m_crossBarF );
+            aOut.Point( dim->m_arrowD1F );
+            aOut.Point( dim->m_arrowD2F );
+            aOut.Point( dim->m_arrowG1F );
+            aOut.Point( dim->m_arrowG2F );
+        }
+        break;
+
+    case PCB_TARGET_T:
+        {
+            PCB_TARGET* target = static_cast<PCB_TARGET*>( aItem );
+
+            aOut.U8( BIN_PCB_TARGET );
+            aOut.U8( target->GetLayer() );
+            aOut.U32( target->GetTimeStamp() );
+            aOut.I32( target->GetShape() );
+            aOut.Point( target->GetPosition() );
+            aOut.I32( target->GetSize() );
+            aOut.I32( target->GetWidth() );
+        }
+        break;
+
+    default:
+        THROW_IO_ERROR( wxT( "Cannot save item " ) + aItem->GetClass() );
+    }
+}
+
+
+BOARD_ITEM* KICAD_BINARY_PLUGIN::loadDrawing( BIN_INPUT& aIn )
+{
+    switch( aIn.U8() )
+    {
+    case BIN_DRAWSEGMENT:
+        {
+            std::unique_ptr<DRAWSEGMENT> segment( new DRAWSEGMENT( NULL ) );
+            std::vector<wxPoint>         pts;
+
+            segment->SetShape( (STROKE_T) aIn.U8() );
+            segment->SetLayer( (LAYER_ID) aIn.U8() );
+            segment->SetWidth( aIn.I32() );
+            segment->SetAngle( aIn.Double() );
+            segment->SetTimeStamp( aIn.U32() );
+            segment->SetStatus( (STATUS_FLAGS) aIn.U32() );
+            segment->SetStart( aIn.Point() );
+            segment->SetEnd( aIn.Point() );
+            segment->SetBezControl1( aIn.Point() );
+            segment->SetBezControl2( aIn.Point() );
+            aIn.Points( pts );
+            segment->SetPolyPoints( pts );
+
+            return segment.release();
+        }
+
+    case BIN_TEXTE_PCB:
+        {
+            std::unique_ptr<TEXTE_PCB> text( new TEXTE_PCB( m_board ) );
+
+            text->SetLayer( (LAYER_ID) aIn.U8() );
+            text->SetTimeStamp( aIn.U32() );
+            loadText( aIn, text.get() );
+
+            return text.release();
+        }
+
+    case BIN_DIMENSION:
+        {
+            std::unique_ptr<DIMENSION> dim( new DIMENSION( NULL ) );
+
+            dim->SetLayer( (LAYER_ID) aIn.U8() );
+            dim->SetTimeStamp( aIn.U32() );
+            dim->SetValue( aIn.I32() );
+            dim->SetWidth( aIn.I32() );
+            dim->Text().SetTimeStamp( aIn.U32() );
+            loadText( aIn, &dim->Text() );
+            dim->SetPosition( dim->Text().GetTextPosition() );
+            dim->m_featureLineDO = aIn.Point();
+            dim->m_featureLineDF = aIn.Point();
+            dim->m_featureLineGO = aIn.Point();
+            dim->m_featureLineGF = aIn.Point();
+            dim->m_crossBarO     = aIn.Point();
+            dim->m_crossBarF     = aIn.Point();
+            dim->m_arrowD1F      = aIn.Point();
+            dim->m_arrowD2F      = aIn.Point();
+            dim->m_arrowG1F      = aIn.Point();
+            dim->m_arrowG2F      = aIn.Point();
+            dim->UpdateHeight();
+
+            return dim.release();
+        }
+
+    case BIN_PCB_TARGET:
+        {
+            std::unique_ptr<PCB_TARGET> target( new PCB_TARGET( NULL ) );
+
+            target->SetLayer( (LAYER_ID) aIn.U8() );
+            target->SetTimeStamp( aIn.U32() );
+            target->SetShape( aIn.I32() );
+            target->SetPosition( aIn.Point() );
+            target->SetSize( aIn.I32() );
+            target->SetWidth( aIn.I32() );
+
+            return target.release();
+        }
+
+    default:
+        THROW_IO_ERROR( wxString::Format( _( "Binary board file '%s' is truncated or corrupt" ),
+                                          GetChars( aIn.GetSource() ) ) );
+    }
+}
+
+
+void KICAD_BINARY_PLUGIN::saveModule( BIN_OUTPUT& aOut, MODULE* aModule ) const
+{
+    aOut.String( std::string( aModule->GetFPID().Format().c_str() ) );
+    aOut.Bool( aModule->IsLocked() );
+    aOut.Bool( aModule->IsPlaced() );
+    aOut.U8( aModule->GetLayer() );
+    aOut.U32( aModule->GetLastEditTime() );
+    aOut.U32( aModule->GetTimeStamp() );
+    aOut.Point( aModule->GetPosition() );
+    aOut.Double( aModule->GetOrientation() );
+    aOut.String( aModule->GetDescription() );
+    aOut.String( aModule->GetKeywords() );
+    aOut.String( aModule->GetPath() );
+    aOut.I32( aModule->GetPlacementCost90() );
+    aOut.I32( aModule->GetPlacementCost180() );
+    aOut.I32( aModule->GetLocalSolderMaskMargin() );
+    aOut.I32( aModule->GetLocalSolderPasteMargin() );
+    aOut.Double( aModule->GetLocalSolderPasteMarginRatio() );
+    aOut.I32( aModule->GetLocalClearance() );
+    aOut.I32( aModule->GetZoneConnection() );
+    aOut.I32( aModule->GetThermalWidth() );
+    aOut.I32( aModule->GetThermalGap() );
+    aOut.I32( aModule->GetAttributes() );
+
+    TEXTE_MODULE* texts[2] = { &aModule->Reference(), &aModule->Value() };
+
+    for( TEXTE_MODULE* text : texts )
+    {
+        aOut.U8( text->GetLayer() );
+        aOut.Point( text->GetPos0() );
+        aOut.Bool( text->IsVisible() );
+        saveText( aOut, text );
+    }
+
+    aOut.U32( aModule->GraphicalItems().GetCount() );
+
+    for( BOARD_ITEM* gr = aModule->GraphicalItems();  gr;  gr = gr->Next() )
+    {
+        if( gr->Type() == PCB_MODULE_TEXT_T )
+        {
+            TEXTE_MODULE* text = static_cast<TEXTE_MODULE*>( gr );
+
+            aOut.U8( PCB_MODULE_TEXT_T );
+            aOut.U8( text->GetType() );
+            aOut.U8( text->GetLayer() );
+            aOut.Point( text->GetPos0() );
+            aOut.Bool( text->IsVisible() );
+            saveText( aOut, text );
+        }
+        else
+        {
+            aOut.U8( PCB_MODULE_EDGE_T );
+            saveDrawing( aOut, gr );
+        }
+    }
+
+    aOut.U32( aModule->Pads().GetCount() );
+
+    for( D_PAD* pad = aModule->Pads();  pad;  pad = pad->Next() )
+        savePad( aOut, pad );
+
+    aOut.U32( aModule->Models().size() );
+
+    for( const S3D_INFO& model : aModule->Models() )
+    {
+        aOut.String( model.m_Filename );
+        aOut.Raw( &model.m_Offset, sizeof( model.m_Offset ) );
+        aOut.Raw( &model.m_Scale, sizeof( model.m_Scale ) );
+        aOut.Raw( &model.m_Rotation, sizeof( model.m_Rotation ) );
+    }
+}
+
+
+MODULE* KICAD_BINARY_PLUGIN::loadModule( BIN_INPUT& aIn )
+{
+    std::unique_ptr<MODULE> module( new MODULE( m_board ) );
+
+    LIB_ID fpid;
+    fpid.Parse( aIn.UTF8String() );
+
+    module->SetLocked( aIn.Bool() );
+    module->SetIsPlaced( aIn.Bool() );
+    module->SetLayer( (LAYER_ID) aIn.U8() );
+    module->SetLastEditTime( aIn.U32() );
+    module->SetTimeStamp( aIn.U32() );
+    module->SetPosition( aIn.Point() );
+    module->SetOrientation( aIn.Double() );
+    module->SetDescription( aIn.String() );
+    module->SetKeywords( aIn.String() );
+    module->SetPath( aIn.String() );
+    module->SetPlacementCost90( aIn.I32() );
+    module->SetPlacementCost180( aIn.I32() );
+    module->SetLocalSolderMaskMargin( aIn.I32() );
+    module->SetLocalSolderPasteMargin( aIn.I32() );
+    module->SetLocalSolderPasteMarginRatio( aIn.Double() );
+    module->SetLocalClearance( aIn.I32() );
+    module->SetZoneConnection( (ZoneConnection) aIn.I32() );
+    module->SetThermalWidth( aIn.I32() );
+    module->SetThermalGap( aIn.I32() );
+    module->SetAttributes( aIn.I32() );
+
+    TEXTE_MODULE* texts[2] = { &module->Reference(), &module->Value() };
+
+    for( TEXTE_MODULE* text : texts )
+    {
+        text->SetLayer( (LAYER_ID) aIn.U8() );
+        wxPoint pos0 = aIn.Point();
+        text->SetVisible( aIn.Bool() );
+        loadText( aIn, text );
+        text->SetPos0( pos0 );      // also sets the draw coordinates
+    }
+
+    uint32_t count = aIn.U32();
+
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        if( aIn.U8() == PCB_MODULE_TEXT_T )
+        {
+            TEXTE_MODULE* text = new TEXTE_MODULE( module.get() );
+
+            module->GraphicalItems().PushBack( text );
+            text->SetType( (TEXTE_MODULE::TEXT_TYPE) aIn.U8() );
+            text->SetLayer( (LAYER_ID) aIn.U8() );
+            wxPoint pos0 = aIn.Point();
+            text->SetVisible( aIn.Bool() );
+            loadText( aIn, text );
+            text->SetPos0( pos0 );
+        }
+        else
+        {
+            EDGE_MODULE*         edge = new EDGE_MODULE( module.get() );
+            std::vector<wxPoint> pts;
+
+            module->GraphicalItems().PushBack( edge );
+            edge->SetShape( (STROKE_T) aIn.U8() );
+            edge->SetLayer( (LAYER_ID) aIn.U8() );
+            edge->SetWidth( aIn.I32() );
+            edge->SetAngle( aIn.Double() );
+            edge->SetTimeStamp( aIn.U32() );
+            edge->SetStatus( (STATUS_FLAGS) aIn.U32() );
+            edge->SetStart0( aIn.Point() );
+            edge->SetEnd0( aIn.Point() );
+            edge->SetBezControl1( aIn.Point() );
+            edge->SetBezControl2( aIn.Point() );
+            aIn.Points( pts );
+            edge->SetPolyPoints( pts );
+            edge->SetDrawCoord();
+        }
+    }
+
+    count = aIn.U32();
+
+    for( uint32_t i = 0; i < count; ++i )
+        module->Add( loadPad( aIn, module.get() ), ADD_APPEND );
+
+    count = aIn.U32();
+
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        S3D_INFO* model = new S3D_INFO;
+
+        model->m_Filename = aIn.String();
+        memcpy( &model->m_Offset, aIn.Raw( sizeof( model->m_Offset ) ), sizeof( model->m_Offset ) );
+        memcpy( &model->m_Scale, aIn.Raw( sizeof( model->m_Scale ) ), sizeof( model->m_Scale ) );
+        memcpy( &model->m_Rotation, aIn.Raw( sizeof( model->m_Rotation ) ),
+                sizeof( model->m_Rotation ) );
+
+        module->Add3DModel( model );
+    }
+
+    module->SetFPID( fpid );
+    module->CalculateBoundingBox();
+
+    return module.release();
+}
+
+
+void KICAD_BINARY_PLUGIN::savePad( BIN_OUTPUT& aOut, D_PAD* aPad ) const
+{
+    aOut.String( aPad->GetPadName() );
+    aOut.U8( aPad->GetAttribute() );
+    aOut.U8( aPad->GetShape() );
+    aOut.U8( aPad->GetDrillShape() );
+    aOut.Point( aPad->GetPos0() );
+    aOut.Double( aPad->GetOrientation() );
+    aOut.Size( aPad->GetSize() );
+    aOut.Size( aPad->GetDelta() );
+    aOut.Size( aPad->GetDrillSize() );
+    aOut.Point( aPad->GetOffset() );
+    aOut.Layers( aPad->GetLayerSet() );
+    aOut.Double( aPad->GetRoundRectRadiusRatio() );
+    aOut.I32( m_mapping->Translate( aPad->GetNetCode() ) );
+    aOut.I32( aPad->GetPadToDieLength() );
+    aOut.I32( aPad->GetLocalSolderMaskMargin() );
+    aOut.I32( aPad->GetLocalSolderPasteMargin() );
+    aOut.Double( aPad->GetLocalSolderPasteMarginRatio() );
+    aOut.I32( aPad->GetLocalClearance() );
+    aOut.I32( aPad->GetZoneConnection() );
+    aOut.I32( aPad->GetThermalWidth() );
+    aOut.I32( aPad->GetThermalGap() );
+}
+
+
+D_PAD* KICAD_BINARY_PLUGIN::loadPad( BIN_INPUT& aIn, MODULE* aParent )
+{
+    std::unique_ptr<D_PAD> pad( new D_PAD( aParent ) );
+
+    pad->SetPadName( aIn.String() );
+    pad->SetAttribute( (PAD_ATTR_T) aIn.U8() );
+    pad->SetShape( (PAD_SHAPE_T) aIn.U8() );
+    pad->SetDrillShape( (PAD_DRILL_SHAPE_T) aIn.U8() );
+    pad->SetPos0( aIn.Point() );
+    pad->SetOrientation( aIn.Double() );
+    pad->SetSize( aIn.Size() );
+    pad->SetDelta( aIn.Size() );
+    pad->SetDrillSize( aIn.Size() );
+    pad->SetOffset( aIn.Point() );
+    pad->SetLayerSet( aIn.Layers() );
+    pad->SetRoundRectRadiusRatio( aIn.Double() );
+
+    if( !pad->SetNetCode( netCode( aIn.I32() ), /* aNoAssert */ true ) )
+        THROW_IO_ERROR( wxString::Format( _( "invalid net ID in file '%s'" ),
+                                          GetChars( aIn.GetSource() ) ) );
+
+    pad->SetPadToDieLength( aIn.I32() );
+    pad->SetLocalSolderMaskMargin( aIn.I32() );
+    pad->SetLocalSolderPasteMargin( aIn.I32() );
+    pad->SetLocalSolderPasteMarginRatio( aIn.Double() );
+    pad->SetLocalClearance( aIn.I32() );
+    pad->SetZoneConnection( (ZoneConnection) aIn.I32() );
+    pad->SetThermalWidth( aIn.I32() );
+    pad->SetThermalGap( aIn.I32() );
+
+    wxPoint pt = pad->GetPos0();
+
+    RotatePoint( &pt, aParent->GetOrientation() );
+    pad->SetPosition( pt + aParent->GetPosition() );
+
+    return pad.release();
+}
+
+
+void KICAD_BINARY_PLUGIN::saveTracks( BIN_OUTPUT& aOut ) const
+{
+    std::vector<BIN_TRACK> records;
+
+    records.reserve( m_board->m_Track.GetCount() );
+
+    for( TRACK* track = m_board->m_Track;  track; track = track->Next() )
+    {
+        BIN_TRACK rec;
+
+        memset( &rec, 0, sizeof( rec ) );
+
+        rec.m_startX    = track->GetStart().x;
+        rec.m_startY    = track->GetStart().y;
+        rec.m_endX      = track->GetEnd().x;
+        rec.m_endY      = track->GetEnd().y;
+        rec.m_width     = track->GetWidth();
+        rec.m_netCode   = m_mapping->Translate( track->GetNetCode() );
+        rec.m_timeStamp = track->GetTimeStamp();
+        rec.m_status    = track->GetStatus();
+        rec.m_layer     = track->GetLayer();
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            VIA*     via = static_cast<VIA*>( track );
+            LAYER_ID top, bottom;
+
+            via->LayerPair( &top, &bottom );
+
+            rec.m_isVia       = 1;
+            rec.m_drill       = via->GetDrill();
+            rec.m_layer       = top;
+            rec.m_bottomLayer = bottom;
+            rec.m_viaType     = via->GetViaType();
+        }
+
+        records.push_back( rec );
+    }
+
+    aOut.U32( records.size() );
+
+    if( records.size() )
+        aOut.Raw( &records[0], records.size() * sizeof( BIN_TRACK ) );
+}
+
+
+void KICAD_BINARY_PLUGIN::loadTracks( BIN_INPUT& aIn )
+{
+    uint32_t count = aIn.Count( sizeof( BIN_TRACK ) );
+
+    if( !count )
+        return;
+
+    std::vector<BIN_TRACK> records( count );
+
+    memcpy( &records[0], aIn.Raw( count * sizeof( BIN_TRACK ) ), count * sizeof( BIN_TRACK ) );
+
+    for( const BIN_TRACK& rec : records )
+    {
+        TRACK* track;
+
+        if( rec.m_isVia )
+        {
+            VIA* via = new VIA( m_board );
+
+            via->SetViaType( (VIATYPE_T) rec.m_viaType );
+            via->SetDrill( rec.m_drill );
+            via->SetLayerPair( (LAYER_ID) rec.m_layer, (LAYER_ID) rec.m_bottomLayer );
+            track = via;
+        }
+        else
+        {
+            track = new TRACK( m_board );
+            track->SetLayer( (LAYER_ID) rec.m_layer );
+        }
+
+        // Hand the item to the board first, so a bad net code does not leak it.
+        m_board->Add( track, ADD_APPEND );
+
+        track->SetStart( wxPoint( rec.m_startX, rec.m_startY ) );
+        track->SetEnd( wxPoint( rec.m_endX, rec.m_endY ) );
+        track->SetWidth( rec.m_width );
+        track->SetTimeStamp( rec.m_timeStamp );
+        track->SetStatus( (STATUS_FLAGS) rec.m_status );
+
+        if( !track->SetNetCode( netCode( rec.m_netCode ), /* aNoAssert */ true ) )
+            THROW_IO_ERROR( wxString::Format( _( "invalid net ID in file '%s'" ),
+                                              GetChars( aIn.GetSource() ) ) );
+    }
+}
+
+
+void KICAD_BINARY_PLUGIN::saveZone( BIN_OUTPUT& aOut, ZONE_CONTAINER* aZone ) const
+{
+    aOut.I32( aZone->GetIsKeepout() ? 0 : m_mapping->Translate( aZone->GetNetCode() ) );
+    aOut.U8( aZone->GetLayer() );
+    aOut.U32( aZone->GetTimeStamp() );
+    aOut.U8( aZone->GetHatchStyle() );
+    aOut.I32( aZone->Outline()->GetHatchPitch() );
+    aOut.U32( aZone->GetPriority() );
+    aOut.I32( aZone->GetPadConnection() );
+    aOut.I32( aZone->GetZoneClearance() );
+    aOut.I32( aZone->GetMinThickness() );
+    aOut.Bool( aZone->GetIsKeepout() );
+    aOut.Bool( aZone->GetDoNotAllowTracks() );
+    aOut.Bool( aZone->GetDoNotAllowVias() );
+    aOut.Bool( aZone->GetDoNotAllowCopperPour() );
+    aOut.Bool( aZone->IsFilled() );
+    aOut.I32( aZone->GetFillMode() );
+    aOut.I32( aZone->GetArcSegmentCount() );
+    aOut.I32( aZone->GetThermalReliefGap() );
+    aOut.I32( aZone->GetThermalReliefCopperBridge() );
+    aOut.I32( aZone->GetCornerSmoothingType() );
+    aOut.U32( aZone->GetCornerRadius() );
+
+    // Outline, one point list per contour.
+    const CPOLYGONS_LIST&   cv = aZone->Outline()->m_CornersList;
+    std::vector<wxPoint>    contour;
+    std::vector< std::vector<wxPoint> > contours;
+
+    for( unsigned ic = 0; ic < cv.GetCornersCount(); ++ic )
+    {
+        contour.push_back( cv.GetPos( ic ) );
+
+        if( cv.IsEndContour( ic ) )
+        {
+            contours.push_back( contour );
+            contour.clear();
+        }
+    }
+
+    aOut.U32( contours.size() );
+
+    for( unsigned ic = 0; ic < contours.size(); ++ic )
+        aOut.Points( contours[ic] );
+
+    // Filled polygons, with their holes if any.
+    const SHAPE_POLY_SET& fill = aZone->GetFilledPolysList();
+
+    aOut.U32( fill.OutlineCount() );
+
+    for( int ip = 0; ip < fill.OutlineCount(); ++ip )
+    {
+        aOut.Points( fill.COutline( ip ) );
+        aOut.U32( fill.HoleCount( ip ) );
+
+        for( int ih = 0; ih < fill.HoleCount( ip ); ++ih )
+            aOut.Points( fill.CHole( ip, ih ) );
+    }
+
+    // Fill segments
+    const std::vector<SEGMENT>& segs = aZone->FillSegments();
+    std::vector<BIN_SEGMENT>    records( segs.size() );
+
+    for( unsigned is = 0; is < segs.size(); ++is )
+    {
+        records[is].m_startX = segs[is].m_Start.x;
+        records[is].m_startY = segs[is].m_Start.y;
+        records[is].m_endX   = segs[is].m_End.x;
+        records[is].m_endY   = segs[is].m_End.y;
+    }
+
+    aOut.U32( records.size() );
+
+    if( records.size() )
+        aOut.Raw( &records[0], records.size() * sizeof( BIN_SEGMENT ) );
+}
+
+
+ZONE_CONTAINER* KICAD_BINARY_PLUGIN::loadZone( BIN_INPUT& aIn )
+{
+    std::unique_ptr<ZONE_CONTAINER> zone( new ZONE_CONTAINER( m_board ) );
+
+    int netcode = netCode( aIn.I32() );
+
+    zone->SetLayer( (LAYER_ID) aIn.U8() );
+    zone->SetTimeStamp( aIn.U32() );
+
+    int hatchStyle = aIn.U8();
+    int hatchPitch = aIn.I32();
+
+    zone->SetPriority( aIn.U32() );
+    zone->SetPadConnection( (ZoneConnection) aIn.I32() );
+    zone->SetZoneClearance( aIn.I32() );
+    zone->SetMinThickness( aIn.I32() );
+    zone->SetIsKeepout( aIn.Bool() );
+    zone->SetDoNotAllowTracks( aIn.Bool() );
+    zone->SetDoNotAllowVias( aIn.Bool() );
+    zone->SetDoNotAllowCopperPour( aIn.Bool() );
+    zone->SetIsFilled( aIn.Bool() );
+    zone->SetFillMode( aIn.I32() );
+    zone->SetArcSegmentCount( aIn.I32() );
+    zone->SetThermalReliefGap( aIn.I32() );
+    zone->SetThermalReliefCopperBridge( aIn.I32() );
+    zone->SetCornerSmoothingType( aIn.I32() );
+    zone->SetCornerRadius( aIn.U32() );
+
+    uint32_t             count = aIn.U32();
+    std::vector<wxPoint> corners;
+
+    for( uint32_t ic = 0; ic < count; ++ic )
+    {
+        aIn.Points( corners );
+        zone->AddPolygon( corners );
+    }
+
+    if( zone->GetNumCorners() > 2 )
+        zone->Outline()->SetHatch( hatchStyle, hatchPitch, true );
+
+    SHAPE_POLY_SET fill;
+
+    count = aIn.U32();
+
+    for( uint32_t ip = 0; ip < count; ++ip )
+    {
+        int outline = fill.NewOutline();
+
+        fill.Outline( outline ) = aIn.Chain();
+        fill.Outline( outline ).SetClosed( true );
+
+        uint32_t holes = aIn.U32();
+
+        for( uint32_t ih = 0; ih < holes; ++ih )
+        {
+            int hole = fill.NewHole( outline );
+            fill.Hole( outline, hole ) = aIn.Chain();
+            fill.Hole( outline, hole ).SetClosed( true );
+        }
+    }
+
+    if( !fill.IsEmpty() )
+        zone->AddFilledPolysList( fill );
+
+    count = aIn.Count( sizeof( BIN_SEGMENT ) );
+
+    if( count )
+    {
+        std::vector<BIN_SEGMENT> records( count );
+        std::vector<SEGMENT>     segs;
+
+        memcpy( &records[0], aIn.Raw( count * sizeof( BIN_SEGMENT ) ),
+                count * sizeof( BIN_SEGMENT ) );
+
+        segs.reserve( count );
+
+        for( const BIN_SEGMENT& rec : records )
+            segs.push_back( SEGMENT( wxPoint( rec.m_startX, rec.m_startY ),
+                                     wxPoint( rec.m_endX, rec.m_endY ) ) );
+
+        zone->AddFillSegments( segs );
+    }
+
+    // Keepout and non copper zones do not have a net.
+    if( !zone->IsOnCopperLayer() || zone->GetIsKeepout() )
+        netcode = NETINFO_LIST::UNCONNECTED;
+
+    if( !zone->SetNetCode( netcode, /* aNoAssert */ true ) )
+        THROW_IO_ERROR( wxString::Format( _( "invalid net ID in file '%s'" ),
+                                          GetChars( aIn.GetSource() ) ) );
+
+    return zone.release();
+}
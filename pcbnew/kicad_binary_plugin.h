@@ -0,0 +1,136 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file kicad_binary_plugin.h
+ * @brief Binary board snapshot file plugin definition file.
+ */
+
+#ifndef KICAD_BINARY_PLUGIN_H_
+#define KICAD_BINARY_PLUGIN_H_
+
+#include <io_mgr.h>
+#include <layers_id_colors_and_visibility.h>
+#include <vector>
+
+
+class BOARD;
+class BOARD_ITEM;
+class MODULE;
+class D_PAD;
+class TRACK;
+class ZONE_CONTAINER;
+class DRAWSEGMENT;
+class EDGE_MODULE;
+class TEXTE_PCB;
+class TEXTE_MODULE;
+class DIMENSION;
+class PCB_TARGET;
+class EDA_TEXT;
+class NETINFO_MAPPING;
+class BIN_OUTPUT;
+class BIN_INPUT;
+
+
+/// Current binary board snapshot format version.  The snapshot layout is tied to the
+/// in memory item model, so any change to a record bumps this number and older
+/// snapshots are refused instead of being misread.
+#define BINARY_BOARD_FILE_VERSION   2
+
+
+/**
+ * Class KICAD_BINARY_PLUGIN
+ * is a PLUGIN derivation for saving and loading compact binary BOARD snapshots.
+ *
+ * The snapshot holds everything the s-expression format holds for a BOARD (settings,
+ * layers, nets, net classes, modules, drawings, tracks, vias and zones including their
+ * fill) but stores coordinates as raw 32 bit integers in length prefixed arrays, so
+ * saving is a handful of buffer appends and loading can bulk copy the large arrays
+ * (tracks, polygon corners, fill segments).  It is intended for autosave, backups and
+ * handing boards to batch tools, not as an interchange format: the byte order is the
+ * host's and a file written on a machine of different endianness is rejected.
+ *
+ * @note This class is not thread safe, but it is re-entrant multiple times in sequence.
+ */
+class KICAD_BINARY_PLUGIN : public PLUGIN
+{
+public:
+
+    //-----<PLUGIN API>---------------------------------------------------------
+
+    const wxString PluginName() const override
+    {
+        return wxT( "KiCad-Binary" );
+    }
+
+    const wxString GetFileExtension() const override
+    {
+        return wxT( "kicad_pcb_bin" );
+    }
+
+    void Save( const wxString& aFileName, BOARD* aBoard,
+               const PROPERTIES* aProperties = NULL ) override;
+
+    BOARD* Load( const wxString& aFileName, BOARD* aAppendToMe,
+                 const PROPERTIES* aProperties = NULL ) override;
+
+    //-----</PLUGIN API>--------------------------------------------------------
+
+    KICAD_BINARY_PLUGIN();
+
+    ~KICAD_BINARY_PLUGIN();
+
+private:
+    BOARD*              m_board;        ///< which BOARD, no ownership here
+    const PROPERTIES*   m_props;        ///< passed via Save() or Load(), no ownership, may be NULL.
+    NETINFO_MAPPING*    m_mapping;      ///< net codes are saved as consecutive integers
+
+    std::vector<int>    m_netCodes;     ///< file net code to BOARD net code, for loads
+
+    void init( const PROPERTIES* aProperties );
+
+    void save( BIN_OUTPUT& aOut, BOARD* aBoard );
+    BOARD* load( BIN_INPUT& aIn, BOARD* aAppendToMe );
+
+    void saveSettings( BIN_OUTPUT& aOut ) const;
+    void saveNets( BIN_OUTPUT& aOut ) const;
+    void saveText( BIN_OUTPUT& aOut, const EDA_TEXT* aText ) const;
+    void saveDrawing( BIN_OUTPUT& aOut, BOARD_ITEM* aItem ) const;
+    void saveModule( BIN_OUTPUT& aOut, MODULE* aModule ) const;
+    void savePad( BIN_OUTPUT& aOut, D_PAD* aPad ) const;
+    void saveTracks( BIN_OUTPUT& aOut ) const;
+    void saveZone( BIN_OUTPUT& aOut, ZONE_CONTAINER* aZone ) const;
+
+    void loadSettings( BIN_INPUT& aIn );
+    void loadNets( BIN_INPUT& aIn );
+    void loadText( BIN_INPUT& aIn, EDA_TEXT* aText );
+    BOARD_ITEM* loadDrawing( BIN_INPUT& aIn );
+    MODULE* loadModule( BIN_INPUT& aIn );
+    D_PAD* loadPad( BIN_INPUT& aIn, MODULE* aParent );
+    void loadTracks( BIN_INPUT& aIn );
+    ZONE_CONTAINER* loadZone( BIN_INPUT& aIn );
+
+    int netCode( int aFileNetCode ) const;
+};
+
+#endif  // KICAD_BINARY_PLUGIN_H_
@@ -243,6 +243,7 @@ void FP_CACHE::Save()
 
             m_owner->SetOutputFormatter( &formatter );
             m_owner->Format( (BOARD_ITEM*) it->second->GetModule() );
+            formatter.Finish();
         }
 
 #ifdef USE_TMP_FILE
@@ -393,6 +394,16 @@ bool FP_CACHE::IsModified( const wxString& aLibPath, const wxString& aFootprintN
 
 
 void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* aProperties )
+{
+    FILE_OUTPUTFORMATTER    formatter( aFileName );
+
+    Save( &formatter, aBoard, aProperties );
+
+    formatter.Finish();
+}
+
+
+void PCB_IO::Save( OUTPUTFORMATTER* aFormatter, BOARD* aBoard, const PROPERTIES* aProperties )
 {
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
@@ -403,12 +414,10 @@ void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* a
     // Prepare net mapping that assures that net codes saved in a file are consecutive integers
     m_mapping->SetBoard( aBoard );
 
-    FILE_OUTPUTFORMATTER    formatter( aFileName );
-
-    m_out = &formatter;     // no ownership
+    m_out = aFormatter;     // no ownership
 
     m_out->Print( 0, "(kicad_pcb (version %d) (host pcbnew %s)\n", SEXPR_BOARD_FILE_VERSION,
-                  formatter.Quotew( GetBuildVersion() ).c_str() );
+                  m_out->Quotew( GetBuildVersion() ).c_str() );
 
     Format( aBoard, 1 );
 
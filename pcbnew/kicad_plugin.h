@@ -133,6 +133,15 @@ public:
 
     ~PCB_IO();
 
+    /**
+     * Function Save
+     * writes a complete board file for \a aBoard to \a aFormatter, as Save() does
+     * to a file.
+     *
+     * @throw IO_ERROR on write error.
+     */
+    void Save( OUTPUTFORMATTER* aFormatter, BOARD* aBoard, const PROPERTIES* aProperties = NULL );
+
     /**
      * Function Format
      * outputs \a aItem to \a aFormatter in s-expression format.
@@ -279,6 +279,65 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+/// Zone fillings drawn as proxies skip the vertices closer than this to the previous one
+static const int ZONE_PROXY_DECIMATION = Millimeter2iu( 0.05 );
+
+
+PAINTER::LOD_LEVEL PCB_PAINTER::GetLOD( const VIEW_ITEM* aItem, int aLayer )
+{
+    const EDA_ITEM* item = static_cast<const EDA_ITEM*>( aItem );
+
+    if( !m_pcbSettings.IsLODEnabled() )
+        return LOD_FULL;
+
+    switch( item->Type() )
+    {
+    case PCB_TEXT_T:
+    case PCB_MODULE_TEXT_T:
+        return lodBySize( aItem->ViewBBox(), true, false );
+
+    case PCB_PAD_T:
+    case PCB_VIA_T:
+        // Net names have their own level of detail, see ViewGetLOD()
+        if( IsNetnameLayer( aLayer ) )
+            return LOD_FULL;
+
+        // Holes are even smaller than the pad or via they belong to
+        if( aLayer == ITEM_GAL_LAYER( PADS_HOLES_VISIBLE )
+                || aLayer == ITEM_GAL_LAYER( VIAS_HOLES_VISIBLE ) )
+        {
+            if( lodBySize( aItem->ViewBBox(), false, true ) != LOD_FULL )
+                return LOD_HIDDEN;
+
+            return LOD_FULL;
+        }
+
+        return lodBySize( aItem->ViewBBox(), false, true );
+
+    case PCB_ZONE_AREA_T:
+        // Zones are large, but their filling has many vertices closer than a pixel
+        if( ZONE_PROXY_DECIMATION * m_gal->GetWorldScale() < 0.5 )
+            return LOD_PROXY;
+
+        return LOD_FULL;
+
+    default:
+        return LOD_FULL;
+    }
+}
+
+
+void PCB_PAINTER::DrawProxy( const VIEW_ITEM* aItem, int aLayer )
+{
+    const EDA_ITEM* item = static_cast<const EDA_ITEM*>( aItem );
+
+    if( item->Type() == PCB_ZONE_AREA_T )
+        draw( static_cast<const ZONE_CONTAINER*>( item ), ZONE_PROXY_DECIMATION );
+    else
+        PAINTER::DrawProxy( aItem, aLayer );
+}
+
+
 void PCB_PAINTER::draw( const TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
@@ -881,7 +940,7 @@ void PCB_PAINTER::draw( const MODULE* aModule, int aLayer )
 }
 
 
-void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone )
+void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aDecimation )
 {
     const COLOR4D& color = m_pcbSettings.GetColor( aZone, aZone->GetLayer() );
     std::deque<VECTOR2D> corners;
@@ -937,7 +996,16 @@ void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone )
 			// is just a performance hog)
 
             for( int j = 0; j < outline.PointCount(); j++ )
-                corners.push_back ( (VECTOR2D) outline.CPoint( j ) );
+            {
+                const VECTOR2I& point = outline.CPoint( j );
+
+                // Proxies skip the vertices too close to the last one kept
+                if( aDecimation > 0 && j > 0
+                        && ( point - VECTOR2I( corners.back() ) ).EuclideanNorm() < aDecimation )
+                    continue;
+
+                corners.push_back( (VECTOR2D) point );
+            }
 
             corners.push_back( (VECTOR2D) outline.CPoint( 0 ) );
 
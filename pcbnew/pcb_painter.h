@@ -199,6 +199,18 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::Clone()
+    virtual PCB_PAINTER* Clone() const override
+    {
+        return new PCB_PAINTER( *this );
+    }
+
+    /// @copydoc PAINTER::GetLOD()
+    virtual LOD_LEVEL GetLOD( const VIEW_ITEM* aItem, int aLayer ) override;
+
+    /// @copydoc PAINTER::DrawProxy()
+    virtual void DrawProxy( const VIEW_ITEM* aItem, int aLayer ) override;
+
 protected:
     PCB_RENDER_SETTINGS m_pcbSettings;
 
@@ -210,7 +222,7 @@ protected:
     void draw( const TEXTE_PCB* aText, int aLayer );
     void draw( const TEXTE_MODULE* aText, int aLayer );
     void draw( const MODULE* aModule, int aLayer );
-    void draw( const ZONE_CONTAINER* aZone );
+    void draw( const ZONE_CONTAINER* aZone, int aDecimation = 0 );
     void draw( const DIMENSION* aDimension, int aLayer );
     void draw( const PCB_TARGET* aTarget );
     void draw( const MARKER_PCB* aMarker );
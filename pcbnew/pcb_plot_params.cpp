@@ -82,6 +82,7 @@ PCB_PLOT_PARAMS::PCB_PLOT_PARAMS()
     m_useGerberProtelExtensions  = false;
     m_useGerberAttributes        = false;
     m_includeGerberNetlistInfo   = false;
+    m_useGerberApertureMacros    = false;
     m_gerberPrecision            = gbrDefaultPrecision;
     m_excludeEdgeLayer           = true;
     m_lineWidth                  = g_DrawDefaultLineThickness;
@@ -156,6 +157,9 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter,
             aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_usegerberadvancedattributes ), trueStr );
     }
 
+    if( m_useGerberApertureMacros ) // save this option only if active
+        aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_usegerberaperturemacros ), trueStr );
+
     if( m_gerberPrecision != gbrDefaultPrecision ) // save this option only if it is not the default value,
                                                    // to avoid incompatibility with older Pcbnew version
         aFormatter->Print( aNestLevel+1, "(%s %d)\n",
@@ -230,6 +234,8 @@ bool PCB_PLOT_PARAMS::operator==( const PCB_PLOT_PARAMS &aPcbPlotParams ) const
         return false;
     if( m_useGerberAttributes && m_includeGerberNetlistInfo != aPcbPlotParams.m_includeGerberNetlistInfo )
         return false;
+    if( m_useGerberApertureMacros != aPcbPlotParams.m_useGerberApertureMacros )
+        return false;
     if( m_gerberPrecision != aPcbPlotParams.m_gerberPrecision )
         return false;
     if( m_excludeEdgeLayer != aPcbPlotParams.m_excludeEdgeLayer )
@@ -396,6 +402,10 @@ void PCB_PLOT_PARAMS_PARSER::Parse( PCB_PLOT_PARAMS* aPcbPlotParams )
             aPcbPlotParams->m_includeGerberNetlistInfo = parseBool();
             break;
 
+        case T_usegerberaperturemacros:
+            aPcbPlotParams->m_useGerberApertureMacros = parseBool();
+            break;
+
         case T_gerberprecision:
             aPcbPlotParams->m_gerberPrecision =
                 parseInt( gbrDefaultPrecision-1, gbrDefaultPrecision);
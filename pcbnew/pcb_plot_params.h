@@ -100,6 +100,9 @@ private:
     /// Include netlist info (only in Gerber X2 format) (chapter ? in revision ?)
     bool        m_includeGerberNetlistInfo;
 
+    /// Flash polygonal pads as aperture macros instead of plotting them as regions
+    bool        m_useGerberApertureMacros;
+
     /// precision of coordinates in Gerber files: accepted 5 or 6
     /// when units are in mm (6 or 7 in inches, but Pcbnew uses mm).
     /// 6 is the internal resolution of Pcbnew, but not alwys accepted by board maker
@@ -237,6 +240,9 @@ public:
     void        SetIncludeGerberNetlistInfo( bool aUse ) { m_includeGerberNetlistInfo = aUse; }
     bool        GetIncludeGerberNetlistInfo() const { return m_includeGerberNetlistInfo; }
 
+    void        SetUseGerberApertureMacros( bool aUse ) { m_useGerberApertureMacros = aUse; }
+    bool        GetUseGerberApertureMacros() const { return m_useGerberApertureMacros; }
+
     void        SetUseGerberProtelExtensions( bool aUse ) { m_useGerberProtelExtensions = aUse; }
     bool        GetUseGerberProtelExtensions() const { return m_useGerberProtelExtensions; }
 
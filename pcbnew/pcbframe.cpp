@@ -71,6 +71,7 @@
 #include <tools/common_actions.h>
 
 #include <wildcards_and_files_ext.h>
+#include <background_saver.h>
 
 #if defined(KICAD_SCRIPTING) || defined(KICAD_SCRIPTING_WXPYTHON)
 #include <python_scripting.h>
@@ -332,6 +333,10 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
     m_hasAutoSave = true;
     m_microWaveToolBar = NULL;
 
+    m_backgroundSaver = new BACKGROUND_SAVER( this );
+    m_modifyCount = 0;
+    Bind( EVT_BACKGROUND_SAVE_DONE, &PCB_EDIT_FRAME::onBackgroundSaveDone, this );
+
     m_rotationAngle = 900;
 
     // Create GAL canvas
@@ -491,6 +496,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
 PCB_EDIT_FRAME::~PCB_EDIT_FRAME()
 {
+    delete m_backgroundSaver;
     delete m_drc;
 }
 
@@ -599,6 +605,9 @@ void PCB_EDIT_FRAME::OnCloseWindow( wxCloseEvent& Event )
 {
     m_canvas->SetAbortRequest( true );
 
+    // A save still being written clears the modified flag once it is done.
+    WaitForBackgroundSave();
+
     if( GetScreen()->IsModify() )
     {
         wxString msg = wxString::Format( _(
@@ -626,6 +635,9 @@ void PCB_EDIT_FRAME::OnCloseWindow( wxCloseEvent& Event )
         }
     }
 
+    // The board must be on disk before its auto save file goes away.
+    WaitForBackgroundSave();
+
     GetGalCanvas()->StopDrawing();
 
     // Delete the auto save file if it exists.
@@ -972,6 +984,8 @@ void PCB_EDIT_FRAME::OnModify( )
 {
     PCB_BASE_FRAME::OnModify();
 
+    m_modifyCount++;
+
     EDA_3D_VIEWER* draw3DFrame = Get3DViewerFrame();
 
     if( draw3DFrame )
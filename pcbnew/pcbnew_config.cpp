@@ -130,6 +130,7 @@ void PCB_EDIT_FRAME::Process_Config( wxCommandEvent& event )
                     FILE_OUTPUTFORMATTER sf( FP_LIB_TABLE::GetGlobalTableFileName() );
 
                     GFootprintTable.Format( &sf, 0 );
+                    sf.Finish();
                     tableChanged = true;
                 }
                 catch( const IO_ERROR& ioe )
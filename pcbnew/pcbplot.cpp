@@ -43,6 +43,11 @@
 #include <dialog_plot.h>
 #include <macros.h>
 #include <build_version.h>
+#include <profile.h>
+#include <exporters/gendrill_Excellon_writer.h>
+
+#include <atomic>
+#include <thread>
 
 
 const wxString GetGerberProtelExtension( LAYER_NUM aLayer )
@@ -402,16 +407,19 @@ PLOT_CONTROLLER::~PLOT_CONTROLLER()
  * C/POSIX using a LOCALE_IO object on the stack. This even when
  * opening/closing the plotfile, since some drivers do I/O even then */
 
-void PLOT_CONTROLLER::ClosePlot()
+bool PLOT_CONTROLLER::ClosePlot()
 {
     LOCALE_IO toggle;
+    bool success = true;
 
     if( m_plotter )
     {
-        m_plotter->EndPlot();
+        success = m_plotter->EndPlot();
         delete m_plotter;
         m_plotter = NULL;
     }
+
+    return success;
 }
 
 
@@ -459,6 +467,126 @@ bool PLOT_CONTROLLER::OpenPlotfile( const wxString &aSuffix,
 }
 
 
+/* Plot a layer of a job in its own plotter, from a worker thread. The plot options are
+ * copied, as StartPlotBoard may change them */
+static void plotJobLayer( BOARD* aBoard, PCB_PLOT_PARAMS aPlotOpts, LAYER_ID aLayer,
+                          const EDA_RECT& aBoardBox, const PLOT_ITEM_INDEX* aItemIndex,
+                          PLOT_JOB_FILE& aFile )
+{
+    prof_counter timer;
+    prof_start( &timer );
+
+    PLOTTER* plotter = StartPlotBoard( aBoard, &aPlotOpts, aLayer, aFile.m_FileName,
+                                       wxEmptyString, &aBoardBox );
+
+    aFile.m_Success = false;
+
+    if( plotter )
+    {
+        PlotOneBoardLayer( aBoard, plotter, aLayer, aPlotOpts, aItemIndex );
+        aFile.m_Success = plotter->EndPlot();
+        delete plotter;
+    }
+
+    prof_end( &timer );
+
+    aFile.m_Time = timer.msecs();
+}
+
+
+bool PLOT_CONTROLLER::PlotLayers( const std::vector<int>& aLayers, PlotFormat aFormat,
+                                  EXCELLON_WRITER* aDrillWriter )
+{
+    // The worker threads do not change the locale, this one is kept for all of them
+    LOCALE_IO toggle;
+
+    GetPlotOptions().SetFormat( aFormat );
+    ClosePlot();
+    m_jobFiles.clear();
+
+    wxString outputDirName = GetPlotOptions().GetOutputDirectory() ;
+    wxFileName outputDir = wxFileName::DirName( outputDirName );
+    wxString boardFilename = m_board->GetFileName();
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+        return false;
+
+    m_jobFiles.resize( aLayers.size() + ( aDrillWriter ? 1 : 0 ) );
+
+    // Filenames are built beforehand, the threads only need the board and the options
+    for( unsigned ii = 0; ii < aLayers.size(); ii++ )
+    {
+        LAYER_ID layer = ToLAYER_ID( aLayers[ii] );
+        wxFileName fn( boardFilename );
+        wxString fileExt = GetDefaultPlotExtension( aFormat );
+
+        if( aFormat == PLOT_FORMAT_GERBER && GetPlotOptions().GetUseGerberProtelExtensions() )
+            fileExt = GetGerberProtelExtension( layer );
+
+        BuildPlotFileName( &fn, outputDir.GetPath(), m_board->GetLayerName( layer ), fileExt );
+        m_jobFiles[ii].m_FileName = fn.GetFullPath();
+    }
+
+    // The board is scanned once for all layers, and its bounding box is computed here
+    // because ComputeBoundingBox() stores it in the board
+    PLOT_ITEM_INDEX itemIndex( m_board );
+    EDA_RECT boardBox = m_board->ComputeBoundingBox();
+    std::atomic<unsigned> nextLayer( 0 );
+
+    auto plotLayers = [&]()
+    {
+        for( unsigned ii = nextLayer++; ii < aLayers.size(); ii = nextLayer++ )
+        {
+            plotJobLayer( m_board, GetPlotOptions(), ToLAYER_ID( aLayers[ii] ), boardBox,
+                          &itemIndex, m_jobFiles[ii] );
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    if( aDrillWriter )
+    {
+        PLOT_JOB_FILE& drillFiles = m_jobFiles.back();
+        drillFiles.m_FileName = outputDir.GetPath();
+
+        workers.push_back( std::thread( [&]()
+        {
+            prof_counter timer;
+            prof_start( &timer );
+
+            drillFiles.m_Success = aDrillWriter->CreateDrillandMapFilesSet(
+                    drillFiles.m_FileName, true, false );
+
+            prof_end( &timer );
+            drillFiles.m_Time = timer.msecs();
+        } ) );
+    }
+
+    // This thread plots too
+    unsigned threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+
+    for( unsigned ii = 1; ii < threadCount && ii < aLayers.size(); ii++ )
+        workers.push_back( std::thread( plotLayers ) );
+
+    plotLayers();
+
+    for( std::thread& worker : workers )
+        worker.join();
+
+    bool success = true;
+
+    for( const PLOT_JOB_FILE& file : m_jobFiles )
+    {
+        wxLogTrace( wxT( "PLOT_JOB" ), wxT( "%s: %.1f ms%s" ), GetChars( file.m_FileName ),
+                    file.m_Time, file.m_Success ? "" : " (failed)" );
+
+        success &= file.m_Success;
+    }
+
+    return success;
+}
+
+
 bool PLOT_CONTROLLER::PlotLayer()
 {
     LOCALE_IO toggle;
@@ -29,6 +29,9 @@
 #ifndef PCBPLOT_H_
 #define PCBPLOT_H_
 
+#include <memory>
+#include <vector>
+
 #include <wx/filename.h>
 #include <pad_shapes.h>
 #include <pcb_plot_params.h>
@@ -44,7 +47,10 @@ class PCB_TARGET;
 class TEXTE_MODULE;
 class ZONE_CONTAINER;
 class BOARD;
+class BOARD_ITEM;
+class VIA;
 class REPORTER;
+class EDA_RECT;
 
 ///@{
 /// \ingroup config
@@ -72,6 +78,53 @@ class REPORTER;
 #define SMALL_DRILL KiROUND( 0.35 * IU_PER_MM )
 
 
+/**
+ * Class PLOT_ITEM_INDEX
+ * sorts the board items lying on a single layer by layer, so plotting a layer visits
+ * only its own items instead of the whole board.
+ * It is built once for all the layers of a plot job and is not modified afterwards, so
+ * several layers may be plotted from it at the same time.
+ */
+class PLOT_ITEM_INDEX
+{
+public:
+    enum ITEM_KIND
+    {
+        BOARD_GRAPHICS,     ///< board drawings, texts, dimensions and targets
+        MODULE_EDGES,       ///< footprint outlines
+        TRACKS,             ///< track segments, vias excluded
+        ZONE_SEGMENTS,      ///< segments filling the zones of old boards
+        ZONES,              ///< filled zones
+        ITEM_KIND_COUNT
+    };
+
+    PLOT_ITEM_INDEX( BOARD* aBoard );
+
+    /**
+     * Function GetItems
+     * @return the items of a kind lying on one of the layers of aLayerMask, in the order
+     * they have on the board
+     */
+    std::vector<BOARD_ITEM*> GetItems( ITEM_KIND aKind, LSET aLayerMask ) const;
+
+    /**
+     * Function GetVias
+     * @return all the vias of the board, which span several layers
+     */
+    const std::vector<VIA*>& GetVias() const { return m_vias; }
+
+private:
+    void add( ITEM_KIND aKind, BOARD_ITEM* aItem );
+
+    /// An item and its rank in the board lists, to restore the board order
+    typedef std::pair<unsigned, BOARD_ITEM*> ENTRY;
+
+    std::vector<ENTRY> m_items[ITEM_KIND_COUNT][LAYER_ID_COUNT];
+    std::vector<VIA*>  m_vias;
+    unsigned           m_count;
+};
+
+
 // A helper class to plot board items
 class BRDITEMS_PLOTTER : public PCB_PLOT_PARAMS
 {
@@ -79,14 +132,35 @@ class BRDITEMS_PLOTTER : public PCB_PLOT_PARAMS
     BOARD*      m_board;
     LSET        m_layerMask;
 
+    /// The index of board items given by the caller, or NULL
+    const PLOT_ITEM_INDEX*           m_itemIndex;
+
+    /// The index built when the caller gives none
+    std::unique_ptr<PLOT_ITEM_INDEX> m_ownItemIndex;
+
 public:
     BRDITEMS_PLOTTER( PLOTTER* aPlotter, BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts ) :
         PCB_PLOT_PARAMS( aPlotOpts )
     {
         m_plotter = aPlotter;
         m_board = aBoard;
+        m_itemIndex = NULL;
     }
 
+    /**
+     * Function SetItemIndex
+     * sets the index of board items to plot from, shared by the layers of a plot job.
+     * It must be kept until this plotter is deleted. Without it, an index is built when
+     * needed.
+     */
+    void SetItemIndex( const PLOT_ITEM_INDEX* aItemIndex ) { m_itemIndex = aItemIndex; }
+
+    /**
+     * Function GetItemIndex
+     * @return the index of board items to plot from
+     */
+    const PLOT_ITEM_INDEX& GetItemIndex();
+
     /**
      * @return a 'width adjustment' for the postscript engine
      * (useful for controlling toner bleeding during direct transfer)
@@ -164,11 +238,20 @@ private:
 
 };
 
+/**
+ * Function StartPlotBoard
+ * opens a new plot file and prepares the page for plotting.
+ * @param aBoardBox is the bounding box of the board, or NULL to compute it.  It must be
+ *                  given when plotters are started from several threads, as
+ *                  BOARD::ComputeBoundingBox() stores its result in the board.
+ * @return the plotter, or NULL if the file cannot be created.
+ */
 PLOTTER* StartPlotBoard( BOARD* aBoard,
                          PCB_PLOT_PARAMS* aPlotOpts,
                          int aLayer,
                          const wxString& aFullFileName,
-                         const wxString& aSheetDesc );
+                         const wxString& aSheetDesc,
+                         const EDA_RECT* aBoardBox = NULL );
 
 /**
  * Function PlotOneBoardLayer
@@ -179,9 +262,12 @@ PLOTTER* StartPlotBoard( BOARD* aBoard,
  * @param aPlotter = the plotter to use
  * @param aLayer = the layer id to plot
  * @param aPlotOpt = the plot options (files, sketch). Has meaning for some formats only
+ * @param aItemIndex = the index of board items, when several layers are plotted from the
+ * same board. If NULL, the board items are indexed for this layer only
  */
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
-                        const PCB_PLOT_PARAMS& aPlotOpt );
+                        const PCB_PLOT_PARAMS& aPlotOpt,
+                        const PLOT_ITEM_INDEX* aItemIndex = NULL );
 
 /**
  * Function PlotStandardLayer
@@ -203,9 +289,11 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
  *                  have the same size. Used in GERBER format only.
  *      SetDrillMarksType( DrillMarksType aVal ) controle the actual hole:
  *              no hole, small hole, actual hole
+ * @param aItemIndex = the index of board items, or NULL to build one
  */
 void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
-                        const PCB_PLOT_PARAMS& aPlotOpt );
+                        const PCB_PLOT_PARAMS& aPlotOpt,
+                        const PLOT_ITEM_INDEX* aItemIndex = NULL );
 
 /**
  * Function PlotLayerOutlines
@@ -226,9 +314,11 @@ void PlotLayerOutlines( BOARD *aBoard, PLOTTER* aPlotter,
  * @param aPlotter = the plotter to use
  * @param aLayerMask = the mask to define the layers to plot (silkscreen Front and/or Back)
  * @param aPlotOpt = the plot options (files, sketch). Has meaning for some formats only
+ * @param aItemIndex = the index of board items, or NULL to build one
  */
 void PlotSilkScreen( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
-                     const PCB_PLOT_PARAMS&  aPlotOpt );
+                     const PCB_PLOT_PARAMS&  aPlotOpt,
+                     const PLOT_ITEM_INDEX* aItemIndex = NULL );
 
 
 /**
@@ -66,10 +66,11 @@ static void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
  * (with option to remove them from some copper areas (pads...)
  */
 void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
-                     const PCB_PLOT_PARAMS& aPlotOpt )
+                     const PCB_PLOT_PARAMS& aPlotOpt, const PLOT_ITEM_INDEX* aItemIndex )
 {
     BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
     itemplotter.SetLayerSet( aLayerMask );
+    itemplotter.SetItemIndex( aItemIndex );
 
     // Plot edge layer and graphic items
     itemplotter.PlotBoardGraphicItems();
@@ -123,27 +124,21 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         }
     }
 
+    const PLOT_ITEM_INDEX& itemIndex = itemplotter.GetItemIndex();
+
     // Plot filled areas
     aPlotter->StartBlock( NULL );
 
-    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
-    {
-        ZONE_CONTAINER* edge_zone = aBoard->GetArea( ii );
-
-        if( !aLayerMask[ edge_zone->GetLayer() ] )
-            continue;
-
-        itemplotter.PlotFilledAreas( edge_zone );
-    }
+    for( BOARD_ITEM* item : itemIndex.GetItems( PLOT_ITEM_INDEX::ZONES, aLayerMask ) )
+        itemplotter.PlotFilledAreas( static_cast<ZONE_CONTAINER*>( item ) );
 
     aPlotter->EndBlock( NULL );
 
     // Plot segments used to fill zone areas (outdated, but here for old boards
     // compatibility):
-    for( SEGZONE* seg = aBoard->m_Zone; seg; seg = seg->Next() )
+    for( BOARD_ITEM* item : itemIndex.GetItems( PLOT_ITEM_INDEX::ZONE_SEGMENTS, aLayerMask ) )
     {
-        if( !aLayerMask[ seg->GetLayer() ] )
-            continue;
+        SEGZONE* seg = static_cast<SEGZONE*>( item );
 
         aPlotter->ThickSegment( seg->GetStart(), seg->GetEnd(), seg->GetWidth(),
                                 itemplotter.GetPlotMode(), NULL );
@@ -151,7 +146,7 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 }
 
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
-                        const PCB_PLOT_PARAMS& aPlotOpt )
+                        const PCB_PLOT_PARAMS& aPlotOpt, const PLOT_ITEM_INDEX* aItemIndex )
 {
     PCB_PLOT_PARAMS plotOpt = aPlotOpt;
     int soldermask_min_thickness = aBoard->GetDesignSettings().m_SolderMaskMinWidth;
@@ -180,7 +175,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
         else
         {
             plotOpt.SetSkipPlotNPTH_Pads( true );
-            PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
+            PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
         }
     }
     else
@@ -199,7 +194,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
                 if( plotOpt.GetFormat() == PLOT_FORMAT_DXF )
                     PlotLayerOutlines( aBoard, aPlotter, layer_mask, plotOpt );
                 else
-                    PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
+                    PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
             }
             else
                 PlotSolderMaskLayer( aBoard, aPlotter, layer_mask, plotOpt,
@@ -218,7 +213,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
             if( plotOpt.GetFormat() == PLOT_FORMAT_DXF )
                 PlotLayerOutlines( aBoard, aPlotter, layer_mask, plotOpt );
             else
-                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
+                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
             break;
 
         case F_SilkS:
@@ -226,7 +221,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
             if( plotOpt.GetFormat() == PLOT_FORMAT_DXF )
                 PlotLayerOutlines( aBoard, aPlotter, layer_mask, plotOpt );
             else
-                PlotSilkScreen( aBoard, aPlotter, layer_mask, plotOpt );
+                PlotSilkScreen( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
 
             // Gerber: Subtract soldermask from silkscreen if enabled
             if( aPlotter->GetPlotterType() == PLOT_FORMAT_GERBER
@@ -244,7 +239,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
                 plotOpt.SetDrillMarksType( PCB_PLOT_PARAMS::NO_DRILL_SHAPE );
 
                 // Plot the mask
-                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
+                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
             }
             break;
 
@@ -267,7 +262,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
             if( plotOpt.GetFormat() == PLOT_FORMAT_DXF )
                 PlotLayerOutlines( aBoard, aPlotter, layer_mask, plotOpt );
             else
-                PlotSilkScreen( aBoard, aPlotter, layer_mask, plotOpt );
+                PlotSilkScreen( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
             break;
 
         default:
@@ -277,7 +272,7 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
             if( plotOpt.GetFormat() == PLOT_FORMAT_DXF )
                 PlotLayerOutlines( aBoard, aPlotter, layer_mask, plotOpt );
             else
-                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt );
+                PlotStandardLayer( aBoard, aPlotter, layer_mask, plotOpt, aItemIndex );
             break;
         }
     }
@@ -288,11 +283,15 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, LAYER_ID aLayer,
  * Silk screen layers are not plotted here.
  */
 void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
-                        LSET aLayerMask, const PCB_PLOT_PARAMS& aPlotOpt )
+                        LSET aLayerMask, const PCB_PLOT_PARAMS& aPlotOpt,
+                        const PLOT_ITEM_INDEX* aItemIndex )
 {
     BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
 
     itemplotter.SetLayerSet( aLayerMask );
+    itemplotter.SetItemIndex( aItemIndex );
+
+    const PLOT_ITEM_INDEX& itemIndex = itemplotter.GetItemIndex();
 
     EDA_DRAW_MODE_T plotMode = aPlotOpt.GetPlotMode();
 
@@ -312,24 +311,8 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
         }
     }
 
-    for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
-    {
-        for( BOARD_ITEM* item = module->GraphicalItems(); item; item = item->Next() )
-        {
-            if( !aLayerMask[ item->GetLayer() ] )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_MODULE_EDGE_T:
-                itemplotter.Plot_1_EdgeModule( (EDGE_MODULE*) item );
-                break;
-
-            default:
-                break;
-            }
-        }
-    }
+    for( BOARD_ITEM* item : itemIndex.GetItems( PLOT_ITEM_INDEX::MODULE_EDGES, aLayerMask ) )
+        itemplotter.Plot_1_EdgeModule( (EDGE_MODULE*) item );
 
     // Plot footprint pads
     for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
@@ -366,7 +349,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             wxSize extraSize = margin * 2;
             extraSize.x += width_adj;
             extraSize.y += width_adj;
-            wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
+
+            // The pad is resized on a copy, as other layers may be plotted at the same time
+            D_PAD plotPad( *pad );
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -399,7 +384,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 else
                     delta.y = coord[1].x - coord[0].x;
 
-                pad->SetDelta( delta );
+                plotPad.SetDelta( delta );
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -416,17 +401,16 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = ColorFromInt( color | aBoard->GetVisibleElementColor( PAD_FR_VISIBLE ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
-            pad->SetSize( padPlotsSize );
+            // Set the pad size to the required plot size:
+            plotPad.SetSize( padPlotsSize );
 
-            switch( pad->GetShape() )
+            switch( plotPad.GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
-                    (pad->GetSize() == pad->GetDrillSize()) &&
-                    (pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED) )
+                    (plotPad.GetSize() == plotPad.GetDrillSize()) &&
+                    (plotPad.GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED) )
                     break;
 
                 // Fall through:
@@ -434,12 +418,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             case PAD_SHAPE_RECT:
             case PAD_SHAPE_ROUNDRECT:
             default:
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( &plotPad, color, plotMode );
                 break;
             }
-
-            pad->SetSize( tmppadsize );     // Restore the pad size
-            pad->SetDelta( deltaSize );
         }
 
         aPlotter->EndBlock( NULL );
@@ -460,13 +441,8 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
 
     aPlotter->StartBlock( NULL );
 
-    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    for( const VIA* Via : itemIndex.GetVias() )
     {
-        const VIA* Via = dyn_cast<const VIA*>( track );
-
-        if( !Via )
-            continue;
-
         // vias are not plotted if not on selected layer, but if layer
         // is SOLDERMASK_LAYER_BACK or SOLDERMASK_LAYER_FRONT,vias are drawn,
         // only if they are on the corresponding external copper layer
@@ -519,13 +495,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
     gbr_metadata.SetApertureAttrib( GBR_APERTURE_METADATA::GBR_APERTURE_ATTRIB_CONDUCTOR );
 
     // Plot tracks (not vias) :
-    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    for( BOARD_ITEM* item : itemIndex.GetItems( PLOT_ITEM_INDEX::TRACKS, aLayerMask ) )
     {
-        if( track->Type() == PCB_VIA_T )
-            continue;
-
-        if( !aLayerMask[track->GetLayer()] )
-            continue;
+        TRACK* track = static_cast<TRACK*>( item );
 
         // Some track segments can be not connected (no net).
         // Set the m_NotInNet for these segments to force a empty net name in gerber file
@@ -540,10 +512,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
     aPlotter->EndBlock( NULL );
 
     // Plot zones (outdated, for old boards compatibility):
-    for( TRACK* track = aBoard->m_Zone; track; track = track->Next() )
+    for( BOARD_ITEM* item : itemIndex.GetItems( PLOT_ITEM_INDEX::ZONE_SEGMENTS, aLayerMask ) )
     {
-        if( !aLayerMask[track->GetLayer()] )
-            continue;
+        TRACK* track = static_cast<TRACK*>( item );
 
         int width = track->GetWidth() + itemplotter.getFineWidthAdj();
         aPlotter->SetColor( itemplotter.getColor( track->GetLayer() ) );
@@ -552,15 +523,10 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
 
     // Plot filled ares
     aPlotter->StartBlock( NULL );
-    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
-    {
-        ZONE_CONTAINER* zone = aBoard->GetArea( ii );
 
-        if( !aLayerMask[zone->GetLayer()] )
-            continue;
+    for( BOARD_ITEM* item : itemIndex.GetItems( PLOT_ITEM_INDEX::ZONES, aLayerMask ) )
+        itemplotter.PlotFilledAreas( static_cast<ZONE_CONTAINER*>( item ) );
 
-        itemplotter.PlotFilledAreas( zone );
-    }
     aPlotter->EndBlock( NULL );
 
     // Adding drill marks, if required and if the plotter is able to plot them:
@@ -882,7 +848,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter,
  *      paper size is the physical page size
  */
 static void initializePlotter( PLOTTER *aPlotter, BOARD * aBoard,
-                               PCB_PLOT_PARAMS *aPlotOpts )
+                               PCB_PLOT_PARAMS *aPlotOpts, const EDA_RECT& aBoardBox )
 {
     PAGE_INFO pageA4( wxT( "A4" ) );
     const PAGE_INFO& pageInfo = aBoard->GetPageSettings();
@@ -916,9 +882,8 @@ static void initializePlotter( PLOTTER *aPlotter, BOARD * aBoard,
         autocenter  = (aPlotOpts->GetScale() != 1.0);
     }
 
-    EDA_RECT bbox = aBoard->ComputeBoundingBox();
-    wxPoint boardCenter = bbox.Centre();
-    wxSize boardSize = bbox.GetSize();
+    wxPoint boardCenter = aBoardBox.Centre();
+    wxSize boardSize = aBoardBox.GetSize();
 
     double compound_scale;
 
@@ -1000,11 +965,13 @@ static void ConfigureHPGLPenSizes( HPGL_PLOTTER *aPlotter,
  * specified in the options and prepare the page for plotting.
  * Return the plotter object if OK, NULL if the file is not created
  * (or has a problem)
+ * aBoardBox is the bounding box of the board, computed here if NULL
  */
 PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts,
                          int aLayer,
                          const wxString& aFullFileName,
-                         const wxString& aSheetDesc )
+                         const wxString& aSheetDesc,
+                         const EDA_RECT* aBoardBox )
 {
     // Create the plotter driver and set the few plotter specific
     // options
@@ -1060,7 +1027,9 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts,
     if( plotOpts.GetPlotFrameRef() && plotOpts.GetMirror() )
         plotOpts.SetMirror( false );
 
-    initializePlotter( plotter, aBoard, &plotOpts );
+    EDA_RECT boardBox = aBoardBox ? *aBoardBox : aBoard->ComputeBoundingBox();
+
+    initializePlotter( plotter, aBoard, &plotOpts, boardBox );
 
     if( plotter->OpenFile( aFullFileName ) )
     {
@@ -1071,6 +1040,9 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts,
         {
             bool useX2mode = plotOpts.GetUseGerberAttributes();
 
+            static_cast<GERBER_PLOTTER*>( plotter )->UseApertureMacros(
+                    plotOpts.GetUseGerberApertureMacros() );
+
             if( useX2mode )
             {
                 AddGerberX2Attribute( plotter, aBoard, aLayer, false );
@@ -1095,7 +1067,7 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts,
                            aSheetDesc, aBoard->GetFileName() );
 
             if( aPlotOpts->GetMirror() )
-                initializePlotter( plotter, aBoard, aPlotOpts );
+                initializePlotter( plotter, aBoard, aPlotOpts, boardBox );
         }
 
         /* When plotting a negative board: draw a black rectangle
@@ -1103,10 +1075,7 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts,
          * color to WHITE; note the color inversion is actually done
          * in the driver (if supported) */
         if( aPlotOpts->GetNegative() )
-        {
-            EDA_RECT bbox = aBoard->ComputeBoundingBox();
-            FillNegativeKnockout( plotter, bbox );
-        }
+            FillNegativeKnockout( plotter, boardBox );
 
         return plotter;
     }
@@ -50,10 +50,95 @@
 #include <pcbplot.h>
 #include <plot_auxiliary_data.h>
 
+#include <algorithm>
+
+
+PLOT_ITEM_INDEX::PLOT_ITEM_INDEX( BOARD* aBoard ) :
+    m_count( 0 )
+{
+    for( BOARD_ITEM* item = aBoard->m_Drawings; item; item = item->Next() )
+        add( BOARD_GRAPHICS, item );
+
+    for( MODULE* module = aBoard->m_Modules;  module;  module = module->Next() )
+    {
+        for( BOARD_ITEM* item = module->GraphicalItems().GetFirst(); item; item = item->Next() )
+        {
+            if( item->Type() == PCB_MODULE_EDGE_T )
+                add( MODULE_EDGES, item );
+        }
+    }
+
+    for( TRACK* track = aBoard->m_Track; track; track = track->Next() )
+    {
+        if( track->Type() == PCB_VIA_T )
+            m_vias.push_back( static_cast<VIA*>( track ) );
+        else
+            add( TRACKS, track );
+    }
+
+    for( SEGZONE* seg = aBoard->m_Zone; seg; seg = seg->Next() )
+        add( ZONE_SEGMENTS, seg );
+
+    for( int ii = 0; ii < aBoard->GetAreaCount(); ii++ )
+        add( ZONES, aBoard->GetArea( ii ) );
+}
+
+
+void PLOT_ITEM_INDEX::add( ITEM_KIND aKind, BOARD_ITEM* aItem )
+{
+    LAYER_ID layer = aItem->GetLayer();
+
+    // Items on no valid layer are never plotted
+    if( layer < 0 || layer >= LAYER_ID_COUNT )
+        return;
+
+    m_items[aKind][layer].push_back( ENTRY( m_count++, aItem ) );
+}
+
+
+std::vector<BOARD_ITEM*> PLOT_ITEM_INDEX::GetItems( ITEM_KIND aKind, LSET aLayerMask ) const
+{
+    std::vector<ENTRY> entries;
+    int layerCount = 0;
+
+    for( LSEQ seq = aLayerMask.Seq();  seq;  ++seq )
+    {
+        const std::vector<ENTRY>& layerItems = m_items[aKind][*seq];
+
+        entries.insert( entries.end(), layerItems.begin(), layerItems.end() );
+        layerCount++;
+    }
+
+    // Items of several layers are plotted in the board order, as if the board was scanned
+    if( layerCount > 1 )
+        std::sort( entries.begin(), entries.end() );
+
+    std::vector<BOARD_ITEM*> items;
+    items.reserve( entries.size() );
+
+    for( const ENTRY& entry : entries )
+        items.push_back( entry.second );
+
+    return items;
+}
+
+
 /* class BRDITEMS_PLOTTER is a helper class to plot board items
  * and a group of board items
  */
 
+const PLOT_ITEM_INDEX& BRDITEMS_PLOTTER::GetItemIndex()
+{
+    if( !m_itemIndex )
+    {
+        m_ownItemIndex.reset( new PLOT_ITEM_INDEX( m_board ) );
+        m_itemIndex = m_ownItemIndex.get();
+    }
+
+    return *m_itemIndex;
+}
+
+
 EDA_COLOR_T BRDITEMS_PLOTTER::getColor( LAYER_NUM aLayer )
 {
     EDA_COLOR_T color = m_board->GetLayerColor( ToLAYER_ID( aLayer ) );
@@ -265,7 +350,8 @@ bool BRDITEMS_PLOTTER::PlotAllTextsModule( MODULE* aModule )
 // plot items like text and graphics, but not tracks and module
 void BRDITEMS_PLOTTER::PlotBoardGraphicItems()
 {
-    for( BOARD_ITEM* item = m_board->m_Drawings; item; item = item->Next() )
+    for( BOARD_ITEM* item : GetItemIndex().GetItems( PLOT_ITEM_INDEX::BOARD_GRAPHICS,
+                                                     m_layerMask ) )
     {
         switch( item->Type() )
         {
@@ -438,15 +524,10 @@ void BRDITEMS_PLOTTER::PlotPcbTarget( PCB_TARGET* aMire )
 // Plot footprints graphic items (outlines)
 void BRDITEMS_PLOTTER::Plot_Edges_Modules()
 {
-    for( MODULE* module = m_board->m_Modules;  module;  module = module->Next() )
+    for( BOARD_ITEM* item : GetItemIndex().GetItems( PLOT_ITEM_INDEX::MODULE_EDGES,
+                                                     m_layerMask ) )
     {
-        for( BOARD_ITEM* item = module->GraphicalItems().GetFirst(); item; item = item->Next() )
-        {
-            EDGE_MODULE* edge = dyn_cast<EDGE_MODULE*>( item );
-
-            if( edge && m_layerMask[edge->GetLayer()] )
-                Plot_1_EdgeModule( edge );
-        }
+        Plot_1_EdgeModule( static_cast<EDGE_MODULE*>( item ) );
     }
 }
 
@@ -635,8 +716,7 @@ void BRDITEMS_PLOTTER::PlotFilledAreas( ZONE_CONTAINER* aZone )
     }
 
     // We need a buffer to store corners coordinates:
-    static std::vector< wxPoint > cornerList;
-    cornerList.clear();
+    std::vector< wxPoint > cornerList;
 
     m_plotter->SetColor( getColor( aZone->GetLayer() ) );
 
@@ -30,11 +30,25 @@
 #ifndef PLOTCONTROLLER_H_
 #define PLOTCONTROLLER_H_
 
+#include <vector>
+
 #include <pcb_plot_params.h>
 #include <layers_id_colors_and_visibility.h>
 
 class PLOTTER;
 class BOARD;
+class EXCELLON_WRITER;
+
+
+/**
+ * A file written by PLOT_CONTROLLER::PlotLayers()
+ */
+struct PLOT_JOB_FILE
+{
+    wxString m_FileName;    ///< the full filename, or the directory of the drill files
+    bool     m_Success;     ///< true if the file was created
+    double   m_Time;        ///< time spent writing the file, in milliseconds
+};
 
 
 /**
@@ -67,8 +81,9 @@ public:
     bool IsPlotOpen() const { return m_plotter != NULL; }
 
     /** Close the current plot, nothing happens if it isn't open
+     * @return false if the end of the plot could not be written
      */
-    void ClosePlot();
+    bool ClosePlot();
 
     /** Open a new plotfile; works as a factory for plotter objects
      * @param aSuffix is a string added to the base filename (derived from
@@ -84,6 +99,31 @@ public:
      */
     bool PlotLayer();
 
+    /**
+     * Plot several layers, each one in its own file named after the layer, using the
+     * current plot options. Any open plot is closed first.
+     * The files are written by several threads at once, along with the drill files if a
+     * drill writer is given.
+     * @param aLayers is the list of layers to plot
+     * @param aFormat is the plot file format identifier
+     * @param aDrillWriter is the set up writer used to create the Excellon drill files in
+     * the plot directory, or NULL to create no drill file
+     * @return true if all files were created
+     */
+    bool PlotLayers( const std::vector<int>& aLayers, PlotFormat aFormat,
+                     EXCELLON_WRITER* aDrillWriter = NULL );
+
+    /**
+     * @return the number of files written by the last PlotLayers call, the drill files
+     * being counted as one file after the layers
+     */
+    int GetJobFileCount() const { return m_jobFiles.size(); }
+
+    /**
+     * @return a file written by the last PlotLayers call, with its time and status
+     */
+    const PLOT_JOB_FILE& GetJobFile( int aIndex ) const { return m_jobFiles.at( aIndex ); }
+
     /**
      * @return the current plot full filename, set by OpenPlotfile
      */
@@ -123,6 +163,9 @@ private:
 
     /// The current plot filename, set by OpenPlotfile
     wxFileName m_plotFile;
+
+    /// The files written by the last PlotLayers call
+    std::vector<PLOT_JOB_FILE> m_jobFiles;
 };
 
 #endif
@@ -39,6 +39,8 @@
 #include <class_pad.h>
 #include <class_track.h>
 #include <class_zone.h>
+#include <disjoint_set.h>
+#include <geometry/delaunay_triangulator.h>
 
 #include <functional>
 using namespace std::placeholders;
@@ -53,27 +55,40 @@ using namespace std::placeholders;
 #include <profile.h>
 #endif
 
-static uint64_t getDistance( const RN_NODE_PTR& aNode1, const RN_NODE_PTR& aNode2 )
+
+///> Nets with up to this many nodes are connected without the Delaunay triangulation.
+static const unsigned int DENSE_MST_MAX_NODES = 64;
+
+#ifdef USE_OPENMP
+///> Nets with at least this many nodes are updated using several threads.
+static const unsigned int LARGE_NET_MIN_NODES = 5000;
+
+///> Minimal number of zones times nodes to test the zones of a net in parallel.
+static const uint64_t PARALLEL_ZONES_MIN_WORK = 20000;
+#endif /* USE_OPENMP */
+
+
+static uint64_t getDistance( int aX1, int aY1, int aX2, int aY2 )
 {
     // Drop the least significant bits to avoid overflow
-    int64_t x = ( aNode1->GetX() - aNode2->GetX() ) >> 16;
-    int64_t y = ( aNode1->GetY() - aNode2->GetY() ) >> 16;
+    int64_t x = ( aX1 - aX2 ) >> 16;
+    int64_t y = ( aY1 - aY2 ) >> 16;
 
     // We do not need sqrt() here, as the distance is computed only for comparison
     return ( x * x + y * y );
 }
 
 
-static bool sortDistance( const RN_NODE_PTR& aOrigin, const RN_NODE_PTR& aNode1,
-                   const RN_NODE_PTR& aNode2 )
+static uint64_t getDistance( const RN_NODE_PTR& aNode1, const RN_NODE_PTR& aNode2 )
 {
-    return getDistance( aOrigin, aNode1 ) < getDistance( aOrigin, aNode2 );
+    return getDistance( aNode1->GetX(), aNode1->GetY(), aNode2->GetX(), aNode2->GetY() );
 }
 
 
-static bool sortWeight( const RN_EDGE_PTR& aEdge1, const RN_EDGE_PTR& aEdge2 )
+static bool sortDistance( const RN_NODE_PTR& aOrigin, const RN_NODE_PTR& aNode1,
+                   const RN_NODE_PTR& aNode2 )
 {
-    return aEdge1->GetWeight() < aEdge2->GetWeight();
+    return getDistance( aOrigin, aNode1 ) < getDistance( aOrigin, aNode2 );
 }
 
 
@@ -113,97 +128,181 @@ static bool isEdgeConnectingNode( const RN_EDGE_PTR& aEdge, const RN_NODE_PTR& a
 }
 
 
-static std::vector<RN_EDGE_MST_PTR>* kruskalMST( RN_LINKS::RN_EDGE_LIST& aEdges,
-                                                 std::vector<RN_NODE_PTR>& aNodes )
+///> Counts the copper clusters a list of nodes belongs to, see RN_NET::UpdateClusters().
+static unsigned int countClusters( const std::vector<RN_NODE_PTR>& aNodes )
+{
+    std::vector<bool> isCluster( aNodes.size(), false );
+    unsigned int clusterCount = 0;
+
+    for( const RN_NODE_PTR& node : aNodes )
+    {
+        if( !isCluster[node->GetTag()] )
+        {
+            isCluster[node->GetTag()] = true;
+            ++clusterCount;
+        }
+    }
+
+    return clusterCount;
+}
+
+
+///> Edge of the Delaunay triangulation considered for the minimal spanning tree.
+struct MST_CANDIDATE
 {
-    unsigned int nodeNumber = aNodes.size();
-    unsigned int mstExpectedSize = nodeNumber - 1;
-    unsigned int mstSize = 0;
-    bool ratsnestLines = false;
+    uint64_t m_weight;
+    int      m_source;      ///< Index of the source node
+    int      m_target;      ///< Index of the target node
+
+    bool operator<( const MST_CANDIDATE& aOther ) const
+    {
+        return m_weight < aOther.m_weight;
+    }
+};
+
+
+///> Arrays used to compute the minimal spanning tree of a net. Every thread keeps its own
+///> set, so updating the ratsnest does not allocate memory for every net.
+struct MST_BUFFERS
+{
+    std::vector<VECTOR2I>       m_points;
+    DELAUNAY_TRIANGULATOR       m_triangulator;
+    std::vector<MST_CANDIDATE>  m_candidates;
+    DISJOINT_SET                m_clusters;
+    std::vector<uint64_t>       m_cost;
+    std::vector<int>            m_closest;
+    std::vector<bool>           m_inTree;
+};
+
+
+static MST_BUFFERS& mstBuffers()
+{
+    static thread_local MST_BUFFERS buffers;
+
+    return buffers;
+}
+
+
+static std::vector<RN_EDGE_MST_PTR>* kruskalMST( const RN_LINKS::RN_NODE_ARRAY& aNodes )
+{
+    // Nodes connected with copper are already tagged with the same cluster (see
+    // RN_NET::UpdateClusters()), and the tags are valid indexes in a set of aNodes.size()
+    // elements, so only the missing connections are left to be chosen.
+    unsigned int clusterCount = countClusters( aNodes );
 
     // The output
     std::vector<RN_EDGE_MST_PTR>* mst = new std::vector<RN_EDGE_MST_PTR>;
-    mst->reserve( mstExpectedSize );
 
-    // Set tags for marking cycles
-    std::unordered_map<RN_NODE_PTR, int> tags;
-    unsigned int tag = 0;
+    if( clusterCount < 2 )
+        return mst;
+
+    mst->reserve( clusterCount - 1 );
+
+    MST_BUFFERS& buffers = mstBuffers();
+    std::vector<VECTOR2I>& points = buffers.m_points;
+
+    points.clear();
 
-    for( RN_NODE_PTR& node : aNodes )
+    for( const RN_NODE_PTR& node : aNodes )
+        points.push_back( VECTOR2I( node->GetX(), node->GetY() ) );
+
+    buffers.m_triangulator.Triangulate( points );
+
+    // Kruskal algorithm requires edges to be sorted by their weight. Edges inside a cluster
+    // are useless, so they are not even stored.
+    std::vector<MST_CANDIDATE>& candidates = buffers.m_candidates;
+
+    candidates.clear();
+
+    for( const DELAUNAY_TRIANGULATOR::EDGE& edge : buffers.m_triangulator.GetEdges() )
     {
-        node->SetTag( tag );
-        tags[node] = tag++;
+        if( aNodes[edge.m_source]->GetTag() != aNodes[edge.m_target]->GetTag() )
+        {
+            const VECTOR2I& source = points[edge.m_source];
+            const VECTOR2I& target = points[edge.m_target];
+            MST_CANDIDATE candidate = { getDistance( source.x, source.y, target.x, target.y ),
+                                        edge.m_source, edge.m_target };
+            candidates.push_back( candidate );
+        }
     }
 
-    // Lists of nodes connected together (subtrees) to detect cycles in the graph
-    std::vector<std::list<int> > cycles( nodeNumber );
-    for( unsigned int i = 0; i < nodeNumber; ++i )
-        cycles[i].push_back( i );
+    std::sort( candidates.begin(), candidates.end() );
 
-    // Kruskal algorithm requires edges to be sorted by their weight
-    aEdges.sort( sortWeight );
+    DISJOINT_SET& clusters = buffers.m_clusters;
 
-    while( mstSize < mstExpectedSize && !aEdges.empty() )
-    {
-        RN_EDGE_PTR& dt = aEdges.front();
+    clusters.Reset( aNodes.size() );
 
-        int srcTag = tags[dt->GetSourceNode()];
-        int trgTag = tags[dt->GetTargetNode()];
+    for( const MST_CANDIDATE& candidate : candidates )
+    {
+        const RN_NODE_PTR& source = aNodes[candidate.m_source];
+        const RN_NODE_PTR& target = aNodes[candidate.m_target];
 
         // Check if by adding this edge we are going to join two different forests
-        if( srcTag != trgTag )
+        if( clusters.Union( source->GetTag(), target->GetTag() ) )
         {
-            // Because edges are sorted by their weight, first we always process connected
-            // items (weight == 0). Once we stumble upon an edge with non-zero weight,
-            // it means that the rest of the lines are ratsnest.
-            if( !ratsnestLines && dt->GetWeight() != 0 )
-                ratsnestLines = true;
-
-            // Update tags
-            if( ratsnestLines )
+            mst->push_back( std::make_shared<RN_EDGE_MST>( source, target, candidate.m_weight ) );
+
+            if( mst->size() == clusterCount - 1 )
+                break;
+        }
+    }
+
+    return mst;
+}
+
+
+static std::vector<RN_EDGE_MST_PTR>* primMST( const RN_LINKS::RN_NODE_ARRAY& aNodes )
+{
+    // The output
+    std::vector<RN_EDGE_MST_PTR>* mst = new std::vector<RN_EDGE_MST_PTR>;
+    const int count = aNodes.size();
+
+    // Joining nodes of the same cluster costs nothing, the others cost their distance + 1,
+    // so every cluster is spanned before it is connected to another one
+    MST_BUFFERS& buffers = mstBuffers();
+    std::vector<uint64_t>& cost = buffers.m_cost;
+    std::vector<int>& closest = buffers.m_closest;
+    std::vector<bool>& inTree = buffers.m_inTree;
+    int current = 0;
+
+    cost.assign( count, std::numeric_limits<uint64_t>::max() );
+    closest.assign( count, 0 );
+    inTree.assign( count, false );
+
+    for( int added = 1; added < count; ++added )
+    {
+        const RN_NODE_PTR& node = aNodes[current];
+        int next = -1;
+
+        inTree[current] = true;
+
+        for( int i = 0; i < count; ++i )
+        {
+            if( inTree[i] )
+                continue;
+
+            uint64_t c = ( aNodes[i]->GetTag() == node->GetTag() ) ? 0
+                                                                   : getDistance( node, aNodes[i] ) + 1;
+
+            if( c < cost[i] )
             {
-                for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
-                {
-                    tags[aNodes[*it]] = srcTag;
-                }
-                // Do a copy of edge, but make it RN_EDGE_MST. In contrary to RN_EDGE,
-                // RN_EDGE_MST saves both source and target node and does not require any other
-                // edges to exist for getting source/target nodes
-                RN_EDGE_MST_PTR newEdge = std::make_shared<RN_EDGE_MST>( dt->GetSourceNode(),
-                                                                         dt->GetTargetNode(),
-                                                                         dt->GetWeight() );
-
-                assert( newEdge->GetSourceNode()->GetTag() != newEdge->GetTargetNode()->GetTag() );
-                assert( newEdge->GetWeight() > 0 );
-
-                mst->push_back( newEdge );
-                ++mstSize;
+                cost[i] = c;
+                closest[i] = current;
             }
-            else
-            {
-                //for( it = cycles[trgTag].begin(), itEnd = cycles[trgTag].end(); it != itEnd; ++it )
-                //for( auto it : cycles[trgTag] )
-                for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
-                {
-                    tags[aNodes[*it]] = srcTag;
-                    aNodes[*it]->SetTag( srcTag );
-                }
 
-                // Processing a connection, decrease the expected size of the ratsnest MST
-                --mstExpectedSize;
-            }
+            if( next < 0 || cost[i] < cost[next] )
+                next = i;
+        }
 
-            // Move nodes that were marked with old tag to the list marked with the new tag
-            cycles[srcTag].splice( cycles[srcTag].end(), cycles[trgTag] );
+        if( cost[next] > 0 )
+        {
+            mst->push_back( std::make_shared<RN_EDGE_MST>( aNodes[closest[next]], aNodes[next],
+                                                           cost[next] - 1 ) );
         }
 
-        // Remove the edge that was just processed
-        aEdges.erase( aEdges.begin() );
+        current = next;
     }
 
-    // Probably we have discarded some of edges, so reduce the size
-    mst->resize( mstSize );
-
     return mst;
 }
 
@@ -277,7 +376,7 @@ void RN_NET::removeNode( RN_NODE_PTR& aNode, const BOARD_CONNECTED_ITEM* aParent
     if( m_links.RemoveNode( aNode ) )
     {
         clearNode( aNode );
-        m_dirty = true;
+        MarkDirty();
     }
 }
 
@@ -303,18 +402,21 @@ void RN_NET::removeEdge( RN_EDGE_MST_PTR& aEdge, const BOARD_CONNECTED_ITEM* aPa
     if( m_links.RemoveNode( end ) )
         clearNode( end );
 
-    m_dirty = true;
+    MarkDirty();
 }
 
 
 const RN_NODE_PTR& RN_LINKS::AddNode( int aX, int aY )
 {
-    RN_NODE_SET::iterator node;
-    bool wasNewElement;
+    auto it = m_nodeIndex.find( nodeKey( aX, aY ) );
+
+    if( it != m_nodeIndex.end() )
+        return m_nodes[it->second];
 
-    std::tie( node, wasNewElement ) = m_nodes.emplace( std::make_shared<RN_NODE>( aX, aY ) );
+    m_nodeIndex[nodeKey( aX, aY )] = m_nodes.size();
+    m_nodes.push_back( std::make_shared<RN_NODE>( aX, aY ) );
 
-    return *node;
+    return m_nodes.back();
 }
 
 
@@ -322,7 +424,25 @@ bool RN_LINKS::RemoveNode( const RN_NODE_PTR& aNode )
 {
     if( aNode->GetRefCount() == 0 )
     {
-        m_nodes.erase( aNode );
+        auto it = m_nodeIndex.find( nodeKey( aNode->GetX(), aNode->GetY() ) );
+
+        // The node may have been removed already, and replaced by another one at its position
+        if( it != m_nodeIndex.end() && m_nodes[it->second].get() == aNode.get() )
+        {
+            // Move the last node to the free slot
+            unsigned int index = it->second;
+            const RN_NODE_PTR& last = m_nodes.back();
+
+            m_nodeIndex.erase( it );
+
+            if( index != m_nodes.size() - 1 )
+            {
+                m_nodeIndex[nodeKey( last->GetX(), last->GetY() )] = index;
+                m_nodes[index] = last;
+            }
+
+            m_nodes.pop_back();
+        }
 
         return true;
     }
@@ -336,63 +456,63 @@ RN_EDGE_MST_PTR RN_LINKS::AddConnection( const RN_NODE_PTR& aNode1, const RN_NOD
 {
     assert( aNode1 != aNode2 );
     RN_EDGE_MST_PTR edge = std::make_shared<RN_EDGE_MST>( aNode1, aNode2, aDistance );
+    m_edgeIndex[edge.get()] = m_edges.size();
     m_edges.push_back( edge );
 
     return edge;
 }
 
 
+void RN_LINKS::RemoveConnection( const RN_EDGE_MST_PTR& aEdge )
+{
+    auto it = m_edgeIndex.find( aEdge.get() );
+
+    if( it == m_edgeIndex.end() )
+        return;
+
+    // Move the last edge to the free slot
+    unsigned int index = it->second;
+
+    m_edgeIndex.erase( it );
+
+    if( index != m_edges.size() - 1 )
+    {
+        m_edgeIndex[m_edges.back().get()] = index;
+        m_edges[index] = m_edges.back();
+    }
+
+    m_edges.pop_back();
+}
+
+
 void RN_NET::compute()
 {
-    const RN_LINKS::RN_NODE_SET& boardNodes = m_links.GetNodes();
-    const RN_LINKS::RN_EDGE_LIST& boardEdges = m_links.GetConnections();
+    const RN_LINKS::RN_NODE_ARRAY& boardNodes = m_links.GetNodes();
 
-    // Special cases do not need complicated algorithms (actually, it does not work well with
-    // the Delaunay triangulator)
+    // Special cases do not need complicated algorithms
     if( boardNodes.size() <= 2 )
     {
         m_rnEdges.reset( new std::vector<RN_EDGE_MST_PTR>( 0 ) );
 
-        // Check if the only possible connection exists
-        if( boardEdges.size() == 0 && boardNodes.size() == 2 )
+        // There can be only one possible connection, check if it is missing
+        if( boardNodes.size() == 2 )
         {
-            RN_LINKS::RN_NODE_SET::const_iterator last = ++boardNodes.begin();
+            const RN_NODE_PTR& first = boardNodes[0];
+            const RN_NODE_PTR& last = boardNodes[1];
 
-            // There can be only one possible connection, but it is missing
-            RN_EDGE_MST_PTR edge = std::make_shared<RN_EDGE_MST>( *boardNodes.begin(), *last );
-            edge->GetSourceNode()->SetTag( 0 );
-            edge->GetTargetNode()->SetTag( 1 );
-            m_rnEdges->push_back( edge );
+            if( first->GetTag() != last->GetTag() )
+                m_rnEdges->push_back( std::make_shared<RN_EDGE_MST>( first, last ) );
         }
-        else
-        {
-            // Set tags to nodes as connected
-            for( RN_NODE_PTR node : boardNodes )
-                node->SetTag( 0 );
-        }
-
 
         return;
     }
 
-    // Move and sort (sorting speeds up) all nodes to a vector for the Delaunay triangulation
-    std::vector<RN_NODE_PTR> nodes( boardNodes.size() );
-    std::partial_sort_copy( boardNodes.begin(), boardNodes.end(), nodes.begin(), nodes.end() );
-
-    TRIANGULATOR triangulator;
-    triangulator.CreateDelaunay( nodes.begin(), nodes.end() );
-    std::unique_ptr<RN_LINKS::RN_EDGE_LIST> triangEdges( triangulator.GetEdges() );
-
-    // Compute weight/distance for edges resulting from triangulation
-    RN_LINKS::RN_EDGE_LIST::iterator eit, eitEnd;
-    for( eit = (*triangEdges).begin(), eitEnd = (*triangEdges).end(); eit != eitEnd; ++eit )
-        (*eit)->SetWeight( getDistance( (*eit)->GetSourceNode(), (*eit)->GetTargetNode() ) );
-
-    // Add the currently existing connections list to the results of triangulation
-    std::copy( boardEdges.begin(), boardEdges.end(), std::front_inserter( *triangEdges ) );
-
-    // Get the minimal spanning tree
-    m_rnEdges.reset( kruskalMST( *triangEdges, nodes ) );
+    // Small nets are more common and checking every pair of their nodes is cheaper than
+    // the triangulation. Larger ones use the minimal spanning tree of the triangulation.
+    if( boardNodes.size() <= DENSE_MST_MAX_NODES )
+        m_rnEdges.reset( primMST( boardNodes ) );
+    else
+        m_rnEdges.reset( kruskalMST( boardNodes ) );
 }
 
 
@@ -438,9 +558,9 @@ bool RN_POLY::HitTest( const RN_NODE_PTR& aNode ) const
 
 void RN_NET::Update()
 {
-    // Add edges resulting from nodes being connected by zones
-    processZones();
-    processPads();
+    // Zones and pads are checked again, even if no item was reported as changed
+    m_clustersDirty = true;
+    UpdateClusters();
 
     compute();
 
@@ -451,6 +571,33 @@ void RN_NET::Update()
 }
 
 
+void RN_NET::UpdateClusters()
+{
+    if( !m_clustersDirty )
+        return;
+
+    // Add edges resulting from nodes being connected by zones
+    processZones();
+    processPads();
+
+    const RN_LINKS::RN_NODE_ARRAY& nodes = m_links.GetNodes();
+    DISJOINT_SET clusters( nodes.size() );
+    int index = 0;
+
+    // Tags temporarily store node indexes in the array
+    for( const RN_NODE_PTR& node : nodes )
+        node->SetTag( index++ );
+
+    for( const RN_EDGE_PTR& edge : m_links.GetConnections() )
+        clusters.Union( edge->GetSourceNode()->GetTag(), edge->GetTargetNode()->GetTag() );
+
+    for( const RN_NODE_PTR& node : nodes )
+        node->SetTag( clusters.Find( node->GetTag() ) );
+
+    m_clustersDirty = false;
+}
+
+
 bool RN_NET::AddItem( const D_PAD* aPad )
 {
     // Ratsnest is not computed for non-copper pads
@@ -460,7 +607,7 @@ bool RN_NET::AddItem( const D_PAD* aPad )
     RN_NODE_PTR node = m_links.AddNode( aPad->GetPosition().x, aPad->GetPosition().y );
     node->AddParent( aPad );
     m_pads[aPad].m_Node = node;
-    m_dirty = true;
+    MarkDirty();
 
     return true;
 }
@@ -471,7 +618,7 @@ bool RN_NET::AddItem( const VIA* aVia )
     RN_NODE_PTR node = m_links.AddNode( aVia->GetPosition().x, aVia->GetPosition().y );
     node->AddParent( aVia );
     m_vias[aVia] = node;
-    m_dirty = true;
+    MarkDirty();
 
     return true;
 }
@@ -488,7 +635,7 @@ bool RN_NET::AddItem( const TRACK* aTrack )
     start->AddParent( aTrack );
     end->AddParent( aTrack );
     m_tracks[aTrack] = m_links.AddConnection( start, end );
-    m_dirty = true;
+    MarkDirty();
 
     return true;
 }
@@ -507,7 +654,7 @@ bool RN_NET::AddItem( const ZONE_CONTAINER* aZone )
         m_zones[aZone].m_Polygons.push_back( poly );
     }
 
-    m_dirty = true;
+    MarkDirty();
 
     return true;
 }
@@ -590,8 +737,8 @@ bool RN_NET::RemoveItem( const ZONE_CONTAINER* aZone )
 
 const RN_NODE_PTR RN_NET::GetClosestNode( const RN_NODE_PTR& aNode ) const
 {
-    const RN_LINKS::RN_NODE_SET& nodes = m_links.GetNodes();
-    RN_LINKS::RN_NODE_SET::const_iterator it, itEnd;
+    const RN_LINKS::RN_NODE_ARRAY& nodes = m_links.GetNodes();
+    RN_LINKS::RN_NODE_ARRAY::const_iterator it, itEnd;
 
     unsigned int minDistance = std::numeric_limits<unsigned int>::max();
     RN_NODE_PTR closest;
@@ -620,8 +767,8 @@ const RN_NODE_PTR RN_NET::GetClosestNode( const RN_NODE_PTR& aNode ) const
 const RN_NODE_PTR RN_NET::GetClosestNode( const RN_NODE_PTR& aNode,
                                           const RN_NODE_FILTER& aFilter ) const
 {
-    const RN_LINKS::RN_NODE_SET& nodes = m_links.GetNodes();
-    RN_LINKS::RN_NODE_SET::const_iterator it, itEnd;
+    const RN_LINKS::RN_NODE_ARRAY& nodes = m_links.GetNodes();
+    RN_LINKS::RN_NODE_ARRAY::const_iterator it, itEnd;
 
     unsigned int minDistance = std::numeric_limits<unsigned int>::max();
     RN_NODE_PTR closest;
@@ -651,7 +798,7 @@ const RN_NODE_PTR RN_NET::GetClosestNode( const RN_NODE_PTR& aNode,
 std::list<RN_NODE_PTR> RN_NET::GetClosestNodes( const RN_NODE_PTR& aNode, int aNumber ) const
 {
     std::list<RN_NODE_PTR> closest;
-    const RN_LINKS::RN_NODE_SET& nodes = m_links.GetNodes();
+    const RN_LINKS::RN_NODE_ARRAY& nodes = m_links.GetNodes();
 
     // Copy nodes
     std::copy( nodes.begin(), nodes.end(), std::back_inserter( closest ) );
@@ -674,7 +821,7 @@ std::list<RN_NODE_PTR> RN_NET::GetClosestNodes( const RN_NODE_PTR& aNode,
                                                 const RN_NODE_FILTER& aFilter, int aNumber ) const
 {
     std::list<RN_NODE_PTR> closest;
-    const RN_LINKS::RN_NODE_SET& nodes = m_links.GetNodes();
+    const RN_LINKS::RN_NODE_ARRAY& nodes = m_links.GetNodes();
 
     // Copy filtered nodes
     std::copy_if( nodes.begin(), nodes.end(), std::back_inserter( closest ), std::cref( aFilter ) );
@@ -805,8 +952,10 @@ void RN_NET::ClearSimple()
 
 void RN_NET::GetConnectedItems( const BOARD_CONNECTED_ITEM* aItem,
                                 std::list<BOARD_CONNECTED_ITEM*>& aOutput,
-                                RN_ITEM_TYPE aTypes ) const
+                                RN_ITEM_TYPE aTypes )
 {
+    UpdateClusters();
+
     std::list<RN_NODE_PTR> nodes = GetNodes( aItem );
     assert( !nodes.empty() );
 
@@ -844,9 +993,9 @@ void RN_NET::GetConnectedItems( const BOARD_CONNECTED_ITEM* aItem,
     {
         for( ZONE_DATA_MAP::const_iterator it = m_zones.begin(); it != m_zones.end(); ++it )
         {
-            for( const RN_EDGE_MST_PTR& edge : it->second.m_Edges )
+            for( const RN_POLY& poly : it->second.m_Polygons )
             {
-                if( edge->GetTag() == tag )
+                if( poly.GetNode()->GetTag() == tag )
                 {
                     aOutput.push_back( const_cast<ZONE_CONTAINER*>( it->first ) );
                     break;
@@ -907,7 +1056,7 @@ void RN_DATA::AddBlocked( const BOARD_ITEM* aItem )
 
 void RN_DATA::GetConnectedItems( const BOARD_CONNECTED_ITEM* aItem,
                                  std::list<BOARD_CONNECTED_ITEM*>& aOutput,
-                                 RN_ITEM_TYPE aTypes ) const
+                                 RN_ITEM_TYPE aTypes )
 {
     int net = aItem->GetNetCode();
 
@@ -943,6 +1092,8 @@ bool RN_DATA::AreConnected( const BOARD_CONNECTED_ITEM* aItem, const BOARD_CONNE
     assert( net1 < (int) m_nets.size() && net2 < (int) m_nets.size() );
 
     // net1 == net2
+    m_nets[net1].UpdateClusters();
+
     std::list<RN_NODE_PTR> items1 = m_nets[net1].GetNodes( aItem );
     std::list<RN_NODE_PTR> items2 = m_nets[net1].GetNodes( aOther );
 
@@ -970,9 +1121,14 @@ int RN_DATA::GetUnconnectedCount() const
 
 void RN_NET::processZones()
 {
+    std::vector<RN_ZONE_DATA*> zones;
+    std::vector<LSET> zoneLayers;
+
+    zones.reserve( m_zones.size() );
+    zoneLayers.reserve( m_zones.size() );
+
     for( ZONE_DATA_MAP::iterator it = m_zones.begin(); it != m_zones.end(); ++it )
     {
-        const ZONE_CONTAINER* zone = it->first;
         RN_ZONE_DATA& zoneData = it->second;
 
         // Reset existing connections
@@ -980,37 +1136,60 @@ void RN_NET::processZones()
             m_links.RemoveConnection( edge );
 
         zoneData.m_Edges.clear();
-        LSET layers = zone->GetLayerSet();
-
-        // Compute new connections
-        RN_LINKS::RN_NODE_SET candidates = m_links.GetNodes();
-        RN_LINKS::RN_NODE_SET::const_iterator point, pointEnd;
 
         // Sorting by area should speed up the processing, as smaller polygons are computed
         // faster and may reduce the number of points for further checks
         std::sort( zoneData.m_Polygons.begin(), zoneData.m_Polygons.end(), sortArea );
 
-        for( std::deque<RN_POLY>::iterator poly = zoneData.m_Polygons.begin(),
-                polyEnd = zoneData.m_Polygons.end(); poly != polyEnd; ++poly )
-        {
-            const RN_NODE_PTR& node = poly->GetNode();
+        zones.push_back( &zoneData );
+        zoneLayers.push_back( it->first->GetLayerSet() );
+    }
+
+    if( zones.empty() )
+        return;
+
+    // Nodes are not added nor removed until the new connections are stored, so zones may be
+    // tested against them in parallel
+    const RN_LINKS::RN_NODE_ARRAY& nodes = m_links.GetNodes();
+    std::vector<const RN_NODE_PTR*> allCandidates;
 
-            point = candidates.begin();
-            pointEnd = candidates.end();
+    allCandidates.reserve( nodes.size() );
 
-            while( point != pointEnd )
+    for( const RN_NODE_PTR& node : nodes )
+        allCandidates.push_back( &node );
+
+    typedef std::pair<const RN_NODE_PTR*, const RN_NODE_PTR*> ZONE_HIT;
+    std::vector<std::vector<ZONE_HIT> > hits( zones.size() );
+    int zoneCount = zones.size();
+
+    // Only nets with a lot of nodes in zones are worth the threads (e.g. ground planes)
+#ifdef USE_OPENMP
+    bool parallel = (uint64_t) zoneCount * allCandidates.size() >= PARALLEL_ZONES_MIN_WORK;
+
+    #pragma omp parallel for schedule(dynamic, 1) if( parallel )
+#endif /* USE_OPENMP */
+    for( int i = 0; i < zoneCount; ++i )
+    {
+        const LSET& layers = zoneLayers[i];
+        std::vector<const RN_NODE_PTR*> candidates( allCandidates );
+
+        for( const RN_POLY& poly : zones[i]->m_Polygons )
+        {
+            const RN_NODE_PTR& node = poly.GetNode();
+            unsigned int point = 0;
+
+            while( point < candidates.size() )
             {
-                if( *point != node && ( (*point)->GetLayers() & layers ).any()
-                        && poly->HitTest( *point ) )
-                {
-                    //(*point)->AddParent( zone );  // do not assign parent for helper links
+                const RN_NODE_PTR& candidate = *candidates[point];
 
-                    RN_EDGE_MST_PTR connection = m_links.AddConnection( node, *point );
-                    zoneData.m_Edges.push_back( connection );
+                if( candidate != node && ( candidate->GetLayers() & layers ).any()
+                        && poly.HitTest( candidate ) )
+                {
+                    hits[i].push_back( ZONE_HIT( &node, &candidate ) );
 
                     // This point already belongs to a polygon, we do not need to check it anymore
-                    point = candidates.erase( point );
-                    pointEnd = candidates.end();
+                    candidates[point] = candidates.back();
+                    candidates.pop_back();
                 }
                 else
                 {
@@ -1019,6 +1198,15 @@ void RN_NET::processZones()
             }
         }
     }
+
+    for( int i = 0; i < zoneCount; ++i )
+    {
+        for( const ZONE_HIT& hit : hits[i] )
+        {
+            //(*hit.second)->AddParent( zone );  // do not assign parent for helper links
+            zones[i]->m_Edges.push_back( m_links.AddConnection( *hit.first, *hit.second ) );
+        }
+    }
 }
 
 
@@ -1034,9 +1222,10 @@ void RN_NET::processPads()
         for( RN_EDGE_MST_PTR edge : edges )
             m_links.RemoveConnection( edge );
 
+        edges.clear();
         LSET layers = pad->GetLayerSet();
-        const RN_LINKS::RN_NODE_SET& candidates = m_links.GetNodes();
-        RN_LINKS::RN_NODE_SET::const_iterator point, pointEnd;
+        const RN_LINKS::RN_NODE_ARRAY& candidates = m_links.GetNodes();
+        RN_LINKS::RN_NODE_ARRAY::const_iterator point, pointEnd;
 
         point = candidates.begin();
         pointEnd = candidates.end();
@@ -1273,22 +1462,38 @@ void RN_DATA::Recalculate( int aNet )
     prof_start( &totalRealTime );
 #endif
 
-        unsigned int i;
+        // Start with net number 1, as 0 stands for not connected
+        std::vector<std::pair<unsigned int, int> > dirtyNets;
 
-#ifdef USE_OPENMP
-        #pragma omp parallel shared(netCount) private(i)
+        for( unsigned int i = 1; i < netCount; ++i )
         {
-            #pragma omp for schedule(guided, 1)
+            if( m_nets[i].IsDirty() )
+                dirtyNets.push_back( std::make_pair( m_nets[i].GetNodeCount(), (int) i ) );
+        }
+
+        // A few huge nets (ground, power) take most of the time, so they are started first
+        // and the small ones fill the gaps
+        std::sort( dirtyNets.begin(), dirtyNets.end(),
+                   std::greater<std::pair<unsigned int, int> >() );
+
+        int i = 0;
+        int dirtyCount = dirtyNets.size();
+
+#ifdef USE_OPENMP
+        // The largest nets are updated one by one, each using all threads for its zones
+        while( i < dirtyCount && dirtyNets[i].first >= LARGE_NET_MIN_NODES )
+            updateNet( dirtyNets[i++].second );
+
+        int first = i;
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for( i = first; i < dirtyCount; ++i )
+            updateNet( dirtyNets[i].second );
 #else /* USE_OPENMP */
-        {
-#endif
-            // Start with net number 1, as 0 stands for not connected
-            for( i = 1; i < netCount; ++i )
-            {
-                if( m_nets[i].IsDirty() )
-                    updateNet( i );
-            }
-        }  /* end of parallel section */
+        for( ; i < dirtyCount; ++i )
+            updateNet( dirtyNets[i].second );
+#endif /* USE_OPENMP */
+
 #ifdef PROFILE
     prof_end( &totalRealTime );
 
@@ -31,7 +31,6 @@
 #define RATSNEST_DATA_H
 
 #include <ttl/halfedge/hetriang.h>
-#include <ttl/halfedge/hetraits.h>
 
 #include <math/box2.h>
 
@@ -65,7 +64,6 @@ typedef hed::NODE_PTR       RN_NODE_PTR;
 typedef hed::EDGE           RN_EDGE;
 typedef hed::EDGE_PTR       RN_EDGE_PTR;
 typedef hed::EDGE_MST       RN_EDGE_MST;
-typedef hed::TRIANGULATION  TRIANGULATOR;
 typedef std::shared_ptr<hed::EDGE_MST> RN_EDGE_MST_PTR;
 
 bool operator==( const RN_NODE_PTR& aFirst, const RN_NODE_PTR& aSecond );
@@ -164,43 +162,19 @@ struct RN_NODE_OR_FILTER : public RN_NODE_FILTER
 };
 
 
-///> Functor comparing if two nodes are equal by their coordinates. It is required to make set of
-///> shared pointers work properly.
-struct RN_NODE_COMPARE : std::binary_function<RN_NODE_PTR, RN_NODE_PTR, bool>
-{
-    bool operator()( const RN_NODE_PTR& aNode1, const RN_NODE_PTR& aNode2 ) const
-    {
-        return aNode1 == aNode2;
-    }
-};
-
-///> Functor calculating hash for a given node. It is required to make set of shared pointers
-///> work properly.
-struct RN_NODE_HASH : std::unary_function<RN_NODE_PTR, std::size_t>
-{
-    std::size_t operator()( const RN_NODE_PTR& aNode ) const
-    {
-        std::size_t hash = 2166136261u;
-
-        hash ^= aNode->GetX();
-        hash *= 16777619;
-        hash ^= aNode->GetY();
-
-        return hash;
-    }
-};
-
-
 /**
  * Class RN_LINKS
  * Manages data describing nodes and connections for a given net.
+ * Nodes and connections are kept in contiguous arrays, so the position of a node is
+ * a valid index for the computations made on the whole net. The arrays are not sorted:
+ * removing an element moves the last one to its place.
  */
 class RN_LINKS
 {
 public:
     // Helper typedefs
-    typedef std::unordered_set<RN_NODE_PTR, RN_NODE_HASH, RN_NODE_COMPARE> RN_NODE_SET;
-    typedef std::list<RN_EDGE_PTR> RN_EDGE_LIST;
+    typedef std::vector<RN_NODE_PTR> RN_NODE_ARRAY;
+    typedef std::vector<RN_EDGE_MST_PTR> RN_EDGE_ARRAY;
 
     /**
      * Function AddNode()
@@ -222,10 +196,10 @@ public:
 
     /**
      * Function GetNodes()
-     * Returns the set of currently used nodes.
-     * @return The set of currently used nodes.
+     * Returns the array of currently used nodes.
+     * @return The array of currently used nodes.
      */
-    const RN_NODE_SET& GetNodes() const
+    const RN_NODE_ARRAY& GetNodes() const
     {
         return m_nodes;
     }
@@ -248,27 +222,36 @@ public:
      * Removes a connection described by a given edge pointer.
      * @param aEdge is a pointer to edge to be removed.
      */
-    void RemoveConnection( const RN_EDGE_PTR& aEdge )
-    {
-        m_edges.remove( aEdge );
-    }
+    void RemoveConnection( const RN_EDGE_MST_PTR& aEdge );
 
     /**
      * Function GetConnections()
-     * Returns the list of edges that currently connect nodes.
-     * @return the list of edges that currently connect nodes.
+     * Returns the array of edges that currently connect nodes.
+     * @return the array of edges that currently connect nodes.
      */
-    const RN_EDGE_LIST& GetConnections() const
+    const RN_EDGE_ARRAY& GetConnections() const
     {
         return m_edges;
     }
 
 protected:
-    ///> Set of nodes that are expected to be connected together (vias, tracks, pads).
-    RN_NODE_SET m_nodes;
+    ///> Returns the key of a node position in m_nodeIndex.
+    static uint64_t nodeKey( int aX, int aY )
+    {
+        return ( (uint64_t) (uint32_t) aX << 32 ) | (uint32_t) aY;
+    }
+
+    ///> Nodes that are expected to be connected together (vias, tracks, pads).
+    RN_NODE_ARRAY m_nodes;
+
+    ///> Index of every node in m_nodes, by position.
+    std::unordered_map<uint64_t, unsigned int> m_nodeIndex;
+
+    ///> Edges that currently connect nodes.
+    RN_EDGE_ARRAY m_edges;
 
-    ///> List of edges that currently connect nodes.
-    RN_EDGE_LIST m_edges;
+    ///> Index of every edge in m_edges.
+    std::unordered_map<const RN_EDGE*, unsigned int> m_edgeIndex;
 };
 
 
@@ -334,7 +317,7 @@ class RN_NET
 {
 public:
     ///> Default constructor.
-    RN_NET() : m_dirty( true ), m_visible( true )
+    RN_NET() : m_dirty( true ), m_clustersDirty( true ), m_visible( true )
     {}
 
     /**
@@ -365,6 +348,7 @@ public:
     void MarkDirty()
     {
         m_dirty = true;
+        m_clustersDirty = true;
     }
 
     /**
@@ -394,6 +378,24 @@ public:
      */
     void Update();
 
+    /**
+     * Function GetNodeCount()
+     * Returns the number of nodes in the net, which is a measure of the time needed to
+     * update it.
+     */
+    unsigned int GetNodeCount() const
+    {
+        return m_links.GetNodes().size();
+    }
+
+    /**
+     * Function UpdateClusters()
+     * Groups the nodes connected together with copper, if anything changed since the last
+     * call. Afterwards every node is tagged with its group, i.e. nodes with equal tags are
+     * connected. It is cheaper than Update(), as the ratsnest lines are not computed.
+     */
+    void UpdateClusters();
+
     /**
      * Function AddItem()
      * Adds an appropriate node associated with selected pad, so it is
@@ -558,7 +560,7 @@ public:
      */
     void GetConnectedItems( const BOARD_CONNECTED_ITEM* aItem,
                             std::list<BOARD_CONNECTED_ITEM*>& aOutput,
-                            RN_ITEM_TYPE aTypes = RN_ALL ) const;
+                            RN_ITEM_TYPE aTypes = RN_ALL );
 
 protected:
     ///> Validates edge, i.e. modifies source and target nodes for an edge
@@ -600,6 +602,9 @@ protected:
     ///> Flag indicating necessity of recalculation of ratsnest for a net.
     bool m_dirty;
 
+    ///> Flag indicating that node tags do not reflect the connections anymore.
+    bool m_clustersDirty;
+
     ///> Structure to hold ratsnest data for ZONE_CONTAINER objects.
     typedef struct
     {
@@ -647,6 +652,10 @@ protected:
  * Class RN_DATA
  *
  * Stores information about unconnected items for a board.
+ * <p>
+ * It is kept up to date by BOARD_COMMIT, and its copper clusters answer the connectivity
+ * queries of the GAL tools and the ratsnest.  TestConnections(), DRC and the track cleanup
+ * still use CONNECTIONS (connect.cpp), which computes the connectivity on its own.
  */
 class RN_DATA
 {
@@ -754,7 +763,7 @@ public:
      */
     void GetConnectedItems( const BOARD_CONNECTED_ITEM* aItem,
                             std::list<BOARD_CONNECTED_ITEM*>& aOutput,
-                            RN_ITEM_TYPE aTypes = RN_ALL ) const;
+                            RN_ITEM_TYPE aTypes = RN_ALL );
 
     /**
      * Function GetNetItems()
@@ -3440,6 +3440,7 @@ void SPECCTRA_DB::ExportPCB( wxString aFilename, bool aNameChange ) throw( IO_ER
             pcb->pcbname = TO_UTF8( aFilename );
 
         pcb->Format( &formatter, 0 );
+        formatter.Finish();
     }
 }
 
@@ -3451,6 +3452,7 @@ void SPECCTRA_DB::ExportSESSION( wxString aFilename )
         FILE_OUTPUTFORMATTER formatter( aFilename, wxT( "wt" ), quote_char[0] );
 
         session->Format( &formatter, 0 );
+        formatter.Finish();
     }
 }
 
@@ -52,6 +52,7 @@
 #include <base_units.h>
 
 #include <collectors.h>
+#include <endpoint_index.h>
 
 #include <geometry/shape_poly_set.h>
 
@@ -271,90 +272,39 @@ static POINT mapPt( const wxPoint& pt )
 /**
  * Function findPoint
  * searches for a DRAWSEGMENT with an end point or start point of aPoint, and
- * if found, removes it from the TYPE_COLLECTOR and returns it, else returns NULL.
+ * if found, removes it from the index and returns it, else returns NULL.
  * @param aPoint The starting or ending point to search for.
- * @param items The list to remove from.
+ * @param aItems The graphic items, numbered as in aIndex.
+ * @param aIndex The end points of the items not used yet, to remove from.
  * @param aLimit is the distance from \a aPoint that still constitutes a valid find.
  * @return DRAWSEGMENT* - The first DRAWSEGMENT that has a start or end point matching
- *   aPoint, otherwise NULL if none.
+ *   aPoint, else the one with the closest start or end point within aLimit,
+ *   otherwise NULL if none.
  */
-static DRAWSEGMENT* findPoint( const wxPoint& aPoint, ::PCB_TYPE_COLLECTOR* items, unsigned aLimit )
+static DRAWSEGMENT* findPoint( const wxPoint& aPoint, const std::vector<DRAWSEGMENT*>& aItems,
+                               ENDPOINT_INDEX& aIndex, unsigned aLimit )
 {
-    unsigned min_d = INT_MAX;
-    int      ndx_min = 0;
+    int found = aIndex.Find( aPoint, aLimit );
 
-    // find the point closest to aPoint and perhaps exactly matching aPoint.
-    for( int i = 0; i < items->GetCount(); ++i )
+    if( found >= 0 )
     {
-        DRAWSEGMENT*    graphic = (DRAWSEGMENT*) (*items)[i];
-        unsigned        d;
-
-        wxASSERT( graphic->Type() == PCB_LINE_T || graphic->Type() == PCB_MODULE_EDGE_T );
-
-        switch( graphic->GetShape() )
-        {
-        case S_ARC:
-            if( aPoint == graphic->GetArcStart() || aPoint == graphic->GetArcEnd() )
-            {
-                items->Remove( i );
-                return graphic;
-            }
-
-            d = close_ness( aPoint, graphic->GetArcStart() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
-
-            d = close_ness( aPoint, graphic->GetArcEnd() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
-            break;
-
-        default:
-            if( aPoint == graphic->GetStart() || aPoint == graphic->GetEnd() )
-            {
-                items->Remove( i );
-                return graphic;
-            }
-
-            d = close_ness( aPoint, graphic->GetStart() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
-
-            d = close_ness( aPoint, graphic->GetEnd() );
-            if( d < min_d )
-            {
-                min_d = d;
-                ndx_min = i;
-            }
-        }
-    }
-
-    if( min_d <= aLimit )
-    {
-        DRAWSEGMENT* graphic = (DRAWSEGMENT*) (*items)[ndx_min];
-        items->Remove( ndx_min );
-        return graphic;
+        aIndex.Remove( found );
+        return aItems[found];
     }
 
 #if defined(DEBUG)
-    if( items->GetCount() )
+    if( aIndex.Count() )
     {
         printf( "Unable to find segment matching point (%.6g;%.6g) (seg count %d)\n",
                 IU2um( aPoint.x )/1000, IU2um( aPoint.y )/1000,
-                items->GetCount());
+                aIndex.Count() );
 
-        for( int i = 0; i< items->GetCount(); ++i )
+        for( int i = aIndex.First(); i < aIndex.Size(); ++i )
         {
-            DRAWSEGMENT* graphic = (DRAWSEGMENT*) (*items)[i];
+            if( aIndex.IsRemoved( i ) )
+                continue;
+
+            DRAWSEGMENT* graphic = aItems[i];
 
             if( graphic->GetShape() == S_ARC )
                 printf( "item %d, type=%s, start=%.6g;%.6g  end=%.6g;%.6g\n",
@@ -932,15 +882,29 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
 
     items.Collect( aBoard, scan_graphics );
 
-    for( int i = 0; i<items.GetCount(); )
+    // Keep the graphics on Edge_Cuts layer, and index their end points so the
+    // outlines are chained without scanning all the remaining graphics each time
+    std::vector<DRAWSEGMENT*>   graphics;
+    ENDPOINT_INDEX              ends( Millimeter2iu( 0.05 ) );
+
+    for( int i = 0; i<items.GetCount(); ++i )
     {
         if( items[i]->GetLayer() != Edge_Cuts )
-            items.Remove( i );
-        else    // remove graphics not on Edge_Cuts layer
-            ++i;
+            continue;
+
+        DRAWSEGMENT* graphic = (DRAWSEGMENT*) items[i];
+
+        wxASSERT( graphic->Type() == PCB_LINE_T || graphic->Type() == PCB_MODULE_EDGE_T );
+
+        graphics.push_back( graphic );
+
+        if( graphic->GetShape() == S_ARC )
+            ends.Add( graphic->GetArcStart(), graphic->GetArcEnd() );
+        else
+            ends.Add( graphic->GetStart(), graphic->GetEnd() );
     }
 
-    if( items.GetCount() )
+    if( graphics.size() )
     {
         PATH*  path = new PATH( boundary );
         boundary->paths.push_back( path );
@@ -955,9 +919,9 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
         wxPoint xmin    = wxPoint( INT_MAX, 0 );
         int     xmini   = 0;
 
-        for( int i = 0; i < items.GetCount(); i++ )
+        for( unsigned i = 0; i < graphics.size(); i++ )
         {
-            graphic = (DRAWSEGMENT*) items[i];
+            graphic = graphics[i];
 
             switch( graphic->GetShape() )
             {
@@ -1040,10 +1004,10 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
         // can put enough graphics together by matching endpoints to formulate a cohesive
         // polygon.
 
-        graphic = (DRAWSEGMENT*) items[xmini];
+        graphic = graphics[xmini];
 
-        // The first DRAWSEGMENT is in 'graphic', ok to remove it from 'items'
-        items.Remove( xmini );
+        // The first DRAWSEGMENT is in 'graphic', ok to remove it from 'ends'
+        ends.Remove( xmini );
 
         // Set maximum proximity threshold for point to point nearness metric for
         // board perimeter only, not interior keepouts yet.
@@ -1142,7 +1106,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
 
                 // Get next closest segment.
 
-                graphic = findPoint( prevPt, &items, prox );
+                graphic = findPoint( prevPt, graphics, ends, prox );
 
                 // If there are no more close segments, check if the board
                 // outline polygon can be closed.
@@ -1174,7 +1138,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
         // polygons.
         prox = Millimeter2iu( 0.05 );
 
-        while( items.GetCount() )
+        while( ends.Count() )
         {
             // emit a signal layers keepout for every interior polygon left...
             KEEPOUT*    keepout = new KEEPOUT( NULL, T_keepout );
@@ -1183,8 +1147,9 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
             keepout->SetShape( poly_ko );
             poly_ko->SetLayerId( "signal" );
             pcb->structure->keepouts.push_back( keepout );
-            graphic = (DRAWSEGMENT*) items[0];
-            items.Remove( 0 );
+            int first = ends.First();
+            graphic = graphics[first];
+            ends.Remove( first );
 
             if( graphic->GetShape() == S_CIRCLE )
             {
@@ -1277,7 +1242,7 @@ void SPECCTRA_DB::fillBOUNDARY( BOARD* aBoard, BOUNDARY* boundary )
 
                     // Get next closest segment.
 
-                    graphic = findPoint( prevPt, &items, prox );
+                    graphic = findPoint( prevPt, graphics, ends, prox );
 
                     // If there are no more close segments, check if polygon
                     // can be closed.
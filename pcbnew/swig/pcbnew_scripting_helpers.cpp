@@ -64,6 +64,9 @@ BOARD* LoadBoard( wxString& aFileName )
     else if( aFileName.EndsWith( wxT( ".brd" ) ) )
         return LoadBoard( aFileName, IO_MGR::LEGACY );
 
+    else if( aFileName.EndsWith( wxT( ".kicad_pcb_bin" ) ) )
+        return LoadBoard( aFileName, IO_MGR::KICAD_BINARY );
+
     // as fall back for any other kind use the legacy format
     return LoadBoard( aFileName, IO_MGR::LEGACY );
 }
@@ -7,3 +7,7 @@
 #include <class_track.h>
 %}
 
+%include track_end_index.h
+%{
+#include <track_end_index.h>
+%}
@@ -0,0 +1,262 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef TRACK_END_INDEX_H_
+#define TRACK_END_INDEX_H_
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdint.h>
+
+#include <class_track.h>
+#include <disjoint_set.h>
+
+/**
+ * Class TRACK_END_INDEX
+ * finds the tracks and vias having an end at a given point, and gives the same answer
+ * as TRACK::GetTrack() without walking the board list.
+ * <p>
+ * The index is built from a board list, and must be told about the tracks removed from
+ * this list and about the tracks whose ends are moved.  Tracks cannot be added or moved
+ * in the list: the index must be built again after that.
+ * <p>
+ * GetTrack() returns the matching track nearest to the reference one in the list, and
+ * does not walk past a track of another net.  So the index keeps, for each track:
+ * - its position in the list when the index was built.  The distance between two tracks
+ *   is the count of tracks still in the list between these positions, which is kept in
+ *   a Fenwick tree.
+ * - its run, the range of tracks of the same net containing it.  Two runs are merged
+ *   when the tracks of other nets separating them are removed.
+ */
+class TRACK_END_INDEX
+{
+public:
+    /**
+     * Function Build
+     * indexes the list of tracks beginning at \a aFirst, the previous content is lost.
+     */
+    void Build( TRACK* aFirst )
+    {
+        m_trackEnds.clear();
+        m_positions.clear();
+
+        int count = 0;
+
+        for( TRACK* track = aFirst; track != NULL; track = track->Next() )
+            ++count;
+
+        m_runs.Reset( count );
+        m_live.assign( count + 1, 0 );
+
+        int position = 0;
+
+        for( TRACK* track = aFirst; track != NULL; track = track->Next(), ++position )
+        {
+            m_positions[track] = position;
+
+            // Searches along the list stop at the first track of another net
+            if( track->Back() && track->Back()->GetNetCode() == track->GetNetCode() )
+                m_runs.Union( position - 1, position );
+
+            // Every track is in the list: each node of the tree counts the positions
+            // below it, i.e. the lowest bit of its index
+            m_live[position + 1] = ( position + 1 ) & -( position + 1 );
+
+            AddEnds( track );
+        }
+    }
+
+    /**
+     * Function Remove
+     * removes a track from the index.  It must be called before \a aTrack is removed from
+     * the board list, as its neighbours in the list are needed.
+     */
+    void Remove( TRACK* aTrack )
+    {
+        auto it = m_positions.find( aTrack );
+
+        if( it == m_positions.end() )
+            return;
+
+        RemoveEnds( aTrack );
+
+        TRACK* back = aTrack->Back();
+        TRACK* next = aTrack->Next();
+
+        // Two runs of the same net become one, so searches may walk further than before
+        if( back && next && back->GetNetCode() == next->GetNetCode() )
+        {
+            auto backPos = m_positions.find( back );
+            auto nextPos = m_positions.find( next );
+
+            if( backPos != m_positions.end() && nextPos != m_positions.end() )
+                m_runs.Union( backPos->second, nextPos->second );
+        }
+
+        for( int i = it->second + 1; i < (int) m_live.size(); i += i & -i )
+            --m_live[i];
+
+        m_positions.erase( it );
+    }
+
+    /// Adds the ends of a track to the index, after they have been moved
+    void AddEnds( TRACK* aTrack )
+    {
+        m_trackEnds[pointKey( aTrack->GetStart() )].push_back( aTrack );
+
+        if( aTrack->GetEnd() != aTrack->GetStart() )
+            m_trackEnds[pointKey( aTrack->GetEnd() )].push_back( aTrack );
+    }
+
+    /// Removes the ends of a track from the index, before they are moved
+    void RemoveEnds( TRACK* aTrack )
+    {
+        const wxPoint* ends[] = { &aTrack->GetStart(), &aTrack->GetEnd() };
+
+        for( const wxPoint* end : ends )
+        {
+            auto bucket = m_trackEnds.find( pointKey( *end ) );
+
+            if( bucket == m_trackEnds.end() )
+                continue;
+
+            std::vector<TRACK*>& tracks = bucket->second;
+            tracks.erase( std::remove( tracks.begin(), tracks.end(), aTrack ), tracks.end() );
+        }
+    }
+
+    /**
+     * Function TracksAt
+     * @return the tracks and vias having an end at \a aPoint, in no particular order.
+     */
+    const std::vector<TRACK*>& TracksAt( const wxPoint& aPoint ) const
+    {
+        static const std::vector<TRACK*> none;
+
+        auto bucket = m_trackEnds.find( pointKey( aPoint ) );
+
+        return bucket == m_trackEnds.end() ? none : bucket->second;
+    }
+
+    /**
+     * Function Position
+     * @return the position of \a aTrack in the list when the index was built, which gives
+     * the order of the tracks in the list, or -1 if the track is not indexed.
+     */
+    int Position( const TRACK* aTrack ) const
+    {
+        auto it = m_positions.find( aTrack );
+
+        return it == m_positions.end() ? -1 : it->second;
+    }
+
+    /**
+     * Function SameRun
+     * @return true if both tracks are indexed, and only tracks of their net are between
+     * them in the list.
+     */
+    bool SameRun( const TRACK* aFirst, const TRACK* aSecond )
+    {
+        int first = Position( aFirst );
+        int second = Position( aSecond );
+
+        return first >= 0 && second >= 0 && m_runs.Find( first ) == m_runs.Find( second );
+    }
+
+    /**
+     * Function FindConnected
+     * is the same as aTrack->GetTrack( first, NULL, aEndPoint, true, false ), where first
+     * is the first track of the indexed list: it finds the track of the same net having an
+     * end at the \a aEndPoint end of \a aTrack, which is the nearest one in the list.
+     */
+    TRACK* FindConnected( TRACK* aTrack, ENDPOINT_T aEndPoint )
+    {
+        int ref = Position( aTrack );
+
+        if( ref < 0 )
+            return NULL;
+
+        int     refRun = m_runs.Find( ref );
+        int     refCount = liveBefore( ref );
+        LSET    refLayers = aTrack->GetLayerSet();
+        TRACK*  found = NULL;
+        int     foundRank = 0;
+
+        for( TRACK* candidate : TracksAt( aTrack->GetEndPoint( aEndPoint ) ) )
+        {
+            if( candidate == aTrack || candidate->GetState( BUSY | IS_DELETED ) )
+                continue;
+
+            int position = Position( candidate );
+
+            if( m_runs.Find( position ) != refRun
+                    || !( refLayers & candidate->GetLayerSet() ).any() )
+                continue;
+
+            // The search along the list alternates between the tracks following and
+            // preceding aTrack at increasing distance, the following one being tested first
+            int distance = liveBefore( position ) - refCount;
+            int rank = distance > 0 ? 2 * distance - 1 : -2 * distance;
+
+            if( !found || rank < foundRank )
+            {
+                found = candidate;
+                foundRank = rank;
+            }
+        }
+
+        return found;
+    }
+
+private:
+    static int64_t pointKey( const wxPoint& aPoint )
+    {
+        return ( (int64_t) aPoint.x << 32 ) | (uint32_t) aPoint.y;
+    }
+
+    /// @return the number of indexed tracks at the positions below aPosition.
+    int liveBefore( int aPosition ) const
+    {
+        int count = 0;
+
+        for( int i = aPosition; i > 0; i -= i & -i )
+            count += m_live[i];
+
+        return count;
+    }
+
+    /// Tracks and vias having an end at a given point, see pointKey()
+    std::unordered_map<int64_t, std::vector<TRACK*> > m_trackEnds;
+
+    /// Position of the indexed tracks in the list when the index was built
+    std::unordered_map<const TRACK*, int> m_positions;
+
+    /// Runs of tracks of the same net, by position
+    DISJOINT_SET m_runs;
+
+    /// Fenwick tree of the positions of the tracks still indexed, 1-based
+    std::vector<int> m_live;
+};
+
+#endif  // TRACK_END_INDEX_H_
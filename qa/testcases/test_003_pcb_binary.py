@@ -0,0 +1,84 @@
+import glob
+import os
+import tempfile
+import time
+import unittest
+import pcbnew
+
+class TestPCBBinary(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = pcbnew.LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.tmpdir = tempfile.mkdtemp()
+        self.bin_name = os.path.join(self.tmpdir, "snapshot.kicad_pcb_bin")
+
+    def tearDown(self):
+        for name in os.listdir(self.tmpdir):
+            os.remove(os.path.join(self.tmpdir, name))
+        os.rmdir(self.tmpdir)
+
+    def save_text(self, board, name):
+        fn = os.path.join(self.tmpdir, name)
+        pcbnew.SaveBoard(fn, board, pcbnew.IO_MGR.KICAD)
+        with open(fn) as f:
+            # skip the header line, which holds the host version
+            return f.readlines()[1:]
+
+    def test_binary_round_trip(self):
+        pcbnew.SaveBoard(self.bin_name, self.pcb, pcbnew.IO_MGR.KICAD_BINARY)
+        pcb2 = pcbnew.LoadBoard(self.bin_name)
+
+        self.assertNotEqual(pcb2, None)
+        self.assertEqual(len(list(pcb2.GetTracks())), 361)
+        self.assertEqual(len(list(pcb2.GetModules())), 72)
+        self.assertEqual(pcb2.GetNetCount(), 51)
+        self.assertEqual(pcb2.GetAreaCount(), self.pcb.GetAreaCount())
+
+        self.assertEqual(self.save_text(self.pcb, "ref.kicad_pcb"),
+                         self.save_text(pcb2, "round_trip.kicad_pcb"))
+
+    def test_binary_round_trip_demos(self):
+        # the snapshot must be lossless on every board the project ships
+        boards = glob.glob("../demos/*/*.kicad_pcb")
+        self.assertNotEqual(boards, [])
+
+        for name in boards:
+            pcb = pcbnew.LoadBoard(name)
+            pcbnew.SaveBoard(self.bin_name, pcb, pcbnew.IO_MGR.KICAD_BINARY)
+            pcb2 = pcbnew.LoadBoard(self.bin_name)
+
+            self.assertEqual(self.save_text(pcb, "ref.kicad_pcb"),
+                             self.save_text(pcb2, "round_trip.kicad_pcb"), name)
+
+    def test_binary_speed(self):
+        text_name = os.path.join(self.tmpdir, "speed.kicad_pcb")
+        pcbnew.SaveBoard(text_name, self.pcb, pcbnew.IO_MGR.KICAD)
+        pcbnew.SaveBoard(self.bin_name, self.pcb, pcbnew.IO_MGR.KICAD_BINARY)
+
+        start = time.time()
+        for i in range(10):
+            pcbnew.LoadBoard(text_name)
+        text_time = time.time() - start
+
+        start = time.time()
+        for i in range(10):
+            pcbnew.LoadBoard(self.bin_name)
+        bin_time = time.time() - start
+
+        # informational only, timings on shared build machines are too noisy
+        print("\nkicad_pcb load: %.3fs, kicad_pcb_bin load: %.3fs (10 loads each)"
+              % (text_time, bin_time))
+
+    def test_binary_truncated(self):
+        pcbnew.SaveBoard(self.bin_name, self.pcb, pcbnew.IO_MGR.KICAD_BINARY)
+
+        with open(self.bin_name, "rb") as f:
+            data = f.read()
+
+        with open(self.bin_name, "wb") as f:
+            f.write(data[:len(data) // 2])
+
+        self.assertRaises(Exception, pcbnew.LoadBoard, self.bin_name)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,43 @@
+import os
+import tempfile
+import time
+import unittest
+import pcbnew
+
+class TestPCBSave(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = pcbnew.LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.fd, self.fn = tempfile.mkstemp(".kicad_pcb")
+        os.close(self.fd)
+
+    def tearDown(self):
+        os.remove(self.fn)
+
+    def test_pcb_save_reload(self):
+        pcbnew.SaveBoard(self.fn, self.pcb)
+        pcb2 = pcbnew.LoadBoard(self.fn)
+
+        self.assertEqual(len(list(pcb2.GetTracks())), 361)
+        self.assertEqual(len(list(pcb2.GetModules())), 72)
+        self.assertEqual(pcb2.GetNetCount(), 51)
+
+        # saving the reloaded board gives the same file
+        with open(self.fn) as f:
+            first = f.read()
+
+        pcbnew.SaveBoard(self.fn, pcb2)
+
+        with open(self.fn) as f:
+            self.assertEqual(first, f.read())
+
+    def test_pcb_save_speed(self):
+        start = time.time()
+        for i in range(20):
+            pcbnew.SaveBoard(self.fn, self.pcb)
+
+        # informational only, timings on shared build machines are too noisy
+        print("\nkicad_pcb save: %.3fs (20 saves)" % (time.time() - start))
+
+if __name__ == '__main__':
+    unittest.main()
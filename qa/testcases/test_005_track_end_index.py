@@ -0,0 +1,87 @@
+import unittest
+import random
+import pcbnew
+
+from pcbnew import *
+
+# ENDPOINT_T values
+ENDPOINTS = (0, 1)
+
+
+class TestTrackEndIndex(unittest.TestCase):
+
+    def setUp(self):
+        self.pcb = LoadBoard("data/complex_hierarchy.kicad_pcb")
+        random.seed(1)
+
+    def address(self, track):
+        if track is None:
+            return None
+
+        return int(track.this)
+
+    def checkIndex(self, index):
+        # TRACK_END_INDEX.FindConnected() must find the same track as TRACK.GetTrack()
+        first = self.pcb.GetTracks().GetFirst()
+
+        for track in self.pcb.GetTracks():
+            for endpoint in ENDPOINTS:
+                expected = track.GetTrack(first, None, endpoint, True, False)
+                found = index.FindConnected(track, endpoint)
+                self.assertEqual(self.address(found), self.address(expected))
+
+    def removeTracks(self, index, tracks):
+        for track in tracks:
+            index.Remove(track)
+            self.pcb.Remove(track)
+
+    def appendTracks(self, tracks):
+        for track in tracks:
+            self.pcb.AddNative(track, ADD_APPEND)
+            track.thisown = 0
+
+    def checkRandomRemovals(self):
+        index = TRACK_END_INDEX()
+        index.Build(self.pcb.GetTracks().GetFirst())
+        self.checkIndex(index)
+
+        # The removed tracks change the distances in the list and join the runs of
+        # tracks of the same net
+        while self.pcb.GetNumSegmTrack() > 0:
+            tracks = list(self.pcb.GetTracks())
+            self.removeTracks(index, random.sample(tracks, min(len(tracks), 25)))
+            self.checkIndex(index)
+
+    def test_board_order(self):
+        self.checkRandomRemovals()
+
+    def test_shuffled_nets(self):
+        tracks = list(self.pcb.GetTracks())
+        self.removeTracks(TRACK_END_INDEX(), tracks)
+        random.shuffle(tracks)
+        self.appendTracks(tracks)
+        self.checkRandomRemovals()
+
+    def test_interleaved_nets(self):
+        tracks = list(self.pcb.GetTracks())
+        self.removeTracks(TRACK_END_INDEX(), tracks)
+
+        # Alternate the tracks of two nets, then remove the tracks of one of them
+        nets = {}
+
+        for track in tracks:
+            nets.setdefault(track.GetNetCode(), []).append(track)
+
+        first, second = sorted(nets.values(), key=len)[-2:]
+        self.appendTracks([t for pair in zip(first, second) for t in pair])
+
+        index = TRACK_END_INDEX()
+        index.Build(self.pcb.GetTracks().GetFirst())
+        self.checkIndex(index)
+
+        self.removeTracks(index, second[:len(first)])
+        self.checkIndex(index)
+
+
+if __name__ == '__main__':
+    unittest.main()
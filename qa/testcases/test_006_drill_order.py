@@ -0,0 +1,127 @@
+import glob
+import math
+import os
+import random
+import re
+import shutil
+import tempfile
+import unittest
+
+from pcbnew import *
+
+
+COORD = re.compile(r'X(-?[0-9.]+)Y(-?[0-9.]+)')
+
+
+class TestDrillOrder(unittest.TestCase):
+
+    def setUp(self):
+        self.dirs = []
+
+    def tearDown(self):
+        for d in self.dirs:
+            shutil.rmtree(d, ignore_errors=True)
+
+    def write_drill_files(self, board, optimize):
+        """Writes the drill files of board, returns {file name: text}"""
+        d = tempfile.mkdtemp()
+        self.dirs.append(d)
+
+        writer = EXCELLON_WRITER(board)
+        writer.SetOptions(False, False, wxPoint(0, 0), False)
+        writer.SetFormat(True)
+        writer.SetDrillOrderOptimization(optimize)
+        writer.CreateDrillandMapFilesSet(d, True, False)
+
+        files = {}
+
+        for path in glob.glob(os.path.join(d, '*.drl')):
+            with open(path) as f:
+                files[os.path.basename(path)] = f.read()
+
+        return files
+
+    def parse_body(self, text):
+        """Returns ({tool: sorted hole lines}, travel in mm) of a drill file"""
+        holes = {}
+        travel = 0.0
+        last = None
+        tool = None
+        in_body = False
+
+        for line in text.splitlines():
+            if not in_body:
+                # the header ends with a line holding only '%'
+                in_body = line == '%'
+                continue
+
+            if re.match(r'^T[0-9]+$', line):
+                tool = line
+                holes.setdefault(tool, [])
+            elif line.startswith('X'):
+                holes[tool].append(line)
+                m = COORD.match(line)
+                pos = (float(m.group(1)), float(m.group(2)))
+
+                if last is not None:
+                    travel += math.hypot(pos[0] - last[0], pos[1] - last[1])
+
+                last = pos
+
+        for tool in holes:
+            holes[tool].sort()
+
+        return holes, travel
+
+    def compare(self, board):
+        """Checks both orders drill the same holes, returns the travels (sorted, optimized)"""
+        sorted_files = self.write_drill_files(board, False)
+        optimized_files = self.write_drill_files(board, True)
+
+        self.assertTrue(sorted_files)
+        self.assertEqual(sorted(sorted_files.keys()), sorted(optimized_files.keys()))
+
+        sorted_travel = 0.0
+        optimized_travel = 0.0
+
+        for name in sorted_files:
+            sorted_holes, travel = self.parse_body(sorted_files[name])
+            sorted_travel += travel
+            optimized_holes, travel = self.parse_body(optimized_files[name])
+            optimized_travel += travel
+
+            # same tools, same holes for each tool: only the order can change
+            self.assertEqual(sorted_holes, optimized_holes)
+
+        return sorted_travel, optimized_travel
+
+    def test_board_holes(self):
+        board = LoadBoard("data/complex_hierarchy.kicad_pcb")
+        self.compare(board)
+
+    def test_random_vias(self):
+        board = BOARD()
+        board.SetFileName(os.path.join(tempfile.gettempdir(), "drill_order.kicad_pcb"))
+        rng = random.Random(6)
+
+        for i in range(5000):
+            via = VIA(board)
+            via.SetLayerPair(F_Cu, B_Cu)
+            via.SetWidth(FromMM(0.8))
+            via.SetDrill(FromMM(rng.choice([0.3, 0.4, 0.6])))
+            pos = wxPoint(FromMM(rng.uniform(0, 200)), FromMM(rng.uniform(0, 150)))
+            via.SetPosition(pos)
+            via.SetStart(pos)
+            via.SetEnd(pos)
+            via.thisown = 0
+            board.AddNative(via, ADD_APPEND)
+
+        sorted_travel, optimized_travel = self.compare(board)
+
+        print("\n5000 vias on 200 x 150 mm, drill travel: %.0f mm sorted by X then Y, "
+              "%.0f mm optimized" % (sorted_travel, optimized_travel))
+        self.assertLess(optimized_travel, sorted_travel / 2)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,202 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Chains a board outline of 20000 segments with ENDPOINT_INDEX, as
+ * SPECCTRA_DB::fillBOUNDARY() does for the Edge.Cuts graphics.
+ *
+ * The outline is a circle cut in short segments, given in random order and
+ * direction, as from an imported DXF file.  One segment end out of ten is moved by
+ * a few nanometers, so the chaining has to fall back to the closest end point.
+ * The found segments are checked against a linear search for the first steps.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include <endpoint_index.h>
+
+#define SEGMENT_COUNT       20000
+#define RADIUS              50000000    // 50 mm, in nm
+#define TOLERANCE           10000       // 0.01 mm, as for the board perimeter
+#define CHECKED_STEPS       500
+
+
+struct SEGMENT
+{
+    wxPoint m_start;
+    wxPoint m_end;
+    int     m_rank;     // position in the outline
+};
+
+
+static unsigned closeness( const wxPoint& aLeft, const wxPoint& aRight )
+{
+    return unsigned( abs( aLeft.x - aRight.x ) + abs( aLeft.y - aRight.y ) );
+}
+
+
+// The reference: the closest end point of the remaining segments, the first one found
+static int linearFind( const std::vector<SEGMENT>& aSegments, const ENDPOINT_INDEX& aIndex,
+                       const wxPoint& aPoint, unsigned aLimit )
+{
+    unsigned min_d = UINT_MAX;
+    int      found = -1;
+
+    for( unsigned i = 0; i < aSegments.size(); ++i )
+    {
+        if( aIndex.IsRemoved( i ) )
+            continue;
+
+        unsigned d = std::min( closeness( aPoint, aSegments[i].m_start ),
+                               closeness( aPoint, aSegments[i].m_end ) );
+
+        if( d < min_d )
+        {
+            min_d = d;
+            found = i;
+        }
+    }
+
+    return min_d <= aLimit ? found : -1;
+}
+
+
+int main( int argc, char** argv )
+{
+    std::mt19937                    rng( 2017 );
+    std::uniform_int_distribution<> jitter( -TOLERANCE / 4, TOLERANCE / 4 );
+    std::vector<wxPoint>            corners;
+    std::vector<SEGMENT>            segments;
+
+    for( int i = 0; i < SEGMENT_COUNT; ++i )
+    {
+        double angle = 2 * M_PI * i / SEGMENT_COUNT;
+
+        corners.push_back( wxPoint( (int) lround( RADIUS * cos( angle ) ),
+                                    (int) lround( RADIUS * sin( angle ) ) ) );
+    }
+
+    for( int i = 0; i < SEGMENT_COUNT; ++i )
+    {
+        SEGMENT seg;
+
+        seg.m_start = corners[i];
+        seg.m_end   = corners[( i + 1 ) % SEGMENT_COUNT];
+        seg.m_rank  = i;
+
+        if( i % 10 == 0 )
+            seg.m_end += wxPoint( jitter( rng ), jitter( rng ) );
+
+        if( rng() & 1 )
+            std::swap( seg.m_start, seg.m_end );
+
+        segments.push_back( seg );
+    }
+
+    std::shuffle( segments.begin(), segments.end(), rng );
+
+    auto start = std::chrono::steady_clock::now();
+
+    ENDPOINT_INDEX index( TOLERANCE );
+
+    for( const SEGMENT& seg : segments )
+        index.Add( seg.m_start, seg.m_end );
+
+    // Start from the segment with the left most end point, as fillBOUNDARY() does
+    int first = 0;
+
+    for( unsigned i = 0; i < segments.size(); ++i )
+    {
+        if( std::min( segments[i].m_start.x, segments[i].m_end.x )
+            < std::min( segments[first].m_start.x, segments[first].m_end.x ) )
+            first = i;
+    }
+
+    index.Remove( first );
+
+    wxPoint startPt = segments[first].m_end;
+    wxPoint prevPt  = segments[first].m_start;
+    int     prevRank = segments[first].m_rank;
+    int     direction = 0;
+    int     steps = 0;
+
+    for( ;; )
+    {
+        int found = index.Find( prevPt, TOLERANCE );
+
+        if( steps < CHECKED_STEPS )
+        {
+            int expected = linearFind( segments, index, prevPt, TOLERANCE );
+
+            if( found != expected )
+            {
+                printf( "error: step %d, found segment %d instead of %d\n", steps, found,
+                        expected );
+                return 1;
+            }
+        }
+
+        if( found < 0 )
+            break;
+
+        index.Remove( found );
+
+        const SEGMENT& seg = segments[found];
+
+        // The chained segments must follow each other along the outline
+        int delta = ( seg.m_rank - prevRank + SEGMENT_COUNT ) % SEGMENT_COUNT;
+
+        if( direction == 0 )
+            direction = delta;
+
+        if( delta != direction || ( delta != 1 && delta != SEGMENT_COUNT - 1 ) )
+        {
+            printf( "error: step %d, segment %d chained after segment %d\n", steps,
+                    seg.m_rank, prevRank );
+            return 1;
+        }
+
+        prevPt = closeness( prevPt, seg.m_start ) <= closeness( prevPt, seg.m_end ) ?
+                 seg.m_end : seg.m_start;
+        prevRank = seg.m_rank;
+        ++steps;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    printf( "%d segments chained in %.1f ms\n", steps + 1,
+            std::chrono::duration<double, std::milli>( end - start ).count() );
+
+    if( index.Count() != 0 || closeness( startPt, prevPt ) > TOLERANCE )
+    {
+        printf( "error: the outline is not closed, %d segments left\n", index.Count() );
+        return 1;
+    }
+
+    return 0;
+}
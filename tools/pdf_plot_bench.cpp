@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Measures the time needed to plot a multi-sheet schematic to PDF, and the size of
+ * the file, for several compression levels of the page streams.
+ *
+ * The schematic is synthetic: every A3 sheet holds symbol bodies, pins, wires,
+ * junctions and texts, plotted with the calls eeschema uses (in mils), so no
+ * schematic file is needed.
+ *
+ * Usage: pdf_plot_bench [output file]
+ */
+
+#include <stdio.h>
+#include <chrono>
+
+#include <fctsys.h>
+#include <common.h>
+#include <plot_common.h>
+#include <class_page_info.h>
+
+#include <wx/filename.h>
+
+#define SHEET_COUNT         40
+#define SYMBOL_ROWS         12
+#define SYMBOL_COLUMNS      16
+
+
+static void plotSymbol( PLOTTER* aPlotter, const wxPoint& aPos, int aIndex )
+{
+    wxSize textSize( 50, 50 );
+
+    aPlotter->SetColor( RED );
+    aPlotter->Rect( aPos, aPos + wxPoint( 600, 400 ), FILLED_WITH_BG_BODYCOLOR, 10 );
+
+    for( int pin = 0; pin < 4; ++pin )
+    {
+        wxPoint pinPos = aPos + wxPoint( 0, 50 + pin * 100 );
+
+        aPlotter->MoveTo( pinPos );
+        aPlotter->FinishTo( pinPos - wxPoint( 150, 0 ) );
+        aPlotter->Text( pinPos + wxPoint( 20, 0 ), RED, wxString::Format( "IO%d", pin ), 0,
+                        textSize, GR_TEXT_HJUSTIFY_LEFT, GR_TEXT_VJUSTIFY_CENTER, 6,
+                        false, false );
+    }
+
+    aPlotter->Text( aPos + wxPoint( 300, -60 ), RED, wxString::Format( "U%d", aIndex ), 0,
+                    textSize, GR_TEXT_HJUSTIFY_CENTER, GR_TEXT_VJUSTIFY_CENTER, 6,
+                    false, false );
+    aPlotter->Text( aPos + wxPoint( 300, 460 ), RED, wxT( "74HC595" ), 0,
+                    textSize, GR_TEXT_HJUSTIFY_CENTER, GR_TEXT_VJUSTIFY_CENTER, 6,
+                    false, false );
+
+    // Wires and junctions towards the next symbol
+    aPlotter->SetColor( GREEN );
+
+    for( int pin = 0; pin < 4; ++pin )
+    {
+        wxPoint start = aPos + wxPoint( 600, 50 + pin * 100 );
+
+        aPlotter->MoveTo( start );
+        aPlotter->LineTo( start + wxPoint( 100 + pin * 25, 0 ) );
+        aPlotter->FinishTo( start + wxPoint( 100 + pin * 25, 150 ) );
+        aPlotter->Circle( start + wxPoint( 100 + pin * 25, 0 ), 40, FILLED_SHAPE );
+    }
+}
+
+
+static bool plot( const wxString& aFileName, int aLevel )
+{
+    PDF_PLOTTER plotter;
+    PAGE_INFO   page( wxT( "A3" ) );
+
+    plotter.SetDefaultLineWidth( 6 );
+    plotter.SetColorMode( true );
+    plotter.SetCreator( wxT( "pdf_plot_bench" ) );
+    plotter.SetCompressionLevel( aLevel );
+
+    if( !plotter.OpenFile( aFileName ) )
+        return false;
+
+    for( int sheet = 0; sheet < SHEET_COUNT; ++sheet )
+    {
+        plotter.SetPageSettings( page );
+        plotter.SetViewport( wxPoint( 0, 0 ), 0.1, 1.0, false );
+
+        if( sheet == 0 )
+            plotter.StartPlot();
+        else
+            plotter.StartPage();
+
+        for( int row = 0; row < SYMBOL_ROWS; ++row )
+        {
+            for( int col = 0; col < SYMBOL_COLUMNS; ++col )
+            {
+                wxPoint pos( 500 + col * 950, 500 + row * 850 );
+
+                plotSymbol( &plotter, pos, ( sheet * SYMBOL_ROWS + row ) * SYMBOL_COLUMNS + col );
+            }
+        }
+
+        if( sheet < SHEET_COUNT - 1 )
+            plotter.ClosePage();
+    }
+
+    plotter.EndPlot();
+
+    return true;
+}
+
+
+int main( int argc, char** argv )
+{
+    wxString fileName = argc > 1 ? wxString::FromUTF8( argv[1] ) : wxString( "pdf_plot_bench.pdf" );
+    static const int levels[] = { 1, 6, 9 };
+    LOCALE_IO toggle;
+
+    printf( "%d sheets, %d symbols per sheet\n", SHEET_COUNT, SYMBOL_ROWS * SYMBOL_COLUMNS );
+
+    for( int level : levels )
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        if( !plot( fileName, level ) )
+        {
+            printf( "error: cannot create '%s'\n", (const char*) fileName.utf8_str() );
+            return 1;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        printf( "compression level %d: %.1f ms, %lu bytes\n", level,
+                std::chrono::duration<double, std::milli>( end - start ).count(),
+                (unsigned long) wxFileName::GetSize( fileName ).GetValue() );
+    }
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Measures the time needed by the s-expression parser of kicad2step to read a
+ * large .kicad_pcb file.
+ *
+ * Without argument, a board of about 100 MB is generated in memory: footprints
+ * with pads, texts and graphics, and tracks.  With a file name, this file is read
+ * with PARSER::ParseFromFile() instead.  The checksum of the tree is printed so the
+ * results of two versions of the parser can be compared.
+ *
+ * Usage: sexpr_parse_bench [file.kicad_pcb]
+ */
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+
+#include <sexpr/sexpr.h>
+#include <sexpr/sexpr_parser.h>
+
+#define MODULE_COUNT    60000
+#define TRACK_COUNT     400000
+#define RUNS            3
+
+
+static std::string generateBoard()
+{
+    std::string board;
+    char        buf[1024];
+
+    board.reserve( 110 * 1024 * 1024 );
+    board += "(kicad_pcb (version 4) (host pcbnew 4.0.5)\n"
+             "  (general\n    (links 0)\n    (thickness 1.6)\n  )\n"
+             "  (setup\n    (grid_origin 0 0)\n    (aux_axis_origin 0 0)\n  )\n";
+
+    for( int i = 0; i < MODULE_COUNT; ++i )
+    {
+        double x = 10.0 + ( i % 250 ) * 1.27;
+        double y = 10.0 + ( i / 250 ) * 1.27;
+
+        snprintf( buf, sizeof( buf ),
+                  "  (module Resistors_SMD:R_0603 (layer F.Cu) (tedit 58307B86) (tstamp 5834%04X)\n"
+                  "    (at %.3f %.3f %d)\n"
+                  "    (descr \"Resistor SMD 0603, reflow soldering\")\n"
+                  "    (fp_text reference R%d (at 0 -1.9) (layer F.SilkS)\n"
+                  "      (effects (font (size 1 1) (thickness 0.15)))\n    )\n",
+                  i & 0xFFFF, x, y, ( i % 4 ) * 90, i );
+        board += buf;
+
+        snprintf( buf, sizeof( buf ),
+                  "    (fp_line (start -1.3 -0.8) (end 1.3 -0.8) (layer F.CrtYd) (width 0.05))\n"
+                  "    (fp_line (start 1.3 0.8) (end -1.3 0.8) (layer F.CrtYd) (width 0.05))\n"
+                  "    (pad 1 smd rect (at -0.75 0) (size 0.5 0.9) (layers F.Cu F.Paste F.Mask)\n"
+                  "      (net %d \"Net-(R%d-Pad1)\"))\n"
+                  "    (pad 2 smd rect (at 0.75 0) (size 0.5 0.9) (layers F.Cu F.Paste F.Mask)\n"
+                  "      (net %d \"Net-(R%d-Pad2)\"))\n"
+                  "    (model Resistors_SMD.3dshapes/R_0603.wrl\n"
+                  "      (at (xyz 0 0 0))\n      (scale (xyz 1 1 1))\n"
+                  "      (rotate (xyz 0 0 0))\n    )\n  )\n",
+                  2 * i + 1, i, 2 * i + 2, i );
+        board += buf;
+    }
+
+    for( int i = 0; i < TRACK_COUNT; ++i )
+    {
+        snprintf( buf, sizeof( buf ),
+                  "  (segment (start %.4f %.4f) (end %.4f %.4f) (width 0.25) (layer %s) (net %d)"
+                  " (tstamp 58%06X))\n",
+                  10.0 + ( i % 997 ) * 0.3, 10.0 + ( i / 997 ) * 0.2,
+                  10.3 + ( i % 997 ) * 0.3, 10.0 + ( i / 997 ) * 0.2,
+                  ( i & 1 ) ? "B.Cu" : "F.Cu", i % 5000, i & 0xFFFFFF );
+        board += buf;
+    }
+
+    board += "  (gr_line (start 0 0) (end 400 0) (angle 90) (layer Edge.Cuts) (width 0.15))\n)\n";
+
+    return board;
+}
+
+
+struct TREE_STATS
+{
+    size_t   m_lists;
+    size_t   m_atoms;
+    unsigned long long m_checksum;
+};
+
+
+static void hashBytes( TREE_STATS& aStats, const char* aData, size_t aSize )
+{
+    for( size_t i = 0; i < aSize; ++i )
+        aStats.m_checksum = aStats.m_checksum * 131 + (unsigned char) aData[i];
+}
+
+
+static void walk( const SEXPR::SEXPR* aNode, TREE_STATS& aStats )
+{
+    if( aNode->IsList() )
+    {
+        aStats.m_lists++;
+
+        for( size_t i = 0; i < aNode->GetNumberOfChildren(); ++i )
+            walk( aNode->GetChild( i ), aStats );
+
+        hashBytes( aStats, ")", 1 );
+        return;
+    }
+
+    aStats.m_atoms++;
+
+    if( aNode->IsSymbol() )
+    {
+        hashBytes( aStats, aNode->GetSymbol().data(), aNode->GetSymbol().size() );
+    }
+    else if( aNode->IsString() )
+    {
+        hashBytes( aStats, "\"", 1 );
+        hashBytes( aStats, aNode->GetString().data(), aNode->GetString().size() );
+    }
+    else if( aNode->IsInteger() )
+    {
+        long long value = aNode->GetLongInteger();
+        hashBytes( aStats, (const char*) &value, sizeof( value ) );
+    }
+    else if( aNode->IsDouble() )
+    {
+        double value = aNode->GetDouble();
+        hashBytes( aStats, (const char*) &value, sizeof( value ) );
+    }
+}
+
+
+int main( int argc, char** argv )
+{
+    std::string board;
+
+    if( argc < 2 )
+        board = generateBoard();
+
+    double best = 0.0;
+    TREE_STATS stats = { 0, 0, 0 };
+
+    for( int run = 0; run < RUNS; ++run )
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        SEXPR::PARSER parser;
+        SEXPR::SEXPR* root;
+
+        try
+        {
+            root = argc < 2 ? parser.Parse( board ) : parser.ParseFromFile( argv[1] );
+        }
+        catch( ... )
+        {
+            printf( "error: cannot parse the board\n" );
+            return 1;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>( end - start ).count();
+
+        if( run == 0 || ms < best )
+            best = ms;
+
+        if( !root )
+        {
+            printf( "error: no data\n" );
+            return 1;
+        }
+
+        stats.m_lists = stats.m_atoms = 0;
+        stats.m_checksum = 0;
+        walk( root, stats );
+    }
+
+    printf( "%s: %lu lists, %lu atoms (checksum %llx)\n",
+            argc < 2 ? "generated board" : argv[1],
+            (unsigned long) stats.m_lists, (unsigned long) stats.m_atoms, stats.m_checksum );
+    printf( "best of %d runs: %.1f ms\n", RUNS, best );
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Measures the time needed to redraw the texts of a large board with the stroke font,
+ * with the stroked lines of text cache emptied before every redraw and with the cache
+ * kept, as on successive repaints.
+ *
+ * The texts are references and values of 10000 footprints, drawn through
+ * DrawGraphicText() with a segment callback, so no window is needed.
+ */
+
+#include <stdio.h>
+#include <vector>
+#include <chrono>
+
+#include <fctsys.h>
+#include <common.h>
+#include <colors.h>
+#include <drawtxt.h>
+#include <gal/stroke_font.h>
+
+#define FOOTPRINT_COUNT     10000       // a reference and a value each
+#define REDRAW_COUNT        5
+
+
+static long segmentCount;
+
+static void countSegment( int x0, int y0, int xf, int yf )
+{
+    ++segmentCount;
+}
+
+
+struct BENCH_TEXT
+{
+    wxString m_text;
+    wxPoint  m_pos;
+    double   m_orient;
+    wxSize   m_size;
+};
+
+
+static double redraw( const std::vector<BENCH_TEXT>& aTexts, bool aClearCache )
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < REDRAW_COUNT; ++i )
+    {
+        if( aClearCache )
+            KIGFX::STROKE_FONT::ClearTextCache();
+
+        for( const BENCH_TEXT& text : aTexts )
+        {
+            DrawGraphicText( NULL, NULL, text.m_pos, BLACK, text.m_text, text.m_orient,
+                             text.m_size, GR_TEXT_HJUSTIFY_CENTER, GR_TEXT_VJUSTIFY_CENTER,
+                             text.m_size.x / 6, false, false, countSegment );
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>( end - start ).count() / REDRAW_COUNT;
+}
+
+
+int main( int argc, char** argv )
+{
+    static const char* prefixes[] = { "R", "C", "U", "D", "L", "Q", "J", "TP" };
+    static const char* values[] = { "10k", "4k7", "100nF", "1uF", "10uF", "BAT54", "1N4148",
+                                    "BC847", "LM358", "100R", "0R", "22pF", "HDR_1x02" };
+    std::vector<BENCH_TEXT> texts;
+
+    for( int i = 0; i < FOOTPRINT_COUNT; ++i )
+    {
+        BENCH_TEXT text;
+        wxPoint    pos( ( i % 100 ) * 5000000, ( i / 100 ) * 5000000 );
+
+        text.m_orient = ( i % 4 ) * 900;
+        text.m_size   = wxSize( 1000000, 1000000 );
+
+        text.m_text = wxString::Format( "%s%d", prefixes[i % 8], i / 8 + 1 );
+        text.m_pos  = pos;
+        texts.push_back( text );
+
+        text.m_text = values[i % 13];
+        text.m_pos  = pos + wxPoint( 0, 1500000 );
+        texts.push_back( text );
+    }
+
+    segmentCount = 0;
+    double cold = redraw( texts, true );
+    long   coldSegments = segmentCount;
+
+    redraw( texts, false );    // fill the cache
+
+    segmentCount = 0;
+    double warm = redraw( texts, false );
+
+    printf( "%u texts, %ld segments per redraw\n", (unsigned) texts.size(),
+            coldSegments / REDRAW_COUNT );
+    printf( "redraw, cache emptied each time: %.1f ms\n", cold );
+    printf( "redraw, cache kept:              %.1f ms\n", warm );
+
+    if( segmentCount != coldSegments )
+    {
+        printf( "error: %ld segments drawn with the cache, %ld without\n",
+                segmentCount, coldSegments );
+        return 1;
+    }
+
+    return 0;
+}
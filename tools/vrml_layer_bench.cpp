@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2017 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/*
+ * Measures the time needed by VRML_LAYER to triangulate a dense copper layer, as
+ * the VRML exporter of pcbnew does: a grid of pads joined by tracks, with a via
+ * drilled in each pad, tesselated with the holes layer and converted to indexed
+ * triangles.
+ *
+ * Usage: vrml_layer_bench [number of runs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include <vrml_layer.h>
+
+#define PAD_ROWS        60
+#define PAD_COLUMNS     60
+#define PITCH           2.54        // mm
+#define PAD_RADIUS      0.8
+#define DRILL_RADIUS    0.4
+#define TRACK_WIDTH     0.25
+
+
+static void buildLayers( VRML_LAYER& aCopper, VRML_LAYER& aHoles )
+{
+    aCopper.SetArcParams( 48, 0.1, 0.5 );
+    aHoles.SetArcParams( 48, 0.1, 0.5 );
+
+    for( int row = 0; row < PAD_ROWS; ++row )
+    {
+        for( int col = 0; col < PAD_COLUMNS; ++col )
+        {
+            double x = col * PITCH;
+            double y = row * PITCH;
+
+            if( ( row + col ) & 1 )
+                aCopper.AddSlot( x, y, 2.4 * PAD_RADIUS, 1.6 * PAD_RADIUS, 30.0 * col );
+            else
+                aCopper.AddCircle( x, y, PAD_RADIUS );
+
+            aHoles.AddCircle( x, y, DRILL_RADIUS, true, true );
+
+            // Tracks towards the next pads, overlapping the pads as in a real layer
+            if( col + 1 < PAD_COLUMNS )
+                aCopper.AddSlot( x + PITCH / 2, y, PITCH, TRACK_WIDTH, 0.0 );
+
+            if( row + 1 < PAD_ROWS && col % 3 == 0 )
+                aCopper.AddSlot( x + PITCH / 4, y + PITCH / 2, PITCH * 1.1, TRACK_WIDTH, 66.0 );
+        }
+    }
+}
+
+
+int main( int argc, char** argv )
+{
+    int runs = argc > 1 ? atoi( argv[1] ) : 3;
+    double best[3] = { 0.0, 0.0, 0.0 };     // build, tesselate and index times
+    size_t vertexCount = 0;
+    size_t planeCount = 0;
+    size_t sideCount = 0;
+    unsigned long long checksum = 0;
+
+    for( int run = 0; run < runs; ++run )
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        VRML_LAYER copper;
+        VRML_LAYER holes;
+
+        buildLayers( copper, holes );
+
+        auto built = std::chrono::steady_clock::now();
+
+        if( !copper.Tesselate( &holes ) )
+        {
+            printf( "error: %s\n", copper.GetError().c_str() );
+            return 1;
+        }
+
+        auto tesselated = std::chrono::steady_clock::now();
+
+        std::vector< double > vertices;
+        std::vector< int > idxPlane;
+        std::vector< int > idxSide;
+
+        if( !copper.Get3DTriangles( vertices, idxPlane, idxSide, 0.035, 0.0 ) )
+        {
+            printf( "error: %s\n", copper.GetError().c_str() );
+            return 1;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        double ms[3] = { std::chrono::duration<double, std::milli>( built - start ).count(),
+                         std::chrono::duration<double, std::milli>( tesselated - built ).count(),
+                         std::chrono::duration<double, std::milli>( end - tesselated ).count() };
+
+        for( int i = 0; i < 3; ++i )
+        {
+            if( run == 0 || ms[i] < best[i] )
+                best[i] = ms[i];
+        }
+
+        vertexCount = vertices.size() / 3;
+        planeCount = idxPlane.size() / 3;
+        sideCount = idxSide.size() / 3;
+        checksum = 0;
+
+        for( size_t i = 0; i < idxPlane.size(); ++i )
+            checksum = checksum * 31 + idxPlane[i];
+
+        for( size_t i = 0; i < idxSide.size(); ++i )
+            checksum = checksum * 31 + idxSide[i];
+    }
+
+    printf( "%d pads: %lu vertices, %lu plane and %lu side triangles (checksum %llx)\n",
+            PAD_ROWS * PAD_COLUMNS, (unsigned long) vertexCount, (unsigned long) planeCount,
+            (unsigned long) sideCount, checksum );
+    printf( "best of %d runs: build %.1f ms, tesselate %.1f ms, index %.1f ms\n", runs,
+            best[0], best[1], best[2] );
+
+    return 0;
+}
@@ -35,6 +35,7 @@
 #include <string>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 #include <vrml_layer.h>
 
 #ifndef CALLBACK
@@ -243,26 +244,13 @@ bool VRML_LAYER::SetArcParams( int aMaxSeg, double aMinLength, double aMaxLength
 // clear all data
 void VRML_LAYER::Clear( void )
 {
-    int i;
-
     fix = false;
     idx = 0;
 
-    for( i = contours.size(); i > 0; --i )
-    {
-        delete contours.back();
-        contours.pop_back();
-    }
-
+    contours.clear();
     pth.clear();
-
     areas.clear();
-
-    for( i = vertices.size(); i > 0; --i )
-    {
-        delete vertices.back();
-        vertices.pop_back();
-    }
+    vertices.clear();
 
     clearTmp();
 }
@@ -281,29 +269,17 @@ void VRML_LAYER::clearTmp( void )
 
     triplets.clear();
     solid.clear();
-
-    for( i = outline.size(); i > 0; --i )
-    {
-        delete outline.back();
-        outline.pop_back();
-    }
-
+    outline.clear();
     ordmap.clear();
+    extra_verts.clear();
 
-    for( i = extra_verts.size(); i > 0; --i )
-    {
-        delete extra_verts.back();
-        extra_verts.pop_back();
-    }
-
-    // note: unlike outline and extra_verts,
-    // vlist is not responsible for memory management
+    // note: vlist points to vertices held by this object (or the holes object)
     vlist.clear();
 
     // go through the vertex list and reset ephemeral parameters
     for( i = 0; i < vertices.size(); ++i )
     {
-        vertices[i]->o = -1;
+        vertices[i].o = -1;
     }
 }
 
@@ -315,12 +291,7 @@ int VRML_LAYER::NewContour(  bool aPlatedHole )
     if( fix )
         return -1;
 
-    std::list<int>* contour = new std::list<int>;
-
-    if( !contour )
-        return -1;
-
-    contours.push_back( contour );
+    contours.push_back( std::vector<int>() );
     areas.push_back( 0.0 );
 
     pth.push_back( aPlatedHole );
@@ -346,30 +317,25 @@ bool VRML_LAYER::AddVertex( int aContourID, double aXpos, double aYpos )
         return false;
     }
 
-    VERTEX_3D* vertex = new VERTEX_3D;
+    std::vector<int>& contour = contours[aContourID];
 
-    if( !vertex )
+    if( !contour.empty() )
     {
-        error = "AddVertex(): a new vertex could not be allocated";
-        return false;
-    }
+        const VERTEX_3D& v2 = vertices[ contour.back() ];
 
-    vertex->x   = aXpos;
-    vertex->y   = aYpos;
-    vertex->i   = idx++;
-    vertex->o   = -1;
-    vertex->pth = pth[ aContourID ];
+        areas[aContourID] += ( aXpos - v2.x ) * ( aYpos + v2.y );
+    }
 
-    VERTEX_3D* v2 = NULL;
+    VERTEX_3D vertex;
 
-    if( contours[aContourID]->size() > 0 )
-        v2 = vertices[ contours[aContourID]->back() ];
+    vertex.x   = aXpos;
+    vertex.y   = aYpos;
+    vertex.i   = idx++;
+    vertex.o   = -1;
+    vertex.pth = pth[ aContourID ];
 
     vertices.push_back( vertex );
-    contours[aContourID]->push_back( vertex->i );
-
-    if( v2 )
-        areas[aContourID] += ( aXpos - v2->x ) * ( aYpos + v2->y );
+    contour.push_back( vertex.i );
 
     return true;
 }
@@ -385,9 +351,9 @@ bool VRML_LAYER::EnsureWinding( int aContourID, bool aHoleFlag )
         return false;
     }
 
-    std::list<int>* cp = contours[aContourID];
+    std::vector<int>& cp = contours[aContourID];
 
-    if( cp->size() < 3 )
+    if( cp.size() < 3 )
     {
         error = "EnsureWinding(): there are fewer than 3 vertices";
         return false;
@@ -395,15 +361,15 @@ bool VRML_LAYER::EnsureWinding( int aContourID, bool aHoleFlag )
 
     double dir = areas[aContourID];
 
-    VERTEX_3D* vp0 = vertices[ cp->back() ];
-    VERTEX_3D* vp1 = vertices[ cp->front() ];
+    const VERTEX_3D& vp0 = vertices[ cp.back() ];
+    const VERTEX_3D& vp1 = vertices[ cp.front() ];
 
-    dir += ( vp1->x - vp0->x ) * ( vp1->y + vp0->y );
+    dir += ( vp1.x - vp0.x ) * ( vp1.y + vp0.y );
 
     // if dir is positive, winding is CW
     if( ( aHoleFlag && dir < 0 ) || ( !aHoleFlag && dir > 0 ) )
     {
-        cp->reverse();
+        std::reverse( cp.begin(), cp.end() );
         areas[aContourID] = -areas[aContourID];
     }
 
@@ -762,12 +728,12 @@ bool VRML_LAYER::Tesselate( VRML_LAYER* holes, bool aHolesOnly )
     {
         for( unsigned int i = 0; i < contours.size(); ++i )
         {
-            if( contours[i]->size() < 3 )
+            if( contours[i].size() < 3 )
                 continue;
 
-            VERTEX_3D* vp0 = vertices[ contours[i]->back() ];
-            VERTEX_3D* vp1 = vertices[ contours[i]->front() ];
-            areas[i] += ( vp1->x - vp0->x ) * ( vp1->y + vp0->y );
+            const VERTEX_3D& vp0 = vertices[ contours[i].back() ];
+            const VERTEX_3D& vp1 = vertices[ contours[i].front() ];
+            areas[i] += ( vp1.x - vp0.x ) * ( vp1.y + vp0.y );
         }
     }
 
@@ -788,6 +754,11 @@ bool VRML_LAYER::Tesselate( VRML_LAYER* holes, bool aHolesOnly )
 
     eidx = idx + hidx;
 
+    // every vertex is usually part of the result, and there are about as many
+    // triangles as vertices
+    ordmap.reserve( eidx );
+    triplets.reserve( eidx );
+
     if( aHolesOnly && ( checkNContours( true ) == 0 ) )
     {
         error = "tesselate(): no hole contours";
@@ -858,24 +829,19 @@ bool VRML_LAYER::Tesselate( VRML_LAYER* holes, bool aHolesOnly )
 
     // erase the previous outline data and vertex order
     // but preserve the extra vertices
-    while( !outline.empty() )
-    {
-        delete outline.back();
-        outline.pop_back();
-    }
-
+    outline.clear();
     ordmap.clear();
     ord = 0;
 
     // go through the vertex lists and reset ephemeral parameters
     for( unsigned int i = 0; i < vertices.size(); ++i )
     {
-        vertices[i]->o = -1;
+        vertices[i].o = -1;
     }
 
     for( unsigned int i = 0; i < extra_verts.size(); ++i )
     {
-        extra_verts[i]->o = -1;
+        extra_verts[i].o = -1;
     }
 
     // close the polygon; this creates the outline points
@@ -910,33 +876,24 @@ bool VRML_LAYER::pushOutline( VRML_LAYER* holes )
         return false;
     }
 
-    std::list<std::list<int>*>::const_iterator obeg = outline.begin();
-    std::list<std::list<int>*>::const_iterator oend = outline.end();
-
     int nc = 0; // number of contours pushed
 
     int pi;
-    std::list<int>::const_iterator  begin;
-    std::list<int>::const_iterator  end;
     GLdouble pt[3];
     VERTEX_3D* vp;
 
-    while( obeg != oend )
+    for( size_t oi = 0; oi < outline.size(); ++oi )
     {
-        if( (*obeg)->size() < 3 )
-        {
-            ++obeg;
+        const std::vector<int>& loop = outline[oi];
+
+        if( loop.size() < 3 )
             continue;
-        }
 
         gluTessBeginContour( tess );
 
-        begin = (*obeg)->begin();
-        end = (*obeg)->end();
-
-        while( begin != end )
+        for( size_t li = 0; li < loop.size(); ++li )
         {
-            pi = *begin;
+            pi = loop[li];
 
             if( pi < 0 || (unsigned int) pi > ordmap.size() )
             {
@@ -961,11 +918,9 @@ bool VRML_LAYER::pushOutline( VRML_LAYER* holes )
             pt[1]   = vp->y;
             pt[2]   = 0.0;
             gluTessVertex( tess, pt, vp );
-            ++begin;
         }
 
         gluTessEndContour( tess );
-        ++obeg;
         ++nc;
     }
 
@@ -1122,8 +1077,8 @@ bool VRML_LAYER::WriteIndices( bool aTopFlag, std::ofstream& aOutFile )
     }
 
     // go through the triplet list and write out the indices based on order
-    std::list<TRIPLET_3D>::const_iterator   tbeg    = triplets.begin();
-    std::list<TRIPLET_3D>::const_iterator   tend    = triplets.end();
+    std::vector<TRIPLET_3D>::const_iterator   tbeg    = triplets.begin();
+    std::vector<TRIPLET_3D>::const_iterator   tend    = triplets.end();
 
     int i = 1;
 
@@ -1180,8 +1135,8 @@ bool VRML_LAYER::Write3DIndices( std::ofstream& aOutFile, bool aIncludePlatedHol
         mark = ',';
 
         // go through the triplet list and write out the indices based on order
-        std::list<TRIPLET_3D>::const_iterator   tbeg    = triplets.begin();
-        std::list<TRIPLET_3D>::const_iterator   tend    = triplets.end();
+        std::vector<TRIPLET_3D>::const_iterator   tbeg    = triplets.begin();
+        std::vector<TRIPLET_3D>::const_iterator   tend    = triplets.end();
 
         // print out the top vertices
         aOutFile << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
@@ -1229,16 +1184,16 @@ bool VRML_LAYER::Write3DIndices( std::ofstream& aOutFile, bool aIncludePlatedHol
     int curPoint;
     int curContour = 0;
 
-    std::list<std::list<int>*>::const_iterator  obeg    = outline.begin();
-    std::list<std::list<int>*>::const_iterator  oend    = outline.end();
-    std::list<int>* cp;
-    std::list<int>::const_iterator  cbeg;
-    std::list<int>::const_iterator  cend;
+    std::vector< std::vector<int> >::const_iterator  obeg    = outline.begin();
+    std::vector< std::vector<int> >::const_iterator  oend    = outline.end();
+    const std::vector<int>* cp;
+    std::vector<int>::const_iterator  cbeg;
+    std::vector<int>::const_iterator  cend;
 
     i = 2;
     while( obeg != oend )
     {
-        cp = *obeg;
+        cp = &*obeg;
 
         if( cp->size() < 3 )
         {
@@ -1299,7 +1254,7 @@ bool VRML_LAYER::Write3DIndices( std::ofstream& aOutFile, bool aIncludePlatedHol
 
         // check if the loop needs to be closed
         cbeg = cp->begin();
-        cend = --cp->end();
+        cend = cp->end() - 1;
 
         curPoint = *(cbeg);
         lastPoint  = *(cend);
@@ -1381,26 +1336,21 @@ bool VRML_LAYER::addTriplet( VERTEX_3D* p0, VERTEX_3D* p1, VERTEX_3D* p2 )
 // add an extra vertex (to be called only by the COMBINE callback)
 VERTEX_3D* VRML_LAYER::AddExtraVertex( double aXpos, double aYpos, bool aPlatedHole )
 {
-    VERTEX_3D* vertex = new VERTEX_3D;
-
-    if( !vertex )
-    {
-        error = "AddExtraVertex(): could not allocate a new vertex";
-        return NULL;
-    }
-
     if( eidx == 0 )
         eidx = idx + hidx;
 
-    vertex->x   = aXpos;
-    vertex->y   = aYpos;
-    vertex->i   = eidx++;
-    vertex->o   = -1;
-    vertex->pth = aPlatedHole;
+    VERTEX_3D vertex;
+
+    vertex.x   = aXpos;
+    vertex.y   = aYpos;
+    vertex.i   = eidx++;
+    vertex.o   = -1;
+    vertex.pth = aPlatedHole;
 
+    // the deque allocates the vertices in blocks and never moves them
     extra_verts.push_back( vertex );
 
-    return vertex;
+    return &extra_verts.back();
 }
 
 
@@ -1409,8 +1359,7 @@ void VRML_LAYER::glStart( GLenum cmd )
 {
     glcmd = cmd;
 
-    while( !vlist.empty() )
-        vlist.pop_back();
+    vlist.clear();
 }
 
 
@@ -1435,10 +1384,11 @@ void VRML_LAYER::glEnd( void )
     case GL_LINE_LOOP:
         {
             // add the loop to the list of outlines
-            std::list<int>* loop = new std::list<int>;
+            outline.push_back( std::vector<int>() );
+
+            std::vector<int>& loop = outline.back();
 
-            if( !loop )
-                break;
+            loop.reserve( vlist.size() );
 
             double firstX = 0.0;
             double firstY = 0.0;
@@ -1449,7 +1399,7 @@ void VRML_LAYER::glEnd( void )
 
             if( vlist.size() > 0 )
             {
-                loop->push_back( vlist[0]->o );
+                loop.push_back( vlist[0]->o );
                 firstX = vlist[0]->x;
                 firstY = vlist[0]->y;
                 lastX = firstX;
@@ -1458,7 +1408,7 @@ void VRML_LAYER::glEnd( void )
 
             for( size_t i = 1; i < vlist.size(); ++i )
             {
-                loop->push_back( vlist[i]->o );
+                loop.push_back( vlist[i]->o );
                 curX = vlist[i]->x;
                 curY = vlist[i]->y;
                 area += ( curX - lastX ) * ( curY + lastY );
@@ -1468,8 +1418,6 @@ void VRML_LAYER::glEnd( void )
 
             area += ( firstX - lastX ) * ( firstY + lastY );
 
-            outline.push_back( loop );
-
             if( area <= 0.0 )
                 solid.push_back( true );
             else
@@ -1493,8 +1441,7 @@ void VRML_LAYER::glEnd( void )
         break;
     }
 
-    while( !vlist.empty() )
-        vlist.pop_back();
+    vlist.clear();
 
     glcmd = 0;
 }
@@ -1598,7 +1545,7 @@ int VRML_LAYER::checkNContours( bool holes )
 
     for( size_t i = 0; i < contours.size(); ++i )
     {
-        if( contours[i]->size() < 3 )
+        if( contours[i].size() < 3 )
             continue;
 
         if( ( holes && areas[i] <= 0.0 ) || ( !holes && areas[i] > 0.0 ) )
@@ -1617,14 +1564,14 @@ void VRML_LAYER::pushVertices( bool holes )
     // push the internally held vertices
     unsigned int i;
 
-    std::list<int>::const_iterator  begin;
-    std::list<int>::const_iterator  end;
+    std::vector<int>::const_iterator  begin;
+    std::vector<int>::const_iterator  end;
     GLdouble pt[3];
     VERTEX_3D* vp;
 
     for( i = 0; i < contours.size(); ++i )
     {
-        if( contours[i]->size() < 3 )
+        if( contours[i].size() < 3 )
             continue;
 
         if( ( holes && areas[i] <= 0.0 ) || ( !holes && areas[i] > 0.0 ) )
@@ -1632,12 +1579,12 @@ void VRML_LAYER::pushVertices( bool holes )
 
         gluTessBeginContour( tess );
 
-        begin = contours[i]->begin();
-        end = contours[i]->end();
+        begin = contours[i].begin();
+        end = contours[i].end();
 
         while( begin != end )
         {
-            vp = vertices[ *begin ];
+            vp = &vertices[ *begin ];
             pt[0]   = vp->x;
             pt[1]   = vp->y;
             pt[2]   = 0.0;
@@ -1663,12 +1610,12 @@ VERTEX_3D* VRML_LAYER::getVertexByIndex( int aPointIndex, VRML_LAYER* holes )
     if( aPointIndex < idx )
     {
         // vertex is in the vertices[] list
-        return vertices[ aPointIndex ];
+        return &vertices[ aPointIndex ];
     }
     else if( aPointIndex >= idx + hidx )
     {
         // vertex is in the extra_verts[] list
-        return extra_verts[aPointIndex - idx - hidx];
+        return &extra_verts[aPointIndex - idx - hidx];
     }
 
     // vertex is in the holes object
@@ -1722,30 +1669,30 @@ int VRML_LAYER::Import( int start, GLUtesselator* tess )
     // renumber from 'start'
     for( i = 0, j = vertices.size(); i < j; ++i )
     {
-        vertices[i]->i = start++;
-        vertices[i]->o = -1;
+        vertices[i].i = start++;
+        vertices[i].o = -1;
     }
 
     // push each contour to the tesselator
     VERTEX_3D* vp;
     GLdouble pt[3];
 
-    std::list<int>::const_iterator cbeg;
-    std::list<int>::const_iterator cend;
+    std::vector<int>::const_iterator cbeg;
+    std::vector<int>::const_iterator cend;
 
     for( i = 0; i < contours.size(); ++i )
     {
-        if( contours[i]->size() < 3 )
+        if( contours[i].size() < 3 )
             continue;
 
-        cbeg = contours[i]->begin();
-        cend = contours[i]->end();
+        cbeg = contours[i].begin();
+        cend = contours[i].end();
 
         gluTessBeginContour( tess );
 
         while( cbeg != cend )
         {
-            vp = vertices[ *cbeg++ ];
+            vp = &vertices[ *cbeg++ ];
             pt[0] = vp->x;
             pt[1] = vp->y;
             pt[2] = 0.0;
@@ -1762,7 +1709,13 @@ int VRML_LAYER::Import( int start, GLUtesselator* tess )
 // return the vertex identified by index
 VERTEX_3D* VRML_LAYER::GetVertexByIndex( int aPointIndex )
 {
-    int i0 = vertices[0]->i;
+    if( vertices.empty() )
+    {
+        error = "GetVertexByIndex(): no vertices";
+        return NULL;
+    }
+
+    int i0 = vertices[0].i;
 
     if( aPointIndex < i0 || aPointIndex >= ( i0 + (int) vertices.size() ) )
     {
@@ -1770,7 +1723,7 @@ VERTEX_3D* VRML_LAYER::GetVertexByIndex( int aPointIndex )
         return NULL;
     }
 
-    return vertices[aPointIndex - i0];
+    return &vertices[aPointIndex - i0];
 }
 
 
@@ -1815,6 +1768,8 @@ bool VRML_LAYER::Get3DTriangles( std::vector< double >& aVertexList,
     size_t i;
     size_t vsize = ordmap.size();
 
+    aVertexList.reserve( vsize * 6 );
+
     // top vertices
     for( i = 0; i < vsize; ++i )
     {
@@ -1841,35 +1796,47 @@ bool VRML_LAYER::Get3DTriangles( std::vector< double >& aVertexList,
         aVertexList.push_back( aBotZ );
     }
 
-    // create the index lists .. it is difficult to estimate the list size
-    // a priori so instead we use a vector to help
+    // create the index lists; each side of each outline gives 2 triangles
+    size_t nsides = 0;
+
+    for( i = 0; i < outline.size(); ++i )
+    {
+        if( outline[i].size() >= 3 )
+            nsides += outline[i].size();
+    }
+
+    aIndexPlane.reserve( triplets.size() * 6 );
+    aIndexSide.reserve( nsides * 6 );
 
     bool holes_only = triplets.empty();
 
     if( !holes_only )
     {
         // go through the triplet list and write out the indices based on order
-        std::list< TRIPLET_3D >::const_iterator tbeg = triplets.begin();
-        std::list< TRIPLET_3D >::const_iterator tend = triplets.end();
-
-        std::vector< int > aIndexBot;
+        std::vector< TRIPLET_3D >::const_iterator tbeg = triplets.begin();
+        std::vector< TRIPLET_3D >::const_iterator tend = triplets.end();
 
+        // top vertices
         while( tbeg != tend )
         {
-            // top vertices
             aIndexPlane.push_back( (int) tbeg->i1 );
             aIndexPlane.push_back( (int) tbeg->i2 );
             aIndexPlane.push_back( (int) tbeg->i3 );
 
-            // bottom vertices
-            aIndexBot.push_back( (int) ( tbeg->i2 + vsize ) );
-            aIndexBot.push_back( (int) ( tbeg->i1 + vsize ) );
-            aIndexBot.push_back( (int) ( tbeg->i3 + vsize ) );
-
             ++tbeg;
         }
 
-        aIndexPlane.insert( aIndexPlane.end(), aIndexBot.begin(), aIndexBot.end() );
+        // bottom vertices
+        tbeg = triplets.begin();
+
+        while( tbeg != tend )
+        {
+            aIndexPlane.push_back( (int) ( tbeg->i2 + vsize ) );
+            aIndexPlane.push_back( (int) ( tbeg->i1 + vsize ) );
+            aIndexPlane.push_back( (int) ( tbeg->i3 + vsize ) );
+
+            ++tbeg;
+        }
     }
 
     // compile indices for the walls joining top to bottom
@@ -1877,16 +1844,16 @@ bool VRML_LAYER::Get3DTriangles( std::vector< double >& aVertexList,
     int curPoint;
     int curContour = 0;
 
-    std::list< std::list< int >* >::const_iterator  obeg = outline.begin();
-    std::list< std::list< int >* >::const_iterator  oend = outline.end();
-    std::list< int >* cp;
-    std::list< int >::const_iterator  cbeg;
-    std::list< int >::const_iterator  cend;
+    std::vector< std::vector< int > >::const_iterator  obeg = outline.begin();
+    std::vector< std::vector< int > >::const_iterator  oend = outline.end();
+    const std::vector< int >* cp;
+    std::vector< int >::const_iterator  cbeg;
+    std::vector< int >::const_iterator  cend;
 
     i = 2;
     while( obeg != oend )
     {
-        cp = *obeg;
+        cp = &*obeg;
 
         if( cp->size() < 3 )
         {
@@ -1929,7 +1896,7 @@ bool VRML_LAYER::Get3DTriangles( std::vector< double >& aVertexList,
 
         // check if the loop needs to be closed
         cbeg = cp->begin();
-        cend = --cp->end();
+        cend = cp->end() - 1;
 
         curPoint = *(cbeg);
         lastPoint  = *(cend);
@@ -1980,6 +1947,8 @@ bool VRML_LAYER::Get2DTriangles( std::vector< double >& aVertexList,
     size_t i;
     size_t vsize = ordmap.size();
 
+    aVertexList.reserve( vsize * 3 );
+
     // vertices
     for( i = 0; i < vsize; ++i )
     {
@@ -1996,17 +1965,14 @@ bool VRML_LAYER::Get2DTriangles( std::vector< double >& aVertexList,
         aVertexList.push_back( aHeight );
     }
 
-    // create the index lists .. it is difficult to estimate the list size
-    // a priori so instead we use a vector to help
-
     if( triplets.empty() )
         return false;
 
-    // go through the triplet list and write out the indices based on order
-    std::list< TRIPLET_3D >::const_iterator tbeg = triplets.begin();
-    std::list< TRIPLET_3D >::const_iterator tend = triplets.end();
+    aIndexPlane.reserve( triplets.size() * 3 );
 
-    std::vector< int > aIndexBot;
+    // go through the triplet list and write out the indices based on order
+    std::vector< TRIPLET_3D >::const_iterator tbeg = triplets.begin();
+    std::vector< TRIPLET_3D >::const_iterator tend = triplets.end();
 
     if( aTopPlane )
     {
@@ -51,6 +51,7 @@
 
 #include <fstream>
 #include <vector>
+#include <deque>
 #include <list>
 #include <utility>
 
@@ -100,20 +101,23 @@ private:
     bool    fix;                            // when true, no more vertices may be added by the user
     int     idx;                            // vertex index (number of contained vertices)
     int     ord;                            // vertex order (number of ordered vertices)
-    std::vector<VERTEX_3D*> vertices;       // vertices of all contours
-    std::vector<std::list<int>*> contours;  // lists of vertices for each contour
+    std::vector<VERTEX_3D> vertices;        // vertices of all contours; they do not move
+                                            // once 'fix' is set
+    std::vector< std::vector<int> > contours;   // lists of vertices for each contour
     std::vector<bool>pth;                   // indicates whether a 'contour' is a PTH or not
     std::vector<bool>solid;                 // indicates whether a 'contour' is a solid or a hole
     std::vector< double > areas;            // area of the contours (positive if winding is CCW)
-    std::list<TRIPLET_3D> triplets;         // output facet triplet list (triplet of ORDER values)
-    std::list<std::list<int>*> outline;     // indices for outline outputs (index by ORDER values)
+    std::vector<TRIPLET_3D> triplets;       // output facet triplet list (triplet of ORDER values)
+    std::vector< std::vector<int> > outline;    // indices for outline outputs (index by ORDER values)
     std::vector<int> ordmap;                // mapping of ORDER to INDEX
 
     std::string error;                      // error message
 
     int hidx;                               // number of vertices in the holes
     int eidx;                               // index for extra vertices
-    std::vector<VERTEX_3D*> extra_verts;    // extra vertices added for outlines and facets
+    std::deque<VERTEX_3D> extra_verts;      // extra vertices added for outlines and facets; a
+                                            // deque so the vertices given to the tesselator
+                                            // do not move when more are added
     std::vector<VERTEX_3D*> vlist;          // vertex list for the GL command in progress
     VRML_LAYER* pholes;                     // pointer to another layer object used for tesselation;
                                             // this object is normally expected to hold only holes
@@ -77,7 +77,7 @@ namespace SEXPR
         return static_cast<SEXPR_LIST const *>(this)->m_children.size();
     }
 
-    std::string const & SEXPR::GetString() const
+    STRING_VIEW SEXPR::GetString() const
     {
         if (m_type != SEXPR_TYPE_ATOM_STRING)
         {
@@ -125,7 +125,7 @@ namespace SEXPR
         return static_cast<float>(GetDouble());
     }
 
-    std::string const & SEXPR::GetSymbol() const
+    STRING_VIEW SEXPR::GetSymbol() const
     {
         if (m_type != SEXPR_TYPE_ATOM_SYMBOL)
         {
@@ -176,11 +176,11 @@ namespace SEXPR
         }
         else if (IsString())
         {
-            result += "\"" + GetString() + "\"";
+            result += "\"" + GetString().str() + "\"";
         }
         else if (IsSymbol())
         {
-            result += GetSymbol();
+            result += GetSymbol().str();
         }
         else if (IsInteger())
         {
@@ -20,6 +20,8 @@
 #define SEXPR_H_
 
 #include <cstdint>
+#include <cstring>
+#include <ostream>
 #include <string>
 #include <vector>
 #include "sexpr/isexprable.h"
@@ -42,6 +44,45 @@ namespace SEXPR
 
 	typedef std::vector<class SEXPR *> SEXPR_VECTOR;
 
+	/**
+	 * A read only view of characters owned by someone else: the buffer of the
+	 * PARSER for the atoms read from a file, else the atom itself.
+	 * It converts implicitly to std::string, which makes a copy.
+	 */
+	class STRING_VIEW
+	{
+	public:
+		STRING_VIEW() : m_data(""), m_size(0) {};
+		STRING_VIEW(const char* data, size_t size) : m_data(data), m_size(size) {};
+		explicit STRING_VIEW(const std::string& str) : m_data(str.data()), m_size(str.size()) {};
+
+		const char* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		std::string str() const { return std::string(m_data, m_size); }
+		operator std::string() const { return str(); }
+
+		bool operator==(const STRING_VIEW& other) const
+		{
+			return m_size == other.m_size && memcmp(m_data, other.m_data, m_size) == 0;
+		}
+
+		bool operator==(const std::string& other) const { return *this == STRING_VIEW(other); }
+		bool operator==(const char* other) const { return *this == STRING_VIEW(other, strlen(other)); }
+
+		template <typename T>
+		bool operator!=(const T& other) const { return !(*this == other); }
+
+	private:
+		const char* m_data;
+		size_t m_size;
+	};
+
+	inline std::ostream& operator<<(std::ostream& stream, const STRING_VIEW& view)
+	{
+		return stream.write(view.data(), view.size());
+	}
+
 	class SEXPR
 	{
 	protected:
@@ -65,8 +106,8 @@ namespace SEXPR
 		int32_t GetInteger() const;
 		float GetFloat() const;
 		double GetDouble() const;
-		std::string const & GetString() const;
-		std::string const & GetSymbol() const;
+		STRING_VIEW GetString() const;
+		STRING_VIEW GetSymbol() const;
 		SEXPR_LIST* GetList();
 		std::string AsString(size_t level = 0);
 		size_t GetLineNumber() { return m_lineNumber; }
@@ -86,18 +127,31 @@ namespace SEXPR
 		SEXPR_DOUBLE(double value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_DOUBLE, lineNumber), m_value(value) {};
 	};
 
+	/**
+	 * The text of an atom built from a std::string is stored in the atom; the atoms
+	 * read by the PARSER only point into its buffer.  The atoms cannot be copied, as
+	 * the copy would point to the text of the original.
+	 */
 	struct SEXPR_STRING : public SEXPR
 	{
-		std::string m_value;
-		SEXPR_STRING(std::string value) : SEXPR(SEXPR_TYPE_ATOM_STRING), m_value(value) {};
-		SEXPR_STRING(std::string value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_STRING, lineNumber), m_value(value) {};
+		std::string m_storage;
+		STRING_VIEW m_value;
+		SEXPR_STRING(std::string value) : SEXPR(SEXPR_TYPE_ATOM_STRING), m_storage(value), m_value(m_storage) {};
+		SEXPR_STRING(std::string value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_STRING, lineNumber), m_storage(value), m_value(m_storage) {};
+		SEXPR_STRING(const STRING_VIEW& value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_STRING, lineNumber), m_value(value) {};
+		SEXPR_STRING(const SEXPR_STRING&) = delete;
+		SEXPR_STRING& operator=(const SEXPR_STRING&) = delete;
 	};
 
 	struct SEXPR_SYMBOL : public SEXPR
 	{
-		std::string m_value;
-		SEXPR_SYMBOL(std::string value) : SEXPR(SEXPR_TYPE_ATOM_SYMBOL), m_value(value) {};
-		SEXPR_SYMBOL(std::string value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_SYMBOL, lineNumber), m_value(value) {};
+		std::string m_storage;
+		STRING_VIEW m_value;
+		SEXPR_SYMBOL(std::string value) : SEXPR(SEXPR_TYPE_ATOM_SYMBOL), m_storage(value), m_value(m_storage) {};
+		SEXPR_SYMBOL(std::string value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_SYMBOL, lineNumber), m_storage(value), m_value(m_storage) {};
+		SEXPR_SYMBOL(const STRING_VIEW& value, int lineNumber) : SEXPR(SEXPR_TYPE_ATOM_SYMBOL, lineNumber), m_value(value) {};
+		SEXPR_SYMBOL(const SEXPR_SYMBOL&) = delete;
+		SEXPR_SYMBOL& operator=(const SEXPR_SYMBOL&) = delete;
 	};
 
 	struct _OUT_STRING
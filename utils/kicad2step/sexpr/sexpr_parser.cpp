@@ -18,8 +18,9 @@
 
 #include "sexpr/sexpr_parser.h"
 #include "sexpr/sexpr_exception.h"
-#include <cctype>
-#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
 #include <stdlib.h>     /* strtod */
 
@@ -28,28 +29,104 @@
 
 namespace SEXPR
 {
-    const std::string PARSER::whitespaceCharacters = " \t\n\r\b\f\v";
+    namespace
+    {
+        enum CHAR_CLASS
+        {
+            CHAR_WHITESPACE = 1,    // " \t\n\r\b\f\v"
+            CHAR_DELIMITER = 2,     // ends a symbol or a number: whitespace and parentheses
+            CHAR_NUMBER = 4         // "0123456789."
+        };
+
+        struct CHAR_TABLE
+        {
+            unsigned char m_class[256];
+
+            CHAR_TABLE()
+            {
+                memset(m_class, 0, sizeof(m_class));
+
+                for (const char* c = " \t\n\r\b\f\v"; *c; ++c)
+                    m_class[(unsigned char) *c] = CHAR_WHITESPACE | CHAR_DELIMITER;
+
+                m_class['('] = m_class[')'] = CHAR_DELIMITER;
+
+                for (const char* c = "0123456789."; *c; ++c)
+                    m_class[(unsigned char) *c] = CHAR_NUMBER;
+            }
+
+            bool Is(char c, int aClass) const { return m_class[(unsigned char) c] & aClass; }
+        };
+
+        const CHAR_TABLE charTable;
+    }
+
+    ARENA::ARENA() : m_current(NULL), m_left(0)
+    {
+    }
+
+    void* ARENA::Allocate(size_t size)
+    {
+        const size_t align = alignof(std::max_align_t);
+        size = (size + align - 1) & ~(align - 1);
+
+        if (size > m_left)
+        {
+            // Oversized requests get their own block, the current one stays in use
+            size_t blockSize = std::max(size, static_cast<size_t>(BLOCK_SIZE));
+            m_blocks.emplace_back(new char[blockSize]);
+
+            if (size > BLOCK_SIZE)
+                return m_blocks.back().get();
+
+            m_current = m_blocks.back().get();
+            m_left = blockSize;
+        }
+
+        void* ptr = m_current;
+        m_current += size;
+        m_left -= size;
+
+        return ptr;
+    }
 
-    PARSER::PARSER() : m_lineNumber(0), m_lineOffset(0)
+    PARSER::PARSER() : m_lineNumber(1), m_lineOffset(0)
     {
     }
 
     PARSER::~PARSER()
     {
+        // The memory of the nodes goes with the arena, but the lists have their
+        // vector of children to release
+        for (SEXPR* root : m_roots)
+            destroyLists(root);
+    }
+
+    void PARSER::destroyLists(SEXPR* aNode)
+    {
+        if (!aNode || !aNode->IsList())
+            return;
+
+        SEXPR_LIST* list = static_cast<SEXPR_LIST*>(aNode);
+
+        for (SEXPR* child : list->m_children)
+            destroyLists(child);
+
+        // The children are not deleted by the destructor: they are in the arena
+        list->m_children.clear();
+        list->~SEXPR_LIST();
     }
 
     SEXPR* PARSER::Parse(const std::string &aString) 
     {
-        std::string::const_iterator it = aString.begin();
-        return parseString(aString, it);
+        m_buffers.push_back(aString);
+        return parseBuffer(m_buffers.back());
     }
 
     SEXPR* PARSER::ParseFromFile(const std::string &aFileName)
     {
-        std::string str = GetFileContents(aFileName);
-
-        std::string::const_iterator it = str.begin();
-        return parseString(str, it);
+        m_buffers.push_back(GetFileContents(aFileName));
+        return parseBuffer(m_buffers.back());
     }
 
     std::string PARSER::GetFileContents(const std::string &aFileName)
@@ -74,42 +151,75 @@ namespace SEXPR
         return str;
     }
 
-    SEXPR* PARSER::parseString(const std::string& aString, std::string::const_iterator& it)
+    SEXPR* PARSER::parseBuffer(const std::string& aBuffer)
     {
-        std::string::const_iterator eit = aString.end();
-        for (; it != aString.end(); ++it)
+        const char* it = aBuffer.data();
+        SEXPR* root;
+
+        m_lineNumber = 1;
+        m_stack.clear();
+
+        try
+        {
+            root = parseString(it, it + aBuffer.size());
+        }
+        catch (...)
         {
-            if (*it == '\n')
+            // The lists already read are waiting on the stack to be added to their parent
+            for (SEXPR* node : m_stack)
+                destroyLists(node);
+
+            m_stack.clear();
+            throw;
+        }
+
+        m_roots.push_back(root);
+        return root;
+    }
+
+    SEXPR* PARSER::parseString(const char*& it, const char* end)
+    {
+        for (; it != end; ++it)
+        {
+            if (charTable.Is(*it, CHAR_WHITESPACE))
             {
-                m_lineNumber++;
-                m_lineOffset = 0;
-            }
+                if (*it == '\n')
+                    m_lineNumber++;
 
-            if (whitespaceCharacters.find(*it) != std::string::npos)
                 continue;
+            }
 
             if (*it == '(')
             {
-                std::advance(it, 1);
+                int lineNumber = m_lineNumber;
+                size_t first = m_stack.size();
+
+                ++it;
 
-                SEXPR_LIST* list = new SEXPR_LIST(m_lineNumber);
-                while (it != aString.end() && *it != ')')
+                while (it != end && *it != ')')
                 {
-                    if (whitespaceCharacters.find(*it) != std::string::npos)
+                    if (charTable.Is(*it, CHAR_WHITESPACE))
                     {
-                        std::advance(it, 1);
+                        if (*it == '\n')
+                            m_lineNumber++;
+
+                        ++it;
                         continue;
                     }
 
-                    SEXPR* item = parseString(aString, it);
-                    list->AddChild(item);
+                    m_stack.push_back(parseString(it, end));
                 }
 
-                if (it != aString.end())
+                if (it != end)
                 {
-                    std::advance(it, 1);
+                    ++it;
                 }
 
+                // The children are only known now, the vector is allocated once
+                SEXPR_LIST* list = m_arena.Create<SEXPR_LIST>(lineNumber);
+                list->m_children.assign(m_stack.begin() + first, m_stack.end());
+                m_stack.resize(first);
+
                 return list;
             }
             else if (*it == ')')
@@ -118,13 +228,14 @@ namespace SEXPR
             }
             else if (*it == '"')
             {
-                size_t startPos = std::distance(aString.begin(), it) + 1;
-                size_t closingPos = aString.find_first_of('"', startPos);
+                const char* start = it + 1;
+                const char* closing = static_cast<const char*>(memchr(start, '"', end - start));
 
-                if (closingPos != std::string::npos)
+                if (closing)
                 {
-                    SEXPR_STRING* str = new SEXPR_STRING(aString.substr(startPos, closingPos - startPos),m_lineNumber);
-                    std::advance(it, closingPos - startPos + 2);
+                    SEXPR_STRING* str = m_arena.Create<SEXPR_STRING>(STRING_VIEW(start, closing - start), m_lineNumber);
+                    m_lineNumber += std::count(start, closing, '\n');
+                    it = closing + 1;
 
                     return str;
                 }
@@ -135,35 +246,46 @@ namespace SEXPR
             }
             else
             {
-                size_t startPos = std::distance(aString.begin(), it);
-                size_t closingPos = aString.find_first_of(whitespaceCharacters+"()", startPos);
+                // A number is made of digits and dots, with an optional leading minus sign
+                const char* start = it;
+                const char* closing = *it == '-' ? it + 1 : it;
+                bool isNumber = true;
+                bool isDouble = false;
 
-                std::string tmp = aString.substr(startPos, closingPos - startPos);
+                for (; closing != end && !charTable.Is(*closing, CHAR_DELIMITER); ++closing)
+                {
+                    if (!charTable.Is(*closing, CHAR_NUMBER))
+                        isNumber = false;
+                    else if (*closing == '.')
+                        isDouble = true;
+                }
 
+                // A lone minus sign is a symbol
+                if (closing == start + 1 && *start == '-')
+                    isNumber = false;
 
-                if (closingPos != std::string::npos)
+                if (closing != end)
                 {
-                    if (tmp.find_first_not_of("0123456789.") == std::string::npos ||
-                        (tmp.size() > 1 && tmp[0] == '-' && tmp.find_first_not_of("0123456789.",1) == std::string::npos)
-                        )
+                    if (isNumber)
                     {
+                        // The token is followed by a delimiter, where the conversion stops
                         SEXPR* res;
-                        if (tmp.find('.') != std::string::npos)
+                        if (isDouble)
                         {
-                            res = new SEXPR_DOUBLE(strtod(tmp.c_str(), NULL), m_lineNumber);
+                            res = m_arena.Create<SEXPR_DOUBLE>(strtod(start, NULL), m_lineNumber);
                             //floating point type
                         }
                         else
                         {
-                            res = new SEXPR_INTEGER(strtoll(tmp.c_str(), NULL, 0), m_lineNumber);
+                            res = m_arena.Create<SEXPR_INTEGER>(static_cast<int64_t>(strtoll(start, NULL, 0)), m_lineNumber);
                         }
-                        std::advance(it, closingPos - startPos);
+                        it = closing;
                         return res;
                     }
                     else
                     {
-                        SEXPR_SYMBOL* str = new SEXPR_SYMBOL(tmp, m_lineNumber);
-                        std::advance(it, closingPos - startPos);
+                        SEXPR_SYMBOL* str = m_arena.Create<SEXPR_SYMBOL>(STRING_VIEW(start, closing - start), m_lineNumber);
+                        it = closing;
 
                         return str;
                     }
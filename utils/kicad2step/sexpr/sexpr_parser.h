@@ -20,12 +20,44 @@
 #define SEXPR_PARSER_H_
 
 #include "sexpr/sexpr.h"
+#include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 
 
 namespace SEXPR
 {
+    /**
+     * Hands out the memory of the nodes read by the PARSER from large blocks, all
+     * released at once by the destructor.
+     */
+    class ARENA
+    {
+    public:
+        ARENA();
+        void* Allocate(size_t size);
+
+        template <typename T, typename... Args>
+        T* Create(const Args&... args)
+        {
+            return new (Allocate(sizeof(T))) T(args...);
+        }
+
+    private:
+        static const size_t BLOCK_SIZE = 1 << 20;
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        char* m_current;
+        size_t m_left;
+    };
+
+    /**
+     * Reads s-expressions from a string or a file.
+     *
+     * The returned trees belong to the parser and stay valid as long as it lives:
+     * the nodes are allocated in its ARENA and the strings and symbols point into the
+     * text it keeps, so they must not be deleted.
+     */
     class PARSER
     {
     public:
@@ -35,8 +67,14 @@ namespace SEXPR
         SEXPR* ParseFromFile(const std::string &filename);
         static std::string GetFileContents(const std::string &filename);
     private:
-        SEXPR* parseString(const std::string& aString, std::string::const_iterator& it);
-        static const std::string whitespaceCharacters;
+        SEXPR* parseBuffer(const std::string& aBuffer);
+        SEXPR* parseString(const char*& it, const char* end);
+        void destroyLists(SEXPR* aNode);
+
+        ARENA m_arena;
+        std::deque<std::string> m_buffers;  ///< the text of each parsed tree
+        std::vector<SEXPR*> m_roots;
+        std::vector<SEXPR*> m_stack;        ///< children of the lists being read
         int m_lineNumber;
         int m_lineOffset;
     };